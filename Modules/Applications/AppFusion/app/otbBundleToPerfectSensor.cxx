@@ -76,6 +76,9 @@ private:
 
     Connect("pansharp.inp","superimpose.inr");
     Connect("pansharp.ram","superimpose.ram");
+
+    // The superimposed image is fused in the same streamed pipeline
+    ConnectImage("pansharp.inxs","superimpose.out");
     
     // Doc example parameter settings
     SetDocExampleParameterValue("inp", "QB_Toulouse_Ortho_PAN.tif");
@@ -92,12 +95,7 @@ private:
 
   void DoExecute() ITK_OVERRIDE
   {
-    ExecuteInternal("superimpose");
-
-    GetInternalApplication("pansharp")->SetParameterInputImage("inxs",
-      GetInternalApplication("superimpose")->GetParameterOutputImage("out"));
-
-    ExecuteInternal("pansharp");
+    ExecuteChain("pansharp");
   }
 
 };
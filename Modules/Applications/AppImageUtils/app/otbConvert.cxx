@@ -23,6 +23,7 @@
 
 #include "otbVectorRescaleIntensityImageFilter.h"
 #include "otbUnaryImageFunctorWithVectorImageFilter.h"
+#include "otbFunctorChainImageFilter.h"
 #include "otbStreamingShrinkImageFilter.h"
 #include "itkListSample.h"
 #include "otbListSampleToHistogramListGenerator.h"
@@ -215,8 +216,16 @@ private:
         SetDefaultParameterInt("channels.rgb.blue", bandBlue);
         }
       }
-    
 
+    // The rescaling estimates the histogram of the input first
+    if (GetParameterString("type") == "none")
+      {
+      MultiPassInputOff("in");
+      }
+    else
+      {
+      MultiPassInputOn("in");
+      }
   }
 
   template<class TImageType>
@@ -294,13 +303,11 @@ private:
         m_TransferLog->UpdateOutputInformation();
 
         shrinkFilter->SetInput(m_TransferLog->GetOutput());
-        rescaler->SetInput(m_TransferLog->GetOutput());
         shrinkFilter->Update();
         }
       else
         {
         shrinkFilter->SetInput(tempImage);
-        rescaler->SetInput(tempImage);
         shrinkFilter->Update();
         }
 
@@ -378,18 +385,42 @@ private:
       otbAppLogDEBUG( << std::setprecision(5) << "Min/Max computation done : min=" << inputMin
                       << " max=" << inputMax );
 
-      rescaler->AutomaticInputMinMaxComputationOff();
-      rescaler->SetInputMinimum(inputMin);
-      rescaler->SetInputMaximum(inputMax);
-
-      if ( rescaleType == "linear")
+      if ( rescaleType == "log2")
         {
-        rescaler->SetGamma(GetParameterFloat("type.linear.gamma"));
+        // Apply the log and the rescaling in a single pass
+        typedef otb::Functor::PerBandFunctor<FloatVectorImageType::PixelType,
+                                             FloatVectorImageType::PixelType,
+                                             TransferLogFunctor>             PerBandLogFunctorType;
+        typedef FunctorChainImageFilter<FloatVectorImageType, TImageType,
+                                        PerBandLogFunctorType,
+                                        typename RescalerType::FunctorType>  LogRescalerType;
+
+        typename LogRescalerType::Pointer logRescaler = LogRescalerType::New();
+        logRescaler->SetInput(tempImage);
+        logRescaler->template GetNthFunctor<0>().SetFunctorVector(std::vector<TransferLogFunctor>(nbComp));
+
+        typename RescalerType::FunctorType & affineFunctor = logRescaler->template GetNthFunctor<1>();
+        affineFunctor.SetInputMinimum(inputMin);
+        affineFunctor.SetInputMaximum(inputMax);
+        affineFunctor.SetOutputMinimum(minimum);
+        affineFunctor.SetOutputMaximum(maximum);
+
+        m_Filters.push_back(logRescaler.GetPointer());
+
+        SetParameterOutputImage<TImageType>("out", logRescaler->GetOutput());
         }
+      else
+        {
+        rescaler->SetInput(tempImage);
+        rescaler->AutomaticInputMinMaxComputationOff();
+        rescaler->SetInputMinimum(inputMin);
+        rescaler->SetInputMaximum(inputMax);
+        rescaler->SetGamma(GetParameterFloat("type.linear.gamma"));
 
-      m_Filters.push_back(rescaler.GetPointer());
+        m_Filters.push_back(rescaler.GetPointer());
 
-      SetParameterOutputImage<TImageType>("out", rescaler->GetOutput());
+        SetParameterOutputImage<TImageType>("out", rescaler->GetOutput());
+        }
       }
   }
 
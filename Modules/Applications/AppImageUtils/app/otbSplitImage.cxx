@@ -22,6 +22,7 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbMultiToMonoChannelExtractROI.h"
+#include "otbMultiImageFileWriter.h"
 
 namespace otb
 {
@@ -55,7 +56,7 @@ private:
     SetDescription("Split a N multiband image into N images");
 
     SetDocName("Split Image");
-    SetDocLongDescription("This application splits a N-bands image into N mono-band images. The output images filename will be generated from the output parameter. Thus if the input image has 2 channels, and the user has set an output outimage.tif, the generated images will be outimage_0.tif and outimage_1.tif");
+    SetDocLongDescription("This application splits a N-bands image into N mono-band images. The output images filename will be generated from the output parameter. Thus if the input image has 2 channels, and the user has set an output outimage.tif, the generated images will be outimage_0.tif and outimage_1.tif. All the output images are written while the input image is read once.");
     SetDocLimitations("None");
     SetDocAuthors("OTB-Team");
     SetDocSeeAlso(" ");
@@ -97,14 +98,22 @@ private:
     fname = itksys::SystemTools::GetFilenameWithoutExtension(ofname);
     ext   = itksys::SystemTools::GetFilenameExtension(ofname);
 
-    // Set the extract filter input image
-    m_Filter = FilterType::New();
-    m_Filter->SetInput(inImage);
+    // All the bands are written together, unless the output filename
+    // holds options changing the written region or the streaming
+    const bool writeTogether = MultiImageFileWriter::IsSupportedFileName(ofname);
+    MultiImageFileWriter::Pointer multiWriter = MultiImageFileWriter::New();
+    multiWriter->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+
+    m_Filters.clear();
+    m_OutputParameters.clear();
 
     for (unsigned int i = 0; i < inImage->GetNumberOfComponentsPerPixel(); ++i)
       {
-      // Set the channel to extract
-      m_Filter->SetChannel(i+1);
+      // Set the extract filter input image and the channel to extract
+      FilterType::Pointer filter = FilterType::New();
+      filter->SetInput(inImage);
+      filter->SetChannel(i+1);
+      m_Filters.push_back(filter);
 
       // build the current output filename
       std::ostringstream oss;
@@ -124,12 +133,27 @@ private:
       // Set the filename of the current output image
       paramOut->SetFileName(oss.str());
       otbAppLogINFO(<< "File: "<<paramOut->GetFileName() << " will be written.");
-      paramOut->SetValue(m_Filter->GetOutput());
+      paramOut->SetValue(filter->GetOutput());
       paramOut->SetPixelType(this->GetParameterOutputImagePixelType("out"));
-      // Add the current level to be written
+      // Add the current channel to be written
       paramOut->InitializeWriters();
-      AddProcess(paramOut->GetWriter(), osswriter.str());
-      paramOut->Write();
+      if (writeTogether)
+        {
+        paramOut->AddToMultiWriter(multiWriter);
+        m_OutputParameters.push_back(paramOut);
+        }
+      else
+        {
+        paramOut->SetRAMValue(GetParameterInt("ram"));
+        AddProcess(paramOut->GetWriter(), osswriter.str());
+        paramOut->Write();
+        }
+      }
+
+    if (writeTogether)
+      {
+      AddProcess(multiWriter, "Writing channels...");
+      multiWriter->Update();
       }
 
     // Disable the output Image parameter to avoid writing
@@ -137,7 +161,8 @@ private:
     DisableParameter("out");
   }
 
-  FilterType::Pointer        m_Filter;
+  std::vector<FilterType::Pointer>           m_Filters;
+  std::vector<OutputImageParameter::Pointer> m_OutputParameters;
 };
 }
 }
@@ -30,6 +30,8 @@
 #include "otbReflectanceToSurfaceReflectanceImageFilter.h"
 #include "itkMultiplyImageFilter.h"
 #include "otbClampVectorImageFilter.h"
+#include "otbFunctorChainImageFilter.h"
+#include "otbMultiplyByScalarImageFilter.h"
 #include "otbSurfaceAdjacencyEffectCorrectionSchemeFilter.h"
 #include "otbGroundSpacingImageFunction.h"
 #include "vnl/vnl_random.h"
@@ -95,6 +97,28 @@ public:
   typedef otb::ClampVectorImageFilter<DoubleVectorImageType,
                                       DoubleVectorImageType>              ClampFilterType;
 
+  typedef otb::Functor::MultiplyByScalar<double, double>                   ScaleFunctorType;
+
+  typedef otb::Functor::FunctorChain<ImageToRadianceImageFilterType::FunctorType,
+                                     RadianceToReflectanceImageFilterType::FunctorType,
+                                     ScaleFunctorType>                    ImageToReflectanceFunctorType;
+
+  typedef otb::Functor::FunctorChain<ReflectanceToRadianceImageFilterType::FunctorType,
+                                     RadianceToImageImageFilterType::FunctorType,
+                                     ScaleFunctorType>                    ReflectanceToImageFunctorType;
+
+  typedef FunctorChainImageFilter<FloatVectorImageType, DoubleVectorImageType,
+                                  otb::Functor::PerBandFunctor<FloatVectorImageType::PixelType,
+                                                               DoubleVectorImageType::PixelType,
+                                                               ImageToReflectanceFunctorType> >
+                                                                          ImageToReflectanceFilterType;
+
+  typedef FunctorChainImageFilter<FloatVectorImageType, DoubleVectorImageType,
+                                  otb::Functor::PerBandFunctor<FloatVectorImageType::PixelType,
+                                                               DoubleVectorImageType::PixelType,
+                                                               ReflectanceToImageFunctorType> >
+                                                                          ReflectanceToImageFilterType;
+
   typedef ReflectanceToSurfaceReflectanceImageFilter<DoubleVectorImageType,
                                                      DoubleVectorImageType>          ReflectanceToSurfaceReflectanceImageFilterType;
   typedef ReflectanceToSurfaceReflectanceImageFilterType::FilterFunctionValuesType  FilterFunctionValuesType;
@@ -758,7 +782,6 @@ private:
 
         m_RadianceToReflectanceFilter->SetUseClamp(IsParameterEnabled("clamp"));
         m_RadianceToReflectanceFilter->UpdateOutputInformation();
-        m_ScaleFilter->SetInput(m_RadianceToReflectanceFilter->GetOutput());
       }
       break;
       case Level_TOA_IM:
@@ -769,7 +792,6 @@ private:
         m_ReflectanceToRadianceFilter->SetInput(inImage);
         m_RadianceToImageFilter->SetInput(m_ReflectanceToRadianceFilter->GetOutput());
         m_RadianceToImageFilter->UpdateOutputInformation();
-        m_ScaleFilter->SetInput(m_RadianceToImageFilter->GetOutput());
       }
       break;
       case Level_TOC:
@@ -928,9 +950,58 @@ private:
       if (GetParameterInt("level") == Level_TOA_IM)
         scale=1. / 1000.;
     }
-    m_ScaleFilter->SetConstant(scale);
 
-    SetParameterOutputImage("out", m_ScaleFilter->GetOutput());
+    switch ( GetParameterInt("level") )
+    {
+      case Level_IM_TOA:
+      {
+        // Calibration and scaling are per band: apply them in a single pass
+        m_ImageToReflectanceFilter =
+          FuseCalibrationFilters<ImageToReflectanceFilterType>(m_ImageToRadianceFilter.GetPointer(),
+                                                               m_RadianceToReflectanceFilter.GetPointer(),
+                                                               scale);
+        SetParameterOutputImage("out", m_ImageToReflectanceFilter->GetOutput());
+      }
+      break;
+      case Level_TOA_IM:
+      {
+        m_ReflectanceToImageFilter =
+          FuseCalibrationFilters<ReflectanceToImageFilterType>(m_ReflectanceToRadianceFilter.GetPointer(),
+                                                               m_RadianceToImageFilter.GetPointer(),
+                                                               scale);
+        SetParameterOutputImage("out", m_ReflectanceToImageFilter->GetOutput());
+      }
+      break;
+      default:
+      {
+        m_ScaleFilter->SetConstant(scale);
+        SetParameterOutputImage("out", m_ScaleFilter->GetOutput());
+      }
+      break;
+    }
+  }
+
+  /** Gather the per band functors of two calibration filters, followed
+   * by the scaling, in a filter applying them in a single pass. The
+   * output information of the second filter must be up to date. */
+  template <class TFusedFilter, class TFirstFilter, class TSecondFilter>
+  typename TFusedFilter::Pointer FuseCalibrationFilters(TFirstFilter * first, TSecondFilter * second, double scale)
+  {
+    first->InitializeFunctorVector();
+    second->InitializeFunctorVector();
+
+    typename TFusedFilter::Pointer fused = TFusedFilter::New();
+    fused->SetInput(first->GetInput());
+
+    auto & bandFunctors = fused->template GetNthFunctor<0>().GetFunctorVector();
+    bandFunctors.resize(first->GetFunctorVector().size());
+    for (unsigned int i = 0; i < bandFunctors.size(); ++i)
+      {
+      bandFunctors[i].template GetNthFunctor<0>() = first->GetFunctorVector()[i];
+      bandFunctors[i].template GetNthFunctor<1>() = second->GetFunctorVector()[i];
+      bandFunctors[i].template GetNthFunctor<2>().SetCoef(scale);
+      }
+    return fused;
   }
 
   //Keep object references as a members of the class, else the pipeline will be broken after exiting DoExecute().
@@ -940,6 +1011,8 @@ private:
   RadianceToImageImageFilterType::Pointer                m_RadianceToImageFilter;
   ReflectanceToSurfaceReflectanceImageFilterType::Pointer m_ReflectanceToSurfaceReflectanceFilter;
   ScaleFilterOutDoubleType::Pointer                       m_ScaleFilter;
+  ImageToReflectanceFilterType::Pointer                   m_ImageToReflectanceFilter;
+  ReflectanceToImageFilterType::Pointer                   m_ReflectanceToImageFilter;
   AtmoCorrectionParametersPointerType                     m_paramAtmo;
   AcquiCorrectionParametersPointerType                    m_paramAcqui;
   ClampFilterType::Pointer                                m_ClampFilter;
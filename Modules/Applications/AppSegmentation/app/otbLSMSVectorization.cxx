@@ -99,6 +99,10 @@ private:
     AddParameter(ParameterType_InputImage,  "inseg",    "Segmented image");
     SetParameterDescription( "inseg", "Segmented image where each pixel value is the unique integer label of the segment it belongs to.");
 
+    // The statistics are computed before the tiles are vectorized
+    MultiPassInputOn("in");
+    MultiPassInputOn("inseg");
+
     AddParameter(ParameterType_OutputFilename, "out", "Output GIS vector file");
     SetParameterDescription( "out", "The output GIS vector file, representing the vectorized version of the segmented image where the features of the polygons are the radiometric means and variances." );
 
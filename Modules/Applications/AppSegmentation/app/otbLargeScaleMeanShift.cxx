@@ -123,7 +123,8 @@ private:
     AddParameter( ParameterType_Empty, "cleanup", "Temporary files cleaning" );
     EnableParameter( "cleanup" );
     SetParameterDescription( "cleanup",
-      "If activated, the application will try to clean all temporary files it created" );
+      "If activated, the application will try to clean all temporary files it created. "
+      "The label images passed from one step to the next are always removed." );
     MandatoryOff( "cleanup" );
 
     // Setup RAM
@@ -139,6 +140,13 @@ private:
     // TODO : this is not exactly true, we used to choose the smoothed image instead
     Connect("merging.in","smoothing.in");
 
+    // The smoothed images feed the segmentation in memory, the label
+    // images read in several passes are written to temporary files
+    ConnectImage("segmentation.in","smoothing.fout");
+    ConnectImage("segmentation.inpos","smoothing.foutpos");
+    ConnectImage("merging.inseg","segmentation.out");
+    ConnectImage("vectorization.inseg","merging.out");
+
     // Setup constant parameters
     GetInternalApplication("smoothing")->SetParameterString("foutpos","foo");
     GetInternalApplication("smoothing")->EnableParameter("foutpos");
@@ -162,35 +170,30 @@ private:
     std::string outPath(isVector ?
       GetParameterString("mode.vector.out"):
       GetParameterString("mode.raster.out"));
-    std::vector<std::string> tmpFilenames;
-    tmpFilenames.push_back(outPath+std::string("_labelmap.tif"));
-    tmpFilenames.push_back(outPath+std::string("_labelmap.geom"));
-    ExecuteInternal("smoothing");
-    // in-memory connexion here (saves 1 additional update for foutpos)
-    GetInternalApplication("segmentation")->SetParameterInputImage("in",
-      GetInternalApplication("smoothing")->GetParameterOutputImage("fout"));
-    GetInternalApplication("segmentation")->SetParameterInputImage("inpos",
-      GetInternalApplication("smoothing")->GetParameterOutputImage("foutpos"));
-    // temporary file output here
+
+    // The temporary label images are written next to the output
+    std::string outDirectory(itksys::SystemTools::GetFilenamePath(outPath));
+    SetTemporaryDirectory(outDirectory.empty() ? std::string(".") : outDirectory);
+
+    // The segmentation names its tiles after its output
     GetInternalApplication("segmentation")->SetParameterString("out",
-      tmpFilenames[0]);
+      outPath+std::string("_labelmap.tif"));
     // take half of previous radii
     GetInternalApplication("segmentation")->SetParameterFloat("spatialr",
       0.5 * (double)GetInternalApplication("smoothing")->GetParameterInt("spatialr"));
     GetInternalApplication("segmentation")->SetParameterFloat("ranger",
       0.5 * GetInternalApplication("smoothing")->GetParameterFloat("ranger"));
-    GetInternalApplication("segmentation")->ExecuteAndWriteOutput();
+    if (IsParameterEnabled("cleanup"))
+      {
+      GetInternalApplication("segmentation")->EnableParameter("cleanup");
+      }
+    else
+      {
+      GetInternalApplication("segmentation")->DisableParameter("cleanup");
+      }
 
-    GetInternalApplication("merging")->SetParameterString("inseg",
-      tmpFilenames[0]);
-    EnableParameter("mode.raster.out");
     if (isVector)
       {
-      tmpFilenames.push_back(outPath+std::string("_labelmap_merged.tif"));
-      tmpFilenames.push_back(outPath+std::string("_labelmap_merged.geom"));
-      GetInternalApplication("merging")->SetParameterString("out",
-        tmpFilenames[2]);
-      GetInternalApplication("merging")->ExecuteAndWriteOutput();
       if (IsParameterEnabled("mode.vector.imfield") &&
           HasValue("mode.vector.imfield"))
         {
@@ -202,27 +205,17 @@ private:
         GetInternalApplication("vectorization")->SetParameterString("in",
           GetParameterString("in"));
         }
-      GetInternalApplication("vectorization")->SetParameterString("inseg",
-        tmpFilenames[2]);
-      ExecuteInternal("vectorization");
+      ExecuteChain("vectorization");
       }
     else
       {
-      GetInternalApplication("merging")->ExecuteAndWriteOutput();
+      // The merged label image is written as the output
+      ExecuteChain("merging");
       }
-    DisableParameter("mode.raster.out");
 
-    if( IsParameterEnabled( "cleanup" ) )
-      {
-      otbAppLogINFO( <<"Final clean-up ..." );
-      for (unsigned int i=0 ; i<tmpFilenames.size() ; ++i)
-        {
-        if(itksys::SystemTools::FileExists(tmpFilenames[i].c_str()))
-          {
-          itksys::SystemTools::RemoveFile(tmpFilenames[i].c_str());
-          }
-        }
-      }
+    // The segmentation output has been copied to a temporary file: its
+    // tiles can be removed
+    GetInternalApplication("segmentation")->WriteOutputs(std::vector<std::string>(1, "out"));
     }
 
 };
@@ -84,6 +84,48 @@ public:
    */
   static RAMValueType GetMaxRAMHint();
 
+  /**
+   * UseMemoryMappedReading tells if raw image files (BSQ, LUM, RAD,
+   * ONERA) can be memory mapped for reading.
+   *
+   * If environment variable OTB_USE_MMAP is defined and set to OFF,
+   * FALSE, NO or 0, returns false
+   * Else, returns true
+   */
+  static bool GetUseMemoryMappedReading();
+
+  /**
+   * BlockCacheSize is the size of the cache of decoded blocks shared
+   * by the readers of the same files, expressed in MegaBytes.
+   *
+   * If environment variable OTB_BLOCK_CACHE_SIZE is defined and could
+   * be converted to int, return its content as a 64 bits unsigned int.
+   * Else, returns default value, which is 0 (no cache)
+   */
+  static RAMValueType GetBlockCacheSize();
+
+  /**
+   * UseMemoryCalibration tells if the RAM driven streaming managers
+   * of the image writers measure the memory used by the pipeline on
+   * probe regions instead of estimating it.
+   *
+   * If environment variable OTB_MEMORY_CALIBRATION is defined and set
+   * to ON, TRUE, YES or 1, returns true
+   * Else, returns false
+   */
+  static bool GetUseMemoryCalibration();
+
+  /**
+   * UseImageBufferPool tells if the buffers of the images are taken
+   * from a pool recycling the buffers freed by previous streaming
+   * divisions, instead of being allocated each time.
+   *
+   * If environment variable OTB_USE_BUFFER_POOL is defined and set
+   * to ON, TRUE, YES or 1, returns true
+   * Else, returns false
+   */
+  static bool GetUseImageBufferPool();
+
 private:
   ConfigurationManager(); //purposely not implemented
   ~ConfigurationManager(); //purposely not implemented
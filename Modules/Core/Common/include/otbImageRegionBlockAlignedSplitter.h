@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageRegionBlockAlignedSplitter_h
+#define otbImageRegionBlockAlignedSplitter_h
+
+#include "itkRegion.h"
+#include "itkImageRegionSplitter.h"
+#include "itkIndex.h"
+#include "itkSize.h"
+#include "itkFastMutexLock.h"
+
+namespace otb
+{
+
+/** \class ImageRegionBlockAlignedSplitter
+   * \brief Divide a region into pieces made of whole blocks of the
+   * input file.
+   *
+   * This region splitter is given the size of the native blocks (tiles
+   * or strips) of the input image. The block grid starts at index 0.
+   * Each split is a rectangle of whole blocks aligned on this grid
+   * (cropped to the image region), so that a block is never decoded
+   * for two different splits.
+   *
+   * Unlike ImageRegionAdaptativeSplitter, splits are never larger than
+   * the number of pixels of the region divided by the requested number
+   * of splits, so that a memory budget expressed as a number of splits
+   * is honored. There may be less splits than requested when the
+   * blocks on the borders are only partly covered by the region.
+   * Splits span whole rows of blocks whenever possible.
+   *
+   * When a single block is larger than this budget, each block is
+   * divided in strips of lines, all the strips of a block being
+   * spawned before the next block.
+   *
+   * If the block size is empty, or if VImageDimension is not 2, the
+   * splitter falls back to the behaviour of
+   * otb::ImageRegionSquareTileSplitter.
+   *
+   * \sa ImageRegionAdaptativeSplitter
+   * \sa RAMDrivenBlockAlignedStreamingManager
+   *
+   * \ingroup ITKSystemObjects
+   * \ingroup DataProcessing
+ *
+ * \ingroup OTBCommon
+ */
+
+template <unsigned int VImageDimension>
+class ITK_EXPORT ImageRegionBlockAlignedSplitter : public itk::ImageRegionSplitter<VImageDimension>
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageRegionBlockAlignedSplitter           Self;
+  typedef itk::ImageRegionSplitter<VImageDimension> Superclass;
+  typedef itk::SmartPointer<Self>                   Pointer;
+  typedef itk::SmartPointer<const Self>             ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageRegionBlockAlignedSplitter, itk::Object);
+
+  /** Dimension of the image available at compile time. */
+  itkStaticConstMacro(ImageDimension, unsigned int, VImageDimension);
+
+  /** Dimension of the image available at run time. */
+  static unsigned int GetImageDimension()
+  {
+    return VImageDimension;
+  }
+
+  /** Index typedef support. An index is used to access pixel values. */
+  typedef itk::Index<VImageDimension>        IndexType;
+  typedef typename IndexType::IndexValueType IndexValueType;
+
+  /** Size typedef support. A size is used to define region bounds. */
+  typedef itk::Size<VImageDimension>       SizeType;
+  typedef typename SizeType::SizeValueType SizeValueType;
+
+  /** Region typedef support.   */
+  typedef itk::ImageRegion<VImageDimension> RegionType;
+
+  typedef std::vector<RegionType> StreamVectorType;
+
+  /** Set the size of the blocks of the input file */
+  itkSetMacro(BlockSize, SizeType);
+
+  /** Get the size of the blocks of the input file */
+  itkGetConstReferenceMacro(BlockSize, SizeType);
+
+  /** Set the ImageRegion parameter */
+  itkSetMacro(ImageRegion, RegionType);
+
+  /** Get the ImageRegion parameter */
+  itkGetConstReferenceMacro(ImageRegion, RegionType);
+
+  /** Set the requested number of splits parameter */
+  itkSetMacro(RequestedNumberOfSplits, unsigned int);
+
+  /** Get the requested number of splits parameter */
+  itkGetConstReferenceMacro(RequestedNumberOfSplits, unsigned int);
+
+  /**
+   * Calling this method will set the image region and the requested
+   * number of splits, and call the EstimateSplitMap() method if
+   * necessary.
+   */
+  unsigned int GetNumberOfSplits(const RegionType& region,
+                                 unsigned int requestedNumber) ITK_OVERRIDE;
+
+  /** Calling this method will set the image region and call the
+   * EstimateSplitMap() method if necessary. */
+  RegionType GetSplit(unsigned int i, unsigned int numberOfPieces,
+                      const RegionType& region) ITK_OVERRIDE;
+
+  /** Make the Modified() method update the IsUpToDate flag */
+  void Modified() const ITK_OVERRIDE
+  {
+    // Call superclass implementation
+    Superclass::Modified();
+
+    // Invalidate up-to-date
+    m_IsUpToDate = false;
+  }
+
+protected:
+  ImageRegionBlockAlignedSplitter() : m_BlockSize(),
+                                      m_ImageRegion(),
+                                      m_RequestedNumberOfSplits(0),
+                                      m_StreamVector(),
+                                      m_IsUpToDate(false)
+                                        {}
+
+  ~ImageRegionBlockAlignedSplitter() ITK_OVERRIDE {}
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  /** This methods actually estimate the split map and stores it in a
+  vector */
+  void EstimateSplitMap();
+
+  ImageRegionBlockAlignedSplitter(const ImageRegionBlockAlignedSplitter &); //purposely not implemented
+  void operator =(const ImageRegionBlockAlignedSplitter&); //purposely not implemented
+
+  // Size of the blocks of the input file
+  SizeType   m_BlockSize;
+
+  // This contains the ImageRegion that is currently being split
+  RegionType m_ImageRegion;
+
+  // This contains the requested number of splits
+  unsigned int m_RequestedNumberOfSplits;
+
+  // This is a vector of all regions which will be split
+  StreamVectorType m_StreamVector;
+
+  // Is the splitter up-to-date ?
+  mutable bool m_IsUpToDate;
+
+  // Lock to ensure thread-safety
+  itk::SimpleFastMutexLock m_Lock;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+# include "otbImageRegionBlockAlignedSplitter.txx"
+#endif
+
+#endif
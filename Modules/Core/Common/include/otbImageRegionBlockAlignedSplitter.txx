@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageRegionBlockAlignedSplitter_txx
+#define otbImageRegionBlockAlignedSplitter_txx
+
+#include "otbImageRegionBlockAlignedSplitter.h"
+#include "otbMacro.h"
+
+#include <algorithm>
+
+// Default when no block size is available
+#include "otbImageRegionSquareTileSplitter.h"
+
+namespace otb
+{
+
+template <unsigned int VImageDimension>
+unsigned int
+ImageRegionBlockAlignedSplitter<VImageDimension>
+::GetNumberOfSplits(const RegionType& region, unsigned int requestedNumber)
+{
+  // Set parameters
+  this->SetImageRegion(region);
+  this->SetRequestedNumberOfSplits(requestedNumber);
+
+  // Check if we need to compute split map again
+  m_Lock.Lock();
+  if(!m_IsUpToDate)
+    {
+    this->EstimateSplitMap();
+    }
+  m_Lock.Unlock();
+
+  // Return the size of the split map
+  return m_StreamVector.size();
+}
+
+template <unsigned int VImageDimension>
+itk::ImageRegion<VImageDimension>
+ImageRegionBlockAlignedSplitter<VImageDimension>
+::GetSplit(unsigned int i, unsigned int itkNotUsed(numberOfPieces), const RegionType& region)
+{
+  // Set parameters
+  this->SetImageRegion(region);
+
+  // Check if we need to compute split map again
+  m_Lock.Lock();
+  if(!m_IsUpToDate)
+    {
+    this->EstimateSplitMap();
+    }
+  m_Lock.Unlock();
+
+  // Return the requested split
+  return m_StreamVector.at(i);
+}
+
+template <unsigned int VImageDimension>
+void
+ImageRegionBlockAlignedSplitter<VImageDimension>
+::EstimateSplitMap()
+{
+  // Clear previous split map
+  m_StreamVector.clear();
+
+  // Handle trivial case
+  if(m_RequestedNumberOfSplits <= 1)
+    {
+    m_StreamVector.push_back(m_ImageRegion);
+    m_IsUpToDate = true;
+    return;
+    }
+
+  // Handle the empty block size case and the case where VImageDimension != 2
+  if(VImageDimension != 2 || m_BlockSize[0] == 0 || m_BlockSize[1] == 0)
+    {
+    typename otb::ImageRegionSquareTileSplitter<VImageDimension>::Pointer
+      splitter = otb::ImageRegionSquareTileSplitter<VImageDimension>::New();
+
+    unsigned int nbSplits = splitter->GetNumberOfSplits(m_ImageRegion, m_RequestedNumberOfSplits);
+
+    for(unsigned int i = 0; i<nbSplits; ++i)
+      {
+      m_StreamVector.push_back(splitter->GetSplit(i, m_RequestedNumberOfSplits, m_ImageRegion));
+      }
+    m_IsUpToDate = true;
+    return;
+    }
+
+  // Blocks covered by the region
+  SizeType blocksPerDim;
+  IndexType firstBlockCovered;
+  for(unsigned int dim = 0; dim < 2; ++dim)
+    {
+    const SizeValueType blockSize = m_BlockSize[dim];
+    firstBlockCovered[dim] = m_ImageRegion.GetIndex()[dim] / blockSize;
+    blocksPerDim[dim] = (m_ImageRegion.GetIndex()[dim] + m_ImageRegion.GetSize()[dim] + blockSize - 1) / blockSize
+      - firstBlockCovered[dim];
+    }
+
+  // Largest split honoring the requested number of splits
+  const SizeValueType maxPixelsPerSplit =
+    std::max<SizeValueType>(1, m_ImageRegion.GetNumberOfPixels() / m_RequestedNumberOfSplits);
+  const SizeValueType blockPixels = m_BlockSize[0] * m_BlockSize[1];
+
+  if(blockPixels <= maxPixelsPerSplit)
+    {
+    // Group blocks, without exceeding the size of a split. Whole rows
+    // of blocks are preferred, as they are read with contiguous
+    // requests.
+    const SizeValueType maxBlocksPerSplit = maxPixelsPerSplit / blockPixels;
+
+    SizeType groupBlocks;
+    if(maxBlocksPerSplit >= blocksPerDim[0])
+      {
+      groupBlocks[0] = blocksPerDim[0];
+      groupBlocks[1] = maxBlocksPerSplit / blocksPerDim[0];
+      }
+    else
+      {
+      groupBlocks[0] = maxBlocksPerSplit;
+      groupBlocks[1] = 1;
+      }
+
+    SizeType splitsPerDim;
+    splitsPerDim[0] = (blocksPerDim[0] + groupBlocks[0] - 1) / groupBlocks[0];
+    splitsPerDim[1] = (blocksPerDim[1] + groupBlocks[1] - 1) / groupBlocks[1];
+
+    SizeType splitSize;
+    splitSize[0] = groupBlocks[0] * m_BlockSize[0];
+    splitSize[1] = groupBlocks[1] * m_BlockSize[1];
+
+    for(SizeValueType splity = 0; splity < splitsPerDim[1]; ++splity)
+      {
+      for(SizeValueType splitx = 0; splitx < splitsPerDim[0]; ++splitx)
+        {
+        IndexType splitIndex;
+        splitIndex[0] = firstBlockCovered[0] * m_BlockSize[0] + splitx * splitSize[0];
+        splitIndex[1] = firstBlockCovered[1] * m_BlockSize[1] + splity * splitSize[1];
+
+        RegionType newSplit(splitIndex, splitSize);
+
+        // Partially covered blocks are cropped to the image region
+        if(newSplit.Crop(m_ImageRegion))
+          {
+          m_StreamVector.push_back(newSplit);
+          }
+        }
+      }
+    }
+  else
+    {
+    // A block is larger than the budget: divide each block in strips
+    // of lines, or in pieces of one line when blocks have less lines
+    // than the number of divisions
+    const SizeValueType divisions = (blockPixels + maxPixelsPerSplit - 1) / maxPixelsPerSplit;
+
+    SizeType splitSize;
+    if(m_BlockSize[1] >= divisions)
+      {
+      splitSize[0] = m_BlockSize[0];
+      splitSize[1] = m_BlockSize[1] / divisions;
+      }
+    else
+      {
+      const SizeValueType columnDivisions = (divisions + m_BlockSize[1] - 1) / m_BlockSize[1];
+      splitSize[0] = std::max<SizeValueType>(1, m_BlockSize[0] / columnDivisions);
+      splitSize[1] = 1;
+      }
+
+    SizeType divisionsPerDim;
+    divisionsPerDim[0] = (m_BlockSize[0] + splitSize[0] - 1) / splitSize[0];
+    divisionsPerDim[1] = (m_BlockSize[1] + splitSize[1] - 1) / splitSize[1];
+
+    for(SizeValueType blocky = 0; blocky < blocksPerDim[1]; ++blocky)
+      {
+      for(SizeValueType blockx = 0; blockx < blocksPerDim[0]; ++blockx)
+        {
+        IndexType blockIndex;
+        blockIndex[0] = (firstBlockCovered[0] + blockx) * m_BlockSize[0];
+        blockIndex[1] = (firstBlockCovered[1] + blocky) * m_BlockSize[1];
+        const RegionType blockRegion(blockIndex, m_BlockSize);
+
+        for(SizeValueType divy = 0; divy < divisionsPerDim[1]; ++divy)
+          {
+          for(SizeValueType divx = 0; divx < divisionsPerDim[0]; ++divx)
+            {
+            IndexType splitIndex;
+            splitIndex[0] = blockIndex[0] + divx * splitSize[0];
+            splitIndex[1] = blockIndex[1] + divy * splitSize[1];
+
+            RegionType newSplit(splitIndex, splitSize);
+
+            // Keep the split inside its block and the image region
+            if(newSplit.Crop(blockRegion) && newSplit.Crop(m_ImageRegion))
+              {
+              m_StreamVector.push_back(newSplit);
+              }
+            }
+          }
+        }
+      }
+    }
+
+  otbMsgDevMacro(<< "Block aligned split map: " << m_StreamVector.size()
+                 << " splits (requested: " << m_RequestedNumberOfSplits << ")");
+
+  // Finally toggle the up-to-date flag
+  m_IsUpToDate = true;
+}
+
+template <unsigned int VImageDimension>
+void
+ImageRegionBlockAlignedSplitter<VImageDimension>
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os<<indent<<"IsUpToDate: "<<(m_IsUpToDate ? "true" : "false")<<std::endl;
+  os<<indent<<"ImageRegion: "<<m_ImageRegion<<std::endl;
+  os<<indent<<"Block size: "<<m_BlockSize<<std::endl;
+  os<<indent<<"Requested number of splits: "<<m_RequestedNumberOfSplits<<std::endl;
+  os<<indent<<"Actual number of splits: "<<m_StreamVector.size()<<std::endl;
+}
+
+} // end namespace otb
+
+#endif
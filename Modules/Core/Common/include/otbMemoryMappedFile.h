@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMemoryMappedFile_h
+#define otbMemoryMappedFile_h
+
+#include <cstddef>
+#include <string>
+
+#include "itkMacro.h"
+
+#include "OTBCommonExport.h"
+
+namespace otb
+{
+
+/** \class MemoryMappedFile
+ * \brief Read-only memory mapping of a whole file.
+ *
+ * This class is used by the ImageIOs of raw formats (BSQ, LUM, RAD,
+ * ONERA) to copy image regions directly from the mapping, instead of
+ * issuing one seek and one read per line and per band.
+ *
+ * ReadRegion() copies a set of evenly spaced lines, optionally
+ * scattering the components in a band interleaved buffer, and asks the
+ * system to start reading the lines that follow the region, which are
+ * usually the next ones requested by the streaming.
+ *
+ * Mapping may fail (32 bits address space, unsupported file system,
+ * OTB_USE_MMAP set to OFF), in which case Open() returns false and the
+ * caller is expected to fall back on regular reads.
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT MemoryMappedFile
+{
+public:
+  MemoryMappedFile();
+  ~MemoryMappedFile();
+
+  /** Map the given file. Return true if it is mapped, false otherwise.
+   * Nothing is done if this file is already mapped. */
+  bool Open(const std::string& filename);
+
+  /** Unmap the file */
+  void Close();
+
+  /** Return true if a file is mapped */
+  bool IsOpen() const
+  {
+    return m_Data != ITK_NULLPTR;
+  }
+
+  /** Get the name of the mapped file */
+  const std::string& GetFileName() const
+  {
+    return m_FileName;
+  }
+
+  /** Get the size of the mapped file, in bytes */
+  size_t GetSize() const
+  {
+    return m_Size;
+  }
+
+  /** Get the mapped content of the file */
+  const char* GetData() const
+  {
+    return m_Data;
+  }
+
+  /** Hint the system that the given range of the file will be read
+   * soon. The range is clipped to the file. */
+  void WillNeed(size_t offset, size_t size) const;
+
+  /** Copy nbLines lines of lineSize bytes into buffer. The first line
+   * starts at offset in the file, the following ones every lineStride
+   * bytes. Each component of componentSize bytes is written every
+   * outputStep bytes in buffer (outputStep == componentSize gives a
+   * contiguous copy). Return false if the region is not in the file. */
+  bool ReadRegion(size_t offset, size_t lineStride, size_t nbLines, size_t lineSize,
+                  size_t componentSize, size_t outputStep, char* buffer) const;
+
+private:
+  MemoryMappedFile(const MemoryMappedFile&); //purposely not implemented
+  void operator =(const MemoryMappedFile&); //purposely not implemented
+
+  std::string m_FileName;
+  const char* m_Data;
+  size_t      m_Size;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  void*       m_FileHandle;
+  void*       m_MappingHandle;
+#endif
+};
+
+} // namespace otb
+
+#endif
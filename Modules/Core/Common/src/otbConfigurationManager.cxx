@@ -61,4 +61,67 @@ ConfigurationManager::RAMValueType ConfigurationManager::GetMaxRAMHint()
   return value;
 
 }
+
+bool ConfigurationManager::GetUseMemoryMappedReading()
+{
+  std::string svalue;
+
+  if(itksys::SystemTools::GetEnv("OTB_USE_MMAP",svalue))
+    {
+    svalue = itksys::SystemTools::UpperCase(svalue);
+    if(svalue == "OFF" || svalue == "FALSE" || svalue == "NO" || svalue == "0")
+      {
+      return false;
+      }
+    }
+
+  return true;
+}
+
+ConfigurationManager::RAMValueType ConfigurationManager::GetBlockCacheSize()
+{
+  std::string svalue;
+
+  RAMValueType value = 0;
+
+  if(itksys::SystemTools::GetEnv("OTB_BLOCK_CACHE_SIZE",svalue))
+    {
+    value = static_cast<RAMValueType>(strtoul(svalue.c_str(),ITK_NULLPTR,10));
+    }
+
+  return value;
+}
+
+bool ConfigurationManager::GetUseMemoryCalibration()
+{
+  std::string svalue;
+
+  if(itksys::SystemTools::GetEnv("OTB_MEMORY_CALIBRATION",svalue))
+    {
+    svalue = itksys::SystemTools::UpperCase(svalue);
+    if(svalue == "ON" || svalue == "TRUE" || svalue == "YES" || svalue == "1")
+      {
+      return true;
+      }
+    }
+
+  return false;
+}
+
+bool ConfigurationManager::GetUseImageBufferPool()
+{
+  std::string svalue;
+
+  if(itksys::SystemTools::GetEnv("OTB_USE_BUFFER_POOL",svalue))
+    {
+    svalue = itksys::SystemTools::UpperCase(svalue);
+    if(svalue == "ON" || svalue == "TRUE" || svalue == "YES" || svalue == "1")
+      {
+      return true;
+      }
+    }
+
+  return false;
+}
+
 }
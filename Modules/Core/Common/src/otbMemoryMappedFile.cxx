@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMemoryMappedFile.h"
+#include "otbConfigurationManager.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace otb
+{
+
+MemoryMappedFile::MemoryMappedFile()
+  : m_FileName(),
+    m_Data(ITK_NULLPTR),
+    m_Size(0)
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  , m_FileHandle(ITK_NULLPTR),
+    m_MappingHandle(ITK_NULLPTR)
+#endif
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+  this->Close();
+}
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+
+/*=====================================================================
+                   WIN32 / MSVC++ implementation
+ *====================================================================*/
+
+bool MemoryMappedFile::Open(const std::string& filename)
+{
+  if (this->IsOpen() && filename == m_FileName)
+    {
+    return true;
+    }
+  this->Close();
+
+  if (!ConfigurationManager::GetUseMemoryMappedReading())
+    {
+    return false;
+    }
+
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    {
+    return false;
+    }
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0
+      || static_cast<unsigned long long>(fileSize.QuadPart) > static_cast<size_t>(-1))
+    {
+    CloseHandle(file);
+    return false;
+    }
+
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL)
+    {
+    CloseHandle(file);
+    return false;
+    }
+
+  const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == NULL)
+    {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+    }
+
+  m_FileHandle = file;
+  m_MappingHandle = mapping;
+  m_Data = static_cast<const char*>(data);
+  m_Size = static_cast<size_t>(fileSize.QuadPart);
+  m_FileName = filename;
+  return true;
+}
+
+void MemoryMappedFile::Close()
+{
+  if (m_Data != ITK_NULLPTR)
+    {
+    UnmapViewOfFile(m_Data);
+    CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+    CloseHandle(static_cast<HANDLE>(m_FileHandle));
+    }
+  m_Data = ITK_NULLPTR;
+  m_Size = 0;
+  m_FileHandle = ITK_NULLPTR;
+  m_MappingHandle = ITK_NULLPTR;
+  m_FileName.clear();
+}
+
+void MemoryMappedFile::WillNeed(size_t, size_t) const
+{
+  // Read-ahead is left to the system
+}
+
+#else
+
+/*=====================================================================
+                   POSIX implementation
+ *====================================================================*/
+
+bool MemoryMappedFile::Open(const std::string& filename)
+{
+  if (this->IsOpen() && filename == m_FileName)
+    {
+    return true;
+    }
+  this->Close();
+
+  if (!ConfigurationManager::GetUseMemoryMappedReading())
+    {
+    return false;
+    }
+
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    {
+    return false;
+    }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0
+      || static_cast<unsigned long long>(fileStat.st_size) > static_cast<size_t>(-1))
+    {
+    close(fd);
+    return false;
+    }
+
+  const size_t size = static_cast<size_t>(fileStat.st_size);
+  void* data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping stays valid once the descriptor is closed
+  close(fd);
+  if (data == MAP_FAILED)
+    {
+    return false;
+    }
+
+  m_Data = static_cast<const char*>(data);
+  m_Size = size;
+  m_FileName = filename;
+  return true;
+}
+
+void MemoryMappedFile::Close()
+{
+  if (m_Data != ITK_NULLPTR)
+    {
+    munmap(const_cast<char*>(m_Data), m_Size);
+    }
+  m_Data = ITK_NULLPTR;
+  m_Size = 0;
+  m_FileName.clear();
+}
+
+void MemoryMappedFile::WillNeed(size_t offset, size_t size) const
+{
+  if (m_Data == ITK_NULLPTR || offset >= m_Size)
+    {
+    return;
+    }
+  size = std::min(size, m_Size - offset);
+
+  // madvise requires an address aligned on a page
+  static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t alignedOffset = offset - offset % pageSize;
+  madvise(const_cast<char*>(m_Data) + alignedOffset, size + (offset - alignedOffset), MADV_WILLNEED);
+}
+
+#endif
+
+bool MemoryMappedFile::ReadRegion(size_t offset, size_t lineStride, size_t nbLines, size_t lineSize,
+                                  size_t componentSize, size_t outputStep, char* buffer) const
+{
+  if (m_Data == ITK_NULLPTR || nbLines == 0 || componentSize == 0)
+    {
+    return m_Data != ITK_NULLPTR;
+    }
+
+  const size_t regionEnd = offset + (nbLines - 1) * lineStride + lineSize;
+  if (regionEnd > m_Size)
+    {
+    return false;
+    }
+
+  // Start reading the whole region at once
+  this->WillNeed(offset, regionEnd - offset);
+
+  const char* line = m_Data + offset;
+  if (outputStep == componentSize)
+    {
+    for (size_t l = 0; l < nbLines; ++l, line += lineStride)
+      {
+      std::memcpy(buffer, line, lineSize);
+      buffer += lineSize;
+      }
+    }
+  else
+    {
+    for (size_t l = 0; l < nbLines; ++l, line += lineStride)
+      {
+      for (size_t i = 0; i < lineSize; i += componentSize)
+        {
+        std::memcpy(buffer, line + i, componentSize);
+        buffer += outputStep;
+        }
+      }
+    }
+
+  // Streaming divisions usually follow each other line-wise: prefetch
+  // the same amount of lines after the region
+  this->WillNeed(offset + nbLines * lineStride, nbLines * lineStride);
+  return true;
+}
+
+} // namespace otb
@@ -26,6 +26,7 @@ void RegisterTests()
   REGISTER_TEST(otbImageRegionTileMapSplitter);
   REGISTER_TEST(otbImageRegionAdaptativeSplitterNew);
   REGISTER_TEST(otbImageRegionAdaptativeSplitter);
+  REGISTER_TEST(otbImageRegionBlockAlignedSplitter);
   REGISTER_TEST(otbRGBAPixelConverterNew);
   REGISTER_TEST(otbRGBAPixelConverter);
   REGISTER_TEST(otbRectangle);
@@ -42,4 +43,5 @@ void RegisterTests()
   REGISTER_TEST(otbStandardFilterWatcherNew);
   REGISTER_TEST(otbStandardOneLineFilterWatcherTest);
   REGISTER_TEST(otbStandardWriterWatcher);
+  REGISTER_TEST(otbMemoryMappedFileTest);
 }
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageRegionBlockAlignedSplitter.h"
+#include <algorithm>
+#include <fstream>
+
+const int Dimension = 2;
+typedef otb::ImageRegionBlockAlignedSplitter<Dimension> SplitterType;
+typedef SplitterType::RegionType                       RegionType;
+typedef RegionType::SizeType                           SizeType;
+typedef RegionType::IndexType                          IndexType;
+
+int otbImageRegionBlockAlignedSplitter(int itkNotUsed(argc), char * argv[])
+{
+  SizeType regionSize, blockSize;
+  IndexType regionIndex;
+  RegionType region;
+  unsigned int requestedNbSplits;
+
+  regionIndex[0] = atoi(argv[1]);
+  regionIndex[1] = atoi(argv[2]);
+  regionSize[0]  = atoi(argv[3]);
+  regionSize[1]  = atoi(argv[4]);
+  blockSize[0]   = atoi(argv[5]);
+  blockSize[1]   = atoi(argv[6]);
+  requestedNbSplits = atoi(argv[7]);
+  std::string outfname = argv[8];
+
+  std::ofstream outfile(outfname.c_str());
+
+  region.SetSize(regionSize);
+  region.SetIndex(regionIndex);
+
+  SplitterType::Pointer splitter = SplitterType::New();
+  splitter->SetBlockSize(blockSize);
+
+  unsigned int nbSplits = splitter->GetNumberOfSplits(region, requestedNbSplits);
+  std::vector<RegionType> splits;
+
+  outfile<<splitter<<std::endl;
+  outfile<<"Split map: "<<std::endl;
+
+  for(unsigned int i = 0; i < nbSplits; ++i)
+    {
+    RegionType tmpRegion = splitter->GetSplit(i, requestedNbSplits, region);
+    splits.push_back(tmpRegion);
+    outfile<<"Split "<<i<<": "<<tmpRegion;
+    }
+
+  outfile.close();
+
+  const unsigned long maxPixelsPerSplit =
+    std::max<unsigned long>(1, region.GetNumberOfPixels() / std::max(requestedNbSplits, 1U));
+
+  unsigned long pixelInSplit = 0;
+  for (unsigned int k=0 ; k<nbSplits ; ++k )
+    {
+    const RegionType& split = splits[k];
+    pixelInSplit += split.GetNumberOfPixels();
+
+    if (requestedNbSplits > 1 && split.GetNumberOfPixels() > maxPixelsPerSplit)
+      {
+      std::cout << "Split "<<k<<" has "<<split.GetNumberOfPixels()<<" pixels, more than "<<maxPixelsPerSplit << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    // A split either holds whole blocks, or is inside a single block
+    for (unsigned int dim = 0; dim < 2; ++dim)
+      {
+      const long start = split.GetIndex()[dim];
+      const long end   = start + static_cast<long>(split.GetSize()[dim]);
+      const long block = static_cast<long>(blockSize[dim]);
+      const bool startAligned = start % block == 0 || start == regionIndex[dim];
+      const bool endAligned   = end % block == 0 || end == regionIndex[dim] + static_cast<long>(regionSize[dim]);
+      const bool insideBlock  = start / block == (end - 1) / block;
+      if (!(startAligned && endAligned) && !insideBlock)
+        {
+        std::cout << "Split "<<k<<" "<<split.GetIndex()<<" "<<split.GetSize()<<" is not aligned on the blocks" << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  if (pixelInSplit != region.GetNumberOfPixels())
+    {
+    std::cout << "Wrong number of pixels in split : got "<<pixelInSplit << " , expected "<< region.GetNumberOfPixels() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Check that splits do not overlap (together with the number of
+  // pixels, this ensures that the region is covered)
+  for (unsigned int k=0 ; k<nbSplits ; ++k )
+    {
+    for (unsigned int l=k+1 ; l<nbSplits ; ++l )
+      {
+      RegionType intersection = splits[k];
+      if (intersection.Crop(splits[l]))
+        {
+        std::cout << "Splits "<<k<<" and "<<l<<" overlap" << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
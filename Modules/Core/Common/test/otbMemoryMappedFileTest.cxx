@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "itkMacro.h"
+#include "otbMemoryMappedFile.h"
+
+int otbMemoryMappedFileTest(int itkNotUsed(argc), char * argv[])
+{
+  const char * fileName = argv[1];
+
+  // 100 lines of 100 shorts holding their own index
+  const unsigned int width = 100;
+  const unsigned int height = 100;
+  {
+  std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  for (unsigned int i = 0; i < width * height; ++i)
+    {
+    const short value = static_cast<short>(i);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(short));
+    }
+  }
+
+  otb::MemoryMappedFile mapping;
+  if (!mapping.Open(fileName))
+    {
+    // Mapping is optional, readers fall back on regular reads
+    std::cout << "File could not be mapped, skipping the test" << std::endl;
+    return EXIT_SUCCESS;
+    }
+
+  if (mapping.GetSize() != width * height * sizeof(short))
+    {
+    std::cerr << "Wrong size: " << mapping.GetSize() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Region of 10x5 pixels starting at (20, 10), copied as the second
+  // band of a 2 bands interleaved buffer
+  const unsigned int x0 = 20, y0 = 10, sizeX = 10, sizeY = 5;
+  std::vector<short> buffer(2 * sizeX * sizeY, -1);
+  if (!mapping.ReadRegion((y0 * width + x0) * sizeof(short), width * sizeof(short), sizeY,
+                          sizeX * sizeof(short), sizeof(short), 2 * sizeof(short),
+                          reinterpret_cast<char*>(&buffer[0]) + sizeof(short)))
+    {
+    std::cerr << "ReadRegion failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  for (unsigned int y = 0; y < sizeY; ++y)
+    {
+    for (unsigned int x = 0; x < sizeX; ++x)
+      {
+      const unsigned int i = 2 * (y * sizeX + x);
+      if (buffer[i] != -1 || buffer[i + 1] != static_cast<short>((y0 + y) * width + x0 + x))
+        {
+        std::cerr << "Wrong value at (" << x << ", " << y << "): " << buffer[i + 1] << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // A region going past the end of the file must be rejected
+  if (mapping.ReadRegion((98 * width) * sizeof(short), width * sizeof(short), 3,
+                         width * sizeof(short), sizeof(short), sizeof(short),
+                         reinterpret_cast<char*>(&buffer[0])))
+    {
+    std::cerr << "ReadRegion did not detect the end of the file" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  mapping.Close();
+  if (mapping.IsOpen())
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -24,9 +24,54 @@
 #include "otbConvertPixelBuffer.h"
 
 #include "itkConvertPixelBuffer.h"
+#include "otbConvertPixelBufferKernels.h"
+
+#include <type_traits>
 
 namespace otb
 {
+
+namespace internal
+{
+/** Call the vectorized kernel converting TInput components to TOutput
+ * components if there is one, return false otherwise */
+template <class TInput, class TOutput,
+          bool IsSupported = ConvertPixelBufferKernelTraits<TInput, TOutput>::IsSupported>
+struct ConvertComponentsWithKernel
+{
+  static bool Convert(const TInput*, TOutput*, size_t)
+  {
+    return false;
+  }
+};
+
+template <class TInput, class TOutput>
+struct ConvertComponentsWithKernel<TInput, TOutput, true>
+{
+  static bool Convert(const TInput* inputData, TOutput* outputData, size_t size)
+  {
+    ConvertPixelBufferKernels::Convert(inputData, outputData, size);
+    return true;
+  }
+};
+
+/** Type of the real and imaginary parts of a complex pixel, void for
+ * other pixels */
+template <class TPixel>
+struct ComplexPartType
+{
+  typedef void Type;
+  static const bool IsComplex = false;
+};
+
+template <class T>
+struct ComplexPartType<std::complex<T> >
+{
+  typedef T Type;
+  static const bool IsComplex = true;
+};
+} // end namespace internal
+
 template < typename InputPixelType,
            typename OutputPixelType,
            class OutputConvertTraits
@@ -37,6 +82,15 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>
           int inputNumberOfComponents,
           OutputPixelType* outputData , size_t size)
 {
+  // scalar to scalar, done by a vectorized kernel when there is one
+  if (std::is_same<OutputPixelType, OutputComponentType>::value
+      && inputNumberOfComponents == 1
+      && internal::ConvertComponentsWithKernel<InputPixelType, OutputPixelType>
+         ::Convert(inputData, outputData, size))
+    {
+    return;
+    }
+
   if ((OutputConvertTraits::GetNumberOfComponents() == 2) &&
       inputNumberOfComponents == 1)
     {
@@ -134,6 +188,14 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>
                      int inputNumberOfComponents,
                      OutputPixelType* outputData , size_t size)
 {
+  // Components are converted one by one, whatever the pixel layout
+  if (std::is_same<OutputPixelType, OutputComponentType>::value
+      && internal::ConvertComponentsWithKernel<InputPixelType, OutputPixelType>
+         ::Convert(inputData, outputData, size * static_cast<size_t>(inputNumberOfComponents)))
+    {
+    return;
+    }
+
   itk::ConvertPixelBuffer<
     InputPixelType,
     OutputPixelType,
@@ -173,6 +235,18 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>
                      OutputPixelType* outputData , size_t size)
 {
   size_t length = size* (size_t)inputNumberOfComponents;
+
+  // Real and imaginary parts are stored as two interleaved components
+  typedef typename internal::ComplexPartType<OutputPixelType>::Type OutputPartType;
+  if (internal::ComplexPartType<OutputPixelType>::IsComplex
+      && internal::ConvertComponentsWithKernel<InputPixelType, OutputPartType>
+         ::Convert(static_cast<const InputPixelType*>(static_cast<const void*>(inputData)),
+                   static_cast<OutputPartType*>(static_cast<void*>(outputData)),
+                   2 * length))
+    {
+    return;
+    }
+
   OutputPixelType dummy;
   for( size_t i=0; i< length; i++ )
     {
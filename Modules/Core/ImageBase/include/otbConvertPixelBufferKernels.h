@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbConvertPixelBufferKernels_h
+#define otbConvertPixelBufferKernels_h
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#include "OTBImageBaseExport.h"
+
+namespace otb
+{
+/**
+ * \class ConvertPixelBufferKernels
+ *  \brief Vectorized conversion of contiguous buffers of components.
+ *
+ * This class converts n components from one scalar type to another,
+ * with the same result as a static_cast of each component for values
+ * in the range of the output type. It is used by ConvertPixelBuffer for
+ * the common cases where the conversion does not depend on the pixel
+ * layout: scalar to scalar, band interleaved vector image to vector
+ * image, and complex to complex (the real and imaginary parts are
+ * converted as two interleaved components).
+ *
+ * The instruction set (AVX2, SSE2 or plain C++) is selected at runtime
+ * from the capabilities of the CPU, when OTB is built with
+ * OTB_USE_SSE_FLAGS. ConvertPixelBufferKernelTraits tells which pairs
+ * of types have a kernel.
+ *
+ * \sa ConvertPixelBuffer
+ *
+ * \ingroup OTBImageBase
+ */
+class OTBImageBase_EXPORT ConvertPixelBufferKernels
+{
+public:
+  typedef enum {SCALAR, SSE2, AVX2} InstructionSetType;
+
+  /** Get the instruction set used by the kernels. The best one
+   * supported by the CPU is selected at first use. */
+  static InstructionSetType GetInstructionSet();
+
+  /** Force the instruction set used by the kernels (for instance to
+   * compare them). The request is ignored if the CPU or the build do
+   * not support it. Return the instruction set actually used. */
+  static InstructionSetType SetInstructionSet(InstructionSetType instructionSet);
+
+  /** Return true if the instruction set can be used on this CPU */
+  static bool IsInstructionSetSupported(InstructionSetType instructionSet);
+
+  /** Convenience method returning the name of the instruction set */
+  static std::string GetInstructionSetAsString(InstructionSetType instructionSet);
+
+  /** Widening conversions to float */
+  static void Convert(const unsigned char* in, float* out, size_t n);
+  static void Convert(const short* in, float* out, size_t n);
+  static void Convert(const unsigned short* in, float* out, size_t n);
+  static void Convert(const int* in, float* out, size_t n);
+  static void Convert(const double* in, float* out, size_t n);
+
+  /** Widening conversions to double */
+  static void Convert(const unsigned char* in, double* out, size_t n);
+  static void Convert(const short* in, double* out, size_t n);
+  static void Convert(const unsigned short* in, double* out, size_t n);
+  static void Convert(const int* in, double* out, size_t n);
+  static void Convert(const float* in, double* out, size_t n);
+
+  /** Narrowing conversions from float (truncation toward zero) */
+  static void Convert(const float* in, unsigned char* out, size_t n);
+  static void Convert(const float* in, short* out, size_t n);
+  static void Convert(const float* in, unsigned short* out, size_t n);
+
+  /** Identity */
+  template <class T>
+  static void Convert(const T* in, T* out, size_t n)
+  {
+    std::copy(in, in + n, out);
+  }
+
+private:
+  ConvertPixelBufferKernels();
+  ~ConvertPixelBufferKernels();
+};
+
+/**
+ * \class ConvertPixelBufferKernelTraits
+ *  \brief Tell if ConvertPixelBufferKernels has a kernel converting
+ *  TInput components to TOutput components.
+ *
+ * \ingroup OTBImageBase
+ */
+template <class TInput, class TOutput>
+struct ConvertPixelBufferKernelTraits
+{
+  static const bool IsSupported = false;
+};
+
+template <class T>
+struct ConvertPixelBufferKernelTraits<T, T>
+{
+  static const bool IsSupported = true;
+};
+
+#define otbConvertPixelBufferKernelMacro(TIn, TOut)     \
+  template <>                                           \
+  struct ConvertPixelBufferKernelTraits<TIn, TOut>      \
+  {                                                     \
+    static const bool IsSupported = true;               \
+  };
+
+otbConvertPixelBufferKernelMacro(unsigned char, float)
+otbConvertPixelBufferKernelMacro(short, float)
+otbConvertPixelBufferKernelMacro(unsigned short, float)
+otbConvertPixelBufferKernelMacro(int, float)
+otbConvertPixelBufferKernelMacro(double, float)
+otbConvertPixelBufferKernelMacro(unsigned char, double)
+otbConvertPixelBufferKernelMacro(short, double)
+otbConvertPixelBufferKernelMacro(unsigned short, double)
+otbConvertPixelBufferKernelMacro(int, double)
+otbConvertPixelBufferKernelMacro(float, double)
+otbConvertPixelBufferKernelMacro(float, unsigned char)
+otbConvertPixelBufferKernelMacro(float, short)
+otbConvertPixelBufferKernelMacro(float, unsigned short)
+
+#undef otbConvertPixelBufferKernelMacro
+
+} // end namespace otb
+
+#endif // otbConvertPixelBufferKernels_h
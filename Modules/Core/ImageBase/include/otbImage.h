@@ -192,6 +192,9 @@ public:
 /// Copy metadata from a DataObject
   void CopyInformation(const itk::DataObject *) ITK_OVERRIDE;
 
+  /** Allocate the buffer, from the ImageBufferPool when it is enabled */
+  void Allocate(bool initialize = false) ITK_OVERRIDE;
+
 protected:
   Image();
   ~Image() ITK_OVERRIDE {}
@@ -25,6 +25,7 @@
 #include "otbImage.h"
 #include "otbImageMetadataInterfaceFactory.h"
 #include "itkMetaDataObject.h"
+#include "otbPooledImageContainer.h"
 
 namespace otb
 {
@@ -180,6 +181,25 @@ Image<TPixel, VImageDimension>::GetImageKeywordlist(void) const
   return  kwl;
 }
 
+template <class TPixel, unsigned int VImageDimension>
+void
+Image<TPixel, VImageDimension>
+::Allocate(bool initialize)
+{
+  // A new image, or one whose buffer has been released at the previous
+  // streaming division, takes its buffer from the pool
+  if (this->GetPixelContainer()->GetImportPointer() == ITK_NULLPTR)
+    {
+    typename PixelContainer::Pointer container = PooledImageContainerFactory<PixelContainer>::Create();
+    if (container.IsNotNull())
+      {
+      this->SetPixelContainer(container);
+      }
+    }
+
+  Superclass::Allocate(initialize);
+}
+
 template <class TPixel, unsigned int VImageDimension>
 void
 Image<TPixel, VImageDimension>
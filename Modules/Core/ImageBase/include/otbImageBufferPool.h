@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageBufferPool_h
+#define otbImageBufferPool_h
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+#include "OTBImageBaseExport.h"
+
+namespace otb
+{
+
+/** \class ImageBufferPool
+ *
+ * \brief Process-wide pool recycling the pixel buffers of the images
+ *
+ * Each streaming division makes every filter of the pipeline release
+ * the buffer of its output and allocate a new one for the next region.
+ * When the pool is enabled, the buffers of otb::Image and
+ * otb::VectorImage (with scalar or complex pixels) come from this pool
+ * (see PooledImageContainer), and go back into it when they are
+ * released. A buffer is reused for a later request of the same size in
+ * bytes, which is the common case since most divisions have the same
+ * size. This saves the allocation, the page faults and the zeroing of
+ * the memory by the system.
+ *
+ * The free buffers kept by the pool never exceed its maximum size: the
+ * least recently released ones are freed first. The maximum size is
+ * OTB_MAX_RAM_HINT by default. The pool is disabled unless the
+ * environment variable OTB_USE_BUFFER_POOL is set to ON, or
+ * SetEnabled(true) is called.
+ *
+ * The numbers of allocations and reuses tell how effective the pool is
+ * for a given pipeline.
+ *
+ * \sa PooledImageContainer
+ *
+ * \ingroup OTBImageBase
+ */
+class OTBImageBase_EXPORT ImageBufferPool
+{
+public:
+  // GetInstance returns a reference to the pool shared by the whole
+  // process
+  static ImageBufferPool& GetInstance()
+  {
+    static ImageBufferPool theUniqueInstance;
+    return theUniqueInstance;
+  }
+
+  /** Get a buffer of size bytes, reusing a free buffer of the same size
+   * if any. Return a null pointer if the memory can not be allocated.
+   * Thread safe. */
+  void * Acquire(size_t size);
+
+  /** Give back a buffer obtained from Acquire(). It is kept for reuse
+   * if the pool is enabled and its maximum size allows it, and freed
+   * otherwise. Thread safe. */
+  void Release(void * buffer, size_t size);
+
+  /** Free all the free buffers. Thread safe. */
+  void Clear();
+
+  /** Enable or disable the pool. Disabling it frees the free buffers;
+   * the buffers in use are still given back to the pool. */
+  void SetEnabled(bool enabled);
+
+  bool IsEnabled() const;
+
+  /** Set the maximum size of the free buffers, in bytes. Thread safe. */
+  void SetMaximumSize(size_t size);
+
+  /** Get the maximum size of the free buffers, in bytes */
+  size_t GetMaximumSize() const;
+
+  /** Get the size of the free buffers, in bytes */
+  size_t GetSize() const;
+
+  /** Get the number of free buffers */
+  size_t GetNumberOfBuffers() const;
+
+  /** Get the number of buffers acquired */
+  unsigned long long GetNumberOfAcquisitions() const;
+
+  /** Get the number of buffers acquired by reusing a free buffer */
+  unsigned long long GetNumberOfReuses() const;
+
+  /** Get the ratio of acquisitions which reused a free buffer */
+  double GetReuseRate() const;
+
+  /** Get the number of free buffers freed because the pool was full */
+  unsigned long long GetNumberOfEvictions() const;
+
+  /** Reset the numbers of acquisitions, reuses and evictions */
+  void ResetStatistics();
+
+  /** Write the counters of the pool */
+  void PrintStatistics(std::ostream& os) const;
+
+private:
+  // private constructor so that this class is allocated only inside GetInstance
+  ImageBufferPool();
+
+  ~ImageBufferPool();
+
+  ImageBufferPool(const ImageBufferPool&); //purposely not implemented
+  void operator =(const ImageBufferPool&); //purposely not implemented
+
+  /** Free the least recently released buffers until the pool fits in
+   * size (the mutex must be locked) */
+  void Shrink(size_t size);
+
+  struct BufferType
+  {
+    void * data;
+    size_t size;
+  };
+
+  typedef std::list<BufferType>                           BufferListType;
+  typedef std::multimap<size_t, BufferListType::iterator> BufferMapType;
+
+  // Most recently released buffers first
+  BufferListType m_Buffers;
+  // Free buffers by size
+  BufferMapType  m_BuffersBySize;
+
+  bool               m_Enabled;
+  size_t             m_Size;
+  size_t             m_MaximumSize;
+  unsigned long long m_NumberOfAcquisitions;
+  unsigned long long m_NumberOfReuses;
+  unsigned long long m_NumberOfEvictions;
+
+  mutable std::mutex m_Mutex;
+}; // end of ImageBufferPool
+
+} // end namespace otb
+
+#endif // otbImageBufferPool_h
@@ -199,11 +199,22 @@ public:
   itkGetConstMacro(UseStreamedWriting,bool);
   itkBooleanMacro(UseStreamedWriting);
 
+  /** Set/Get a boolean to write into the existing file, keeping the
+   * regions already written, instead of creating a new one. Only taken
+   * into account if CanResumeWrite() returns true. */
+  itkSetMacro(ResumeWriting,bool);
+  itkGetConstMacro(ResumeWriting,bool);
+  itkBooleanMacro(ResumeWriting);
+
 
   /** Convenience method returns the IOComponentType as a string. This can be
    * used for writing output files. */
   std::string GetComponentTypeAsString(IOComponentType) const;
 
+  /** Return the component type matching a C++ type_info, or
+   * UNKNOWNCOMPONENTTYPE if there is none. */
+  static IOComponentType MapComponentType(const std::type_info& ctype);
+
   /** Convenience method returns the IOPixelType as a string. This can be
    * used for writing output files. */
   std::string GetPixelTypeAsString(IOPixelType) const;
@@ -323,6 +334,51 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   virtual void Read(void* buffer) = 0;
 
+  /** Set/Get the list of bands (0-based components of the file) to
+   * read. When the list is not empty and CanReadBandSubset() returns
+   * true, Read() only decodes the selected bands and fills the buffer
+   * with GetBandList().size() components per pixel, in the order of
+   * the list. An empty list (the default) means every band is read. */
+  void SetBandList(const std::vector<unsigned int>& bandList)
+    {
+    m_BandList = bandList;
+    }
+  const std::vector<unsigned int>& GetBandList() const
+    {
+    return m_BandList;
+    }
+
+  /** Determine if Read() honours the band list for the file. This
+   * method should be invoked after ReadImageInformation(). Default is
+   * false. */
+  virtual bool CanReadBandSubset()
+    {
+    return false;
+    }
+
+  /** Set/Get the component type of the buffer filled by Read(). When
+   * set to a type different from the file component type and
+   * CanReadAsComponentType() returns true for it, Read() converts the
+   * components on the fly. UNKNOWNCOMPONENTTYPE (the default) means
+   * the buffer uses the file component type. */
+  itkSetEnumMacro(ReadComponentType, IOComponentType);
+  itkGetEnumMacro(ReadComponentType, IOComponentType);
+
+  /** Determine if Read() can convert the components to the given type
+   * without loss, so that the conversion done by the reader can be
+   * skipped. This method should be invoked after
+   * ReadImageInformation(). Default is false. */
+  virtual bool CanReadAsComponentType(IOComponentType itkNotUsed(type))
+    {
+    return false;
+    }
+
+  /** Set/Get the number of threads Read() may use to decode the
+   * requested region, for the ImageIOs able to decode several blocks of
+   * the file concurrently. Default is 1 (sequential read). */
+  itkSetMacro(NumberOfReadThreads, unsigned int);
+  itkGetConstMacro(NumberOfReadThreads, unsigned int);
+
 
   /*-------- This part of the interfaces deals with writing data ----- */
 
@@ -340,6 +396,22 @@ public:
     return false;
     }
 
+  /** Determine whether the regions left unwritten read back as no-data,
+   * so that the writer may skip the regions holding no data. Default
+   * is false. */
+  virtual bool CanSkipEmptyRegions()
+    {
+    return false;
+    }
+
+  /** Determine whether the ImageIO can reopen the existing file to
+   * complete an interrupted write (see SetResumeWriting()). Default is
+   * false. */
+  virtual bool CanResumeWrite()
+    {
+    return false;
+    }
+
   /** Writes the spacing and dimensions of the image.
    * Assumes SetFileName has been called with a valid file name. */
   virtual void WriteImageInformation() = 0;
@@ -349,6 +421,13 @@ public:
    * pointer to the beginning of the image data. */
   virtual void Write( const void* buffer) = 0;
 
+  /** Store in the file the regions written so far, which may be held
+   * in caches until the file is closed, so that they survive an
+   * interruption of the process. Default does nothing. */
+  virtual void Flush()
+    {
+    }
+
   /* --- Support reading and writing data as a series of files. --- */
 
   /** The different types of ImageIO's can support data of varying
@@ -465,10 +544,22 @@ protected:
   /** Should we use streaming for writing */
   bool m_UseStreamedWriting;
 
+  /** Should we complete the existing file */
+  bool m_ResumeWriting;
+
   /** The region to read or write. The region contains information about the
    * data within the region to read or write. */
   itk::ImageIORegion m_IORegion;
 
+  /** The list of bands to read, empty to read every band */
+  std::vector<unsigned int> m_BandList;
+
+  /** Component type of the buffer filled by Read() */
+  IOComponentType m_ReadComponentType;
+
+  /** Number of threads used by Read() */
+  unsigned int m_NumberOfReadThreads;
+
   /** The array which stores the number of pixels in the x, y, z directions. */
   std::vector< SizeValueType > m_Dimensions;
 
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPooledImageContainer_h
+#define otbPooledImageContainer_h
+
+#include <algorithm>
+#include <complex>
+#include <type_traits>
+
+#include "itkImportImageContainer.h"
+#include "otbImageBufferPool.h"
+
+namespace otb
+{
+
+/** \class PooledImageContainer
+ *  \brief Pixel container whose buffer comes from the ImageBufferPool.
+ *
+ *  The buffer is acquired from the pool instead of being allocated with
+ *  new[], and given back to the pool instead of being deleted. Reused
+ *  buffers hold the pixels of their previous image unless the default
+ *  constructor of the elements is requested.
+ *
+ *  Only elements without constructor nor destructor (scalars and
+ *  complex numbers) can be pooled: see IsPoolableImageElement.
+ *
+ * \sa ImageBufferPool
+ *
+ * \ingroup OTBImageBase
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_EXPORT PooledImageContainer
+  : public itk::ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  /** Standard class typedefs. */
+  typedef PooledImageContainer                                    Self;
+  typedef itk::ImportImageContainer<TElementIdentifier, TElement> Superclass;
+  typedef itk::SmartPointer<Self>                                 Pointer;
+  typedef itk::SmartPointer<const Self>                           ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PooledImageContainer, ImportImageContainer);
+
+  typedef typename Superclass::ElementIdentifier ElementIdentifier;
+  typedef typename Superclass::Element           Element;
+
+protected:
+  PooledImageContainer() {}
+
+  ~PooledImageContainer() ITK_OVERRIDE
+  {
+    // The superclass destructor would delete the buffer
+    this->DeallocateManagedMemory();
+  }
+
+  TElement * AllocateElements(ElementIdentifier size, bool UseDefaultConstructor = false) const ITK_OVERRIDE
+  {
+    TElement * data = static_cast<TElement *>(ImageBufferPool::GetInstance().Acquire(size * sizeof(TElement)));
+    if (data == ITK_NULLPTR)
+      {
+      throw itk::MemoryAllocationError(__FILE__, __LINE__,
+                                       "Failed to allocate memory for image.",
+                                       ITK_LOCATION);
+      }
+    if (UseDefaultConstructor)
+      {
+      std::fill(data, data + size, TElement());
+      }
+    return data;
+  }
+
+  void DeallocateManagedMemory() ITK_OVERRIDE
+  {
+    if (this->GetContainerManageMemory() && this->GetImportPointer() != ITK_NULLPTR)
+      {
+      ImageBufferPool::GetInstance().Release(this->GetImportPointer(), this->Capacity() * sizeof(TElement));
+      }
+    this->SetImportPointer(ITK_NULLPTR);
+    this->SetCapacity(0);
+    this->SetSize(0);
+  }
+
+private:
+  PooledImageContainer(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+};
+
+/** Tell if the buffers of an element type can be pooled */
+template <typename TElement>
+struct IsPoolableImageElement
+{
+  static const bool value = std::is_arithmetic<TElement>::value;
+};
+
+template <typename TElement>
+struct IsPoolableImageElement<std::complex<TElement> >
+{
+  static const bool value = std::is_arithmetic<TElement>::value;
+};
+
+/** Create a PooledImageContainer compatible with TContainer (an
+ * itk::ImportImageContainer) if its elements can be pooled and the
+ * pool is enabled. Return a null pointer otherwise. */
+template <typename TContainer,
+          bool VPoolable = IsPoolableImageElement<typename TContainer::Element>::value>
+struct PooledImageContainerFactory
+{
+  static typename TContainer::Pointer Create()
+  {
+    return ITK_NULLPTR;
+  }
+};
+
+template <typename TContainer>
+struct PooledImageContainerFactory<TContainer, true>
+{
+  static typename TContainer::Pointer Create()
+  {
+    if (!ImageBufferPool::GetInstance().IsEnabled())
+      {
+      return ITK_NULLPTR;
+      }
+    typedef PooledImageContainer<typename TContainer::ElementIdentifier,
+                                 typename TContainer::Element> PooledContainerType;
+    typename PooledContainerType::Pointer container = PooledContainerType::New();
+    return container.GetPointer();
+  }
+};
+
+} // end namespace otb
+
+#endif
@@ -159,6 +159,9 @@ public:
   /// Copy metadata from a DataObject
   void CopyInformation(const itk::DataObject *) ITK_OVERRIDE;
 
+  /** Allocate the buffer, from the ImageBufferPool when it is enabled */
+  void Allocate(bool initialize = false) ITK_OVERRIDE;
+
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
 
   /** Return the Pixel Accessor object */
@@ -26,6 +26,7 @@
 #include "otbImageMetadataInterfaceFactory.h"
 #include "otbImageKeywordlist.h"
 #include "itkMetaDataObject.h"
+#include "otbPooledImageContainer.h"
 
 namespace otb
 {
@@ -182,6 +183,25 @@ VectorImage<TPixel,VImageDimension>::SetImageKeywordList(const ImageKeywordlistT
 }
 
 
+template <class TPixel, unsigned int VImageDimension>
+void
+VectorImage<TPixel, VImageDimension>
+::Allocate(bool initialize)
+{
+  // A new image, or one whose buffer has been released at the previous
+  // streaming division, takes its buffer from the pool
+  if (this->GetPixelContainer()->GetImportPointer() == ITK_NULLPTR)
+    {
+    typename PixelContainer::Pointer container = PooledImageContainerFactory<PixelContainer>::Create();
+    if (container.IsNotNull())
+      {
+      this->SetPixelContainer(container);
+      }
+    }
+
+  Superclass::Allocate(initialize);
+}
+
 template <class TPixel, unsigned int VImageDimension>
 void
 VectorImage<TPixel, VImageDimension>
@@ -0,0 +1,451 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbConvertPixelBufferKernels.h"
+#include "otbConfigure.h"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(OTB_USE_SSE_FLAGS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define OTB_CONVERT_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+// AVX2 kernels are compiled with a target attribute and only called
+// when the CPU supports them, so that the rest of the library does not
+// require AVX2
+#if defined(OTB_CONVERT_KERNELS_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OTB_CONVERT_KERNELS_AVX2
+#include <immintrin.h>
+#define OTB_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace otb
+{
+
+namespace
+{
+
+/** Plain C++ conversion, used as fallback and for the remainder of
+ * the vectorized loops */
+template <class TIn, class TOut>
+inline void ScalarConvert(const TIn* in, TOut* out, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+    out[i] = static_cast<TOut>(in[i]);
+    }
+}
+
+#ifdef OTB_CONVERT_KERNELS_SSE2
+
+/** Load 4 integer components as 32 bits integers */
+inline __m128i LoadEpi32SSE2(const unsigned char* in)
+{
+  int packed;
+  std::memcpy(&packed, in, sizeof(int));
+  const __m128i zero = _mm_setzero_si128();
+  return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+}
+
+inline __m128i LoadEpi32SSE2(const short* in)
+{
+  const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in));
+  // Sign extension: put each value in the high half, then shift back
+  return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+inline __m128i LoadEpi32SSE2(const unsigned short* in)
+{
+  const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in));
+  return _mm_unpacklo_epi16(v, _mm_setzero_si128());
+}
+
+inline __m128i LoadEpi32SSE2(const int* in)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+}
+
+template <class TIn>
+void IntegerToFloatSSE2(const TIn* in, float* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+    _mm_storeu_ps(out + i, _mm_cvtepi32_ps(LoadEpi32SSE2(in + i)));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+template <class TIn>
+void IntegerToDoubleSSE2(const TIn* in, double* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+    const __m128i v = LoadEpi32SSE2(in + i);
+    _mm_storeu_pd(out + i, _mm_cvtepi32_pd(v));
+    _mm_storeu_pd(out + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+void FloatToDoubleSSE2(const float* in, double* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+    const __m128 v = _mm_loadu_ps(in + i);
+    _mm_storeu_pd(out + i, _mm_cvtps_pd(v));
+    _mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+void DoubleToFloatSSE2(const double* in, float* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+    const __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(in + i));
+    const __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(in + i + 2));
+    _mm_storeu_ps(out + i, _mm_movelh_ps(lo, hi));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+void FloatToUCharSSE2(const float* in, unsigned char* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+    const __m128i v = _mm_cvttps_epi32(_mm_loadu_ps(in + i));
+    const __m128i p16 = _mm_packs_epi32(v, v);
+    const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(p16, p16));
+    std::memcpy(out + i, &packed, sizeof(int));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+void FloatToShortSSE2(const float* in, short* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+    const __m128i v = _mm_cvttps_epi32(_mm_loadu_ps(in + i));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(v, v));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+void FloatToUShortSSE2(const float* in, unsigned short* out, size_t n)
+{
+  // SSE2 has no unsigned saturated pack from 32 bits: shift the values
+  // to the signed range, pack, and shift them back
+  const __m128i offset32 = _mm_set1_epi32(32768);
+  const __m128i offset16 = _mm_set1_epi16(static_cast<short>(0x8000));
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+    const __m128i v = _mm_sub_epi32(_mm_cvttps_epi32(_mm_loadu_ps(in + i)), offset32);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i),
+                     _mm_xor_si128(_mm_packs_epi32(v, v), offset16));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+#endif // OTB_CONVERT_KERNELS_SSE2
+
+#ifdef OTB_CONVERT_KERNELS_AVX2
+
+/** Load 8 integer components as 32 bits integers */
+OTB_TARGET_AVX2 inline __m256i LoadEpi32AVX2(const unsigned char* in)
+{
+  return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)));
+}
+
+OTB_TARGET_AVX2 inline __m256i LoadEpi32AVX2(const short* in)
+{
+  return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+}
+
+OTB_TARGET_AVX2 inline __m256i LoadEpi32AVX2(const unsigned short* in)
+{
+  return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+}
+
+OTB_TARGET_AVX2 inline __m256i LoadEpi32AVX2(const int* in)
+{
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+}
+
+template <class TIn>
+OTB_TARGET_AVX2 void IntegerToFloatAVX2(const TIn* in, float* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    {
+    _mm256_storeu_ps(out + i, _mm256_cvtepi32_ps(LoadEpi32AVX2(in + i)));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+template <class TIn>
+OTB_TARGET_AVX2 void IntegerToDoubleAVX2(const TIn* in, double* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    {
+    const __m256i v = LoadEpi32AVX2(in + i);
+    _mm256_storeu_pd(out + i, _mm256_cvtepi32_pd(_mm256_castsi256_si128(v)));
+    _mm256_storeu_pd(out + i + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+OTB_TARGET_AVX2 void FloatToDoubleAVX2(const float* in, double* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    {
+    _mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm_loadu_ps(in + i)));
+    _mm256_storeu_pd(out + i + 4, _mm256_cvtps_pd(_mm_loadu_ps(in + i + 4)));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+OTB_TARGET_AVX2 void DoubleToFloatAVX2(const double* in, float* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    {
+    _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_loadu_pd(in + i)));
+    _mm_storeu_ps(out + i + 4, _mm256_cvtpd_ps(_mm256_loadu_pd(in + i + 4)));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+OTB_TARGET_AVX2 void FloatToUCharAVX2(const float* in, unsigned char* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    {
+    const __m256i v = _mm256_cvttps_epi32(_mm256_loadu_ps(in + i));
+    const __m128i p16 = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(p16, p16));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+OTB_TARGET_AVX2 void FloatToShortAVX2(const float* in, short* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    {
+    const __m256i v = _mm256_cvttps_epi32(_mm256_loadu_ps(in + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+OTB_TARGET_AVX2 void FloatToUShortAVX2(const float* in, unsigned short* out, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    {
+    const __m256i v = _mm256_cvttps_epi32(_mm256_loadu_ps(in + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+    }
+  ScalarConvert(in + i, out + i, n - i);
+}
+
+#endif // OTB_CONVERT_KERNELS_AVX2
+
+ConvertPixelBufferKernels::InstructionSetType DetectInstructionSet()
+{
+#if defined(OTB_CONVERT_KERNELS_AVX2)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    {
+    return ConvertPixelBufferKernels::AVX2;
+    }
+#endif
+#if defined(OTB_CONVERT_KERNELS_SSE2)
+  return ConvertPixelBufferKernels::SSE2;
+#else
+  return ConvertPixelBufferKernels::SCALAR;
+#endif
+}
+
+/** Instruction set in use, initialized at first use */
+std::atomic<int>& CurrentInstructionSet()
+{
+  static std::atomic<int> instructionSet(static_cast<int>(DetectInstructionSet()));
+  return instructionSet;
+}
+
+} // end anonymous namespace
+
+// Dispatch a conversion to the kernel of the current instruction set
+#if defined(OTB_CONVERT_KERNELS_AVX2)
+#define otbConvertDispatchMacro(avx2Kernel, sse2Kernel)            \
+  switch (GetInstructionSet())                                    \
+    {                                                             \
+    case AVX2:                                                    \
+      avx2Kernel(in, out, n);                                     \
+      return;                                                     \
+    case SSE2:                                                    \
+      sse2Kernel(in, out, n);                                     \
+      return;                                                     \
+    default:                                                      \
+      ScalarConvert(in, out, n);                                  \
+      return;                                                     \
+    }
+#elif defined(OTB_CONVERT_KERNELS_SSE2)
+#define otbConvertDispatchMacro(avx2Kernel, sse2Kernel)            \
+  if (GetInstructionSet() == SSE2)                                \
+    {                                                             \
+    sse2Kernel(in, out, n);                                       \
+    return;                                                       \
+    }                                                             \
+  ScalarConvert(in, out, n);
+#else
+#define otbConvertDispatchMacro(avx2Kernel, sse2Kernel)            \
+  ScalarConvert(in, out, n);
+#endif
+
+ConvertPixelBufferKernels::InstructionSetType
+ConvertPixelBufferKernels::GetInstructionSet()
+{
+  return static_cast<InstructionSetType>(CurrentInstructionSet().load());
+}
+
+ConvertPixelBufferKernels::InstructionSetType
+ConvertPixelBufferKernels::SetInstructionSet(InstructionSetType instructionSet)
+{
+  if (IsInstructionSetSupported(instructionSet))
+    {
+    CurrentInstructionSet().store(static_cast<int>(instructionSet));
+    }
+  return GetInstructionSet();
+}
+
+bool
+ConvertPixelBufferKernels::IsInstructionSetSupported(InstructionSetType instructionSet)
+{
+  switch (instructionSet)
+    {
+    case SCALAR:
+      return true;
+    case SSE2:
+      return DetectInstructionSet() != SCALAR;
+    case AVX2:
+      return DetectInstructionSet() == AVX2;
+    default:
+      return false;
+    }
+}
+
+std::string
+ConvertPixelBufferKernels::GetInstructionSetAsString(InstructionSetType instructionSet)
+{
+  switch (instructionSet)
+    {
+    case SSE2:
+      return "SSE2";
+    case AVX2:
+      return "AVX2";
+    case SCALAR:
+    default:
+      return "Scalar";
+    }
+}
+
+void ConvertPixelBufferKernels::Convert(const unsigned char* in, float* out, size_t n)
+{
+  otbConvertDispatchMacro(IntegerToFloatAVX2, IntegerToFloatSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const short* in, float* out, size_t n)
+{
+  otbConvertDispatchMacro(IntegerToFloatAVX2, IntegerToFloatSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const unsigned short* in, float* out, size_t n)
+{
+  otbConvertDispatchMacro(IntegerToFloatAVX2, IntegerToFloatSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const int* in, float* out, size_t n)
+{
+  otbConvertDispatchMacro(IntegerToFloatAVX2, IntegerToFloatSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const double* in, float* out, size_t n)
+{
+  otbConvertDispatchMacro(DoubleToFloatAVX2, DoubleToFloatSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const unsigned char* in, double* out, size_t n)
+{
+  otbConvertDispatchMacro(IntegerToDoubleAVX2, IntegerToDoubleSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const short* in, double* out, size_t n)
+{
+  otbConvertDispatchMacro(IntegerToDoubleAVX2, IntegerToDoubleSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const unsigned short* in, double* out, size_t n)
+{
+  otbConvertDispatchMacro(IntegerToDoubleAVX2, IntegerToDoubleSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const int* in, double* out, size_t n)
+{
+  otbConvertDispatchMacro(IntegerToDoubleAVX2, IntegerToDoubleSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const float* in, double* out, size_t n)
+{
+  otbConvertDispatchMacro(FloatToDoubleAVX2, FloatToDoubleSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const float* in, unsigned char* out, size_t n)
+{
+  otbConvertDispatchMacro(FloatToUCharAVX2, FloatToUCharSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const float* in, short* out, size_t n)
+{
+  otbConvertDispatchMacro(FloatToShortAVX2, FloatToShortSSE2)
+}
+
+void ConvertPixelBufferKernels::Convert(const float* in, unsigned short* out, size_t n)
+{
+  otbConvertDispatchMacro(FloatToUShortAVX2, FloatToUShortSSE2)
+}
+
+#undef otbConvertDispatchMacro
+
+} // end namespace otb
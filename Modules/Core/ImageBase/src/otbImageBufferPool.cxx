@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageBufferPool.h"
+#include "otbConfigurationManager.h"
+
+#include <new>
+
+#include "itkMacro.h"
+
+namespace otb
+{
+
+ImageBufferPool::ImageBufferPool()
+  : m_Enabled(ConfigurationManager::GetUseImageBufferPool()),
+    m_Size(0),
+    m_MaximumSize(static_cast<size_t>(ConfigurationManager::GetMaxRAMHint()) * 1024 * 1024),
+    m_NumberOfAcquisitions(0),
+    m_NumberOfReuses(0),
+    m_NumberOfEvictions(0)
+{
+}
+
+ImageBufferPool::~ImageBufferPool()
+{
+  this->Clear();
+}
+
+void *
+ImageBufferPool::Acquire(size_t size)
+{
+  {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  ++m_NumberOfAcquisitions;
+
+  BufferMapType::iterator it = m_BuffersBySize.find(size);
+  if (it != m_BuffersBySize.end())
+    {
+    void * data = it->second->data;
+    m_Buffers.erase(it->second);
+    m_BuffersBySize.erase(it);
+    m_Size -= size;
+    ++m_NumberOfReuses;
+    return data;
+    }
+  }
+
+  void * data = ::operator new(size, std::nothrow);
+  if (data == ITK_NULLPTR)
+    {
+    // The free buffers may be what is missing
+    this->Clear();
+    data = ::operator new(size, std::nothrow);
+    }
+  return data;
+}
+
+void
+ImageBufferPool::Release(void * buffer, size_t size)
+{
+  if (buffer == ITK_NULLPTR)
+    {
+    return;
+    }
+
+  {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_Enabled && size <= m_MaximumSize)
+    {
+    this->Shrink(m_MaximumSize - size);
+
+    BufferType entry = {buffer, size};
+    m_Buffers.push_front(entry);
+    m_BuffersBySize.insert(std::make_pair(size, m_Buffers.begin()));
+    m_Size += size;
+    return;
+    }
+  }
+
+  ::operator delete(buffer);
+}
+
+void
+ImageBufferPool::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  this->Shrink(0);
+}
+
+void
+ImageBufferPool::Shrink(size_t size)
+{
+  while (m_Size > size && !m_Buffers.empty())
+    {
+    const BufferType& oldest = m_Buffers.back();
+
+    std::pair<BufferMapType::iterator, BufferMapType::iterator> range = m_BuffersBySize.equal_range(oldest.size);
+    for (BufferMapType::iterator it = range.first; it != range.second; ++it)
+      {
+      if (it->second->data == oldest.data)
+        {
+        m_BuffersBySize.erase(it);
+        break;
+        }
+      }
+
+    ::operator delete(oldest.data);
+    m_Size -= oldest.size;
+    m_Buffers.pop_back();
+    ++m_NumberOfEvictions;
+    }
+}
+
+void
+ImageBufferPool::SetEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Enabled = enabled;
+  if (!enabled)
+    {
+    this->Shrink(0);
+    }
+}
+
+bool
+ImageBufferPool::IsEnabled() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Enabled;
+}
+
+void
+ImageBufferPool::SetMaximumSize(size_t size)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumSize = size;
+  this->Shrink(size);
+}
+
+size_t
+ImageBufferPool::GetMaximumSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumSize;
+}
+
+size_t
+ImageBufferPool::GetSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Size;
+}
+
+size_t
+ImageBufferPool::GetNumberOfBuffers() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Buffers.size();
+}
+
+unsigned long long
+ImageBufferPool::GetNumberOfAcquisitions() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfAcquisitions;
+}
+
+unsigned long long
+ImageBufferPool::GetNumberOfReuses() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfReuses;
+}
+
+double
+ImageBufferPool::GetReuseRate() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_NumberOfAcquisitions == 0)
+    {
+    return 0.;
+    }
+  return static_cast<double>(m_NumberOfReuses) / static_cast<double>(m_NumberOfAcquisitions);
+}
+
+unsigned long long
+ImageBufferPool::GetNumberOfEvictions() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfEvictions;
+}
+
+void
+ImageBufferPool::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_NumberOfAcquisitions = 0;
+  m_NumberOfReuses = 0;
+  m_NumberOfEvictions = 0;
+}
+
+void
+ImageBufferPool::PrintStatistics(std::ostream& os) const
+{
+  const double reuseRate = this->GetReuseRate();
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  os << "Image buffer pool: " << (m_Enabled ? "enabled" : "disabled") << std::endl
+     << "  Acquisitions: " << m_NumberOfAcquisitions << std::endl
+     << "  Reuses: " << m_NumberOfReuses << " (" << 100. * reuseRate << "%)" << std::endl
+     << "  Evictions: " << m_NumberOfEvictions << std::endl
+     << "  Free buffers: " << m_Buffers.size() << " (" << m_Size << " bytes, maximum "
+     << m_MaximumSize << " bytes)" << std::endl;
+}
+
+} // end namespace otb
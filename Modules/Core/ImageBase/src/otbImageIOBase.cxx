@@ -39,7 +39,10 @@ ImageIOBase::ImageIOBase() :
   m_ComponentType(UNKNOWNCOMPONENTTYPE),
   m_ByteOrder(OrderNotApplicable),
   m_FileType(TypeNotApplicable),
-  m_NumberOfDimensions(0)
+  m_NumberOfDimensions(0),
+  m_ResumeWriting(false),
+  m_ReadComponentType(UNKNOWNCOMPONENTTYPE),
+  m_NumberOfReadThreads(1)
 {
   Reset(false);
 }
@@ -220,6 +223,67 @@ const std::type_info& ImageIOBase::GetComponentTypeInfo() const
     }
 }
 
+ImageIOBase::IOComponentType ImageIOBase::MapComponentType(const std::type_info& ctype)
+{
+  if (ctype == typeid(unsigned char))
+    {
+    return UCHAR;
+    }
+  else if (ctype == typeid(char))
+    {
+    return CHAR;
+    }
+  else if (ctype == typeid(unsigned short))
+    {
+    return USHORT;
+    }
+  else if (ctype == typeid(short))
+    {
+    return SHORT;
+    }
+  else if (ctype == typeid(unsigned int))
+    {
+    return UINT;
+    }
+  else if (ctype == typeid(int))
+    {
+    return INT;
+    }
+  else if (ctype == typeid(unsigned long))
+    {
+    return ULONG;
+    }
+  else if (ctype == typeid(long))
+    {
+    return LONG;
+    }
+  else if (ctype == typeid(float))
+    {
+    return FLOAT;
+    }
+  else if (ctype == typeid(double))
+    {
+    return DOUBLE;
+    }
+  else if (ctype == typeid(std::complex<short>))
+    {
+    return CSHORT;
+    }
+  else if (ctype == typeid(std::complex<int>))
+    {
+    return CINT;
+    }
+  else if (ctype == typeid(std::complex<float>))
+    {
+    return CFLOAT;
+    }
+  else if (ctype == typeid(std::complex<double>))
+    {
+    return CDOUBLE;
+    }
+  return UNKNOWNCOMPONENTTYPE;
+}
+
 //
 // This macro enforces pixel type information to be available for all different
 // pixel types.
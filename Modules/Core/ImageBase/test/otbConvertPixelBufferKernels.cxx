@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include "itkTimeProbe.h"
+#include "itkConvertPixelBuffer.h"
+#include "otbDefaultConvertPixelTraits.h"
+#include "otbConvertPixelBufferKernels.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+typedef otb::ConvertPixelBufferKernels KernelsType;
+
+/** Check the kernels of every instruction set against the generic
+ * conversion. If nbRuns is not 0, also report the mean time taken by
+ * each of them over nbRuns conversions. */
+template <class TInput, class TOutput>
+bool CheckAndBenchmark(const std::string& name, double minValue, double maxValue,
+                       size_t size, unsigned int nbRuns)
+{
+  const unsigned int nbConversions = std::max(nbRuns, 1u);
+
+  std::vector<TInput> input(size);
+  for (size_t i = 0; i < size; ++i)
+    {
+    // Values spanning the range of the output type, with a fractional
+    // part for floating point inputs
+    const double ratio = static_cast<double>((i * 7919) % 10007) / 10006.;
+    input[i] = static_cast<TInput>(minValue + ratio * (maxValue - minValue));
+    }
+
+  // Current path: component by component through the pixel traits
+  std::vector<TOutput> reference(size);
+  itk::TimeProbe genericChrono;
+  for (unsigned int run = 0; run < nbConversions; ++run)
+    {
+    genericChrono.Start();
+    itk::ConvertPixelBuffer<TInput, TOutput, otb::DefaultConvertPixelTraits<TOutput> >
+      ::ConvertVectorImage(&input[0], 1, &reference[0], size);
+    genericChrono.Stop();
+    }
+
+  if (nbRuns > 0)
+    {
+    std::cout << std::setw(16) << name << std::setw(10) << "Generic"
+              << std::setw(12) << genericChrono.GetMean() << " s" << std::endl;
+    }
+
+  bool ok = true;
+  const KernelsType::InstructionSetType instructionSets[] =
+    {KernelsType::SCALAR, KernelsType::SSE2, KernelsType::AVX2};
+  const KernelsType::InstructionSetType defaultInstructionSet = KernelsType::GetInstructionSet();
+
+  for (unsigned int k = 0; k < 3; ++k)
+    {
+    if (!KernelsType::IsInstructionSetSupported(instructionSets[k]))
+      {
+      continue;
+      }
+    KernelsType::SetInstructionSet(instructionSets[k]);
+
+    std::vector<TOutput> output(size);
+    itk::TimeProbe chrono;
+    for (unsigned int run = 0; run < nbConversions; ++run)
+      {
+      chrono.Start();
+      KernelsType::Convert(&input[0], &output[0], size);
+      chrono.Stop();
+      }
+
+    if (nbRuns > 0)
+      {
+      std::cout << std::setw(16) << name << std::setw(10)
+                << KernelsType::GetInstructionSetAsString(instructionSets[k])
+                << std::setw(12) << chrono.GetMean() << " s"
+                << "  (x" << genericChrono.GetMean() / std::max(chrono.GetMean(), 1e-9) << ")"
+                << std::endl;
+      }
+
+    for (size_t i = 0; i < size; ++i)
+      {
+      if (output[i] != reference[i])
+        {
+        std::cerr << name << " " << KernelsType::GetInstructionSetAsString(instructionSets[k])
+                  << ": component " << i << " is " << +output[i]
+                  << " instead of " << +reference[i] << std::endl;
+        ok = false;
+        break;
+        }
+      }
+    }
+
+  KernelsType::SetInstructionSet(defaultInstructionSet);
+  return ok;
+}
+}
+
+int otbConvertPixelBufferKernels(int argc, char * argv[])
+{
+  // Odd default size so that the remainder of the vectorized loops is
+  // also checked. The kernels are only timed if a number of runs is
+  // given, which is not done by the regression tests, e.g.
+  // otbImageBaseTestDriver otbConvertPixelBufferKernels 4000037 5
+  const size_t       size   = argc > 1 ? static_cast<size_t>(atol(argv[1])) : 10007;
+  const unsigned int nbRuns = argc > 2 ? static_cast<unsigned int>(atoi(argv[2])) : 0;
+
+  std::cout << "Default instruction set: "
+            << KernelsType::GetInstructionSetAsString(KernelsType::GetInstructionSet())
+            << std::endl;
+
+  bool ok = true;
+  ok = CheckAndBenchmark<unsigned char, float>("uint8->float", 0, 255, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<short, float>("int16->float", -32768, 32767, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<unsigned short, float>("uint16->float", 0, 65535, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<int, float>("int32->float", -2e9, 2e9, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<double, float>("double->float", -1e6, 1e6, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<unsigned char, double>("uint8->double", 0, 255, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<short, double>("int16->double", -32768, 32767, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<unsigned short, double>("uint16->double", 0, 65535, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<int, double>("int32->double", -2e9, 2e9, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<float, double>("float->double", -1e6, 1e6, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<float, unsigned char>("float->uint8", -0.9, 255.9, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<float, short>("float->int16", -32768.9, 32767.9, size, nbRuns) && ok;
+  ok = CheckAndBenchmark<float, unsigned short>("float->uint16", -0.9, 65535.9, size, nbRuns) && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -52,4 +52,6 @@ void RegisterTests()
   REGISTER_TEST(otbMultiChannelExtractROINew);
   REGISTER_TEST(otbMetaImageFunction);
   REGISTER_TEST(otbMetaImageFunctionNew);
+  REGISTER_TEST(otbConvertPixelBufferKernels);
+  REGISTER_TEST(otbImageBufferPool);
 }
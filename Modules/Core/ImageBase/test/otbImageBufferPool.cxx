@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageBufferPool.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "otbMultiChannelExtractROI.h"
+
+#include <iostream>
+
+int otbImageBufferPool(int itkNotUsed(argc), char * argv[])
+{
+  typedef otb::VectorImage<float, 2>                            ImageType;
+  typedef otb::ImageFileReader<ImageType>                       ReaderType;
+  typedef otb::ImageFileWriter<ImageType>                       WriterType;
+  typedef otb::MultiChannelExtractROI<float, float>             ExtractType;
+
+  otb::ImageBufferPool& pool = otb::ImageBufferPool::GetInstance();
+  pool.SetEnabled(true);
+  pool.SetMaximumSize(3000);
+  pool.Clear();
+  pool.ResetStatistics();
+
+  bool ok = true;
+
+  // Buffers of the same size are reused
+  void * first = pool.Acquire(1000);
+  pool.Release(first, 1000);
+  void * second = pool.Acquire(1000);
+  if (second != first || pool.GetNumberOfReuses() != 1)
+    {
+    std::cerr << "A free buffer of the same size should be reused" << std::endl;
+    ok = false;
+    }
+
+  // Other sizes are allocated
+  void * other = pool.Acquire(500);
+  if (pool.GetNumberOfReuses() != 1 || pool.GetNumberOfAcquisitions() != 3)
+    {
+    std::cerr << "A buffer of another size should not be reused" << std::endl;
+    ok = false;
+    }
+  pool.Release(second, 1000);
+  pool.Release(other, 500);
+
+  // The oldest free buffers are freed when the pool is full
+  pool.Release(pool.Acquire(2000), 2000);
+  if (pool.GetSize() > pool.GetMaximumSize() || pool.GetNumberOfEvictions() != 1
+      || pool.GetNumberOfBuffers() != 2)
+    {
+    std::cerr << "The pool should hold 2 buffers after one eviction" << std::endl;
+    ok = false;
+    }
+
+  // Stream an image through a filter: the buffers of the previous
+  // divisions are reused
+  pool.SetMaximumSize(64 * 1024 * 1024);
+  pool.Clear();
+  pool.ResetStatistics();
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  ExtractType::Pointer extract = ExtractType::New();
+  extract->SetInput(reader->GetOutput());
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(argv[2]);
+  writer->SetInput(extract->GetOutput());
+  writer->SetNumberOfDivisionsStrippedStreaming(10);
+  writer->Update();
+
+  pool.PrintStatistics(std::cout);
+  if (pool.GetNumberOfReuses() == 0)
+    {
+    std::cerr << "No buffer was reused during the streaming" << std::endl;
+    ok = false;
+    }
+
+  pool.SetEnabled(false);
+  if (pool.GetNumberOfBuffers() != 0)
+    {
+    std::cerr << "Disabling the pool should free its buffers" << std::endl;
+    ok = false;
+    }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDistributedReducer_h
+#define otbDistributedReducer_h
+
+#include <cstddef>
+#include <vector>
+
+#include "itkLightObject.h"
+#include "itkVariableLengthVector.h"
+#include "itkVariableSizeMatrix.h"
+
+#include "OTBStreamingExport.h"
+
+namespace otb
+{
+
+/** \class DistributedReducer
+ *  \brief Combine the persistent data of several processes sharing the
+ *  streaming of an image.
+ *
+ *  When several processes run the same pipeline (for instance under
+ *  mpirun), each of them can stream only a part of the divisions of an
+ *  image through a persistent filter, provided that the filter combines
+ *  its accumulators with the ones of the other processes in
+ *  Synthetize(). This class gives the rank of the current process, the
+ *  number of processes, and the element-wise reductions needed to do
+ *  so. Every process gets the result of a reduction, and all of them
+ *  must call it in the same order with the same number of values.
+ *
+ *  This module does not depend on any parallel library: an
+ *  implementation (for instance the MPI one of the OTBMPIConfig module)
+ *  registers itself with SetInstance(). GetInstance() returns a null
+ *  pointer when the process is alone.
+ *
+ *  Values are exchanged as doubles: integers are exact up to 2^53.
+ *
+ * \sa PersistentImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ *
+ * \ingroup OTBStreaming
+ */
+class OTBStreaming_EXPORT DistributedReducer : public itk::LightObject
+{
+public:
+  /** Standard class typedefs */
+  typedef DistributedReducer            Self;
+  typedef itk::LightObject              Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(DistributedReducer, itk::LightObject);
+
+  /** Element-wise operations */
+  typedef enum
+  {
+    SUM,
+    MIN,
+    MAX
+  } OperationType;
+
+  /** Get the reducer of the running processes, or a null pointer if
+   * the process is alone */
+  static Pointer GetInstance();
+
+  /** Register the reducer of the running processes. Pass a null
+   * pointer to go back to a single process. */
+  static void SetInstance(Self * reducer);
+
+  /** Rank of the current process, between 0 and
+   * GetNumberOfProcesses() - 1 */
+  virtual unsigned int GetRank() const = 0;
+
+  /** Number of processes sharing the streaming */
+  virtual unsigned int GetNumberOfProcesses() const = 0;
+
+  /** Replace values by their reduction over all the processes */
+  virtual void AllReduce(double * values, size_t size, OperationType operation) = 0;
+
+  /** Return true if the division is streamed by the current process.
+   * The divisions are dealt to the processes in turn. */
+  bool IsDivisionOwned(unsigned int division) const
+  {
+    return division % this->GetNumberOfProcesses() == this->GetRank();
+  }
+
+  /** Reduce an array of any arithmetic type */
+  template <class TValue>
+  void AllReduce(TValue * values, size_t size, OperationType operation)
+  {
+    if (size == 0)
+      {
+      return;
+      }
+    std::vector<double> buffer(values, values + size);
+    this->AllReduce(&buffer[0], size, operation);
+    for (size_t i = 0; i < size; ++i)
+      {
+      values[i] = static_cast<TValue>(buffer[i]);
+      }
+  }
+
+  /** Reduce a single value */
+  template <class TValue>
+  void AllReduce(TValue & value, OperationType operation)
+  {
+    this->AllReduce(&value, 1, operation);
+  }
+
+  /** Reduce each component of a pixel */
+  template <class TValue>
+  void AllReduce(itk::VariableLengthVector<TValue> & vector, OperationType operation)
+  {
+    this->AllReduce(vector.GetDataPointer(), vector.GetSize(), operation);
+  }
+
+  /** Reduce each element of a matrix */
+  template <class TValue>
+  void AllReduce(itk::VariableSizeMatrix<TValue> & matrix, OperationType operation)
+  {
+    this->AllReduce(matrix.GetVnlMatrix().data_block(),
+                    static_cast<size_t>(matrix.Rows()) * matrix.Cols(), operation);
+  }
+
+protected:
+  DistributedReducer() {}
+  ~DistributedReducer() ITK_OVERRIDE {}
+
+private:
+  DistributedReducer(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  static Pointer m_Instance;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbEmptyDivisionPredicate_h
+#define otbEmptyDivisionPredicate_h
+
+#include "itkLightObject.h"
+#include "itkObjectFactory.h"
+
+namespace otb
+{
+
+/** \class EmptyDivisionPredicate
+ *  \brief Tell which streaming divisions hold no data.
+ *
+ * A writer given such a predicate asks it, before computing a
+ * division, whether the division is empty. Empty divisions are not
+ * computed: they are written as no-data directly (see
+ * ImageFileWriter::SetEmptyDivisionPredicate()).
+ *
+ * Subclasses must answer much faster than the pipeline computes the
+ * division, from a footprint, a mask, or a low resolution scan of the
+ * input. They must be conservative: a division holding any valid pixel
+ * must not be reported as empty.
+ *
+ * \sa MaskEmptyDivisionPredicate
+ *
+ * \ingroup OTBStreaming
+ */
+template <class TImage>
+class ITK_EXPORT EmptyDivisionPredicate : public itk::LightObject
+{
+public:
+  /** Standard class typedefs. */
+  typedef EmptyDivisionPredicate        Self;
+  typedef itk::LightObject              Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  typedef TImage                          ImageType;
+  typedef typename ImageType::RegionType  RegionType;
+
+  /** Runtime information support. */
+  itkTypeMacro(EmptyDivisionPredicate, itk::LightObject);
+
+  /** Called once before streaming, with the up to date information
+   * of the image to write */
+  virtual void Initialize(const ImageType * image) = 0;
+
+  /** Return true if the given region of the image holds no data */
+  virtual bool IsEmpty(const RegionType& region) = 0;
+
+protected:
+  EmptyDivisionPredicate() {}
+  ~EmptyDivisionPredicate() ITK_OVERRIDE {}
+
+private:
+  EmptyDivisionPredicate(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+};
+
+} // End namespace otb
+
+#endif
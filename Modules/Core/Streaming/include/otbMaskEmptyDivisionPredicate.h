@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMaskEmptyDivisionPredicate_h
+#define otbMaskEmptyDivisionPredicate_h
+
+#include "otbEmptyDivisionPredicate.h"
+
+namespace otb
+{
+
+/** \class MaskEmptyDivisionPredicate
+ *  \brief Report the divisions where a mask is null as empty.
+ *
+ * The mask covers the same area as the image to write, possibly at a
+ * lower resolution: each division is mapped to the mask through the
+ * physical coordinates, enlarged by one mask pixel to stay
+ * conservative, and is empty if the mask is null on all of it. Parts
+ * of the image outside of the mask are considered empty.
+ *
+ * The mask can be the output of a pipeline. Only the regions
+ * covering the divisions are requested, which stays cheap for a low
+ * resolution mask, such as an ImageToNoDataMaskFilter applied on an
+ * overview of the input, or a rasterized footprint.
+ *
+ * \sa ImageFileWriter::SetEmptyDivisionPredicate()
+ *
+ * \ingroup OTBStreaming
+ */
+template <class TImage, class TMaskImage>
+class ITK_EXPORT MaskEmptyDivisionPredicate : public EmptyDivisionPredicate<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef MaskEmptyDivisionPredicate     Self;
+  typedef EmptyDivisionPredicate<TImage> Superclass;
+  typedef itk::SmartPointer<Self>        Pointer;
+  typedef itk::SmartPointer<const Self>  ConstPointer;
+
+  typedef typename Superclass::ImageType   ImageType;
+  typedef typename Superclass::RegionType  RegionType;
+  typedef TMaskImage                       MaskImageType;
+  typedef typename MaskImageType::RegionType MaskRegionType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(MaskEmptyDivisionPredicate, EmptyDivisionPredicate);
+
+  /** Set/Get the mask, non-null where the image has data */
+  void SetMask(const MaskImageType * mask)
+  {
+    m_Mask = mask;
+  }
+
+  const MaskImageType * GetMask() const
+  {
+    return m_Mask;
+  }
+
+  void Initialize(const ImageType * image) ITK_OVERRIDE;
+
+  bool IsEmpty(const RegionType& region) ITK_OVERRIDE;
+
+protected:
+  MaskEmptyDivisionPredicate() {}
+  ~MaskEmptyDivisionPredicate() ITK_OVERRIDE {}
+
+private:
+  MaskEmptyDivisionPredicate(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  typename MaskImageType::ConstPointer m_Mask;
+  /** Holds the geometry of the image to write, without its data */
+  typename ImageType::Pointer          m_Geometry;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbMaskEmptyDivisionPredicate.txx"
+#endif
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMaskEmptyDivisionPredicate_txx
+#define otbMaskEmptyDivisionPredicate_txx
+
+#include "otbMaskEmptyDivisionPredicate.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkContinuousIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+template <class TImage, class TMaskImage>
+void
+MaskEmptyDivisionPredicate<TImage, TMaskImage>
+::Initialize(const ImageType * image)
+{
+  if (m_Mask.IsNull())
+    {
+    itkExceptionMacro(<< "No mask set");
+    }
+  const_cast<MaskImageType *>(m_Mask.GetPointer())->UpdateOutputInformation();
+
+  m_Geometry = ImageType::New();
+  m_Geometry->CopyInformation(image);
+}
+
+template <class TImage, class TMaskImage>
+bool
+MaskEmptyDivisionPredicate<TImage, TMaskImage>
+::IsEmpty(const RegionType& region)
+{
+  const unsigned int dimension = ImageType::ImageDimension;
+  typedef itk::ContinuousIndex<double, ImageType::ImageDimension>     ImageContinuousIndexType;
+  typedef itk::ContinuousIndex<double, MaskImageType::ImageDimension> MaskContinuousIndexType;
+  typedef typename ImageType::PointType                               PointType;
+
+  // Bounding box, in the mask, of the corners of the region (the
+  // direction of the axes may differ)
+  MaskContinuousIndexType lower, upper;
+  lower.Fill(itk::NumericTraits<double>::max());
+  upper.Fill(itk::NumericTraits<double>::NonpositiveMin());
+
+  for (unsigned int corner = 0; corner < (1u << dimension); ++corner)
+    {
+    ImageContinuousIndexType cornerIndex;
+    for (unsigned int i = 0; i < dimension; ++i)
+      {
+      cornerIndex[i] = (corner & (1u << i)) ? region.GetIndex(i) + region.GetSize(i) - 0.5
+                                            : region.GetIndex(i) - 0.5;
+      }
+
+    PointType cornerPoint;
+    m_Geometry->TransformContinuousIndexToPhysicalPoint(cornerIndex, cornerPoint);
+
+    MaskContinuousIndexType maskIndex;
+    m_Mask->TransformPhysicalPointToContinuousIndex(cornerPoint, maskIndex);
+    for (unsigned int i = 0; i < MaskImageType::ImageDimension; ++i)
+      {
+      lower[i] = std::min(lower[i], maskIndex[i]);
+      upper[i] = std::max(upper[i], maskIndex[i]);
+      }
+    }
+
+  // Mask pixels touching the footprint, plus one pixel all around
+  MaskRegionType maskRegion;
+  for (unsigned int i = 0; i < MaskImageType::ImageDimension; ++i)
+    {
+    const long first = static_cast<long>(std::floor(lower[i] + 0.5)) - 1;
+    const long last  = static_cast<long>(std::floor(upper[i] + 0.5)) + 1;
+    maskRegion.SetIndex(i, first);
+    maskRegion.SetSize(i, static_cast<typename MaskRegionType::SizeValueType>(last - first + 1));
+    }
+
+  if (!maskRegion.Crop(m_Mask->GetLargestPossibleRegion()))
+    {
+    // The division is outside of the mask
+    return true;
+    }
+
+  MaskImageType * mask = const_cast<MaskImageType *>(m_Mask.GetPointer());
+  mask->SetRequestedRegion(maskRegion);
+  mask->PropagateRequestedRegion();
+  mask->UpdateOutputData();
+
+  itk::ImageRegionConstIterator<MaskImageType> it(m_Mask, maskRegion);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    if (it.Get() != itk::NumericTraits<typename MaskImageType::PixelType>::ZeroValue())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+} // End namespace otb
+
+#endif
@@ -41,6 +41,16 @@ void
 PersistentFilterStreamingDecorator<TFilter>
 ::GenerateData(void)
 {
+  // Share the streaming with the other processes if the filter can
+  // combine their results
+  DistributedReducer::Pointer reducer;
+  if (this->GetFilter()->IsDistributable())
+    {
+    reducer = DistributedReducer::GetInstance();
+    }
+  this->GetFilter()->SetReducer(reducer);
+  this->GetStreamer()->SetReducer(reducer);
+
   // Reset the filter before the generation.
   this->GetFilter()->Reset();
 
@@ -22,6 +22,7 @@
 #define otbPersistentImageFilter_h
 
 #include "itkImageToImageFilter.h"
+#include "otbDistributedReducer.h"
 
 namespace otb
 {
@@ -36,6 +37,12 @@ namespace otb
  *   pieces of the image to the global result. The second one, Reset(), allows the user to
  *   reset the temporary data for a new input image for instance.
  *
+ *  When several processes share the streaming of the image, each of
+ *  them streams only a part of it. Filters able to combine their
+ *  persistent data with the other processes in Synthetize(), through
+ *  the reducer given by GetReducer(), return true in IsDistributable().
+ *  Other filters are always given the whole image.
+ *
  *  \note This class contains pure virtual method, and can not be instantiated.
  *
  * \sa StatisticsImageFilter
@@ -69,6 +76,26 @@ public:
    */
   virtual void Synthetize(void) = 0;
 
+  /** Return true if Synthetize() combines the persistent data of the
+   * processes given by the reducer, so that each of them can stream a
+   * part of the image only */
+  virtual bool IsDistributable() const
+  {
+    return false;
+  }
+
+  /** Set the reducer of the processes sharing the streaming, or a
+   * null pointer if this process streams the whole image */
+  void SetReducer(DistributedReducer * reducer)
+  {
+    m_Reducer = reducer;
+  }
+
+  DistributedReducer * GetReducer() const
+  {
+    return m_Reducer;
+  }
+
 protected:
   /** Constructor */
   PersistentImageFilter() {}
@@ -83,6 +110,8 @@ protected:
 private:
   PersistentImageFilter(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
+
+  DistributedReducer::Pointer m_Reducer;
 };
 } // End namespace otb
 
@@ -27,6 +27,8 @@
 #else
 #include "itk_kwiml.h"
 #endif
+#include <map>
+#include <mutex>
 #include <set>
 
 #include "OTBStreamingExport.h"
@@ -67,6 +69,19 @@ namespace otb
  *  correction factor parameters allows compensating this bias to the first
  *  order.
  *
+ *  To get rid of some of these limitations, the memory print can also
+ *  be measured: Measure() updates the data to write on its current
+ *  requested region (in general a probe region). Each filter records
+ *  the bytes of the output buffers it has actually allocated, which
+ *  accounts for neighborhood padding and for the filters buffering
+ *  more than requested (whole images, aligned blocks, ...). These
+ *  prints only depend on the regions processed, so that they are
+ *  reproducible. The peak resident memory of the process above the
+ *  one recorded by ResetMeasurements() is also sampled, for
+ *  information: it includes the buffers of the minipipelines, but also
+ *  the noise of the allocator. It is only supported on Linux and Mac
+ *  OS X (see IsMemoryMeasurementSupported()).
+ *
  * \ingroup OTBStreaming
  */
 class OTBStreaming_EXPORT PipelineMemoryPrintCalculator :
@@ -90,6 +105,7 @@ public:
   typedef KWIML_INT_uint64_t                  MemoryPrintType;
 #endif
   typedef std::set<const ProcessObjectType *> ProcessObjectPointerSetType;
+  typedef std::map<const ProcessObjectType *, MemoryPrintType> ProcessObjectMemoryPrintMapType;
 
   /** Run-time type information (and related methods). */
   itkTypeMacro(PipelineMemoryPrintCalculator, itk::Object);
@@ -123,6 +139,42 @@ public:
   /** Evaluate the print (in bytes) of a single data object */
   MemoryPrintType EvaluateDataObjectPrint(DataObjectType * data) const;
 
+  /** Evaluate the print (in bytes) of the buffer currently allocated
+   * by a single data object */
+  MemoryPrintType EvaluateDataObjectBufferedPrint(DataObjectType * data) const;
+
+  /** Get the resident memory of the process (in bytes). Return false
+   * if it can not be retrieved on this platform. */
+  static bool GetResidentMemory(MemoryPrintType & residentMemory);
+
+  /** Return true if the resident memory is sampled by Measure() on
+   * this platform */
+  static bool IsMemoryMeasurementSupported();
+
+  /** Record the current resident memory as the reference of the next
+   * measurements, and clear the memory prints of the filters */
+  void ResetMeasurements();
+
+  /** Update the data to write on its current requested region,
+   * recording the output buffers allocated by each filter and
+   * sampling the resident memory. The buffers of the pipeline are
+   * released afterwards, so that successive measurements do not
+   * depend on each other. */
+  void Measure();
+
+  /** Get the peak resident memory (in bytes) reached during the last
+   * call to Measure(), above the reference. 0 if the resident memory
+   * can not be retrieved on this platform. */
+  itkGetMacro(MeasuredMemoryPrint, MemoryPrintType);
+
+  /** Get the bytes of the output buffers allocated by each filter, as
+   * found when it ends, maximum over the calls to Measure() since
+   * ResetMeasurements() */
+  const ProcessObjectMemoryPrintMapType & GetMeasuredProcessObjectPrints() const
+  {
+    return m_MeasuredProcessObjectPrints;
+  }
+
 protected:
   /** Constructor */
   PipelineMemoryPrintCalculator();
@@ -136,6 +188,10 @@ protected:
   /** Recursive method to evaluate memory print in bytes */
   MemoryPrintType EvaluateProcessObjectPrintRecursive(ProcessObjectType * process);
 
+  /** Evaluate the print (in bytes) of the requested or the buffered
+   * region of a single data object */
+  MemoryPrintType EvaluateDataObjectRegionPrint(DataObjectType * data, bool buffered) const;
+
 private:
   PipelineMemoryPrintCalculator(const Self &); //purposely not implemented
   void operator =(const Self&);                //purposely not implemented
@@ -152,6 +208,28 @@ private:
   /** Visited ProcessObject set */
   ProcessObjectPointerSetType m_VisitedProcessObjects;
 
+  /** Observe the end of the filters during Measure() */
+  void ObserveProcessObject(itk::Object * caller, const itk::EventObject & event);
+
+  /** Update the peaks with a new sample of the resident memory */
+  void AddMemorySample(MemoryPrintType residentMemory);
+
+  /** Resident memory recorded by ResetMeasurements() */
+  MemoryPrintType m_MeasurementReference;
+
+  /** Peak memory print of the last measurement */
+  MemoryPrintType m_MeasuredMemoryPrint;
+
+  /** Memory prints measured for each filter */
+  ProcessObjectMemoryPrintMapType m_MeasuredProcessObjectPrints;
+
+  /** Peak resident memory during the current measurement */
+  MemoryPrintType m_PeakResidentMemory;
+
+  /** Protect the measures updated by the sampling thread and by the
+   * filters ending in other threads */
+  std::mutex m_MeasurementMutex;
+
 };
 } // end of namespace otb
 
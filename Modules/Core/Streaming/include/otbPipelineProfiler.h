@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPipelineProfiler_h
+#define otbPipelineProfiler_h
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkProcessObject.h"
+#include "itkCommand.h"
+
+#include "otbPipelineMemoryPrintCalculator.h"
+
+#include "OTBStreamingExport.h"
+
+namespace otb
+{
+
+/** \class PipelineProfiler
+ *  \brief Record the time spent and the data produced by each filter
+ *  of a pipeline.
+ *
+ *  Attach() observes the StartEvent and EndEvent of a process object
+ *  and of all the process objects upstream of it. Each time one of
+ *  them runs, the profiler records:
+ *  - its wall and CPU times, both inclusive and exclusive of the
+ *  filters running inside it (for instance the upstream pipeline of a
+ *  writer, or the mini-pipeline of a composite filter),
+ *  - its number of calls,
+ *  - the pixels of the requested regions of its image outputs, to be
+ *  compared with the pixels of their largest possible region (a ratio
+ *  above 1 means that some pixels are computed several times),
+ *  - the bytes of its inputs and outputs, as evaluated by
+ *  PipelineMemoryPrintCalculator. For a reader, the output bytes are
+ *  the bytes decoded from the ImageIO. For a writer, which updates its
+ *  input once per streaming division, the input bytes are the bytes
+ *  given to the ImageIO.
+ *
+ *  The CPU times are process-wide: a filter spreads its work over the
+ *  threads of the multithreader, so the time of the calling thread
+ *  alone (RUSAGE_THREAD) would miss most of it. As a consequence,
+ *  threads running beside the pipeline are accounted to the filter
+ *  running at the same time, and the reports name these figures
+ *  processCpuTime and selfProcessCpuTime.
+ *
+ *  The thread utilization of a filter is its exclusive process CPU
+ *  time over its exclusive wall time times its number of threads.
+ *
+ *  The profiles can be written as JSON or CSV.
+ *
+ * \sa PipelineMemoryPrintCalculator
+ *
+ * \ingroup OTBStreaming
+ */
+class OTBStreaming_EXPORT PipelineProfiler : public itk::Object
+{
+public:
+  /** Standard class typedefs */
+  typedef PipelineProfiler                Self;
+  typedef itk::Object                     Superclass;
+  typedef itk::SmartPointer<Self>         Pointer;
+  typedef itk::SmartPointer<const Self>   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PipelineProfiler, itk::Object);
+
+  typedef itk::ProcessObject                         ProcessObjectType;
+  typedef itk::DataObject                            DataObjectType;
+  typedef unsigned long long                         CounterType;
+
+  /** Measures of a process object */
+  struct ProcessObjectProfile
+  {
+    ProcessObjectProfile();
+
+    /** Class and object names of the process object */
+    std::string   className;
+    std::string   objectName;
+    unsigned long numberOfCalls;
+    /** Times in seconds. The CPU times are the ones of the whole
+     * process while the process object was running, see
+     * GetProcessCPUTime() */
+    double        wallTime;
+    double        selfWallTime;
+    double        processCPUTime;
+    double        selfProcessCPUTime;
+    unsigned int  numberOfThreads;
+    CounterType   requestedPixels;
+    CounterType   largestPixels;
+    CounterType   inputBytes;
+    CounterType   outputBytes;
+
+    /** Exclusive process CPU time over exclusive wall time and threads */
+    double GetThreadUtilization() const;
+  };
+
+  /** Observe process and all the process objects upstream of it.
+   * Process objects already observed are skipped. */
+  void Attach(ProcessObjectType * process);
+
+  /** Stop observing all the process objects. The profiles are kept. */
+  void Detach();
+
+  /** Clear the measures of the observed process objects */
+  void Reset();
+
+  /** Get the number of observed process objects */
+  unsigned int GetNumberOfProcessObjects() const;
+
+  /** Get a copy of the profile of the i-th observed process object,
+   * in the order they were attached */
+  ProcessObjectProfile GetProfile(unsigned int i) const;
+
+  /** Get a copy of the profile of a process object. Throw an
+   * exception if it is not observed. */
+  ProcessObjectProfile GetProfile(const ProcessObjectType * process) const;
+
+  /** Write the profiles as a JSON document */
+  void WriteJSON(std::ostream & os) const;
+
+  /** Write the profiles as CSV, one line per process object */
+  void WriteCSV(std::ostream & os) const;
+
+  /** Write the profiles in a file, as CSV if its extension is .csv,
+   * as JSON otherwise */
+  void WriteReport(const std::string & filename) const;
+
+  /** CPU time used by all the threads of the process so far, in seconds */
+  static double GetProcessCPUTime();
+
+protected:
+  PipelineProfiler();
+  ~PipelineProfiler() ITK_OVERRIDE;
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  PipelineProfiler(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** An observed process object */
+  struct Entry
+  {
+    ProcessObjectType::Pointer process;
+    unsigned long              startTag;
+    unsigned long              endTag;
+    bool                       hasImageOutput;
+    ProcessObjectProfile       profile;
+  };
+
+  /** A process object running in a thread */
+  struct Frame
+  {
+    unsigned int entry;
+    double       wallStart;
+    double       cpuStart;
+    double       childrenWallTime;
+    double       childrenCPUTime;
+    bool         inputsAccounted;
+  };
+
+  typedef std::map<const ProcessObjectType *, unsigned int>               EntryIndexMapType;
+  typedef std::map<const DataObjectType *, std::vector<unsigned int> >    ConsumerMapType;
+  typedef std::map<std::thread::id, std::vector<Frame> >                 FrameStackMapType;
+  typedef itk::MemberCommand<Self>                                        CommandType;
+
+  /** Callback of the StartEvent and EndEvent of the observed objects */
+  void ObserveProcessObject(itk::Object * caller, const itk::EventObject & event);
+
+  /** Account an input of a running process object */
+  void AccountInput(Entry & entry, DataObjectType * data);
+
+  /** Wall clock time in seconds */
+  static double GetWallTime();
+
+  std::vector<Entry>                       m_Entries;
+  EntryIndexMapType                        m_EntryIndices;
+  /** Observed process objects reading each data object */
+  ConsumerMapType                          m_Consumers;
+  FrameStackMapType                        m_Frames;
+  CommandType::Pointer                     m_Command;
+  PipelineMemoryPrintCalculator::Pointer   m_PrintCalculator;
+  mutable std::mutex                       m_Mutex;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRAMDrivenBlockAlignedStreamingManager_h
+#define otbRAMDrivenBlockAlignedStreamingManager_h
+
+#include "otbStreamingManager.h"
+
+namespace otb
+{
+
+/** \class RAMDrivenBlockAlignedStreamingManager
+ *  \brief This class computes the divisions needed to stream an image
+ *  along the native blocks of the input files and according to a
+ *  user-defined available RAM.
+ *
+ * The block size is retrieved from the TileHint of the
+ * MetaDataDictionary of the streamed image and of the images found
+ * upstream in the pipeline (typically the outputs of the readers),
+ * as long as they share the index space of the streamed image (same
+ * largest possible region, origin and spacing). When several block
+ * sizes are found, the splits are aligned on their least common
+ * multiple.
+ *
+ * You can use SetAvailableRAMInMB to set the available RAM. An
+ * estimation of the pipeline memory print will be done, and the
+ * number of divisions will then be computed to fit the available RAM.
+ * Splits are made of whole blocks, and are never larger than what the
+ * available RAM allows (blocks are divided when a single block does
+ * not fit).
+ *
+ * \sa ImageRegionBlockAlignedSplitter
+ * \sa RAMDrivenAdaptativeStreamingManager
+ * \sa ImageFileWriter
+ * \sa StreamingImageVirtualFileWriter
+ *
+ * \ingroup OTBStreaming
+ */
+template<class TImage>
+class ITK_EXPORT RAMDrivenBlockAlignedStreamingManager : public StreamingManager<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef RAMDrivenBlockAlignedStreamingManager Self;
+  typedef StreamingManager<TImage>              Superclass;
+  typedef itk::SmartPointer<Self>               Pointer;
+  typedef itk::SmartPointer<const Self>         ConstPointer;
+
+  typedef TImage                          ImageType;
+  typedef typename Superclass::RegionType RegionType;
+  typedef typename Superclass::SizeType   SizeType;
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  /** Type macro */
+  itkTypeMacro(RAMDrivenBlockAlignedStreamingManager, itk::LightObject);
+
+  /** Dimension of input image. */
+  itkStaticConstMacro(ImageDimension, unsigned int, ImageType::ImageDimension);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkGetConstMacro(AvailableRAMInMB, unsigned int);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkSetMacro(Bias, double);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkGetConstMacro(Bias, double);
+
+  /** The block size used by the last call to PrepareStreaming (null
+   * if no block size was found) */
+  itkGetConstReferenceMacro(BlockSize, SizeType);
+
+  /** Actually computes the stream divisions, according to the specified streaming mode,
+   * eventually using the input parameter to estimate memory consumption */
+  void PrepareStreaming(itk::DataObject * input, const RegionType &region) ITK_OVERRIDE;
+
+  /** Look for the block size of the files read by the pipeline
+   * producing input. Return a null size if none is found. */
+  static SizeType FindBlockSize(itk::DataObject * input);
+
+protected:
+  RAMDrivenBlockAlignedStreamingManager();
+  ~RAMDrivenBlockAlignedStreamingManager() ITK_OVERRIDE;
+
+  /** The number of MegaBytes of RAM available */
+  unsigned int m_AvailableRAMInMB;
+
+  /** The multiplier to apply to the memory print estimation */
+  double m_Bias;
+
+  /** The block size the splits are aligned on */
+  SizeType m_BlockSize;
+
+private:
+  RAMDrivenBlockAlignedStreamingManager(const RAMDrivenBlockAlignedStreamingManager &);
+  void operator =(const RAMDrivenBlockAlignedStreamingManager&);
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbRAMDrivenBlockAlignedStreamingManager.txx"
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRAMDrivenBlockAlignedStreamingManager_txx
+#define otbRAMDrivenBlockAlignedStreamingManager_txx
+
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
+#include "otbMacro.h"
+#include "otbImageRegionBlockAlignedSplitter.h"
+#include "itkImageBase.h"
+#include "itkMetaDataObject.h"
+#include "otbMetaDataKey.h"
+
+#include <algorithm>
+#include <deque>
+#include <set>
+
+namespace otb
+{
+
+template <class TImage>
+RAMDrivenBlockAlignedStreamingManager<TImage>::RAMDrivenBlockAlignedStreamingManager()
+  : m_AvailableRAMInMB(0),
+    m_Bias(1.0)
+{
+  m_BlockSize.Fill(0);
+}
+
+template <class TImage>
+RAMDrivenBlockAlignedStreamingManager<TImage>::~RAMDrivenBlockAlignedStreamingManager()
+{
+}
+
+template <class TImage>
+typename RAMDrivenBlockAlignedStreamingManager<TImage>::SizeType
+RAMDrivenBlockAlignedStreamingManager<TImage>::FindBlockSize( itk::DataObject * input )
+{
+  typedef itk::ImageBase<itkGetStaticConstMacro(ImageDimension)> ImageBaseType;
+
+  SizeType blockSize;
+  blockSize.Fill(0);
+  SizeType largestHint;
+  largestHint.Fill(0);
+
+  const ImageBaseType * reference = dynamic_cast<const ImageBaseType *>(input);
+  if (reference == ITK_NULLPTR || ImageDimension != 2)
+    {
+    return blockSize;
+    }
+
+  // Walk the pipeline upstream, breadth first
+  std::deque<itk::DataObject *>    toVisit(1, input);
+  std::set<const itk::DataObject *> visited;
+
+  while (!toVisit.empty())
+    {
+    itk::DataObject * current = toVisit.front();
+    toVisit.pop_front();
+    if (current == ITK_NULLPTR || !visited.insert(current).second)
+      {
+      continue;
+      }
+
+    // The blocks of images in another index space (resampled, extracted,
+    // ...) do not tell anything about the splits of the streamed image,
+    // nor do the images upstream of them
+    const ImageBaseType * image = dynamic_cast<const ImageBaseType *>(current);
+    if (image == ITK_NULLPTR
+        || image->GetLargestPossibleRegion() != reference->GetLargestPossibleRegion()
+        || image->GetOrigin() != reference->GetOrigin()
+        || image->GetSpacing() != reference->GetSpacing())
+      {
+      continue;
+      }
+
+    unsigned int tileHint[2] = {0, 0};
+    itk::ExposeMetaData<unsigned int>(image->GetMetaDataDictionary(), MetaDataKey::TileHintX, tileHint[0]);
+    itk::ExposeMetaData<unsigned int>(image->GetMetaDataDictionary(), MetaDataKey::TileHintY, tileHint[1]);
+
+    if (tileHint[0] > 0 && tileHint[1] > 0)
+      {
+      for (unsigned int dim = 0; dim < 2; ++dim)
+        {
+        largestHint[dim] = std::max<typename SizeType::SizeValueType>(largestHint[dim], tileHint[dim]);
+        if (blockSize[dim] == 0)
+          {
+          blockSize[dim] = tileHint[dim];
+          }
+        else
+          {
+          // Least common multiple, so that the splits are aligned on
+          // the blocks of every file
+          typename SizeType::SizeValueType a = blockSize[dim];
+          typename SizeType::SizeValueType b = tileHint[dim];
+          while (b != 0)
+            {
+            typename SizeType::SizeValueType r = a % b;
+            a = b;
+            b = r;
+            }
+          blockSize[dim] = blockSize[dim] / a * tileHint[dim];
+          }
+        }
+      }
+
+    itk::ProcessObject * source = current->GetSource();
+    if (source != ITK_NULLPTR)
+      {
+      itk::ProcessObject::DataObjectPointerArray inputs = source->GetInputs();
+      for (unsigned int i = 0; i < inputs.size(); ++i)
+        {
+        toVisit.push_back(inputs[i].GetPointer());
+        }
+      }
+    }
+
+  // A common multiple larger than the image is useless: align on the
+  // largest block only
+  for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+    if (blockSize[dim] > reference->GetLargestPossibleRegion().GetSize()[dim])
+      {
+      blockSize[dim] = largestHint[dim];
+      }
+    }
+
+  return blockSize;
+}
+
+template <class TImage>
+void
+RAMDrivenBlockAlignedStreamingManager<TImage>::PrepareStreaming( itk::DataObject * input, const RegionType &region )
+{
+  unsigned long nbDivisions =
+      this->EstimateOptimalNumberOfDivisions(input, region, m_AvailableRAMInMB, m_Bias);
+
+  m_BlockSize = FindBlockSize(input);
+  otbMsgDevMacro(<< "Block size used for the splits : " << m_BlockSize)
+
+  typename otb::ImageRegionBlockAlignedSplitter<itkGetStaticConstMacro(ImageDimension)>::Pointer splitter =
+      otb::ImageRegionBlockAlignedSplitter<itkGetStaticConstMacro(ImageDimension)>::New();
+
+  splitter->SetBlockSize(m_BlockSize);
+
+  this->m_Splitter = splitter;
+
+  this->m_ComputedNumberOfSplits = this->m_Splitter->GetNumberOfSplits(region, nbDivisions);
+  otbMsgDevMacro(<< "Number of split : " << this->m_ComputedNumberOfSplits)
+  this->m_Region = region;
+}
+
+} // End namespace otb
+
+#endif
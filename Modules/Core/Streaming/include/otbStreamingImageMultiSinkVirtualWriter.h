@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingImageMultiSinkVirtualWriter_h
+#define otbStreamingImageMultiSinkVirtualWriter_h
+
+#include <vector>
+
+#include "otbStreamingImageVirtualWriter.h"
+
+namespace otb
+{
+
+/** \class StreamingImageMultiSinkVirtualWriter
+ *  \brief Stream an image through several persistent filters at once.
+ *
+ *  Chaining a PersistentFilterStreamingDecorator per statistic means
+ *  reading and computing the whole upstream pipeline once per
+ *  statistic. This writer connects all the persistent filters added
+ *  with AddPersistentFilter() to its input, and for each division of
+ *  the streaming, brings the input up to date once before updating
+ *  every filter on the same region. Reset() is called on each filter
+ *  before the streaming and Synthetize() after it, like the decorator
+ *  does.
+ *
+ *  The filters must accept the input image type of the writer. A
+ *  filter requesting a region larger than the division (a filter with
+ *  a radius, for instance) makes the upstream pipeline compute the
+ *  division again: such filters are better streamed on their own.
+ *
+ *  The streaming is shared with the other processes given by
+ *  DistributedReducer::GetInstance() only if all the filters are
+ *  distributable.
+ *
+ * \sa StreamingImageVirtualWriter
+ * \sa PersistentImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ *
+ * \ingroup OTBStreaming
+ */
+template <class TInputImage>
+class ITK_EXPORT StreamingImageMultiSinkVirtualWriter : public StreamingImageVirtualWriter<TInputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef StreamingImageMultiSinkVirtualWriter     Self;
+  typedef StreamingImageVirtualWriter<TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>                  Pointer;
+  typedef itk::SmartPointer<const Self>            ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(StreamingImageMultiSinkVirtualWriter, StreamingImageVirtualWriter);
+
+  typedef typename Superclass::InputImageType       InputImageType;
+  typedef typename Superclass::InputImagePointer    InputImagePointer;
+  typedef typename Superclass::InputImageRegionType InputImageRegionType;
+
+  /** Add a persistent filter to update during the streaming. TFilter
+   * must provide SetInput(const InputImageType *), Reset(),
+   * Synthetize(), IsDistributable() and SetReducer(), as the
+   * PersistentImageFilter subclasses do. */
+  template <class TFilter>
+  void AddPersistentFilter(TFilter * filter)
+  {
+    typename PersistentFilterSink<TFilter>::Pointer sink = PersistentFilterSink<TFilter>::New();
+    sink->SetFilter(filter);
+    m_Sinks.push_back(sink.GetPointer());
+    this->Modified();
+  }
+
+  /** Remove all the persistent filters */
+  void ClearPersistentFilters();
+
+  /** Get the number of persistent filters */
+  unsigned int GetNumberOfPersistentFilters() const
+  {
+    return static_cast<unsigned int>(m_Sinks.size());
+  }
+
+  /** Reset the filters, stream the input through all of them, and
+   * synthetize their results */
+  void Update() ITK_OVERRIDE;
+
+protected:
+  StreamingImageMultiSinkVirtualWriter();
+
+  ~StreamingImageMultiSinkVirtualWriter() ITK_OVERRIDE {}
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+  /** Update the input, then each filter, on the division */
+  void UpdateDivision(const InputImageRegionType& streamRegion) ITK_OVERRIDE;
+
+private:
+  StreamingImageMultiSinkVirtualWriter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** Persistent filter, independently of its type */
+  class Sink : public itk::LightObject
+  {
+  public:
+    typedef Sink                    Self;
+    typedef itk::SmartPointer<Self> Pointer;
+
+    virtual void SetInput(const InputImageType * input) = 0;
+    virtual void Reset() = 0;
+    virtual void Synthetize() = 0;
+    virtual void UpdateOutputInformation() = 0;
+    virtual void UpdateRegion(const InputImageRegionType& region) = 0;
+    virtual bool IsDistributable() const = 0;
+    virtual void SetReducer(DistributedReducer * reducer) = 0;
+    virtual const char * GetFilterNameOfClass() const = 0;
+  };
+
+  template <class TFilter>
+  class PersistentFilterSink : public Sink
+  {
+  public:
+    typedef PersistentFilterSink    Self;
+    typedef itk::SmartPointer<Self> Pointer;
+
+    itkSimpleNewMacro(Self);
+
+    void SetFilter(TFilter * filter)
+    {
+      m_Filter = filter;
+    }
+
+    void SetInput(const InputImageType * input) ITK_OVERRIDE
+    {
+      m_Filter->SetInput(input);
+    }
+
+    void Reset() ITK_OVERRIDE
+    {
+      m_Filter->Reset();
+    }
+
+    void Synthetize() ITK_OVERRIDE
+    {
+      m_Filter->Synthetize();
+    }
+
+    void UpdateOutputInformation() ITK_OVERRIDE
+    {
+      m_Filter->GetOutput()->UpdateOutputInformation();
+    }
+
+    void UpdateRegion(const InputImageRegionType& region) ITK_OVERRIDE
+    {
+      m_Filter->GetOutput()->SetRequestedRegion(region);
+      m_Filter->GetOutput()->PropagateRequestedRegion();
+      m_Filter->GetOutput()->UpdateOutputData();
+    }
+
+    bool IsDistributable() const ITK_OVERRIDE
+    {
+      return m_Filter->IsDistributable();
+    }
+
+    void SetReducer(DistributedReducer * reducer) ITK_OVERRIDE
+    {
+      m_Filter->SetReducer(reducer);
+    }
+
+    const char * GetFilterNameOfClass() const ITK_OVERRIDE
+    {
+      return m_Filter->GetNameOfClass();
+    }
+
+  private:
+    typename TFilter::Pointer m_Filter;
+  };
+
+  typedef std::vector<typename Sink::Pointer> SinkListType;
+
+  SinkListType m_Sinks;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingImageMultiSinkVirtualWriter.txx"
+#endif
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingImageMultiSinkVirtualWriter_txx
+#define otbStreamingImageMultiSinkVirtualWriter_txx
+
+#include "otbStreamingImageMultiSinkVirtualWriter.h"
+
+namespace otb
+{
+
+template <class TInputImage>
+StreamingImageMultiSinkVirtualWriter<TInputImage>
+::StreamingImageMultiSinkVirtualWriter()
+{
+}
+
+template <class TInputImage>
+void
+StreamingImageMultiSinkVirtualWriter<TInputImage>
+::ClearPersistentFilters()
+{
+  m_Sinks.clear();
+  this->Modified();
+}
+
+template <class TInputImage>
+void
+StreamingImageMultiSinkVirtualWriter<TInputImage>
+::Update()
+{
+  if (m_Sinks.empty())
+    {
+    itkExceptionMacro(<< "No persistent filter to update");
+    }
+
+  InputImagePointer inputPtr = const_cast<InputImageType *>(this->GetInput(0));
+  if (inputPtr.IsNull())
+    {
+    itkExceptionMacro(<< "No input to stream");
+    }
+
+  // The input of a division must stay in memory until the last filter
+  // has been updated on it
+  const bool releaseDataFlag = inputPtr->GetReleaseDataFlag();
+  inputPtr->ReleaseDataFlagOff();
+
+  // Share the streaming with the other processes only if every filter
+  // can combine their results
+  DistributedReducer::Pointer reducer = DistributedReducer::GetInstance();
+  for (typename SinkListType::iterator it = m_Sinks.begin(); it != m_Sinks.end(); ++it)
+    {
+    if (!(*it)->IsDistributable())
+      {
+      reducer = ITK_NULLPTR;
+      }
+    }
+  this->SetReducer(reducer);
+
+  for (typename SinkListType::iterator it = m_Sinks.begin(); it != m_Sinks.end(); ++it)
+    {
+    (*it)->SetReducer(reducer);
+    (*it)->SetInput(inputPtr);
+    (*it)->Reset();
+    (*it)->UpdateOutputInformation();
+    }
+
+  try
+    {
+    Superclass::Update();
+    }
+  catch (...)
+    {
+    inputPtr->SetReleaseDataFlag(releaseDataFlag);
+    throw;
+    }
+  inputPtr->SetReleaseDataFlag(releaseDataFlag);
+
+  for (typename SinkListType::iterator it = m_Sinks.begin(); it != m_Sinks.end(); ++it)
+    {
+    (*it)->Synthetize();
+    }
+}
+
+template <class TInputImage>
+void
+StreamingImageMultiSinkVirtualWriter<TInputImage>
+::UpdateDivision(const InputImageRegionType& streamRegion)
+{
+  // Compute the division once: the filters then find it in the
+  // buffered region of the input
+  Superclass::UpdateDivision(streamRegion);
+
+  for (typename SinkListType::iterator it = m_Sinks.begin(); it != m_Sinks.end(); ++it)
+    {
+    (*it)->UpdateRegion(streamRegion);
+    }
+}
+
+template <class TInputImage>
+void
+StreamingImageMultiSinkVirtualWriter<TInputImage>
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Persistent filters: " << m_Sinks.size() << std::endl;
+  for (typename SinkListType::const_iterator it = m_Sinks.begin(); it != m_Sinks.end(); ++it)
+    {
+    os << indent.GetNextIndent() << (*it)->GetFilterNameOfClass() << std::endl;
+    }
+}
+
+} // end namespace otb
+
+#endif
@@ -24,6 +24,7 @@
 #include "itkMacro.h"
 #include "itkImageToImageFilter.h"
 #include "otbStreamingManager.h"
+#include "otbDistributedReducer.h"
 
 namespace otb
 {
@@ -138,6 +139,29 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /**  Set the streaming mode to 'blocks' and configure the number of MB
+   *   available. The actual number of divisions is computed automatically
+   *   by estimating the memory consumption of the pipeline.
+   *   Splits are made of whole blocks of the input files, aligned on
+   *   them, and never exceed the available RAM.
+   *   Setting the availableRAM parameter to 0 means that the available RAM
+   *   is set from the CMake configuration option */
+  void SetAutomaticBlockAlignedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
+  /** Set the reducer of the processes sharing the streaming. When it
+   *  is set, only the divisions owned by the current process are
+   *  updated: the persistent filters downstream must combine their
+   *  results with the other processes in Synthetize(). */
+  void SetReducer(DistributedReducer * reducer)
+    {
+    m_Reducer = reducer;
+    }
+
+  DistributedReducer * GetReducer()
+    {
+    return m_Reducer;
+    }
+
   /** Override Update() from ProcessObject
    *  This filter does not produce an output */
   void Update() ITK_OVERRIDE;
@@ -153,6 +177,10 @@ protected:
 
   void GenerateInputRequestedRegion(void) ITK_OVERRIDE;
 
+  /** Bring the given division of the input up to date. Called by
+   * GenerateData() for each division of the streaming. */
+  virtual void UpdateDivision(const InputImageRegionType& streamRegion);
+
 private:
   StreamingImageVirtualWriter(const StreamingImageVirtualWriter &); //purposely not implemented
   void operator =(const StreamingImageVirtualWriter&); //purposely not implemented
@@ -184,6 +212,8 @@ private:
 
   StreamingManagerPointerType m_StreamingManager;
 
+  DistributedReducer::Pointer m_Reducer;
+
   bool          m_IsObserving;
   unsigned long m_ObserverID;
 };
@@ -32,6 +32,7 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
 
 namespace otb
 {
@@ -148,6 +149,18 @@ StreamingImageVirtualWriter<TInputImage>
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void
+StreamingImageVirtualWriter<TInputImage>
+::SetAutomaticBlockAlignedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef RAMDrivenBlockAlignedStreamingManager<TInputImage> RAMDrivenBlockAlignedStreamingManagerType;
+  typename RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager = RAMDrivenBlockAlignedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  m_StreamingManager = streamingManager;
+}
+
 template <class TInputImage>
 void
 StreamingImageVirtualWriter<TInputImage>
@@ -177,6 +190,17 @@ StreamingImageVirtualWriter<TInputImage>
   inputPtr->SetRequestedRegion(region);
 }
 
+template <class TInputImage>
+void
+StreamingImageVirtualWriter<TInputImage>
+::UpdateDivision(const InputImageRegionType& streamRegion)
+{
+  InputImagePointer inputPtr = const_cast<InputImageType *>(this->GetInput(0));
+  inputPtr->SetRequestedRegion(streamRegion);
+  inputPtr->PropagateRequestedRegion();
+  inputPtr->UpdateOutputData();
+}
+
 template<class TInputImage>
 void
 StreamingImageVirtualWriter<TInputImage>
@@ -243,12 +267,10 @@ StreamingImageVirtualWriter<TInputImage>
     {
     streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
     otbMsgDevMacro(<< "Processing region : " << streamRegion )
-    //inputPtr->ReleaseData();
-    //inputPtr->SetRequestedRegion(streamRegion);
-    //inputPtr->Update();
-    inputPtr->SetRequestedRegion(streamRegion);
-    inputPtr->PropagateRequestedRegion();
-    inputPtr->UpdateOutputData();
+    if (m_Reducer.IsNull() || m_Reducer->IsDivisionOwned(m_CurrentDivision))
+      {
+      this->UpdateDivision(streamRegion);
+      }
     }
 
   /**
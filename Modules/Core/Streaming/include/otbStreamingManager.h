@@ -24,6 +24,7 @@
 #include "otbMacro.h"
 
 #include "itkDataObject.h"
+#include "itkNumericTraits.h"
 #include "itkImageRegionSplitterBase.h"
 #include "otbPipelineMemoryPrintCalculator.h"
 
@@ -88,6 +89,44 @@ public:
    * GetNumberOfSplits() returns. */
   virtual RegionType GetSplit(unsigned int i);
 
+  /** Set/Get the number of additional buffers holding one stream
+   * division of the written image which are kept alive alongside the
+   * pipeline (for instance buffers queued by an asynchronous
+   * writer). The RAM driven streaming managers account for them when
+   * estimating the number of divisions. Default is 0. */
+  itkSetMacro(NumberOfExtraOutputBuffers, unsigned int);
+  itkGetConstMacro(NumberOfExtraOutputBuffers, unsigned int);
+
+  /** Set/Get the memory print, in bytes, of additional buffers holding
+   * one stream division of the pipeline sources (for instance the
+   * regions read ahead by the readers), given for the whole streamed
+   * region: it is divided by the number of divisions like the pipeline
+   * memory print. The RAM driven streaming managers account for it
+   * when estimating the number of divisions. Default is 0. */
+  itkSetMacro(ExtraInputBuffersPrint, MemoryPrintType);
+  itkGetConstMacro(ExtraInputBuffersPrint, MemoryPrintType);
+
+  /** Set/Get whether the RAM driven streaming managers measure the
+   * memory used by the pipeline instead of estimating it. Two probe
+   * regions are processed (see PipelineMemoryPrintCalculator::Measure())
+   * and the output buffers allocated by each filter on both of them
+   * give its fixed part and its part proportional to the number of
+   * pixels, from which the number of divisions is extrapolated. The
+   * bias correction factor is not applied to the measures. Since the
+   * buffer sizes only depend on the regions, the calibrated number of
+   * divisions is the same from one run to the other. Since the probe
+   * regions are actually processed, this must not be used with
+   * persistent filters in the pipeline. Default is false. */
+  itkSetMacro(MemoryCalibration, bool);
+  itkGetConstMacro(MemoryCalibration, bool);
+  itkBooleanMacro(MemoryCalibration);
+
+  /** Set/Get the number of divisions processed at the same time by
+   * independent pipelines. The RAM driven streaming managers share the
+   * available RAM between them. Default is 1. */
+  itkSetClampMacro(NumberOfConcurrentDivisions, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfConcurrentDivisions, unsigned int);
+
 protected:
   StreamingManager();
   ~StreamingManager() ITK_OVERRIDE;
@@ -96,6 +135,11 @@ protected:
                                                         MemoryPrintType availableRAMInMB,
                                                         double bias = 1.0);
 
+  /** Compute the number of divisions from the memory measured on
+   * probe regions. Return 0 if the memory could not be measured. */
+  unsigned int CalibrateNumberOfDivisions(ImageType * input, const RegionType &region,
+                                          MemoryPrintType availableRAMInBytes);
+
   /** The number of splits generated by the splitter */
   unsigned int m_ComputedNumberOfSplits;
 
@@ -107,6 +151,18 @@ protected:
   typedef typename AbstractSplitterType::Pointer AbstractSplitterPointerType;
   AbstractSplitterPointerType m_Splitter;
 
+  /** The number of additional output buffers to account for */
+  unsigned int m_NumberOfExtraOutputBuffers;
+
+  /** The memory print of additional input buffers to account for */
+  MemoryPrintType m_ExtraInputBuffersPrint;
+
+  /** Measure the memory print instead of estimating it */
+  bool m_MemoryCalibration;
+
+  /** The number of divisions sharing the available RAM */
+  unsigned int m_NumberOfConcurrentDivisions;
+
 private:
   StreamingManager(const StreamingManager &); //purposely not implemented
   void operator =(const StreamingManager&);   //purposely not implemented
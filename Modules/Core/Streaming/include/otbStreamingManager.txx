@@ -24,13 +24,20 @@
 #include "otbStreamingManager.h"
 #include "otbConfigurationManager.h"
 #include "itkExtractImageFilter.h"
+#include "otbMath.h"
+
+#include <algorithm>
 
 namespace otb
 {
 
 template <class TImage>
 StreamingManager<TImage>::StreamingManager()
-  : m_ComputedNumberOfSplits(0)
+  : m_ComputedNumberOfSplits(0),
+    m_NumberOfExtraOutputBuffers(0),
+    m_ExtraInputBuffersPrint(0),
+    m_MemoryCalibration(false),
+    m_NumberOfConcurrentDivisions(1)
 {
 }
 
@@ -66,6 +73,9 @@ StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::DataObject * inp
 
   MemoryPrintType availableRAMInBytes = GetActualAvailableRAMInBytes(availableRAM);
 
+  // Each of the divisions processed at the same time gets its share
+  availableRAMInBytes /= m_NumberOfConcurrentDivisions;
+
   otb::PipelineMemoryPrintCalculator::Pointer memoryPrintCalculator;
   memoryPrintCalculator = otb::PipelineMemoryPrintCalculator::New();
 
@@ -133,6 +143,27 @@ StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::DataObject * inp
 
       pipelineMemoryPrint -= extractContrib;
       }
+
+    if (m_NumberOfExtraOutputBuffers > 0)
+      {
+      // Buffers holding a copy of a division of the output scale
+      // with the number of divisions just like the pipeline
+      MemoryPrintType extraBuffersPrint = static_cast<MemoryPrintType>(m_NumberOfExtraOutputBuffers)
+        * region.GetNumberOfPixels()
+        * inputImage->GetNumberOfComponentsPerPixel()
+        * sizeof(PixelType);
+
+      otbMsgDevMacro("Memory print of the extra output buffers : "
+                     << extraBuffersPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte << " MB")
+      pipelineMemoryPrint += extraBuffersPrint;
+      }
+
+    if (m_ExtraInputBuffersPrint > 0)
+      {
+      otbMsgDevMacro("Memory print of the extra input buffers : "
+                     << m_ExtraInputBuffersPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte << " MB")
+      pipelineMemoryPrint += m_ExtraInputBuffersPrint;
+      }
     }
   else
     {
@@ -153,6 +184,125 @@ StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::DataObject * inp
   otbMsgDevMacro( "Optimal number of stream divisions: "
                   << optimalNumberOfDivisions << std::endl)
 
+  if (m_MemoryCalibration && inputImage)
+    {
+    const unsigned int calibratedNumberOfDivisions =
+      this->CalibrateNumberOfDivisions(inputImage, region, availableRAMInBytes);
+    if (calibratedNumberOfDivisions > 0)
+      {
+      return calibratedNumberOfDivisions;
+      }
+    itkWarningMacro(<< "Memory calibration failed, the number of divisions is estimated instead");
+    }
+
+  return optimalNumberOfDivisions;
+}
+
+template <class TImage>
+unsigned int
+StreamingManager<TImage>::CalibrateNumberOfDivisions(ImageType * input, const RegionType &region,
+                                                     MemoryPrintType availableRAMInBytes)
+{
+  typedef otb::PipelineMemoryPrintCalculator::ProcessObjectMemoryPrintMapType ProcessObjectMemoryPrintMapType;
+
+  otb::PipelineMemoryPrintCalculator::Pointer memoryPrintCalculator;
+  memoryPrintCalculator = otb::PipelineMemoryPrintCalculator::New();
+  memoryPrintCalculator->SetDataToWrite(input);
+
+  // Process two square probes around the region center: the second
+  // one has four times as many pixels, which allows separating for each
+  // filter the fixed part of its buffers (neighborhood padding, whole
+  // images, ...) from the part proportional to the number of pixels.
+  // The probes are large enough for the padding not to hide the
+  // proportional part.
+  const unsigned int probeSizes[2] = {512, 1024};
+  double probePixels[2] = {0., 0.};
+  ProcessObjectMemoryPrintMapType probePrints[2];
+  unsigned int nbProbes = 0;
+
+  for (unsigned int k = 0; k < 2; ++k)
+    {
+    RegionType probe;
+    SizeType   probeSize;
+    IndexType  probeIndex;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+      probeSize[dim] = probeSizes[k];
+      probeIndex[dim] = region.GetIndex()[dim]
+        + static_cast<typename IndexType::IndexValueType>(region.GetSize()[dim] / 2)
+        - static_cast<typename IndexType::IndexValueType>(probeSizes[k] / 2);
+      }
+    probe.SetSize(probeSize);
+    probe.SetIndex(probeIndex);
+
+    if (!probe.Crop(region))
+      {
+      return 0;
+      }
+
+    // The region is too small for a larger probe
+    if (nbProbes > 0 && probe.GetNumberOfPixels() == probePixels[nbProbes - 1])
+      {
+      break;
+      }
+
+    otbMsgDevMacro("Measuring memory print on probe region " << probe)
+    memoryPrintCalculator->ResetMeasurements();
+    input->SetRequestedRegion(probe);
+    memoryPrintCalculator->Measure();
+
+    probePixels[nbProbes] = probe.GetNumberOfPixels();
+    probePrints[nbProbes] = memoryPrintCalculator->GetMeasuredProcessObjectPrints();
+    ++nbProbes;
+    }
+
+  // Sum the parts of the filters
+  double printPerPixel = 0.;
+  double fixedPrint = 0.;
+  const ProcessObjectMemoryPrintMapType & lastPrints = probePrints[nbProbes - 1];
+  for (typename ProcessObjectMemoryPrintMapType::const_iterator it = lastPrints.begin();
+       it != lastPrints.end(); ++it)
+    {
+    const double lastPrint = static_cast<double>(it->second);
+    double filterPrintPerPixel = lastPrint / probePixels[nbProbes - 1];
+    double filterFixedPrint = 0.;
+    if (nbProbes == 2)
+      {
+      typename ProcessObjectMemoryPrintMapType::const_iterator firstIt = probePrints[0].find(it->first);
+      const double firstPrint = firstIt != probePrints[0].end() ? static_cast<double>(firstIt->second) : 0.;
+      filterPrintPerPixel = std::max(0., (lastPrint - firstPrint) / (probePixels[1] - probePixels[0]));
+      filterFixedPrint = std::max(0., lastPrint - filterPrintPerPixel * probePixels[1]);
+      }
+
+    otbMsgDevMacro("Measured memory print of " << it->first->GetNameOfClass() << ": "
+                   << filterFixedPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte
+                   << " MB + " << filterPrintPerPixel << " bytes per pixel")
+    printPerPixel += filterPrintPerPixel;
+    fixedPrint += filterFixedPrint;
+    }
+
+  // Buffers holding a copy of a division of the output
+  printPerPixel += static_cast<double>(m_NumberOfExtraOutputBuffers)
+    * input->GetNumberOfComponentsPerPixel() * sizeof(PixelType);
+
+  // Buffers holding a copy of a division of the sources
+  printPerPixel += static_cast<double>(m_ExtraInputBuffersPrint) / region.GetNumberOfPixels();
+
+  otbMsgDevMacro("Measured memory print: " << fixedPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte
+                 << " MB + " << printPerPixel << " bytes per pixel")
+
+  if (printPerPixel <= 0. || fixedPrint >= static_cast<double>(availableRAMInBytes))
+    {
+    return 0;
+    }
+
+  const double pixelsPerDivision = (static_cast<double>(availableRAMInBytes) - fixedPrint) / printPerPixel;
+  const unsigned int optimalNumberOfDivisions = std::max(1u,
+    static_cast<unsigned int>(vcl_ceil(region.GetNumberOfPixels() / pixelsPerDivision)));
+
+  otbMsgDevMacro( "Calibrated number of stream divisions: "
+                  << optimalNumberOfDivisions << std::endl)
+
   return optimalNumberOfDivisions;
 }
 
@@ -27,6 +27,21 @@
 #include "otbVectorImage.h"
 #include "itkFixedArray.h"
 #include "otbImageList.h"
+#include "itkCommand.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif
 
 namespace otb
 {
@@ -38,7 +53,11 @@ PipelineMemoryPrintCalculator
   : m_MemoryPrint(0),
     m_DataToWrite(ITK_NULLPTR),
     m_BiasCorrectionFactor(1.),
-    m_VisitedProcessObjects()
+    m_VisitedProcessObjects(),
+    m_MeasurementReference(0),
+    m_MeasuredMemoryPrint(0),
+    m_MeasuredProcessObjectPrints(),
+    m_PeakResidentMemory(0)
 {}
 
 PipelineMemoryPrintCalculator
@@ -67,6 +86,14 @@ PipelineMemoryPrintCalculator
   os<<indent<<"Data to write:                      "<<m_DataToWrite<<std::endl;
   os<<indent<<"Memory print of whole pipeline:     "<<m_MemoryPrint * ByteToMegabyte <<" Mb"<<std::endl;
   os<<indent<<"Bias correction factor applied:     "<<m_BiasCorrectionFactor<<std::endl;
+  os<<indent<<"Measured memory print:              "<<m_MeasuredMemoryPrint * ByteToMegabyte <<" Mb"<<std::endl;
+
+  for(ProcessObjectMemoryPrintMapType::const_iterator it = m_MeasuredProcessObjectPrints.begin();
+      it != m_MeasuredProcessObjectPrints.end(); ++it)
+    {
+    os<<indent<<"  "<<it->first->GetNameOfClass()<<" ("<<it->first<<"): "
+      <<it->second * ByteToMegabyte<<" Mb"<<std::endl;
+    }
 }
 
 void
@@ -163,6 +190,20 @@ PipelineMemoryPrintCalculator
 PipelineMemoryPrintCalculator::MemoryPrintType
 PipelineMemoryPrintCalculator
 ::EvaluateDataObjectPrint(DataObjectType * data) const
+{
+  return this->EvaluateDataObjectRegionPrint(data, false);
+}
+
+PipelineMemoryPrintCalculator::MemoryPrintType
+PipelineMemoryPrintCalculator
+::EvaluateDataObjectBufferedPrint(DataObjectType * data) const
+{
+  return this->EvaluateDataObjectRegionPrint(data, true);
+}
+
+PipelineMemoryPrintCalculator::MemoryPrintType
+PipelineMemoryPrintCalculator
+::EvaluateDataObjectRegionPrint(DataObjectType * data, bool buffered) const
 {
   otbMsgDevMacro(<< "EvaluateMemoryPrint for " << data->GetNameOfClass() << " (" << data << ")")
 
@@ -170,13 +211,13 @@ PipelineMemoryPrintCalculator
   if(dynamic_cast<itk::Image<type, 2> *>(data) != NULL)                  \
     {                                                                   \
     itk::Image<type, 2> * image = dynamic_cast<itk::Image<type, 2> *>(data); \
-    return image->GetRequestedRegion().GetNumberOfPixels()              \
+    return (buffered ? image->GetBufferedRegion() : image->GetRequestedRegion()).GetNumberOfPixels() \
       * image->GetNumberOfComponentsPerPixel() * sizeof(type); \
     }                                                                   \
   if(dynamic_cast<itk::VectorImage<type, 2> * >(data) != NULL)           \
     {                                                                   \
     itk::VectorImage<type, 2> * image = dynamic_cast<itk::VectorImage<type, 2> *>(data); \
-    return image->GetRequestedRegion().GetNumberOfPixels()              \
+    return (buffered ? image->GetBufferedRegion() : image->GetRequestedRegion()).GetNumberOfPixels() \
       * image->GetNumberOfComponentsPerPixel() * sizeof(type); \
     }                                                                   \
   if(dynamic_cast<ImageList<Image<type, 2> > *>(data) != NULL)   \
@@ -186,7 +227,8 @@ PipelineMemoryPrintCalculator
     for(ImageList<Image<type, 2> >::ConstIterator it = imageList->Begin(); \
        it != imageList->End(); ++it)                                    \
        {                                                             \
-       print += it.Get()->GetRequestedRegion().GetNumberOfPixels()   \
+       print += (buffered ? it.Get()->GetBufferedRegion()            \
+                 : it.Get()->GetRequestedRegion()).GetNumberOfPixels() \
        * it.Get()->GetNumberOfComponentsPerPixel() * sizeof(type); \
        }                                                           \
     return print;                                                  \
@@ -198,7 +240,8 @@ PipelineMemoryPrintCalculator
     for(ImageList<VectorImage<type, 2> >::ConstIterator it = imageList->Begin(); \
        it != imageList->End(); ++it)                                    \
        {                                                             \
-       print += it.Get()->GetRequestedRegion().GetNumberOfPixels()   \
+       print += (buffered ? it.Get()->GetBufferedRegion()            \
+                 : it.Get()->GetRequestedRegion()).GetNumberOfPixels() \
        * it.Get()->GetNumberOfComponentsPerPixel() * sizeof(type); \
        }                                                           \
     return print;                                                  \
@@ -227,4 +270,214 @@ PipelineMemoryPrintCalculator
   return 0;
 }
 
+// [static]
+bool
+PipelineMemoryPrintCalculator
+::GetResidentMemory(MemoryPrintType & residentMemory)
+{
+#if defined(__linux__)
+  std::ifstream statm("/proc/self/statm");
+  unsigned long size = 0;
+  unsigned long resident = 0;
+  if(statm >> size >> resident)
+    {
+    residentMemory = static_cast<MemoryPrintType>(resident) * sysconf(_SC_PAGESIZE);
+    return true;
+    }
+#elif defined(__APPLE__)
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+               reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+    {
+    residentMemory = info.resident_size;
+    return true;
+    }
+#else
+  (void)residentMemory;
+#endif
+  return false;
+}
+
+// [static]
+bool
+PipelineMemoryPrintCalculator
+::IsMemoryMeasurementSupported()
+{
+  MemoryPrintType residentMemory;
+  return GetResidentMemory(residentMemory);
+}
+
+void
+PipelineMemoryPrintCalculator
+::ResetMeasurements()
+{
+  m_MeasurementReference = 0;
+  GetResidentMemory(m_MeasurementReference);
+  m_MeasuredMemoryPrint = 0;
+  m_MeasuredProcessObjectPrints.clear();
+}
+
+void
+PipelineMemoryPrintCalculator
+::Measure()
+{
+  MemoryPrintType residentMemory = 0;
+  const bool sampleResidentMemory = GetResidentMemory(residentMemory);
+
+  // Collect the process objects upstream of the data to write
+  std::vector<ProcessObjectType *> processObjects;
+  std::vector<DataObjectType *>    dataObjects(1, m_DataToWrite.GetPointer());
+  ProcessObjectPointerSetType      visited;
+  while(!dataObjects.empty())
+    {
+    ProcessObjectType * process = dataObjects.back()->GetSource();
+    dataObjects.pop_back();
+    if(process == ITK_NULLPTR || !visited.insert(process).second)
+      {
+      continue;
+      }
+    processObjects.push_back(process);
+
+    ProcessObjectType::DataObjectPointerArray inputs = process->GetInputs();
+    for(unsigned int i = 0; i < inputs.size(); ++i)
+      {
+      if(inputs[i].IsNotNull())
+        {
+        dataObjects.push_back(inputs[i].GetPointer());
+        }
+      }
+    }
+
+  // Observe when each of them ends, before its outputs may be released
+  // by the filters downstream
+  typedef itk::MemberCommand<Self> CommandType;
+  CommandType::Pointer command = CommandType::New();
+  command->SetCallbackFunction(this, &Self::ObserveProcessObject);
+
+  std::vector<unsigned long> endTags(processObjects.size());
+  for(unsigned int i = 0; i < processObjects.size(); ++i)
+    {
+    endTags[i] = processObjects[i]->AddObserver(itk::EndEvent(), command);
+    }
+
+  {
+  std::lock_guard<std::mutex> lock(m_MeasurementMutex);
+  m_PeakResidentMemory = residentMemory;
+  }
+
+  // Sample the resident memory while the pipeline is updated, so that
+  // the temporary buffers of the filters are taken into account
+  std::atomic<bool> stopSampling(false);
+  std::thread sampler;
+  if(sampleResidentMemory)
+    {
+    sampler = std::thread([this, &stopSampling]()
+      {
+      while(!stopSampling)
+        {
+        MemoryPrintType sample;
+        if(GetResidentMemory(sample))
+          {
+          this->AddMemorySample(sample);
+          }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      });
+    }
+
+  try
+    {
+    m_DataToWrite->PropagateRequestedRegion();
+    m_DataToWrite->UpdateOutputData();
+    }
+  catch(...)
+    {
+    stopSampling = true;
+    if(sampler.joinable())
+      {
+      sampler.join();
+      }
+    for(unsigned int i = 0; i < processObjects.size(); ++i)
+      {
+      processObjects[i]->RemoveObserver(endTags[i]);
+      }
+    throw;
+    }
+
+  stopSampling = true;
+  if(sampler.joinable())
+    {
+    sampler.join();
+    }
+
+  if(sampleResidentMemory && GetResidentMemory(residentMemory))
+    {
+    this->AddMemorySample(residentMemory);
+    }
+
+  m_MeasuredMemoryPrint = m_PeakResidentMemory > m_MeasurementReference
+    ? m_PeakResidentMemory - m_MeasurementReference : 0;
+
+  otbMsgDevMacro(<< "Measured resident memory print: " << m_MeasuredMemoryPrint * ByteToMegabyte << " Mb")
+
+  // Release the buffers of this measurement
+  for(unsigned int i = 0; i < processObjects.size(); ++i)
+    {
+    processObjects[i]->RemoveObserver(endTags[i]);
+
+    ProcessObjectType::DataObjectPointerArray outputs = processObjects[i]->GetOutputs();
+    for(unsigned int j = 0; j < outputs.size(); ++j)
+      {
+      if(outputs[j].IsNotNull())
+        {
+        outputs[j]->ReleaseData();
+        }
+      }
+    }
+}
+
+void
+PipelineMemoryPrintCalculator
+::AddMemorySample(MemoryPrintType residentMemory)
+{
+  std::lock_guard<std::mutex> lock(m_MeasurementMutex);
+  m_PeakResidentMemory = std::max(m_PeakResidentMemory, residentMemory);
+}
+
+void
+PipelineMemoryPrintCalculator
+::ObserveProcessObject(itk::Object * caller, const itk::EventObject & event)
+{
+  ProcessObjectType * process = dynamic_cast<ProcessObjectType *>(caller);
+  if(process == ITK_NULLPTR || typeid(event) != typeid(itk::EndEvent))
+    {
+    return;
+    }
+
+  // The buffers allocated by the filter are the ones of its outputs
+  MemoryPrintType print = 0;
+  ProcessObjectType::DataObjectPointerArray outputs = process->GetOutputs();
+  for(unsigned int i = 0; i < outputs.size(); ++i)
+    {
+    if(outputs[i].IsNotNull())
+      {
+      print += this->EvaluateDataObjectBufferedPrint(outputs[i].GetPointer());
+      }
+    }
+
+  MemoryPrintType residentMemory;
+  if(GetResidentMemory(residentMemory))
+    {
+    this->AddMemorySample(residentMemory);
+    }
+
+  std::lock_guard<std::mutex> lock(m_MeasurementMutex);
+  MemoryPrintType & measuredPrint = m_MeasuredProcessObjectPrints[process];
+  measuredPrint = std::max(measuredPrint, print);
+
+  otbMsgDevMacro(<< "Measured memory print of " << process->GetNameOfClass()
+                 << ": " << print * ByteToMegabyte << " Mb")
+}
+
 } // End namespace otb
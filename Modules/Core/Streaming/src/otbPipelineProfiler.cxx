@@ -0,0 +1,545 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbPipelineProfiler.h"
+
+#include "itkImageBase.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <typeinfo>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <sys/time.h>
+#endif
+
+namespace otb
+{
+
+namespace
+{
+/** Escape a string to be written in a JSON document */
+std::string JSONEscape(const std::string & str)
+{
+  std::ostringstream oss;
+  for(std::string::const_iterator it = str.begin(); it != str.end(); ++it)
+    {
+    if(*it == '"' || *it == '\\')
+      {
+      oss << '\\' << *it;
+      }
+    else if(static_cast<unsigned char>(*it) < 0x20)
+      {
+      oss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+          << static_cast<int>(*it) << std::dec << std::setfill(' ');
+      }
+    else
+      {
+      oss << *it;
+      }
+    }
+  return oss.str();
+}
+
+/** Quote a string to be written in a CSV field */
+std::string CSVQuote(const std::string & str)
+{
+  std::string quoted("\"");
+  for(std::string::const_iterator it = str.begin(); it != str.end(); ++it)
+    {
+    quoted += *it;
+    if(*it == '"')
+      {
+      quoted += '"';
+      }
+    }
+  return quoted + "\"";
+}
+}
+
+PipelineProfiler::ProcessObjectProfile
+::ProcessObjectProfile()
+  : className(),
+    objectName(),
+    numberOfCalls(0),
+    wallTime(0.),
+    selfWallTime(0.),
+    processCPUTime(0.),
+    selfProcessCPUTime(0.),
+    numberOfThreads(1),
+    requestedPixels(0),
+    largestPixels(0),
+    inputBytes(0),
+    outputBytes(0)
+{}
+
+double
+PipelineProfiler::ProcessObjectProfile
+::GetThreadUtilization() const
+{
+  if(selfWallTime <= 0. || numberOfThreads == 0)
+    {
+    return 0.;
+    }
+  return selfProcessCPUTime / (selfWallTime * numberOfThreads);
+}
+
+PipelineProfiler
+::PipelineProfiler()
+  : m_Entries(),
+    m_EntryIndices(),
+    m_Consumers(),
+    m_Frames(),
+    m_Command(CommandType::New()),
+    m_PrintCalculator(PipelineMemoryPrintCalculator::New())
+{
+  m_Command->SetCallbackFunction(this, &Self::ObserveProcessObject);
+}
+
+PipelineProfiler
+::~PipelineProfiler()
+{
+  this->Detach();
+}
+
+void
+PipelineProfiler
+::Attach(ProcessObjectType * process)
+{
+  if(process == ITK_NULLPTR)
+    {
+    return;
+    }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  std::vector<ProcessObjectType *> processObjects(1, process);
+  while(!processObjects.empty())
+    {
+    ProcessObjectType * current = processObjects.back();
+    processObjects.pop_back();
+
+    unsigned int index;
+    EntryIndexMapType::const_iterator indexIt = m_EntryIndices.find(current);
+    if(indexIt == m_EntryIndices.end())
+      {
+      index = static_cast<unsigned int>(m_Entries.size());
+      m_EntryIndices[current] = index;
+
+      Entry entry;
+      entry.hasImageOutput = false;
+      entry.profile.className = current->GetNameOfClass();
+      entry.profile.objectName = current->GetObjectName();
+
+      ProcessObjectType::DataObjectPointerArray outputs = current->GetOutputs();
+      for(unsigned int i = 0; i < outputs.size(); ++i)
+        {
+        if(dynamic_cast<itk::ImageBase<2> *>(outputs[i].GetPointer()) != ITK_NULLPTR)
+          {
+          entry.hasImageOutput = true;
+          }
+        }
+      m_Entries.push_back(entry);
+      }
+    else if(m_Entries[indexIt->second].process.IsNull())
+      {
+      // Attached again after Detach()
+      index = indexIt->second;
+      }
+    else
+      {
+      continue;
+      }
+
+    Entry & entry = m_Entries[index];
+    entry.process = current;
+    entry.startTag = current->AddObserver(itk::StartEvent(), m_Command);
+    entry.endTag = current->AddObserver(itk::EndEvent(), m_Command);
+
+    ProcessObjectType::DataObjectPointerArray inputs = current->GetInputs();
+    for(unsigned int i = 0; i < inputs.size(); ++i)
+      {
+      if(inputs[i].IsNull())
+        {
+        continue;
+        }
+      m_Consumers[inputs[i].GetPointer()].push_back(index);
+      if(inputs[i]->GetSource() != ITK_NULLPTR)
+        {
+        processObjects.push_back(inputs[i]->GetSource());
+        }
+      }
+    }
+}
+
+void
+PipelineProfiler
+::Detach()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  for(std::vector<Entry>::iterator it = m_Entries.begin(); it != m_Entries.end(); ++it)
+    {
+    if(it->process.IsNotNull())
+      {
+      it->process->RemoveObserver(it->startTag);
+      it->process->RemoveObserver(it->endTag);
+      it->process = ITK_NULLPTR;
+      }
+    }
+  m_Consumers.clear();
+  m_Frames.clear();
+}
+
+void
+PipelineProfiler
+::Reset()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  for(std::vector<Entry>::iterator it = m_Entries.begin(); it != m_Entries.end(); ++it)
+    {
+    ProcessObjectProfile profile;
+    profile.className = it->profile.className;
+    profile.objectName = it->profile.objectName;
+    it->profile = profile;
+    }
+  m_Frames.clear();
+}
+
+unsigned int
+PipelineProfiler
+::GetNumberOfProcessObjects() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return static_cast<unsigned int>(m_Entries.size());
+}
+
+PipelineProfiler::ProcessObjectProfile
+PipelineProfiler
+::GetProfile(unsigned int i) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if(i >= m_Entries.size())
+    {
+    itkExceptionMacro(<< "No process object profile at index " << i << " (" << m_Entries.size() << " profiles)");
+    }
+  return m_Entries[i].profile;
+}
+
+PipelineProfiler::ProcessObjectProfile
+PipelineProfiler
+::GetProfile(const ProcessObjectType * process) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  EntryIndexMapType::const_iterator it = m_EntryIndices.find(process);
+  if(it == m_EntryIndices.end())
+    {
+    itkExceptionMacro(<< "Process object " << process << " is not observed");
+    }
+  return m_Entries[it->second].profile;
+}
+
+void
+PipelineProfiler
+::ObserveProcessObject(itk::Object * caller, const itk::EventObject & event)
+{
+  const double wallTime = GetWallTime();
+  const double cpuTime = GetProcessCPUTime();
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  EntryIndexMapType::const_iterator indexIt =
+    m_EntryIndices.find(dynamic_cast<ProcessObjectType *>(caller));
+  if(indexIt == m_EntryIndices.end() || m_Entries[indexIt->second].process.IsNull())
+    {
+    return;
+    }
+  Entry & entry = m_Entries[indexIt->second];
+  std::vector<Frame> & frames = m_Frames[std::this_thread::get_id()];
+
+  if(typeid(event) == typeid(itk::StartEvent))
+    {
+    ++entry.profile.numberOfCalls;
+    entry.profile.numberOfThreads = entry.process->GetNumberOfThreads();
+
+    Frame frame;
+    frame.entry = indexIt->second;
+    frame.wallStart = wallTime;
+    frame.cpuStart = cpuTime;
+    frame.childrenWallTime = 0.;
+    frame.childrenCPUTime = 0.;
+    frame.inputsAccounted = false;
+    frames.push_back(frame);
+    return;
+    }
+
+  if(typeid(event) != typeid(itk::EndEvent))
+    {
+    return;
+    }
+
+  // Find the frame of this process object. The frames above it belong
+  // to process objects interrupted by an exception.
+  std::vector<Frame>::reverse_iterator frameIt = frames.rbegin();
+  while(frameIt != frames.rend() && frameIt->entry != indexIt->second)
+    {
+    ++frameIt;
+    }
+  if(frameIt == frames.rend())
+    {
+    return;
+    }
+  const Frame frame = *frameIt;
+  frames.erase(frameIt.base() - 1, frames.end());
+
+  const double elapsedWallTime = wallTime - frame.wallStart;
+  const double elapsedCPUTime = cpuTime - frame.cpuStart;
+  entry.profile.wallTime += elapsedWallTime;
+  entry.profile.processCPUTime += elapsedCPUTime;
+  entry.profile.selfWallTime += std::max(0., elapsedWallTime - frame.childrenWallTime);
+  entry.profile.selfProcessCPUTime += std::max(0., elapsedCPUTime - frame.childrenCPUTime);
+
+  if(!frames.empty())
+    {
+    frames.back().childrenWallTime += elapsedWallTime;
+    frames.back().childrenCPUTime += elapsedCPUTime;
+    }
+
+  ProcessObjectType::DataObjectPointerArray outputs = entry.process->GetOutputs();
+  for(unsigned int i = 0; i < outputs.size(); ++i)
+    {
+    DataObjectType * output = outputs[i].GetPointer();
+    if(output == ITK_NULLPTR)
+      {
+      continue;
+      }
+    entry.profile.outputBytes += m_PrintCalculator->EvaluateDataObjectPrint(output);
+
+    itk::ImageBase<2> * image = dynamic_cast<itk::ImageBase<2> *>(output);
+    if(image != ITK_NULLPTR)
+      {
+      entry.profile.requestedPixels += image->GetRequestedRegion().GetNumberOfPixels();
+      entry.profile.largestPixels = image->GetLargestPossibleRegion().GetNumberOfPixels();
+      }
+
+    // Consumers updating their input while they run (writers) receive
+    // it here, once per update
+    ConsumerMapType::const_iterator consumersIt = m_Consumers.find(output);
+    if(consumersIt == m_Consumers.end())
+      {
+      continue;
+      }
+    for(std::vector<Frame>::iterator it = frames.begin(); it != frames.end(); ++it)
+      {
+      if(std::find(consumersIt->second.begin(), consumersIt->second.end(), it->entry)
+         != consumersIt->second.end())
+        {
+        this->AccountInput(m_Entries[it->entry], output);
+        it->inputsAccounted = true;
+        }
+      }
+    }
+
+  if(!frame.inputsAccounted)
+    {
+    ProcessObjectType::DataObjectPointerArray inputs = entry.process->GetInputs();
+    for(unsigned int i = 0; i < inputs.size(); ++i)
+      {
+      if(inputs[i].IsNotNull())
+        {
+        this->AccountInput(entry, inputs[i].GetPointer());
+        }
+      }
+    }
+}
+
+void
+PipelineProfiler
+::AccountInput(Entry & entry, DataObjectType * data)
+{
+  entry.profile.inputBytes += m_PrintCalculator->EvaluateDataObjectPrint(data);
+
+  // Process objects without image output are sinks: their pixels are
+  // the ones they consume
+  itk::ImageBase<2> * image = dynamic_cast<itk::ImageBase<2> *>(data);
+  if(!entry.hasImageOutput && image != ITK_NULLPTR)
+    {
+    entry.profile.requestedPixels += image->GetRequestedRegion().GetNumberOfPixels();
+    entry.profile.largestPixels = image->GetLargestPossibleRegion().GetNumberOfPixels();
+    }
+}
+
+void
+PipelineProfiler
+::WriteJSON(std::ostream & os) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  os << "{" << std::endl;
+  os << "  \"processObjects\": [";
+  for(unsigned int i = 0; i < m_Entries.size(); ++i)
+    {
+    const ProcessObjectProfile & profile = m_Entries[i].profile;
+    os << (i == 0 ? "" : ",") << std::endl;
+    os << "    {" << std::endl;
+    os << "      \"index\": " << i << "," << std::endl;
+    os << "      \"class\": \"" << JSONEscape(profile.className) << "\"," << std::endl;
+    os << "      \"name\": \"" << JSONEscape(profile.objectName) << "\"," << std::endl;
+    os << "      \"calls\": " << profile.numberOfCalls << "," << std::endl;
+    os << "      \"wallTime\": " << profile.wallTime << "," << std::endl;
+    os << "      \"selfWallTime\": " << profile.selfWallTime << "," << std::endl;
+    os << "      \"processCpuTime\": " << profile.processCPUTime << "," << std::endl;
+    os << "      \"selfProcessCpuTime\": " << profile.selfProcessCPUTime << "," << std::endl;
+    os << "      \"threads\": " << profile.numberOfThreads << "," << std::endl;
+    os << "      \"threadUtilization\": " << profile.GetThreadUtilization() << "," << std::endl;
+    os << "      \"requestedPixels\": " << profile.requestedPixels << "," << std::endl;
+    os << "      \"largestPixels\": " << profile.largestPixels << "," << std::endl;
+    os << "      \"inputBytes\": " << profile.inputBytes << "," << std::endl;
+    os << "      \"outputBytes\": " << profile.outputBytes << std::endl;
+    os << "    }";
+    }
+  os << std::endl << "  ]" << std::endl;
+  os << "}" << std::endl;
+}
+
+void
+PipelineProfiler
+::WriteCSV(std::ostream & os) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  os << "index,class,name,calls,wall_time,self_wall_time,process_cpu_time,self_process_cpu_time,"
+     << "threads,thread_utilization,requested_pixels,largest_pixels,input_bytes,output_bytes"
+     << std::endl;
+  for(unsigned int i = 0; i < m_Entries.size(); ++i)
+    {
+    const ProcessObjectProfile & profile = m_Entries[i].profile;
+    os << i << ","
+       << CSVQuote(profile.className) << ","
+       << CSVQuote(profile.objectName) << ","
+       << profile.numberOfCalls << ","
+       << profile.wallTime << ","
+       << profile.selfWallTime << ","
+       << profile.processCPUTime << ","
+       << profile.selfProcessCPUTime << ","
+       << profile.numberOfThreads << ","
+       << profile.GetThreadUtilization() << ","
+       << profile.requestedPixels << ","
+       << profile.largestPixels << ","
+       << profile.inputBytes << ","
+       << profile.outputBytes << std::endl;
+    }
+}
+
+void
+PipelineProfiler
+::WriteReport(const std::string & filename) const
+{
+  std::ofstream ofs(filename.c_str());
+  if(!ofs.is_open())
+    {
+    itkExceptionMacro(<< "Unable to open " << filename << " to write the profiles");
+    }
+
+  std::string extension;
+  const std::string::size_type dot = filename.rfind('.');
+  if(dot != std::string::npos)
+    {
+    extension = filename.substr(dot);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    }
+
+  if(extension == ".csv")
+    {
+    this->WriteCSV(ofs);
+    }
+  else
+    {
+    this->WriteJSON(ofs);
+    }
+}
+
+// [static]
+double
+PipelineProfiler
+::GetWallTime()
+{
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// [static]
+double
+PipelineProfiler
+::GetProcessCPUTime()
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if(!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+    {
+    return 0.;
+    }
+  ULARGE_INTEGER kernel, user;
+  kernel.LowPart = kernelTime.dwLowDateTime;
+  kernel.HighPart = kernelTime.dwHighDateTime;
+  user.LowPart = userTime.dwLowDateTime;
+  user.HighPart = userTime.dwHighDateTime;
+  // FILETIME counts 100 ns intervals
+  return (kernel.QuadPart + user.QuadPart) * 1e-7;
+#else
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+    return 0.;
+    }
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+    + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#endif
+}
+
+void
+PipelineProfiler
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  os << indent << "Number of observed process objects: " << m_Entries.size() << std::endl;
+  for(unsigned int i = 0; i < m_Entries.size(); ++i)
+    {
+    const ProcessObjectProfile & profile = m_Entries[i].profile;
+    os << indent << "  " << i << " " << profile.className << ": "
+       << profile.numberOfCalls << " calls, "
+       << profile.selfWallTime << " s (" << profile.wallTime << " s inclusive)" << std::endl;
+    }
+}
+
+} // end namespace otb
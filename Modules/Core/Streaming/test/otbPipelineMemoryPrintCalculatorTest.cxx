@@ -24,6 +24,7 @@
 #include "otbImage.h"
 #include "otbImageFileReader.h"
 #include "otbVectorImageToIntensityImageFilter.h"
+#include "otbRAMDrivenStrippedStreamingManager.h"
 
 int otbPipelineMemoryPrintCalculatorNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
 {
@@ -67,3 +68,98 @@ int otbPipelineMemoryPrintCalculatorTest(int itkNotUsed(argc), char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbPipelineMemoryPrintCalculatorMeasure(int itkNotUsed(argc), char * argv[])
+{
+  typedef otb::VectorImage<double, 2>            VectorImageType;
+  typedef otb::Image<double, 2>                  ImageType;
+  typedef otb::ImageFileReader<VectorImageType>  ReaderType;
+  typedef otb::VectorImageToIntensityImageFilter
+    <VectorImageType, ImageType>                 IntensityImageFilterType;
+  typedef otb::RAMDrivenStrippedStreamingManager<ImageType> StreamingManagerType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  IntensityImageFilterType::Pointer intensity = IntensityImageFilterType::New();
+  intensity->SetInput(reader->GetOutput());
+  intensity->UpdateOutputInformation();
+
+  // Measure the memory print of a probe region
+  ImageType::RegionType probe = intensity->GetOutput()->GetLargestPossibleRegion();
+  ImageType::SizeType   probeSize;
+  probeSize.Fill(256);
+  probe.SetSize(probeSize);
+  probe.Crop(intensity->GetOutput()->GetLargestPossibleRegion());
+  intensity->GetOutput()->SetRequestedRegion(probe);
+
+  otb::PipelineMemoryPrintCalculator::Pointer calculator = otb::PipelineMemoryPrintCalculator::New();
+  calculator->SetDataToWrite(intensity->GetOutput());
+  calculator->ResetMeasurements();
+  calculator->Measure();
+  std::cout << calculator << std::endl;
+
+  typedef otb::PipelineMemoryPrintCalculator::ProcessObjectMemoryPrintMapType PrintMapType;
+  const PrintMapType prints = calculator->GetMeasuredProcessObjectPrints();
+  if (prints.count(intensity.GetPointer()) == 0 || prints.count(reader.GetPointer()) == 0)
+    {
+    std::cerr << "The memory print of the filters was not measured" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The intensity filter allocates exactly the probe
+  const otb::PipelineMemoryPrintCalculator::MemoryPrintType expectedPrint =
+    probe.GetNumberOfPixels() * sizeof(ImageType::PixelType);
+  if (prints.find(intensity.GetPointer())->second != expectedPrint)
+    {
+    std::cerr << "The memory print of the intensity filter is "
+              << prints.find(intensity.GetPointer())->second
+              << " instead of " << expectedPrint << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The measures only depend on the region processed
+  calculator->ResetMeasurements();
+  intensity->GetOutput()->SetRequestedRegion(probe);
+  calculator->Measure();
+  if (calculator->GetMeasuredProcessObjectPrints() != prints)
+    {
+    std::cerr << "The memory prints of the filters changed from one measure to the other" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The probe buffers must have been released
+  if (intensity->GetOutput()->GetBufferedRegion().GetNumberOfPixels() != 0)
+    {
+    std::cerr << "The buffers of the measurement were not released" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Calibrate the number of divisions of a RAM driven streaming
+  StreamingManagerType::Pointer streamingManager = StreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(1);
+  streamingManager->SetMemoryCalibration(true);
+  streamingManager->PrepareStreaming(intensity->GetOutput(),
+                                     intensity->GetOutput()->GetLargestPossibleRegion());
+
+  std::cout << "Calibrated number of divisions: " << streamingManager->GetNumberOfSplits() << std::endl;
+  if (streamingManager->GetNumberOfSplits() == 0)
+    {
+    std::cerr << "Invalid number of divisions" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The layout of the divisions must not change between runs, as the
+  // journal of a resumable write relies on it
+  const unsigned int nbDivisions = streamingManager->GetNumberOfSplits();
+  streamingManager->PrepareStreaming(intensity->GetOutput(),
+                                     intensity->GetOutput()->GetLargestPossibleRegion());
+  if (streamingManager->GetNumberOfSplits() != nbDivisions)
+    {
+    std::cerr << "The calibrated number of divisions changed from " << nbDivisions
+              << " to " << streamingManager->GetNumberOfSplits() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbPipelineProfiler.h"
+
+#include "otbVectorImage.h"
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "otbVectorImageToIntensityImageFilter.h"
+
+int otbPipelineProfilerTest(int itkNotUsed(argc), char * argv[])
+{
+  typedef otb::VectorImage<double, 2>            VectorImageType;
+  typedef otb::Image<double, 2>                  ImageType;
+  typedef otb::ImageFileReader<VectorImageType>  ReaderType;
+  typedef otb::ImageFileWriter<ImageType>        WriterType;
+  typedef otb::VectorImageToIntensityImageFilter
+    <VectorImageType, ImageType>                 IntensityImageFilterType;
+  typedef otb::PipelineProfiler::ProcessObjectProfile ProfileType;
+
+  const unsigned int nbDivisions = 4;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  IntensityImageFilterType::Pointer intensity = IntensityImageFilterType::New();
+  intensity->SetInput(reader->GetOutput());
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(argv[2]);
+  writer->SetInput(intensity->GetOutput());
+  writer->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+
+  otb::PipelineProfiler::Pointer profiler = otb::PipelineProfiler::New();
+  profiler->Attach(writer);
+  // Attaching twice must not observe the filters twice
+  profiler->Attach(intensity);
+
+  if (profiler->GetNumberOfProcessObjects() != 3)
+    {
+    std::cerr << "Wrong number of observed process objects: "
+              << profiler->GetNumberOfProcessObjects() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  writer->Update();
+  std::cout << profiler << std::endl;
+
+  const ProfileType readerProfile = profiler->GetProfile(reader);
+  const ProfileType intensityProfile = profiler->GetProfile(intensity);
+  const ProfileType writerProfile = profiler->GetProfile(writer);
+
+  // The writer runs once and updates its input once per division
+  if (writerProfile.numberOfCalls != 1
+      || intensityProfile.numberOfCalls != nbDivisions
+      || readerProfile.numberOfCalls != nbDivisions)
+    {
+    std::cerr << "Wrong number of calls: writer " << writerProfile.numberOfCalls
+              << ", intensity " << intensityProfile.numberOfCalls
+              << ", reader " << readerProfile.numberOfCalls << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Streaming divisions do not overlap
+  const ImageType::RegionType largestRegion = intensity->GetOutput()->GetLargestPossibleRegion();
+  if (intensityProfile.requestedPixels != largestRegion.GetNumberOfPixels()
+      || intensityProfile.largestPixels != largestRegion.GetNumberOfPixels()
+      || writerProfile.requestedPixels != largestRegion.GetNumberOfPixels())
+    {
+    std::cerr << "Wrong number of pixels: requested " << intensityProfile.requestedPixels
+              << ", largest " << intensityProfile.largestPixels
+              << ", written " << writerProfile.requestedPixels << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Bytes written and bytes transmitted between the filters
+  if (writerProfile.inputBytes != largestRegion.GetNumberOfPixels() * sizeof(double)
+      || intensityProfile.outputBytes != writerProfile.inputBytes
+      || intensityProfile.inputBytes != readerProfile.outputBytes
+      || readerProfile.outputBytes == 0)
+    {
+    std::cerr << "Wrong number of bytes: read " << readerProfile.outputBytes
+              << ", intensity input " << intensityProfile.inputBytes
+              << ", intensity output " << intensityProfile.outputBytes
+              << ", written " << writerProfile.inputBytes << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The time of the writer includes the upstream pipeline
+  if (writerProfile.selfWallTime > writerProfile.wallTime
+      || writerProfile.wallTime < intensityProfile.wallTime + readerProfile.wallTime)
+    {
+    std::cerr << "Wrong wall times: writer " << writerProfile.selfWallTime
+              << " s (" << writerProfile.wallTime << " s inclusive), intensity "
+              << intensityProfile.wallTime << " s, reader " << readerProfile.wallTime << " s" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  profiler->WriteReport(argv[3]);
+  profiler->WriteReport(argv[4]);
+
+  profiler->Reset();
+  if (profiler->GetProfile(writer).numberOfCalls != 0)
+    {
+    std::cerr << "The profiles were not reset" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Detached filters are not profiled anymore
+  profiler->Detach();
+  intensity->Modified();
+  writer->Update();
+  if (profiler->GetProfile(intensity).numberOfCalls != 0)
+    {
+    std::cerr << "The filters are still observed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbStreamingImageMultiSinkVirtualWriter.h"
+
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbStreamingStatisticsVectorImageFilter.h"
+#include "otbStreamingMinMaxVectorImageFilter.h"
+#include "otbPipelineProfiler.h"
+
+#include <cmath>
+
+int otbStreamingImageMultiSinkVirtualWriter(int itkNotUsed(argc), char * argv[])
+{
+  typedef otb::VectorImage<double, 2>                                 ImageType;
+  typedef otb::ImageFileReader<ImageType>                             ReaderType;
+  typedef otb::StreamingImageMultiSinkVirtualWriter<ImageType>        MultiSinkWriterType;
+  typedef otb::PersistentStreamingStatisticsVectorImageFilter<ImageType> PersistentStatisticsType;
+  typedef otb::PersistentMinMaxVectorImageFilter<ImageType>           PersistentMinMaxType;
+  typedef otb::StreamingStatisticsVectorImageFilter<ImageType>        StatisticsType;
+  typedef otb::StreamingMinMaxVectorImageFilter<ImageType>            MinMaxType;
+
+  const unsigned int nbDivisions = 5;
+
+  // One pass through both filters
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  PersistentStatisticsType::Pointer statistics = PersistentStatisticsType::New();
+  PersistentMinMaxType::Pointer     minMax = PersistentMinMaxType::New();
+
+  MultiSinkWriterType::Pointer writer = MultiSinkWriterType::New();
+  writer->SetInput(reader->GetOutput());
+  writer->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+  writer->AddPersistentFilter(statistics.GetPointer());
+  writer->AddPersistentFilter(minMax.GetPointer());
+
+  otb::PipelineProfiler::Pointer profiler = otb::PipelineProfiler::New();
+  profiler->Attach(reader);
+
+  writer->Update();
+
+  // Reference: one decorator per statistic
+  ReaderType::Pointer refReader = ReaderType::New();
+  refReader->SetFileName(argv[1]);
+
+  StatisticsType::Pointer refStatistics = StatisticsType::New();
+  refStatistics->SetInput(refReader->GetOutput());
+  refStatistics->GetStreamer()->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+  refStatistics->Update();
+
+  MinMaxType::Pointer refMinMax = MinMaxType::New();
+  refMinMax->SetInput(refReader->GetOutput());
+  refMinMax->GetStreamer()->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+  refMinMax->Update();
+
+  bool ok = true;
+
+  const unsigned long nbReads = profiler->GetProfile(reader).numberOfCalls;
+  std::cout << "Reader updated " << nbReads << " times for " << nbDivisions << " divisions" << std::endl;
+  if (nbReads != nbDivisions)
+    {
+    std::cerr << "The input should be read once per division" << std::endl;
+    ok = false;
+    }
+
+  const unsigned int nbBands = reader->GetOutput()->GetNumberOfComponentsPerPixel();
+  for (unsigned int b = 0; b < nbBands; ++b)
+    {
+    if (minMax->GetMinimum()[b] != refMinMax->GetMinimum()[b]
+        || minMax->GetMaximum()[b] != refMinMax->GetMaximum()[b])
+      {
+      std::cerr << "Band " << b << ": min/max are " << minMax->GetMinimum()[b] << "/" << minMax->GetMaximum()[b]
+                << " instead of " << refMinMax->GetMinimum()[b] << "/" << refMinMax->GetMaximum()[b] << std::endl;
+      ok = false;
+      }
+    if (std::abs(statistics->GetMean()[b] - refStatistics->GetMean()[b]) > 1e-9
+        || statistics->GetMinimum()[b] != refStatistics->GetMinimum()[b]
+        || statistics->GetMaximum()[b] != refStatistics->GetMaximum()[b])
+      {
+      std::cerr << "Band " << b << ": mean is " << statistics->GetMean()[b]
+                << " instead of " << refStatistics->GetMean()[b] << std::endl;
+      ok = false;
+      }
+    }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -25,6 +25,8 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
+#include "itkExtractImageFilter.h"
 
 #include <fstream>
 
@@ -35,6 +37,7 @@ typedef otb::RAMDrivenStrippedStreamingManager<ImageType>     RAMDrivenStrippedS
 typedef otb::TileDimensionTiledStreamingManager<ImageType>    TileDimensionTiledStreamingManagerType;
 typedef otb::RAMDrivenTiledStreamingManager<ImageType>        RAMDrivenTiledStreamingManagerType;
 typedef otb::RAMDrivenAdaptativeStreamingManager<ImageType>        RAMDrivenAdaptativeStreamingManagerType;
+typedef otb::RAMDrivenBlockAlignedStreamingManager<ImageType>      RAMDrivenBlockAlignedStreamingManagerType;
 
 
 ImageType::Pointer makeImage(ImageType::RegionType region)
@@ -69,6 +72,9 @@ int otbStreamingManagerNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
   RAMDrivenAdaptativeStreamingManagerType::Pointer streamingManager5 = RAMDrivenAdaptativeStreamingManagerType::New();
   std::cout<<streamingManager5<<std::endl;
 
+  RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager6 = RAMDrivenBlockAlignedStreamingManagerType::New();
+  std::cout<<streamingManager6<<std::endl;
+
   return EXIT_SUCCESS;
 }
 
@@ -230,3 +236,55 @@ int otbRAMDrivenAdaptativeStreamingManager(int itkNotUsed(argc), char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbRAMDrivenBlockAlignedStreamingManager(int itkNotUsed(argc), char * argv[])
+{
+  std::ofstream outfile(argv[1]);
+
+  RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager = RAMDrivenBlockAlignedStreamingManagerType::New();
+
+  ImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, 10013);
+  region.SetSize(1, 5727);
+
+  // The block size must be found upstream of the streamed image
+  typedef itk::ExtractImageFilter<ImageType, ImageType> ExtractFilterType;
+  ExtractFilterType::Pointer extract = ExtractFilterType::New();
+  extract->SetInput(makeImage(region));
+  extract->SetExtractionRegion(region);
+  extract->UpdateOutputInformation();
+  extract->GetOutput()->SetMetaDataDictionary(itk::MetaDataDictionary());
+
+  streamingManager->SetAvailableRAMInMB(1);
+  streamingManager->PrepareStreaming( extract->GetOutput(), region );
+
+  if (streamingManager->GetBlockSize()[0] != 64 || streamingManager->GetBlockSize()[1] != 64)
+    {
+    std::cout << "Wrong block size : got " << streamingManager->GetBlockSize() << ", expected [64, 64]" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  unsigned int nbSplits = streamingManager->GetNumberOfSplits();
+  outfile << "Number of splits: " << nbSplits << std::endl;
+
+  for (unsigned int i = 0; i < nbSplits; ++i)
+    {
+    ImageType::RegionType split = streamingManager->GetSplit(i);
+    outfile << split << std::endl;
+
+    for (unsigned int dim = 0; dim < 2; ++dim)
+      {
+      const long end = split.GetIndex()[dim] + static_cast<long>(split.GetSize()[dim]);
+      if (split.GetIndex()[dim] % 64 != 0
+          || (end % 64 != 0 && end != static_cast<long>(region.GetSize()[dim])))
+        {
+        std::cout << "Split " << i << " is not aligned on the blocks: " << split << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -28,6 +28,10 @@ void RegisterTests()
   REGISTER_TEST(otbTileDimensionTiledStreamingManager);
   REGISTER_TEST(otbRAMDrivenTiledStreamingManager);
   REGISTER_TEST(otbRAMDrivenAdaptativeStreamingManager);
+  REGISTER_TEST(otbRAMDrivenBlockAlignedStreamingManager);
   REGISTER_TEST(otbPipelineMemoryPrintCalculatorTest);
   REGISTER_TEST(otbPipelineMemoryPrintCalculatorNew);
+  REGISTER_TEST(otbPipelineMemoryPrintCalculatorMeasure);
+  REGISTER_TEST(otbPipelineProfilerTest);
+  REGISTER_TEST(otbStreamingImageMultiSinkVirtualWriter);
 }
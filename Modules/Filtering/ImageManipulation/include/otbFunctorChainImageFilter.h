@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFunctorChainImageFilter_h
+#define otbFunctorChainImageFilter_h
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkNumericTraits.h"
+
+namespace otb
+{
+namespace Functor
+{
+/** \class FunctorChain
+ *  \brief Compose a list of functors into a single functor.
+ *
+ * The functors are applied in the order of the template parameters:
+ * FunctorChain<F1, F2, F3> computes F3(F2(F1(x))). The composition is
+ * resolved at compile time, so that the calls can be inlined and the
+ * intermediate values never leave the registers (or the stack for
+ * variable length pixels).
+ *
+ * The functors are default constructed, and configured through
+ * GetNthFunctor<N>().
+ *
+ * GetOutputSize() tells the number of components of the result from
+ * the number of components of the input: functors exposing a
+ * GetOutputSize() method are asked for it, the others are expected to
+ * keep the number of components of their input.
+ *
+ * \sa FunctorChainImageFilter
+ *
+ * \ingroup OTBImageManipulation
+ */
+template <class... TFunctors>
+class FunctorChain
+{
+public:
+  typedef std::tuple<TFunctors...> FunctorTupleType;
+
+  /** Number of functors in the chain */
+  static const unsigned int NumberOfFunctors = sizeof...(TFunctors);
+
+  FunctorChain() {}
+  virtual ~FunctorChain() {}
+
+  /** Get the Nth functor of the chain */
+  template <unsigned int N>
+  typename std::tuple_element<N, FunctorTupleType>::type & GetNthFunctor()
+  {
+    return std::get<N>(m_Functors);
+  }
+
+  template <unsigned int N>
+  const typename std::tuple_element<N, FunctorTupleType>::type & GetNthFunctor() const
+  {
+    return std::get<N>(m_Functors);
+  }
+
+  /** Number of components of the result, given the number of
+   * components of the input */
+  unsigned int GetOutputSize(unsigned int inputSize)
+  {
+    return this->ChainOutputSize(inputSize, std::index_sequence_for<TFunctors...>());
+  }
+
+  // main computation method
+  template <class TInput>
+  inline auto operator ()(const TInput& x)
+  {
+    return this->template Apply<0>(x, IsLast<0>());
+  }
+
+private:
+  static_assert(sizeof...(TFunctors) > 0, "FunctorChain needs at least one functor");
+
+  template <unsigned int N>
+  using IsLast = std::integral_constant<bool, N + 1 == sizeof...(TFunctors)>;
+
+  template <unsigned int N, class TValue>
+  inline auto Apply(const TValue& x, std::true_type)
+  {
+    return std::get<N>(m_Functors)(x);
+  }
+
+  template <unsigned int N, class TValue>
+  inline auto Apply(const TValue& x, std::false_type)
+  {
+    return this->template Apply<N + 1>(std::get<N>(m_Functors)(x), IsLast<N + 1>());
+  }
+
+  /** Output size of a functor providing GetOutputSize() */
+  template <class TFunctor>
+  static auto StageOutputSize(TFunctor& functor, unsigned int, int)
+    -> decltype(static_cast<unsigned int>(functor.GetOutputSize()))
+  {
+    return static_cast<unsigned int>(functor.GetOutputSize());
+  }
+
+  /** Output size of the other functors */
+  template <class TFunctor>
+  static unsigned int StageOutputSize(TFunctor&, unsigned int inputSize, long)
+  {
+    return inputSize;
+  }
+
+  template <std::size_t... N>
+  unsigned int ChainOutputSize(unsigned int size, std::index_sequence<N...>)
+  {
+    // The elements of a braced list are evaluated in order
+    const unsigned int sizes[] = {(size = StageOutputSize(std::get<N>(m_Functors), size, 0))...};
+    (void)sizes;
+    return size;
+  }
+
+  FunctorTupleType m_Functors;
+};
+
+/** \class PerBandFunctor
+ *  \brief Apply a scalar functor to each component of a variable length pixel.
+ *
+ * One functor is held per band, so that each band can have its own
+ * parameters, like in UnaryImageFunctorWithVectorImageFilter. A
+ * FunctorChain of scalar functors can be used to apply several per
+ * band transforms at once without building the intermediate pixels.
+ *
+ * As in UnaryImageFunctorWithVectorImageFilter, a null input pixel
+ * carries no sensor information and gives a null output pixel.
+ *
+ * TInput and TOutput type are supposed to be of type itk::VariableLengthVector.
+ *
+ * \sa UnaryImageFunctorWithVectorImageFilter
+ *
+ * \ingroup OTBImageManipulation
+ */
+template <class TInput, class TOutput, class TBandFunctor>
+class PerBandFunctor
+{
+public:
+  typedef typename TInput::ValueType  InputValueType;
+  typedef typename TOutput::ValueType OutputValueType;
+  typedef TBandFunctor                BandFunctorType;
+  typedef std::vector<TBandFunctor>   FunctorVectorType;
+
+  PerBandFunctor() {}
+  virtual ~PerBandFunctor() {}
+
+  /** Get the functor list, one functor per band */
+  FunctorVectorType& GetFunctorVector()
+  {
+    return m_FunctorVector;
+  }
+
+  const FunctorVectorType& GetFunctorVector() const
+  {
+    return m_FunctorVector;
+  }
+
+  void SetFunctorVector(const FunctorVectorType& functors)
+  {
+    m_FunctorVector = functors;
+  }
+
+  // main computation method
+  inline TOutput operator ()(const TInput& x)
+  {
+    const unsigned int size = x.GetSize();
+
+    if (m_FunctorVector.size() < size)
+      {
+      itkGenericExceptionMacro(<< "Pixel size greater than the number of band functors !");
+      }
+
+    TOutput result(size);
+    result.Fill(itk::NumericTraits<OutputValueType>::ZeroValue());
+
+    unsigned int firstNonNull = 0;
+    while (firstNonNull < size && x[firstNonNull] == itk::NumericTraits<InputValueType>::ZeroValue())
+      {
+      ++firstNonNull;
+      }
+
+    if (firstNonNull < size)
+      {
+      for (unsigned int i = 0; i < size; ++i)
+        {
+        result[i] = static_cast<OutputValueType>(m_FunctorVector[i](x[i]));
+        }
+      }
+    return result;
+  }
+
+private:
+  FunctorVectorType m_FunctorVector;
+};
+} // End namespace Functor
+
+/** \class FunctorChainImageFilter
+ *  \brief Apply a chain of per pixel functors in a single pass.
+ *
+ * A pipeline of per pixel filters (UnaryFunctorImageFilter,
+ * UnaryImageFunctorWithVectorImageFilter, ShiftScaleVectorImageFilter,
+ * VectorRescaleIntensityImageFilter, ...) allocates and walks one
+ * intermediate buffer per filter. This filter composes the functors of
+ * such filters with Functor::FunctorChain and applies them in one
+ * ThreadedGenerateData(), without any intermediate buffer.
+ *
+ * The functors are applied in the order of the template parameters.
+ * The input of the first one is the input pixel, the result of the
+ * last one is converted to the output pixel type. They are accessed
+ * through GetNthFunctor<N>(); as with GetFunctor(), Modified() must be
+ * called if a functor is changed after an update.
+ *
+ * The number of components of the output is computed by
+ * Functor::FunctorChain::GetOutputSize().
+ *
+ * Per band functors, such as the ones of the radiometric calibration
+ * filters, are wrapped in a Functor::PerBandFunctor. Filters deriving
+ * from UnaryImageFunctorWithVectorImageFilter can set up their functor
+ * list with InitializeFunctorVector() to feed it.
+ *
+ * \sa Functor::FunctorChain
+ * \sa Functor::PerBandFunctor
+ * \ingroup IntensityImageFilters
+ * \ingroup MultiThreaded
+ *
+ * \ingroup OTBImageManipulation
+ */
+template <class TInputImage, class TOutputImage, class... TFunctors>
+class ITK_EXPORT FunctorChainImageFilter :
+    public itk::UnaryFunctorImageFilter<TInputImage, TOutputImage,
+                                        Functor::FunctorChain<TFunctors...> >
+{
+public:
+  /** Standard class typedefs. */
+  typedef FunctorChainImageFilter                                      Self;
+  typedef Functor::FunctorChain<TFunctors...>                          FunctorType;
+  typedef itk::UnaryFunctorImageFilter<TInputImage, TOutputImage,
+                                       FunctorType>                    Superclass;
+  typedef itk::SmartPointer<Self>                                      Pointer;
+  typedef itk::SmartPointer<const Self>                                ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(FunctorChainImageFilter, itk::UnaryFunctorImageFilter);
+
+  /** Get the Nth functor of the chain */
+  template <unsigned int N>
+  typename std::tuple_element<N, typename FunctorType::FunctorTupleType>::type & GetNthFunctor()
+  {
+    return this->GetFunctor().template GetNthFunctor<N>();
+  }
+
+protected:
+  FunctorChainImageFilter() {}
+  ~FunctorChainImageFilter() ITK_OVERRIDE {}
+
+  /** Generate output information */
+  void GenerateOutputInformation(void) ITK_OVERRIDE
+  {
+    Superclass::GenerateOutputInformation();
+
+    const TInputImage * inputPtr = this->GetInput();
+    if (inputPtr != ITK_NULLPTR)
+      {
+      this->GetOutput()->SetNumberOfComponentsPerPixel(
+        this->GetFunctor().GetOutputSize(inputPtr->GetNumberOfComponentsPerPixel()));
+      }
+  }
+
+private:
+  FunctorChainImageFilter(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+};
+
+} // end namespace otb
+
+#endif
@@ -205,6 +205,13 @@ public:
   
   void Synthetize(void) ITK_OVERRIDE;
 
+  /** The pixels shrunk by all the processes are gathered in
+   * Synthetize() */
+  bool IsDistributable() const ITK_OVERRIDE
+  {
+    return true;
+  }
+
   void Reset(void) ITK_OVERRIDE;
 
   itkSetMacro(ShrinkFactor, unsigned int);
@@ -236,6 +243,9 @@ private:
   PersistentShrinkImageFilter(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
+  /** Number of components in the buffer of the shrunk image */
+  size_t GetShrunkOutputBufferSize() const;
+
   /* the output shrunk image */
   OutputImagePointer m_ShrunkOutput;
 
@@ -26,6 +26,8 @@
 #include "otbMacro.h"
 #include "itkProgressReporter.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
@@ -162,6 +164,15 @@ PersistentShrinkImageFilter<TInputImage, TOutputImage>
 
   m_ShrunkOutput->SetRegions(shrunkOutputLargestPossibleRegion);
   m_ShrunkOutput->Allocate();
+
+  // Each pixel is set by one process only: the others leave it to zero
+  // so that the shrunk images can be summed in Synthetize()
+  if (this->GetReducer())
+    {
+    std::fill(m_ShrunkOutput->GetBufferPointer(),
+              m_ShrunkOutput->GetBufferPointer() + this->GetShrunkOutputBufferSize(),
+              0);
+    }
 }
 
 template<class TInputImage, class TOutputImage>
@@ -169,6 +180,20 @@ void
 PersistentShrinkImageFilter<TInputImage, TOutputImage>
 ::Synthetize()
 {
+  if (DistributedReducer * reducer = this->GetReducer())
+    {
+    reducer->AllReduce(m_ShrunkOutput->GetBufferPointer(), this->GetShrunkOutputBufferSize(),
+                       DistributedReducer::SUM);
+    }
+}
+
+template<class TInputImage, class TOutputImage>
+size_t
+PersistentShrinkImageFilter<TInputImage, TOutputImage>
+::GetShrunkOutputBufferSize() const
+{
+  return static_cast<size_t>(m_ShrunkOutput->GetLargestPossibleRegion().GetNumberOfPixels())
+    * m_ShrunkOutput->GetNumberOfComponentsPerPixel();
 }
 
 template<class TInputImage, class TOutputImage>
@@ -87,6 +87,15 @@ public:
     return m_FunctorVector;
   }
 
+  /** Set up the functor list as it is done before processing, so that
+   * the functors can be applied by another filter (see
+   * FunctorChainImageFilter). The output information must be up to
+   * date. */
+  void InitializeFunctorVector()
+  {
+    this->BeforeThreadedGenerateData();
+  }
+
 protected:
   UnaryImageFunctorWithVectorImageFilter();
   ~UnaryImageFunctorWithVectorImageFilter() ITK_OVERRIDE {}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+
+#include "otbFunctorChainImageFilter.h"
+#include "otbUnaryImageFunctorWithVectorImageFilter.h"
+#include "otbShiftScaleVectorImageFilter.h"
+#include "otbVectorRescaleIntensityImageFilter.h"
+#include "otbMultiplyByScalarImageFilter.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+
+int otbFunctorChainImageFilter(int itkNotUsed(argc), char * argv[])
+{
+  const char * inputFileName  = argv[1];
+  const char * outputFileName = argv[2];
+
+  typedef otb::VectorImage<double, 2>                                    ImageType;
+  typedef ImageType::PixelType                                           PixelType;
+  typedef otb::ImageFileReader<ImageType>                                ReaderType;
+  typedef otb::ImageFileWriter<ImageType>                                WriterType;
+
+  typedef otb::Functor::MultiplyByScalar<double, double>                 BandFunctorType;
+  typedef otb::UnaryImageFunctorWithVectorImageFilter<ImageType, ImageType,
+                                                      BandFunctorType>   MultiplyFilterType;
+  typedef otb::ShiftScaleVectorImageFilter<ImageType, ImageType>         ShiftScaleFilterType;
+  typedef otb::VectorRescaleIntensityImageFilter<ImageType, ImageType>   RescaleFilterType;
+
+  typedef otb::FunctorChainImageFilter<ImageType, ImageType,
+    otb::Functor::PerBandFunctor<PixelType, PixelType, BandFunctorType>,
+    ShiftScaleFilterType::FunctorType,
+    RescaleFilterType::FunctorType>                                      FusedFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFileName);
+  reader->UpdateOutputInformation();
+
+  const unsigned int nbComp = reader->GetOutput()->GetNumberOfComponentsPerPixel();
+
+  PixelType shift(nbComp), scale(nbComp), inMin(nbComp), inMax(nbComp), outMin(nbComp), outMax(nbComp);
+  std::vector<BandFunctorType> bandFunctors(nbComp);
+  for (unsigned int i = 0; i < nbComp; ++i)
+    {
+    bandFunctors[i].SetCoef(0.5 + i);
+    shift[i] = 10. * i;
+    scale[i] = 2.;
+    inMin[i] = 5.;
+    inMax[i] = 100.;
+    }
+  outMin.Fill(0.);
+  outMax.Fill(255.);
+
+  // Reference: one filter per functor
+  MultiplyFilterType::Pointer multiply = MultiplyFilterType::New();
+  multiply->SetInput(reader->GetOutput());
+  multiply->UpdateOutputInformation();
+  multiply->GetFunctorVector() = bandFunctors;
+
+  ShiftScaleFilterType::Pointer shiftScale = ShiftScaleFilterType::New();
+  shiftScale->SetInput(multiply->GetOutput());
+  shiftScale->SetShift(shift);
+  shiftScale->SetScale(scale);
+
+  RescaleFilterType::Pointer rescale = RescaleFilterType::New();
+  rescale->SetInput(shiftScale->GetOutput());
+  rescale->AutomaticInputMinMaxComputationOff();
+  rescale->SetInputMinimum(inMin);
+  rescale->SetInputMaximum(inMax);
+  rescale->SetOutputMinimum(outMin);
+  rescale->SetOutputMaximum(outMax);
+  rescale->Update();
+
+  // Same functors applied in a single pass
+  FusedFilterType::Pointer fused = FusedFilterType::New();
+  fused->SetInput(reader->GetOutput());
+  fused->GetNthFunctor<0>().SetFunctorVector(bandFunctors);
+  fused->GetNthFunctor<1>().SetShiftValues(shift);
+  fused->GetNthFunctor<1>().SetScaleValues(scale);
+  fused->GetNthFunctor<2>().SetInputMinimum(inMin);
+  fused->GetNthFunctor<2>().SetInputMaximum(inMax);
+  fused->GetNthFunctor<2>().SetOutputMinimum(outMin);
+  fused->GetNthFunctor<2>().SetOutputMaximum(outMax);
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(outputFileName);
+  writer->SetInput(fused->GetOutput());
+  writer->Update();
+
+  if (fused->GetOutput()->GetNumberOfComponentsPerPixel() != nbComp)
+    {
+    std::cerr << "Wrong number of components: " << fused->GetOutput()->GetNumberOfComponentsPerPixel()
+              << " instead of " << nbComp << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  itk::ImageRegionConstIterator<ImageType> refIt(rescale->GetOutput(), rescale->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> fusedIt(fused->GetOutput(), fused->GetOutput()->GetLargestPossibleRegion());
+
+  for (refIt.GoToBegin(), fusedIt.GoToBegin(); !refIt.IsAtEnd(); ++refIt, ++fusedIt)
+    {
+    if (refIt.Get() != fusedIt.Get())
+      {
+      std::cerr << "Pixel " << refIt.GetIndex() << ": fused value " << fusedIt.Get()
+                << " differs from the filter pipeline value " << refIt.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
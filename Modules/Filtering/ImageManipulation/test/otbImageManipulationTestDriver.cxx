@@ -35,6 +35,7 @@ void RegisterTests()
   REGISTER_TEST(otbUnaryFunctorWithIndexImageFilterNew);
   REGISTER_TEST(otbUnaryFunctorImageFilterNew);
   REGISTER_TEST(otbUnaryImageFunctorWithVectorImageFilter);
+  REGISTER_TEST(otbFunctorChainImageFilter);
   REGISTER_TEST(otbImageToVectorImageCastFilterNew);
   REGISTER_TEST(otbPrintableImageFilterWithMask);
   REGISTER_TEST(otbStreamingResampleImageFilter);
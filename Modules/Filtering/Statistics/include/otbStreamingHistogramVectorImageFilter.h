@@ -178,6 +178,12 @@ public:
   void AllocateOutputs() ITK_OVERRIDE;
   void GenerateOutputInformation() ITK_OVERRIDE;
   void Synthetize(void) ITK_OVERRIDE;
+
+  /** The frequencies of all the processes are summed in Synthetize() */
+  bool IsDistributable() const ITK_OVERRIDE
+  {
+    return true;
+  }
   void Reset(void) ITK_OVERRIDE;
 
 protected:
@@ -227,6 +227,33 @@ PersistentHistogramVectorImageFilter<TInputImage>
         }
       }
     }
+
+  // Sum the frequencies of the processes sharing the streaming
+  if (DistributedReducer * reducer = this->GetReducer())
+    {
+    for (unsigned int j = 0; j < numberOfComponent; ++j)
+      {
+      HistogramType* outHisto = outputHisto->GetNthElement(j);
+
+      std::vector<double> frequencies;
+      frequencies.reserve(outHisto->Size());
+      for (typename HistogramType::Iterator it = outHisto->Begin(); it != outHisto->End(); ++it)
+        {
+        frequencies.push_back(static_cast<double>(it.GetFrequency()));
+        }
+
+      if (!frequencies.empty())
+        {
+        reducer->AllReduce(&frequencies[0], frequencies.size(), DistributedReducer::SUM);
+        }
+
+      std::vector<double>::const_iterator frequency = frequencies.begin();
+      for (typename HistogramType::Iterator it = outHisto->Begin(); it != outHisto->End(); ++it, ++frequency)
+        {
+        it.SetFrequency(static_cast<typename HistogramType::AbsoluteFrequencyType>(*frequency));
+        }
+      }
+    }
 }
 
 template<class TInputImage>
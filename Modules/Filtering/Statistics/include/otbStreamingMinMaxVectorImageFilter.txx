@@ -197,6 +197,13 @@ PersistentMinMaxVectorImageFilter<TInputImage>
       }
     } // end for( i = 0; i < numberOfThreads; ++i)
 
+  // Combine the results of the processes sharing the streaming
+  if (DistributedReducer * reducer = this->GetReducer())
+    {
+    reducer->AllReduce(minimumVector, DistributedReducer::MIN);
+    reducer->AllReduce(maximumVector, DistributedReducer::MAX);
+    }
+
   // Set the outputs
   this->GetMinimumOutput()->Set(minimumVector);
   this->GetMaximumOutput()->Set(maximumVector);
@@ -151,6 +151,13 @@ public:
   void AllocateOutputs() ITK_OVERRIDE;
   void GenerateOutputInformation() ITK_OVERRIDE;
   void Synthetize(void) ITK_OVERRIDE;
+
+  /** The counts, sums and extrema of all the processes are combined in
+   * Synthetize() */
+  bool IsDistributable() const ITK_OVERRIDE
+  {
+    return true;
+  }
   void Reset(void) ITK_OVERRIDE;
 
   itkSetMacro(IgnoreInfiniteValues, bool);
@@ -268,6 +268,17 @@ PersistentStatisticsImageFilter<TInputImage>
       maximum = m_ThreadMax[i];
       }
     }
+
+  // Combine the results of the processes sharing the streaming
+  if (DistributedReducer * reducer = this->GetReducer())
+    {
+    reducer->AllReduce(count, DistributedReducer::SUM);
+    reducer->AllReduce(sum, DistributedReducer::SUM);
+    reducer->AllReduce(sumOfSquares, DistributedReducer::SUM);
+    reducer->AllReduce(minimum, DistributedReducer::MIN);
+    reducer->AllReduce(maximum, DistributedReducer::MAX);
+    }
+
   if (count > 0)
     {
     // compute statistics
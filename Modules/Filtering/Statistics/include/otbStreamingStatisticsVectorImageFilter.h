@@ -192,6 +192,12 @@ public:
 
   void Synthetize(void) ITK_OVERRIDE;
 
+  /** The accumulators of all the processes are combined in Synthetize() */
+  bool IsDistributable() const ITK_OVERRIDE
+  {
+    return true;
+  }
+
   itkSetMacro(EnableMinMax, bool);
   itkGetMacro(EnableMinMax, bool);
 
@@ -433,6 +433,28 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
     ignoredUserPixelCount += m_IgnoredUserPixelCount[threadId];
     }
 
+  // Combine the results of the processes sharing the streaming
+  if (DistributedReducer * reducer = this->GetReducer())
+    {
+    if (m_EnableMinMax)
+      {
+      reducer->AllReduce(minimum, DistributedReducer::MIN);
+      reducer->AllReduce(maximum, DistributedReducer::MAX);
+      }
+    if (m_EnableFirstOrderStats)
+      {
+      reducer->AllReduce(streamFirstOrderAccumulator, DistributedReducer::SUM);
+      reducer->AllReduce(streamFirstOrderComponentAccumulator, DistributedReducer::SUM);
+      }
+    if (m_EnableSecondOrderStats)
+      {
+      reducer->AllReduce(streamSecondOrderAccumulator, DistributedReducer::SUM);
+      reducer->AllReduce(streamSecondOrderComponentAccumulator, DistributedReducer::SUM);
+      }
+    reducer->AllReduce(ignoredInfinitePixelCount, DistributedReducer::SUM);
+    reducer->AllReduce(ignoredUserPixelCount, DistributedReducer::SUM);
+    }
+
   // There cannot be more ignored pixels than read pixels.
   assert( nbPixels >= ignoredInfinitePixelCount + ignoredUserPixelCount );
   if( nbPixels < ignoredInfinitePixelCount + ignoredUserPixelCount )
@@ -42,6 +42,11 @@ namespace otb
  *             - a range of bands : '3:' means 3rd band until the last one
  *                 ':-2' means the first bands until the second to last
  *                 '2:4' means bands 2,3 and 4
+ * - &readthreads : number of threads decoding the native blocks of the
+ *           requested region concurrently (GDAL only), 0 meaning the
+ *           default number of threads
+ * - &readahead : switch to read the next streaming region from a
+ *           background thread while the current one is processed
  *
  *  \sa ImageFileReader
  *
@@ -75,6 +80,8 @@ public:
     std::pair< bool, bool         >  skipGeom;
     std::pair< bool, bool         >  skipRpcTag;
     std::pair< bool, std::string  >  bandRange;
+    std::pair< bool, unsigned int >  readThreads;
+    std::pair< bool, bool         >  readAhead;
     std::vector<std::string>         optionList;
   };
 
@@ -99,6 +106,11 @@ public:
   /** Test if band range extended filename is set */
   bool BandRangeIsSet () const;
 
+  bool ReadThreadsIsSet () const;
+  unsigned int GetReadThreads () const;
+  bool ReadAheadIsSet () const;
+  bool GetReadAhead () const;
+
 protected:
   ExtendedFilenameToReaderOptions();
   ~ExtendedFilenameToReaderOptions() ITK_OVERRIDE {}
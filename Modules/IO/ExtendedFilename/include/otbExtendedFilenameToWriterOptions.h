@@ -35,6 +35,13 @@ namespace otb
  * - &gdal:co:<KEY>=<VALUE> : the gdal creation option <KEY>
  * - streaming modes
  * - box
+ * - &asyncwrite=<N> : write the divisions from a dedicated I/O thread,
+ *   with at most N buffers waiting to be written
+ * - &overviews=<N> : write N internal overview levels along with the
+ *   image (GTiff only)
+ * - &overviews:method=<average|nearest> : resampling of the overviews
+ * - &resume=ON : record the divisions written in a journal, and only
+ *   write the remaining ones if an interrupted write is run again
  * See http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName
  *
  *  \sa ImageFileWriter
@@ -73,6 +80,10 @@ public:
     std::pair<bool,  double>                     streamingSizeValue;
     std::pair<bool,  std::string>                box;
     std::pair< bool, std::string>                bandRange;
+    std::pair< bool, unsigned int>               asyncWrite;
+    std::pair< bool, unsigned int>               overviews;
+    std::pair< bool, std::string>                overviewsMethod;
+    std::pair< bool, bool>                       resume;
     std::vector<std::string>                     optionList;
   };
 
@@ -100,6 +111,25 @@ public:
   /** Test if band range extended filename is set */
   bool BandRangeIsSet () const;
 
+  /** Test if asynchronous writing is set */
+  bool AsyncWriteIsSet () const;
+  /** Get the number of buffers to queue for asynchronous writing */
+  unsigned int GetAsyncWrite () const;
+
+  /** Test if the number of overviews to write is set */
+  bool OverviewsIsSet () const;
+  /** Get the number of overviews written along with the image */
+  unsigned int GetOverviews () const;
+  /** Test if the resampling method of the overviews is set */
+  bool OverviewsMethodIsSet () const;
+  /** Get the resampling method of the overviews (average or nearest) */
+  std::string GetOverviewsMethod () const;
+
+  /** Test if the resumable write is set */
+  bool ResumeIsSet () const;
+  /** Get whether an interrupted write is resumed */
+  bool GetResume () const;
+
 protected:
   ExtendedFilenameToWriterOptions();
   ~ExtendedFilenameToWriterOptions() ITK_OVERRIDE {}
@@ -52,6 +52,12 @@ ExtendedFilenameToReaderOptions
   m_Options.bandRange.first = false;
   m_Options.bandRange.second = "";
 
+  m_Options.readThreads.first  = false;
+  m_Options.readThreads.second = 1;
+
+  m_Options.readAhead.first  = false;
+  m_Options.readAhead.second = false;
+
   m_Options.optionList.push_back("geom");
   m_Options.optionList.push_back("sdataidx");
   m_Options.optionList.push_back("resol");
@@ -59,6 +65,8 @@ ExtendedFilenameToReaderOptions
   m_Options.optionList.push_back("skipgeom");
   m_Options.optionList.push_back("skiprpctag");
   m_Options.optionList.push_back("bands");
+  m_Options.optionList.push_back("readthreads");
+  m_Options.optionList.push_back("readahead");
 }
 
 void
@@ -145,6 +153,31 @@ ExtendedFilenameToReaderOptions
       }
     }
 
+  if (!map["readthreads"].empty())
+    {
+    int readThreads = atoi(map["readthreads"].c_str());
+    if (readThreads < 0)
+      {
+      itkExceptionMacro("Invalid value "<<map["readthreads"]<<" for readthreads. Expect a positive number of threads (0 for the default number of threads)");
+      }
+    m_Options.readThreads.first  = true;
+    m_Options.readThreads.second = static_cast<unsigned int>(readThreads);
+    }
+
+  if (!map["readahead"].empty())
+    {
+    m_Options.readAhead.first = true;
+    if (   map["readahead"] == "On"
+        || map["readahead"] == "on"
+        || map["readahead"] == "ON"
+        || map["readahead"] == "true"
+        || map["readahead"] == "True"
+        || map["readahead"] == "1"   )
+      {
+      m_Options.readAhead.second = true;
+      }
+    }
+
   //Option Checking
   MapIteratorType it;
   for ( it=map.begin(); it != map.end(); it++ )
@@ -259,4 +292,32 @@ ExtendedFilenameToReaderOptions
   return m_Options.bandRange.second;
 }
 
+bool
+ExtendedFilenameToReaderOptions
+::ReadThreadsIsSet () const
+{
+  return m_Options.readThreads.first;
+}
+
+unsigned int
+ExtendedFilenameToReaderOptions
+::GetReadThreads () const
+{
+  return m_Options.readThreads.second;
+}
+
+bool
+ExtendedFilenameToReaderOptions
+::ReadAheadIsSet () const
+{
+  return m_Options.readAhead.first;
+}
+
+bool
+ExtendedFilenameToReaderOptions
+::GetReadAhead () const
+{
+  return m_Options.readAhead.second;
+}
+
 } // end namespace otb
@@ -46,6 +46,18 @@ ExtendedFilenameToWriterOptions
   m_Options.bandRange.first = false;
   m_Options.bandRange.second = "";
 
+  m_Options.asyncWrite.first = false;
+  m_Options.asyncWrite.second = 0;
+
+  m_Options.overviews.first = false;
+  m_Options.overviews.second = 0;
+
+  m_Options.overviewsMethod.first = false;
+  m_Options.overviewsMethod.second = "average";
+
+  m_Options.resume.first = false;
+  m_Options.resume.second = false;
+
   m_Options.optionList.push_back("writegeom");
   m_Options.optionList.push_back("writerpctags");
   m_Options.optionList.push_back("streaming:type");
@@ -53,6 +65,10 @@ ExtendedFilenameToWriterOptions
   m_Options.optionList.push_back("streaming:sizevalue");
   m_Options.optionList.push_back("box");
   m_Options.optionList.push_back("bands");
+  m_Options.optionList.push_back("asyncwrite");
+  m_Options.optionList.push_back("overviews");
+  m_Options.optionList.push_back("overviews:method");
+  m_Options.optionList.push_back("resume");
 }
 
 void
@@ -108,11 +124,26 @@ ExtendedFilenameToWriterOptions
        }
      }
   
+  if (!map["resume"].empty())
+     {
+     m_Options.resume.first = true;
+     if (   map["resume"] == "On"
+         || map["resume"] == "on"
+         || map["resume"] == "ON"
+         || map["resume"] == "true"
+         || map["resume"] == "True"
+         || map["resume"] == "1"   )
+       {
+       m_Options.resume.second = true;
+       }
+     }
+
   if(!map["streaming:type"].empty())
     {
     if(map["streaming:type"] == "auto"
        || map["streaming:type"] == "tiled"
        || map["streaming:type"] == "stripped"
+       || map["streaming:type"] == "blocks"
        || map["streaming:type"] == "none")
       {
       m_Options.streamingType.first=true;
@@ -120,7 +151,7 @@ ExtendedFilenameToWriterOptions
       }
     else
       {
-      itkWarningMacro("Unkwown value "<<map["streaming:type"]<<" for streaming:type option. Available values are auto,tiled,stripped.");
+      itkWarningMacro("Unkwown value "<<map["streaming:type"]<<" for streaming:type option. Available values are auto,tiled,stripped,blocks,none.");
       }
     }
 
@@ -178,6 +209,50 @@ ExtendedFilenameToWriterOptions
       }
     }
 
+  if (!map["asyncwrite"].empty())
+    {
+    itksys::RegularExpression reg;
+    reg.compile("^[0-9]+$");
+    if (reg.find(map["asyncwrite"]))
+      {
+      m_Options.asyncWrite.first = true;
+      m_Options.asyncWrite.second = atoi(map["asyncwrite"].c_str());
+      }
+    else
+      {
+      itkWarningMacro("Unkwown value "<<map["asyncwrite"]<<" for asyncwrite option. Expect the number of buffers waiting to be written (0 disables asynchronous writing).");
+      }
+    }
+
+  if (!map["overviews"].empty())
+    {
+    itksys::RegularExpression reg;
+    reg.compile("^[0-9]+$");
+    if (reg.find(map["overviews"]))
+      {
+      m_Options.overviews.first = true;
+      m_Options.overviews.second = atoi(map["overviews"].c_str());
+      }
+    else
+      {
+      itkWarningMacro("Unkwown value "<<map["overviews"]<<" for overviews option. Expect the number of overview levels to write (0 disables them).");
+      }
+    }
+
+  if (!map["overviews:method"].empty())
+    {
+    if (map["overviews:method"] == "average"
+        || map["overviews:method"] == "nearest")
+      {
+      m_Options.overviewsMethod.first = true;
+      m_Options.overviewsMethod.second = map["overviews:method"];
+      }
+    else
+      {
+      itkWarningMacro("Unkwown value "<<map["overviews:method"]<<" for overviews:method option. Available values are average,nearest.");
+      }
+    }
+
   //Option Checking
   for ( it=map.begin(); it != map.end(); it++ )
     {
@@ -323,4 +398,60 @@ ExtendedFilenameToWriterOptions
   return m_Options.bandRange.second;
 }
 
+bool
+ExtendedFilenameToWriterOptions
+::AsyncWriteIsSet () const
+{
+  return m_Options.asyncWrite.first;
+}
+
+unsigned int
+ExtendedFilenameToWriterOptions
+::GetAsyncWrite () const
+{
+  return m_Options.asyncWrite.second;
+}
+
+bool
+ExtendedFilenameToWriterOptions
+::OverviewsIsSet () const
+{
+  return m_Options.overviews.first;
+}
+
+unsigned int
+ExtendedFilenameToWriterOptions
+::GetOverviews () const
+{
+  return m_Options.overviews.second;
+}
+
+bool
+ExtendedFilenameToWriterOptions
+::OverviewsMethodIsSet () const
+{
+  return m_Options.overviewsMethod.first;
+}
+
+std::string
+ExtendedFilenameToWriterOptions
+::GetOverviewsMethod () const
+{
+  return m_Options.overviewsMethod.second;
+}
+
+bool
+ExtendedFilenameToWriterOptions
+::ResumeIsSet () const
+{
+  return m_Options.resume.first;
+}
+
+bool
+ExtendedFilenameToWriterOptions
+::GetResume () const
+{
+  return m_Options.resume.second;
+}
+
 } // end namespace otb
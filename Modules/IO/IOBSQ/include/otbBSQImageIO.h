@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "otbImageIOBase.h"
+#include "otbMemoryMappedFile.h"
 
 namespace otb
 {
@@ -71,6 +72,12 @@ public:
     return true;
   }
 
+  /** Each band is stored in its own file, selected bands are read directly */
+  bool CanReadBandSubset() ITK_OVERRIDE
+  {
+    return true;
+  }
+
   /** Set the spacing and dimension information for the set filename. */
   void ReadImageInformation() ITK_OVERRIDE;
 
@@ -181,6 +188,8 @@ private:
   std::string                 m_TypeBsq;
   std::vector<std::string>    m_ChannelsFileName;
   std::fstream * m_ChannelsFile;
+  /** Mappings of the channel files, used for reading when possible */
+  MemoryMappedFile * m_ChannelsMapping;
 
 };
 
@@ -22,6 +22,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 #include "itkByteSwapper.h"
 #include "otbSystem.h"
@@ -58,6 +59,7 @@ BSQImageIO::BSQImageIO()
   m_Origin[0] = 0.5;
   m_Origin[1] = 0.5;
   m_ChannelsFile = ITK_NULLPTR;
+  m_ChannelsMapping = ITK_NULLPTR;
   m_FlagWriteImageInformation = true;
 
   this->AddSupportedWriteExtension(".hd");
@@ -85,6 +87,7 @@ BSQImageIO::~BSQImageIO()
       }
     delete[] m_ChannelsFile;
     }
+  delete[] m_ChannelsMapping;
 }
 
 bool BSQImageIO::CanReadFile(const char* filename)
@@ -131,7 +134,18 @@ void BSQImageIO::ReadVolume(void*)
 // Read image
 void BSQImageIO::Read(void* buffer)
 {
-  unsigned long step = this->GetNumberOfComponents();
+  // Bands to read, in the order they are stored in the buffer
+  std::vector<unsigned int> bandList(m_BandList);
+  if (bandList.empty())
+    {
+    for (unsigned int i = 0; i < this->GetNumberOfComponents(); ++i)
+      {
+      bandList.push_back(i);
+      }
+    }
+  const unsigned int nbBands = static_cast<unsigned int>(bandList.size());
+
+  unsigned long step = nbBands;
   char *        p = static_cast<char *>(buffer);
 
   int lNbLines   = this->GetIORegion().GetSize()[1];
@@ -168,9 +182,32 @@ void BSQImageIO::Read(void* buffer)
   otbMsgDevMacro(<< " sizeof(size_t)        : " << sizeof(size_t));
   otbMsgDevMacro(<< " sizeof(unsigned long) : " << sizeof(unsigned long));
 
-  for (unsigned int nbComponents = 0; nbComponents < this->GetNumberOfComponents(); ++nbComponents)
+  for (unsigned int outBand = 0; outBand < nbBands; ++outBand)
     {
-    cpt = (unsigned long) (nbComponents) * (unsigned long) (this->GetComponentSize());
+    const unsigned int nbComponents = bandList[outBand];
+    if (nbComponents >= this->GetNumberOfComponents())
+      {
+      delete[] value;
+      itkExceptionMacro(<< "BSQImageIO::Read() Band " << nbComponents + 1 << " is out of range");
+      }
+    cpt = (unsigned long) (outBand) * (unsigned long) (this->GetComponentSize());
+
+    // Copy the region directly from the mapped channel file if possible
+    if (m_ChannelsMapping != ITK_NULLPTR
+        && m_ChannelsMapping[nbComponents].Open(m_ChannelsFileName[nbComponents])
+        && m_ChannelsMapping[nbComponents].ReadRegion(
+             static_cast<size_t>(headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine)
+                                 + static_cast<std::streamoff>(this->GetComponentSize() * lFirstColumn)),
+             static_cast<size_t>(numberOfBytesPerLines),
+             static_cast<size_t>(lNbLines),
+             static_cast<size_t>(numberOfBytesToBeRead),
+             this->GetComponentSize(),
+             step,
+             p + cpt))
+      {
+      continue;
+      }
+
     //Read region of the channel
     for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
       {
@@ -200,7 +237,7 @@ void BSQImageIO::Read(void* buffer)
         }
       }
     }
-  unsigned long numberOfPixelsOfRegion = lNbLines * lNbColumns * this->GetNumberOfComponents();
+  unsigned long numberOfPixelsOfRegion = lNbLines * lNbColumns * nbBands;
 
   delete[] value;
 
@@ -446,6 +483,10 @@ bool BSQImageIO::InternalReadHeaderInformation(const std::string& file_name, std
 
   m_ChannelsFile = new std::fstream[this->GetNumberOfComponents()];
 
+  // Channel files are mapped at the first read
+  delete[] m_ChannelsMapping;
+  m_ChannelsMapping = new MemoryMappedFile[this->GetNumberOfComponents()];
+
   //Try to open channels file
   for (unsigned int channels = 0; channels < m_ChannelsFileName.size(); ++channels)
     {
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGDALBlockCache_h
+#define otbGDALBlockCache_h
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "OTBIOGDALExport.h"
+
+namespace otb
+{
+
+/** \class GDALBlockCache
+ *
+ * \brief Process-wide cache of the blocks decoded by GDALImageIO
+ *
+ * Several readers often read the same file in one pipeline (bands
+ * concatenated from one file, the same input given twice to a filter,
+ * ...). Each of them has its own GDAL dataset, so the blocks read by
+ * one reader were decoded again by the other ones. When this cache is
+ * enabled, GDALImageIO decodes the blocks of the requested regions
+ * through it, and the blocks are shared by all the readers of the
+ * file.
+ *
+ * Blocks are stored in the data type of the file, and identified by
+ * the file (or subdataset) name, the size and the modification time
+ * of the file, the band, the overview (-1 for the full resolution) and
+ * the block position. The size and the time make the blocks of a file
+ * rewritten since they were cached (by another process, or under
+ * another name) unreachable, until they are evicted. The least recently used
+ * blocks are evicted when the size of the cache exceeds its maximum
+ * size. The cache is disabled when the maximum size is 0, which is the
+ * default unless the environment variable OTB_BLOCK_CACHE_SIZE gives
+ * another size (in MB).
+ *
+ * The numbers of hits and misses can be used to size the cache for a
+ * given processing.
+ *
+ * \ingroup OTBIOGDAL
+ */
+class OTBIOGDAL_EXPORT GDALBlockCache
+{
+public:
+  /** Decoded block. It stays valid when evicted from the cache. */
+  typedef std::shared_ptr<const std::vector<char> > BlockPointerType;
+
+  /** Identify a block of a file */
+  struct KeyType
+  {
+    std::string fileName;
+    long long   fileSize;
+    long long   fileTime;
+    int         band;
+    int         overview;
+    int         blockX;
+    int         blockY;
+
+    bool operator<(const KeyType& other) const;
+  };
+
+  // GetInstance returns a reference to the cache shared by the whole
+  // process
+  static GDALBlockCache& GetInstance()
+  {
+    static GDALBlockCache theUniqueInstance;
+    return theUniqueInstance;
+  }
+
+  /** Get a block from the cache, and count a hit. Return a null
+   * pointer and count a miss if the block is not cached. Thread
+   * safe. */
+  BlockPointerType Get(const KeyType& key);
+
+  /** Store a block, evicting the least recently used ones if needed.
+   * Blocks larger than the maximum size are not stored. Thread safe. */
+  void Insert(const KeyType& key, const BlockPointerType& block);
+
+  /** Remove all the blocks of a file, for instance because it is
+   * about to be rewritten. Thread safe. */
+  void Clear(const std::string& fileName);
+
+  /** Remove all the blocks. Thread safe. */
+  void Clear();
+
+  /** Set the maximum size of the cache, in bytes. 0 disables the
+   * cache. Thread safe. */
+  void SetMaximumSize(size_t size);
+
+  /** Get the maximum size of the cache, in bytes */
+  size_t GetMaximumSize() const;
+
+  /** Return true if the maximum size of the cache is not 0 */
+  bool IsEnabled() const
+  {
+    return this->GetMaximumSize() > 0;
+  }
+
+  /** Get the size of the cached blocks, in bytes */
+  size_t GetSize() const;
+
+  /** Get the number of cached blocks */
+  size_t GetNumberOfBlocks() const;
+
+  /** Get the number of blocks found in the cache */
+  unsigned long long GetNumberOfHits() const;
+
+  /** Get the number of blocks not found in the cache */
+  unsigned long long GetNumberOfMisses() const;
+
+  /** Reset the numbers of hits and misses */
+  void ResetStatistics();
+
+private:
+  // private constructor so that this class is allocated only inside GetInstance
+  GDALBlockCache();
+
+  ~GDALBlockCache();
+
+  GDALBlockCache(const GDALBlockCache&); //purposely not implemented
+  void operator =(const GDALBlockCache&); //purposely not implemented
+
+  /** Evict the least recently used blocks until the cache fits in
+   * size (the mutex must be locked) */
+  void Shrink(size_t size);
+
+  typedef std::list<KeyType> KeyListType;
+
+  struct EntryType
+  {
+    BlockPointerType      block;
+    KeyListType::iterator position;
+  };
+
+  typedef std::map<KeyType, EntryType> BlockMapType;
+
+  // Most recently used blocks first
+  KeyListType  m_UsageList;
+  BlockMapType m_Blocks;
+
+  size_t             m_Size;
+  size_t             m_MaximumSize;
+  unsigned long long m_NumberOfHits;
+  unsigned long long m_NumberOfMisses;
+
+  mutable std::mutex m_Mutex;
+}; // end of GDALBlockCache
+
+} // end namespace otb
+
+#endif // otbGDALBlockCache_h
@@ -22,6 +22,10 @@
 #define otbGDALDriverManagerWrapper_h
 
 
+#include <map>
+#include <mutex>
+#include <vector>
+
 #include "itkLightObject.h"
 #include "itkProcessObject.h"
 #include "otbConfigure.h"
@@ -51,6 +55,12 @@ namespace otb
  * available during all the program lifetime. This class automatically
  * allocate and destroy the available gdal drivers.
  *
+ * A GDALDataset can not be used by several threads at the same time.
+ * AcquireDataset() and ReleaseDataset() manage a pool of independent
+ * read-only handles per file, so that several regions of the same file
+ * can be decoded in parallel without opening the file again for each
+ * region.
+ *
  * \ingroup IOFilters
  *
  *
@@ -76,6 +86,10 @@ public:
   // Open the file for reading and returns a smart dataset pointer
   GDALDatasetWrapper::Pointer Open( std::string filename ) const;
 
+  // Open the existing file for writing and returns a smart dataset
+  // pointer, null if the file can not be updated
+  GDALDatasetWrapper::Pointer Update( std::string filename ) const;
+
   // Open the new  file for writing and returns a smart dataset pointer
   GDALDatasetWrapper::Pointer Create( std::string driverShortName, std::string filename,
                                       int nXSize, int nYSize, int nBands,
@@ -84,11 +98,32 @@ public:
 
   GDALDriver* GetDriverByName( std::string driverShortName ) const;
 
+  // Get a read-only dataset on the file, not shared with any other
+  // user: an idle one from the pool if any, a new one otherwise.
+  // Returns a null pointer if the file can not be opened. Thread safe.
+  GDALDatasetWrapper::Pointer AcquireDataset( std::string filename );
+
+  // Give back a dataset obtained with AcquireDataset(). It is closed if
+  // the pool of the file already holds one idle dataset per thread.
+  // Thread safe.
+  void ReleaseDataset( std::string filename, GDALDatasetWrapper::Pointer dataset );
+
+  // Close the idle datasets of the pool on the file, for instance
+  // because the file is about to be rewritten. Thread safe.
+  void ClearDatasetPool( std::string filename );
+
 private :
 // private constructor so that this class is allocated only inside GetInstance
   GDALDriverManagerWrapper();
 
   ~GDALDriverManagerWrapper();
+
+  typedef std::vector<GDALDatasetWrapper::Pointer>      DatasetListType;
+  typedef std::map<std::string, DatasetListType>        DatasetPoolType;
+
+  // Idle datasets, per file
+  DatasetPoolType m_DatasetPool;
+  std::mutex      m_DatasetPoolMutex;
 }; // end of GDALDriverManagerWrapper
 
 
@@ -27,6 +27,7 @@
 
 /* ITK Libraries */
 #include "otbImageIOBase.h"
+#include "otbGDALOverviewsBuilder.h"
 
 #include "OTBIOGDALExport.h"
 
@@ -34,6 +35,7 @@ namespace otb
 {
 class GDALDatasetWrapper;
 class GDALDataTypeWrapper;
+class GDALStreamingOverviewsWriter;
 
 /** \class GDALImageIO
  *
@@ -61,7 +63,17 @@ class GDALDataTypeWrapper;
  * physical space as GDAL physical space : a given point of
  * image has the same physical location in OTB and in GDAL.
  *
- * The streaming read is implemented.
+ * The streaming read is implemented. When more than one read thread
+ * is set (see ImageIOBase::SetNumberOfReadThreads()), the requested
+ * region is split along the native blocks of the file, which are
+ * decoded concurrently with independent datasets. When the block cache
+ * is enabled (see GDALBlockCache), the blocks are instead decoded
+ * through the cache, and shared with the other readers of the file.
+ *
+ * When a number of overviews to write is set, GTiff files are written
+ * tiled, and their internal overviews are filled while the streamed
+ * regions are written (see GDALStreamingOverviewsWriter), instead of
+ * being computed from the file once written.
  *
  * \ingroup IOFilters
  *
@@ -105,6 +117,17 @@ public:
   itkGetMacro(WriteRPCTags,bool);
 
   
+  /** Set/Get the number of internal overviews (factors 2, 4, ...,
+   * 2^n) written along with the image. Only the GTiff driver supports
+   * it. 0 by default (no overviews). */
+  itkSetMacro(NumberOfOverviewsToWrite, unsigned int);
+  itkGetMacro(NumberOfOverviewsToWrite, unsigned int);
+
+  /** Set/Get the resampling method of the written overviews (NEAREST
+   * or AVERAGE, the default) */
+  itkSetEnumMacro(OverviewsResampling, GDALResampling);
+  itkGetEnumMacro(OverviewsResampling, GDALResampling);
+
   /** Set/Get the options */
   void SetOptions(const GDALCreationOptionsType& opts)
   {
@@ -143,6 +166,16 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   void Read(void* buffer) ITK_OVERRIDE;
 
+  /** Band subsets are passed to GDAL RasterIO (band map), except for
+   * indexed images and when the components do not match the bands of
+   * the file (complex data read into a real or complex vector
+   * image). */
+  bool CanReadBandSubset() ITK_OVERRIDE;
+
+  /** GDAL RasterIO converts the components when the requested type can
+   * hold every value of the file type (e.g. uint16 read as float). */
+  bool CanReadAsComponentType(IOComponentType type) ITK_OVERRIDE;
+
   /** Reads 3D data from multiple files assuming one slice per file. */
   virtual void ReadVolume(void* buffer);
 
@@ -161,6 +194,15 @@ public:
   /** Determine the file type. Returns true if the ImageIO can stream write the specified file */
   bool CanStreamWrite() ITK_OVERRIDE;
 
+  /** Blocks left unwritten in a GeoTIFF created with the SPARSE_OK
+   * option read back as no-data, unless overviews are written along
+   * with the image */
+  bool CanSkipEmptyRegions() ITK_OVERRIDE;
+
+  /** Files written with a streaming driver can be reopened to complete
+   * an interrupted write */
+  bool CanResumeWrite() ITK_OVERRIDE;
+
   /** Writes the spacing and dimensions of the image.
    * Assumes SetFileName has been called with a valid file name. */
   void WriteImageInformation() ITK_OVERRIDE;
@@ -169,6 +211,9 @@ public:
    * that the IORegion has been set properly. */
   void Write(const void* buffer) ITK_OVERRIDE;
 
+  /** Flush the blocks cached by GDAL to the file */
+  void Flush() ITK_OVERRIDE;
+
   /** Get all resolutions possible from the file dimensions */
   bool GetAvailableResolutions(std::vector<unsigned int>& res);
 
@@ -203,6 +248,9 @@ protected:
   void InternalReadImageInformation();
   /** Write all information on the image*/
   void InternalWriteImageInformation(const void* buffer);
+  /** Build the overviews of the written dataset from its full
+   * resolution, for the writes resumed after an interruption */
+  void RebuildOverviews();
   /** Number of bands of the image*/
   int m_NbBands;
   /** Buffer*/
@@ -238,6 +286,10 @@ private:
   typedef itk::SmartPointer<GDALDatasetWrapper> GDALDatasetWrapperPointer;
   GDALDatasetWrapperPointer m_Dataset;
 
+  /** Name used to open m_Dataset for reading (file or sub-dataset),
+   * to get more datasets on it for the concurrent reads */
+  std::string m_DatasetFileName;
+
   GDALDataTypeWrapper*    m_PxType;
   /** Nombre d'octets par pixel */
   int m_BytePerPixel;
@@ -268,6 +320,22 @@ private:
    * Size of the different overviews of the file */
   std::vector<std::pair<unsigned int, unsigned int> > m_OverviewsSize;
 
+  /**
+   * Number of overviews written along with the image */
+  unsigned int m_NumberOfOverviewsToWrite;
+
+  /**
+   * Resampling method of the written overviews */
+  GDALResampling m_OverviewsResampling;
+
+  /**
+   * Fills the overviews of the written dataset */
+  itk::SmartPointer<GDALStreamingOverviewsWriter> m_OverviewsWriter;
+
+  /**
+   * Whether the overviews are built once a resumed write is complete */
+  bool m_RebuildOverviews;
+
   /** Resolution factor
    */
   unsigned int m_ResolutionFactor;
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGDALStreamingOverviewsWriter_h
+#define otbGDALStreamingOverviewsWriter_h
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "itkLightObject.h"
+#include "itkObjectFactory.h"
+
+#include "otbGDALOverviewsBuilder.h"
+
+#include "OTBIOGDALExport.h"
+
+
+class GDALDataset;
+
+
+namespace otb
+{
+
+/** \class GDALStreamingOverviewsWriter
+ *  \brief Fill the internal overviews of a dataset while its full
+ *  resolution is written.
+ *
+ * Initialize() creates empty overview levels of factors 2, 4, ...,
+ * 2^n in a dataset opened for writing (GTiff). Each region written at
+ * full resolution is then given to WriteRegion(), which decimates it
+ * and writes the overview pixels it covers, so that the pyramid is
+ * built without reading the file back.
+ *
+ * With the AVERAGE resampling, an overview pixel is the mean of its
+ * footprint in the full resolution image. The footprints lying across
+ * several written regions are accumulated until their last pixel is
+ * written. No such pixel remains when the regions are aligned on
+ * 2^n. The NEAREST resampling keeps the top left pixel of each
+ * footprint, like GDAL does for power of two factors.
+ *
+ * The dataset is not owned: it must stay open until Flush() is
+ * called.
+ *
+ * \sa GDALImageIO
+ * \sa GDALOverviewsBuilder
+ *
+ * \ingroup OTBIOGDAL
+ */
+class OTBIOGDAL_EXPORT GDALStreamingOverviewsWriter : public itk::LightObject
+{
+public:
+  typedef GDALStreamingOverviewsWriter Self;
+  typedef itk::LightObject             Superclass;
+  typedef itk::SmartPointer<Self>      Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(GDALStreamingOverviewsWriter, itk::LightObject);
+
+  /** Create nbLevels empty overviews in dataset. Only the NEAREST and
+   * AVERAGE resampling methods are supported. Throw an exception if
+   * the overviews can not be created. */
+  void Initialize(GDALDataset * dataset, unsigned int nbLevels, GDALResampling resampling);
+
+  /** Update the overviews with a region just written at full
+   * resolution. The buffer holds all the bands, pixel interleaved, in
+   * the data type of the dataset. */
+  void WriteRegion(const void * buffer, int firstColumn, int firstLine, int nbColumns, int nbLines);
+
+  /** Write the overview pixels whose footprint has not been entirely
+   * written, from the pixels received so far. */
+  void Flush();
+
+  /** Get the number of overview levels */
+  unsigned int GetNumberOfLevels() const
+  {
+    return static_cast<unsigned int>(m_Levels.size());
+  }
+
+  /** Get the number of overview pixels waiting for the rest of their
+   * footprint */
+  size_t GetNumberOfPendingPixels() const;
+
+protected:
+  GDALStreamingOverviewsWriter();
+  ~GDALStreamingOverviewsWriter() ITK_OVERRIDE;
+
+private:
+  GDALStreamingOverviewsWriter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** Sums of the components of an overview pixel over the part of
+   * its footprint received so far */
+  struct PendingPixel
+  {
+    std::vector<double> sums;
+    unsigned int        count;
+  };
+
+  typedef std::map<std::pair<int, int>, PendingPixel> PendingPixelMapType;
+
+  struct Level
+  {
+    int                 factor;
+    int                 width;
+    int                 height;
+    PendingPixelMapType pending;
+  };
+
+  /** Decimate a region whose lines do not cross a multiple of the
+   * largest factor, except at its borders */
+  void WriteAveragedRegion(const char * buffer, int firstColumn, int firstLine, int nbColumns, int nbLines);
+
+  void WriteNearestRegion(const char * buffer, int firstColumn, int firstLine, int nbColumns, int nbLines);
+
+  /** Write means of sums (nbColumns x nbLines pixels, lineStride
+   * pixels between lines) at the given position of a level */
+  void WriteMeans(unsigned int level, const double * sums, const unsigned int * counts,
+                  int lineStride, int firstColumn, int firstLine, int nbColumns, int nbLines);
+
+  /** Write pixel interleaved pixels at the given position of a level */
+  void WriteLevel(unsigned int level, char * buffer, int firstColumn, int firstLine, int nbColumns, int nbLines);
+
+  /** Number of full resolution pixels in the footprint of an
+   * overview pixel */
+  unsigned int GetFootprintSize(const Level & level, int column, int line) const;
+
+  GDALDataset *      m_Dataset;
+  int                m_Width;
+  int                m_Height;
+  int                m_NbBands;
+  int                m_DataType;
+  /** Bytes of a band value (both parts of a complex value) */
+  int                m_BandBytes;
+  /** Scalar components per pixel (two per band for complex data) */
+  int                m_NbComponents;
+  GDALResampling     m_Resampling;
+  std::vector<Level> m_Levels;
+};
+
+} // end namespace otb
+
+#endif // otbGDALStreamingOverviewsWriter_h
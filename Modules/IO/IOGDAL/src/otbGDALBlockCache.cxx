@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGDALBlockCache.h"
+#include "otbConfigurationManager.h"
+
+namespace otb
+{
+
+bool
+GDALBlockCache::KeyType::operator<(const KeyType& other) const
+{
+  if (blockX != other.blockX)
+    {
+    return blockX < other.blockX;
+    }
+  if (blockY != other.blockY)
+    {
+    return blockY < other.blockY;
+    }
+  if (band != other.band)
+    {
+    return band < other.band;
+    }
+  if (overview != other.overview)
+    {
+    return overview < other.overview;
+    }
+  if (fileTime != other.fileTime)
+    {
+    return fileTime < other.fileTime;
+    }
+  if (fileSize != other.fileSize)
+    {
+    return fileSize < other.fileSize;
+    }
+  return fileName < other.fileName;
+}
+
+GDALBlockCache::GDALBlockCache()
+  : m_Size(0),
+    m_MaximumSize(static_cast<size_t>(ConfigurationManager::GetBlockCacheSize()) * 1024 * 1024),
+    m_NumberOfHits(0),
+    m_NumberOfMisses(0)
+{
+}
+
+GDALBlockCache::~GDALBlockCache()
+{
+}
+
+GDALBlockCache::BlockPointerType
+GDALBlockCache::Get(const KeyType& key)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  BlockMapType::iterator it = m_Blocks.find(key);
+  if (it == m_Blocks.end())
+    {
+    ++m_NumberOfMisses;
+    return BlockPointerType();
+    }
+
+  ++m_NumberOfHits;
+  m_UsageList.splice(m_UsageList.begin(), m_UsageList, it->second.position);
+  return it->second.block;
+}
+
+void
+GDALBlockCache::Insert(const KeyType& key, const BlockPointerType& block)
+{
+  if (!block)
+    {
+    return;
+    }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (block->size() > m_MaximumSize)
+    {
+    return;
+    }
+
+  // Another reader may have decoded the same block meanwhile
+  BlockMapType::iterator it = m_Blocks.find(key);
+  if (it != m_Blocks.end())
+    {
+    m_UsageList.splice(m_UsageList.begin(), m_UsageList, it->second.position);
+    return;
+    }
+
+  this->Shrink(m_MaximumSize - block->size());
+
+  m_UsageList.push_front(key);
+  EntryType entry = {block, m_UsageList.begin()};
+  m_Blocks.insert(std::make_pair(key, entry));
+  m_Size += block->size();
+}
+
+void
+GDALBlockCache::Clear(const std::string& fileName)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  for (KeyListType::iterator it = m_UsageList.begin(); it != m_UsageList.end(); )
+    {
+    if (it->fileName == fileName)
+      {
+      BlockMapType::iterator entry = m_Blocks.find(*it);
+      m_Size -= entry->second.block->size();
+      m_Blocks.erase(entry);
+      it = m_UsageList.erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+}
+
+void
+GDALBlockCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  this->Shrink(0);
+}
+
+void
+GDALBlockCache::SetMaximumSize(size_t size)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumSize = size;
+  this->Shrink(size);
+}
+
+size_t
+GDALBlockCache::GetMaximumSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumSize;
+}
+
+size_t
+GDALBlockCache::GetSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Size;
+}
+
+size_t
+GDALBlockCache::GetNumberOfBlocks() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Blocks.size();
+}
+
+unsigned long long
+GDALBlockCache::GetNumberOfHits() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfHits;
+}
+
+unsigned long long
+GDALBlockCache::GetNumberOfMisses() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfMisses;
+}
+
+void
+GDALBlockCache::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_NumberOfHits = 0;
+  m_NumberOfMisses = 0;
+}
+
+void
+GDALBlockCache::Shrink(size_t size)
+{
+  while (m_Size > size && !m_UsageList.empty())
+    {
+    BlockMapType::iterator entry = m_Blocks.find(m_UsageList.back());
+    m_Size -= entry->second.block->size();
+    m_Blocks.erase(entry);
+    m_UsageList.pop_back();
+    }
+}
+
+} // end namespace otb
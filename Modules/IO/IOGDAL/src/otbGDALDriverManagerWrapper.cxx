@@ -19,7 +19,9 @@
  */
 
 #include "otbGDALDriverManagerWrapper.h"
+#include <algorithm>
 #include <vector>
+#include "itkMultiThreader.h"
 #include "otb_boost_string_header.h"
 #include "otbSystem.h"
 
@@ -49,6 +51,8 @@ GDALDriverManagerWrapper::GDALDriverManagerWrapper()
 
 GDALDriverManagerWrapper::~GDALDriverManagerWrapper()
 {
+  // Pooled datasets must be closed before the drivers are destroyed
+  m_DatasetPool.clear();
   GDALDestroyDriverManager();
 }
 
@@ -94,6 +98,22 @@ GDALDriverManagerWrapper::Open( std::string filename ) const
   return datasetWrapper;
 }
 
+// Open the existing file for writing and returns a smart dataset pointer
+GDALDatasetWrapper::Pointer
+GDALDriverManagerWrapper::Update( std::string filename ) const
+{
+  GDALDatasetWrapper::Pointer datasetWrapper;
+
+  GDALDatasetH dataset = GDALOpen(filename.c_str(), GA_Update);
+
+  if (dataset != ITK_NULLPTR)
+    {
+    datasetWrapper = GDALDatasetWrapper::New();
+    datasetWrapper->m_Dataset = static_cast<GDALDataset*>(dataset);
+    }
+  return datasetWrapper;
+}
+
 // Open the new  file for writing and returns a smart dataset pointer
 GDALDatasetWrapper::Pointer
 GDALDriverManagerWrapper::Create( std::string driverShortName, std::string filename,
@@ -125,4 +145,57 @@ GDALDriverManagerWrapper::GetDriverByName( std::string driverShortName ) const
   return GetGDALDriverManager()->GetDriverByName(driverShortName.c_str());
 }
 
+GDALDatasetWrapper::Pointer
+GDALDriverManagerWrapper::AcquireDataset( std::string filename )
+{
+  {
+  std::lock_guard<std::mutex> lock(m_DatasetPoolMutex);
+  DatasetPoolType::iterator it = m_DatasetPool.find(filename);
+  if (it != m_DatasetPool.end() && !it->second.empty())
+    {
+    GDALDatasetWrapper::Pointer dataset = it->second.back();
+    it->second.pop_back();
+    return dataset;
+    }
+  }
+
+  // Opening may take time (headers parsing): do it outside of the lock
+  return this->Open(filename);
+}
+
+void
+GDALDriverManagerWrapper::ReleaseDataset( std::string filename, GDALDatasetWrapper::Pointer dataset )
+{
+  if (dataset.IsNull())
+    {
+    return;
+    }
+
+  const size_t maxIdleDatasets =
+    std::max<size_t>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads(), 1);
+
+  std::lock_guard<std::mutex> lock(m_DatasetPoolMutex);
+  DatasetListType & idleDatasets = m_DatasetPool[filename];
+  if (idleDatasets.size() < maxIdleDatasets)
+    {
+    idleDatasets.push_back(dataset);
+    }
+}
+
+void
+GDALDriverManagerWrapper::ClearDatasetPool( std::string filename )
+{
+  DatasetListType idleDatasets;
+  {
+  std::lock_guard<std::mutex> lock(m_DatasetPoolMutex);
+  DatasetPoolType::iterator it = m_DatasetPool.find(filename);
+  if (it != m_DatasetPool.end())
+    {
+    idleDatasets.swap(it->second);
+    m_DatasetPool.erase(it);
+    }
+  }
+  // The datasets are closed here, outside of the lock
+}
+
 } // end namespace otb
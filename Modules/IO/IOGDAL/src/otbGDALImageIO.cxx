@@ -18,8 +18,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <fstream>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "otbGDALImageIO.h"
@@ -38,10 +42,13 @@
 #include "itkTimeProbe.h"
 
 #include "cpl_conv.h"
+#include "cpl_vsi.h"
 #include "ogr_spatialref.h"
 #include "ogr_srs_api.h"
 
 #include "otbGDALDriverManagerWrapper.h"
+#include "otbGDALBlockCache.h"
+#include "otbGDALStreamingOverviewsWriter.h"
 
 #include "otb_boost_string_header.h"
 
@@ -125,6 +132,284 @@ void printDataBuffer(unsigned char *pData, GDALDataType pxlType, int nbBands, in
 };
 */
 
+// Part of a region read by one RasterIO call
+struct GDALBlockReadTask
+{
+  int x;
+  int y;
+  int sizeX;
+  int sizeY;
+};
+
+// Split a region of the file along its native blocks. Rows of blocks
+// are grouped so that each thread gets a few tasks: one task per block
+// would be too small for stripped files (one line per block).
+static std::vector<GDALBlockReadTask> SplitRegionOnBlocks(GDALDataset* dataset,
+                                                          int firstColumn, int firstLine,
+                                                          int nbColumns, int nbLines,
+                                                          unsigned int nbThreads)
+{
+  std::vector<GDALBlockReadTask> tasks;
+
+  int blockSizeX = 0;
+  int blockSizeY = 0;
+  dataset->GetRasterBand(1)->GetBlockSize(&blockSizeX, &blockSizeY);
+  if (blockSizeX <= 0 || blockSizeY <= 0 || nbColumns <= 0 || nbLines <= 0)
+    {
+    return tasks;
+    }
+
+  const int firstBlockRow    = firstLine / blockSizeY;
+  const int lastBlockRow     = (firstLine + nbLines - 1) / blockSizeY;
+  const int firstBlockColumn = firstColumn / blockSizeX;
+  const int lastBlockColumn  = (firstColumn + nbColumns - 1) / blockSizeX;
+
+  const int blockRowsPerTask =
+    std::max(1, (lastBlockRow - firstBlockRow + 1) / static_cast<int>(4 * nbThreads));
+
+  for (int blockRow = firstBlockRow; blockRow <= lastBlockRow; blockRow += blockRowsPerTask)
+    {
+    const int startY = std::max(firstLine, blockRow * blockSizeY);
+    const int endY   = std::min(firstLine + nbLines, (blockRow + blockRowsPerTask) * blockSizeY);
+
+    for (int blockColumn = firstBlockColumn; blockColumn <= lastBlockColumn; ++blockColumn)
+      {
+      const int startX = std::max(firstColumn, blockColumn * blockSizeX);
+      const int endX   = std::min(firstColumn + nbColumns, (blockColumn + 1) * blockSizeX);
+
+      GDALBlockReadTask task = {startX, startY, endX - startX, endY - startY};
+      tasks.push_back(task);
+      }
+    }
+  return tasks;
+}
+
+// Read a region (at full resolution) with several threads. The calling
+// thread uses the main dataset, the others get their own dataset from
+// the pool of GDALDriverManagerWrapper. Return false if the region has
+// a single block, in which case nothing is read. Errors are reported in
+// errorMessage.
+static bool ReadBlocksConcurrently(GDALDatasetWrapper* mainDataset, const std::string& filename,
+                                   unsigned int nbThreads, unsigned char* buffer,
+                                   int firstColumn, int firstLine, int nbColumns, int nbLines,
+                                   GDALDataType bufferType, int nbBands, int* bandMap,
+                                   int pixelOffset, int lineOffset, int bandOffset,
+                                   std::string& errorMessage)
+{
+  const std::vector<GDALBlockReadTask> tasks =
+    SplitRegionOnBlocks(mainDataset->GetDataSet(), firstColumn, firstLine, nbColumns, nbLines, nbThreads);
+  if (tasks.size() < 2)
+    {
+    return false;
+    }
+  nbThreads = std::min(nbThreads, static_cast<unsigned int>(tasks.size()));
+
+  otbMsgDevMacro(<< "Reading " << tasks.size() << " blocks with " << nbThreads << " threads");
+
+  std::atomic<size_t> nextTask(0);
+  std::mutex          errorMutex;
+
+  auto readTasks = [&](GDALDataset* dataset)
+    {
+    for (size_t t = nextTask++; t < tasks.size(); t = nextTask++)
+      {
+      const GDALBlockReadTask& task = tasks[t];
+      unsigned char* taskBuffer = buffer
+        + static_cast<std::ptrdiff_t>(task.y - firstLine) * lineOffset
+        + static_cast<std::ptrdiff_t>(task.x - firstColumn) * pixelOffset;
+
+      CPLErr lCrGdal = dataset->RasterIO(GF_Read,
+                                         task.x, task.y, task.sizeX, task.sizeY,
+                                         taskBuffer, task.sizeX, task.sizeY,
+                                         bufferType, nbBands, bandMap,
+                                         pixelOffset, lineOffset, bandOffset);
+      if (lCrGdal == CE_Failure)
+        {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (errorMessage.empty())
+          {
+          // The GDAL error message is local to the thread
+          errorMessage = CPLGetLastErrorMsg();
+          if (errorMessage.empty())
+            {
+            errorMessage = "RasterIO failed";
+            }
+          }
+        // Stop the other threads
+        nextTask = tasks.size();
+        return;
+        }
+      }
+    };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < nbThreads; ++i)
+    {
+    threads.push_back(std::thread([&]()
+      {
+      GDALDatasetWrapper::Pointer dataset =
+        GDALDriverManagerWrapper::GetInstance().AcquireDataset(filename);
+      // If the file can not be opened again, the other threads do the job
+      if (dataset.IsNotNull())
+        {
+        readTasks(dataset->GetDataSet());
+        GDALDriverManagerWrapper::GetInstance().ReleaseDataset(filename, dataset);
+        }
+      }));
+    }
+
+  readTasks(mainDataset->GetDataSet());
+
+  for (unsigned int i = 0; i < threads.size(); ++i)
+    {
+    threads[i].join();
+    }
+  return true;
+}
+
+// Return the index of the overview of the given size, -1 if there is
+// none
+static int FindOverviewOfSize(GDALDataset* dataset, unsigned int width, unsigned int height)
+{
+  GDALRasterBand* band = dataset->GetRasterBand(1);
+  for (int i = 0; i < band->GetOverviewCount(); ++i)
+    {
+    GDALRasterBand* overview = band->GetOverview(i);
+    if (overview != ITK_NULLPTR
+        && static_cast<unsigned int>(overview->GetXSize()) == width
+        && static_cast<unsigned int>(overview->GetYSize()) == height)
+      {
+      return i;
+      }
+    }
+  return -1;
+}
+
+// Read a region through the block cache shared by the readers of the
+// file: each block of each band is decoded once (at the resolution of
+// the given overview, -1 for the full resolution), and copied into the
+// buffer with the conversion to the buffer type. Return false if the
+// blocks do not fit in the cache, in which case nothing is read.
+// Errors are reported in errorMessage.
+static bool ReadBlocksThroughCache(GDALDataset* dataset, const std::string& filename, int overview,
+                                   unsigned char* buffer,
+                                   int firstColumn, int firstLine, int nbColumns, int nbLines,
+                                   GDALDataType bufferType, int nbBands, int* bandMap,
+                                   int pixelOffset, int lineOffset, int bandOffset,
+                                   std::string& errorMessage)
+{
+  GDALBlockCache& cache = GDALBlockCache::GetInstance();
+
+  // The blocks of a file rewritten since they were cached must not be
+  // used (subdatasets and virtual files may not be stat-ed, which gives
+  // 0 for both)
+  long long fileSize = 0;
+  long long fileTime = 0;
+  VSIStatBufL fileStat;
+  if (VSIStatL(filename.c_str(), &fileStat) == 0)
+    {
+    fileSize = static_cast<long long>(fileStat.st_size);
+    fileTime = static_cast<long long>(fileStat.st_mtime);
+    }
+
+  for (int i = 0; i < nbBands; ++i)
+    {
+    const int bandIndex = bandMap != ITK_NULLPTR ? bandMap[i] : i + 1;
+    GDALRasterBand* band = dataset->GetRasterBand(bandIndex);
+    if (overview >= 0)
+      {
+      band = band->GetOverview(overview);
+      }
+
+    int blockSizeX = 0;
+    int blockSizeY = 0;
+    band->GetBlockSize(&blockSizeX, &blockSizeY);
+    const GDALDataType fileType = band->GetRasterDataType();
+    const int fileBytes = GDALGetDataTypeSize(fileType) / 8;
+    const size_t blockBytes = static_cast<size_t>(blockSizeX) * blockSizeY * fileBytes;
+    if (blockSizeX <= 0 || blockSizeY <= 0 || blockBytes > cache.GetMaximumSize())
+      {
+      return false;
+      }
+
+    const int lastBlockRow    = (firstLine + nbLines - 1) / blockSizeY;
+    const int lastBlockColumn = (firstColumn + nbColumns - 1) / blockSizeX;
+
+    for (int blockRow = firstLine / blockSizeY; blockRow <= lastBlockRow; ++blockRow)
+      {
+      for (int blockColumn = firstColumn / blockSizeX; blockColumn <= lastBlockColumn; ++blockColumn)
+        {
+        const GDALBlockCache::KeyType key = {filename, fileSize, fileTime, bandIndex, overview, blockColumn, blockRow};
+        GDALBlockCache::BlockPointerType block = cache.Get(key);
+        if (!block)
+          {
+          std::shared_ptr<std::vector<char> > decoded(new std::vector<char>(blockBytes));
+          if (band->ReadBlock(blockColumn, blockRow, &(*decoded)[0]) != CE_None)
+            {
+            errorMessage = CPLGetLastErrorMsg();
+            if (errorMessage.empty())
+              {
+              errorMessage = "ReadBlock failed";
+              }
+            return true;
+            }
+          block = decoded;
+          cache.Insert(key, block);
+          }
+
+        // Copy the part of the block inside the region
+        const int startX = std::max(firstColumn, blockColumn * blockSizeX);
+        const int endX   = std::min(firstColumn + nbColumns, (blockColumn + 1) * blockSizeX);
+        const int startY = std::max(firstLine, blockRow * blockSizeY);
+        const int endY   = std::min(firstLine + nbLines, (blockRow + 1) * blockSizeY);
+
+        for (int y = startY; y < endY; ++y)
+          {
+          const char* in = &(*block)[0]
+            + (static_cast<size_t>(y - blockRow * blockSizeY) * blockSizeX
+               + (startX - blockColumn * blockSizeX)) * fileBytes;
+          unsigned char* out = buffer
+            + static_cast<std::ptrdiff_t>(y - firstLine) * lineOffset
+            + static_cast<std::ptrdiff_t>(startX - firstColumn) * pixelOffset
+            + static_cast<std::ptrdiff_t>(i) * bandOffset;
+          GDALCopyWords(const_cast<char*>(in), fileType, fileBytes,
+                        out, bufferType, pixelOffset, endX - startX);
+          }
+        }
+      }
+    }
+  return true;
+}
+
+// Return the GDAL data type storing the given real component type,
+// GDT_Unknown if there is none
+static GDALDataType GDALDataTypeFromComponentType(ImageIOBase::IOComponentType type)
+{
+  switch (type)
+    {
+    case ImageIOBase::UCHAR:
+      return GDT_Byte;
+    case ImageIOBase::USHORT:
+      return GDT_UInt16;
+    case ImageIOBase::SHORT:
+      return GDT_Int16;
+    case ImageIOBase::UINT:
+      return GDT_UInt32;
+    case ImageIOBase::INT:
+      return GDT_Int32;
+    case ImageIOBase::ULONG:
+      return sizeof(unsigned long) == 4 ? GDT_UInt32 : GDT_Unknown;
+    case ImageIOBase::LONG:
+      return sizeof(long) == 4 ? GDT_Int32 : GDT_Unknown;
+    case ImageIOBase::FLOAT:
+      return GDT_Float32;
+    case ImageIOBase::DOUBLE:
+      return GDT_Float64;
+    default:
+      return GDT_Unknown;
+    }
+}
+
 GDALImageIO::GDALImageIO()
 {
   // By default set number of dimensions to two.
@@ -161,6 +446,9 @@ GDALImageIO::GDALImageIO()
   m_PxType = new GDALDataTypeWrapper;
 
   m_NumberOfOverviews = 0;
+  m_NumberOfOverviewsToWrite = 0;
+  m_OverviewsResampling = GDAL_RESAMPLING_AVERAGE;
+  m_RebuildOverviews = false;
   m_ResolutionFactor = 0;
   m_BytePerPixel = 0;
   m_WriteRPCTags = false;
@@ -168,6 +456,11 @@ GDALImageIO::GDALImageIO()
 
 GDALImageIO::~GDALImageIO()
 {
+  // Close the datasets opened for the concurrent reads of this file
+  if (!m_DatasetFileName.empty())
+    {
+    GDALDriverManagerWrapper::GetInstance().ClearDatasetPool(m_DatasetFileName);
+    }
   delete m_PxType;
 }
 
@@ -181,6 +474,7 @@ bool GDALImageIO::CanReadFile(const char* file)
     return false;
     }
   m_Dataset = GDALDriverManagerWrapper::GetInstance().Open(file);
+  m_DatasetFileName = m_Dataset.IsNotNull() ? std::string(file) : std::string();
   return m_Dataset.IsNotNull();
 }
 
@@ -191,6 +485,7 @@ void GDALImageIO::PrintSelf(std::ostream& os, itk::Indent indent) const
   os << indent << "Compression Level : " << m_CompressionLevel << "\n";
   os << indent << "IsComplex (otb side) : " << m_IsComplex << "\n";
   os << indent << "Byte per pixel : " << m_BytePerPixel << "\n";
+  os << indent << "Number of overviews to write : " << m_NumberOfOverviewsToWrite << "\n";
 }
 
 // Read a 3D image (or event more bands)... not implemented yet
@@ -211,6 +506,11 @@ void GDALImageIO::Read(void* buffer)
     return;
     }
 
+  if (!m_BandList.empty() && !this->CanReadBandSubset())
+    {
+    itkExceptionMacro(<< "Reading a subset of the bands is not supported for " << m_FileName);
+    }
+
   // Get the origin of the region to read
   int lFirstLineRegion   = this->GetIORegion().GetIndex()[1];
   int lFirstColumnRegion = this->GetIORegion().GetIndex()[0];
@@ -380,9 +680,24 @@ void GDALImageIO::Read(void* buffer)
   else
     {
     /********  Nominal case ***********/
-    int pixelOffset = m_BytePerPixel * m_NbBands;
-    int lineOffset  = m_BytePerPixel * m_NbBands * lNbColumnsRegion;
-    int bandOffset  = m_BytePerPixel;
+    // Let GDAL convert the components when another type is requested
+    GDALDataType bufferType   = m_PxType->pixType;
+    int          bytePerPixel = m_BytePerPixel;
+    if (m_ReadComponentType != UNKNOWNCOMPONENTTYPE
+        && m_ReadComponentType != this->GetComponentType())
+      {
+      if (!this->CanReadAsComponentType(m_ReadComponentType))
+        {
+        itkExceptionMacro(<< "Cannot read " << m_FileName << " as "
+                          << this->GetComponentTypeAsString(m_ReadComponentType));
+        }
+      bufferType   = GDALDataTypeFromComponentType(m_ReadComponentType);
+      bytePerPixel = GDALGetDataTypeSize(bufferType) / 8;
+      }
+
+    int pixelOffset = bytePerPixel * m_NbBands;
+    int lineOffset  = bytePerPixel * m_NbBands * lNbColumnsRegion;
+    int bandOffset  = bytePerPixel;
     int nbBands     = m_NbBands;
 
     // In some cases, we need to change some parameters for RasterIO
@@ -393,6 +708,19 @@ void GDALImageIO::Read(void* buffer)
       bandOffset  = m_BytePerPixel;
       }
 
+    // Only decode the selected bands (GDAL band indices start at 1)
+    std::vector<int> bandMap;
+    if (!m_BandList.empty())
+      {
+      for (unsigned int i = 0; i < m_BandList.size(); ++i)
+        {
+        bandMap.push_back(static_cast<int>(m_BandList[i]) + 1);
+        }
+      nbBands     = static_cast<int>(m_BandList.size());
+      pixelOffset = bytePerPixel * nbBands;
+      lineOffset  = pixelOffset * lNbColumnsRegion;
+      }
+
     // keep it for the moment
     //otbMsgDevMacro(<< "Number of bands inside input file: " << m_NbBands);
     otbMsgDevMacro(<< "Parameters RasterIO : \n"
@@ -403,6 +731,7 @@ void GDALImageIO::Read(void* buffer)
                    << " Buffer Size X = " << lNbColumnsRegion << "\n"
                    << " Buffer Size Y = " << lNbLinesRegion << "\n"
                    << " GDAL Data Type = " << GDALGetDataTypeName(m_PxType->pixType) << "\n"
+                   << " Buffer Data Type = " << GDALGetDataTypeName(bufferType) << "\n"
                    << " nbBands = " << nbBands << "\n"
                    << " pixelOffset = " << pixelOffset << "\n"
                    << " lineOffset = " << lineOffset << "\n"
@@ -410,21 +739,63 @@ void GDALImageIO::Read(void* buffer)
 
     itk::TimeProbe chrono;
     chrono.Start();
-    CPLErr lCrGdal = m_Dataset->GetDataSet()->RasterIO(GF_Read,
-                                                       lFirstColumn,
-                                                       lFirstLine,
-                                                       lNbColumns,
-                                                       lNbLines,
-                                                       p,
-                                                       lNbColumnsRegion,
-                                                       lNbLinesRegion,
-                                                       m_PxType->pixType,
-                                                       nbBands,
-                                                       // We want to read all bands
-                                                       ITK_NULLPTR,
-                                                       pixelOffset,
-                                                       lineOffset,
-                                                       bandOffset);
+
+    // Share the decoded blocks with the other readers of the file when
+    // the block cache is enabled. At a lower resolution, the blocks are
+    // those of the overview of the same size, if any.
+    std::string blocksErrorMessage;
+    const int cachedOverview = m_ResolutionFactor == 0 ? -1 :
+      FindOverviewOfSize(dataset, m_Dimensions[0], m_Dimensions[1]);
+    bool readByBlocks = GDALBlockCache::GetInstance().IsEnabled()
+      && !m_DatasetFileName.empty()
+      && (m_ResolutionFactor == 0 || cachedOverview >= 0)
+      && ReadBlocksThroughCache(dataset, m_DatasetFileName, cachedOverview, p,
+                                lFirstColumnRegion, lFirstLineRegion, lNbColumnsRegion, lNbLinesRegion,
+                                bufferType, nbBands,
+                                bandMap.empty() ? ITK_NULLPTR : &bandMap[0],
+                                pixelOffset, lineOffset, bandOffset,
+                                blocksErrorMessage);
+
+    // Otherwise, decode the blocks of the region concurrently when
+    // requested. This is only done at full resolution, where the buffer
+    // and the file regions have the same size.
+    if (!readByBlocks)
+      {
+      readByBlocks = m_NumberOfReadThreads > 1
+        && m_ResolutionFactor == 0
+        && !m_DatasetFileName.empty()
+        && ReadBlocksConcurrently(m_Dataset.GetPointer(), m_DatasetFileName, m_NumberOfReadThreads, p,
+                                  lFirstColumn, lFirstLine, lNbColumns, lNbLines,
+                                  bufferType, nbBands,
+                                  bandMap.empty() ? ITK_NULLPTR : &bandMap[0],
+                                  pixelOffset, lineOffset, bandOffset,
+                                  blocksErrorMessage);
+      }
+    if (readByBlocks && !blocksErrorMessage.empty())
+      {
+      itkExceptionMacro(<< "Error while reading image (GDAL format) '"
+        << m_FileName.c_str() << "' : " << blocksErrorMessage);
+      }
+
+    CPLErr lCrGdal = CE_None;
+    if (!readByBlocks)
+      {
+      lCrGdal = m_Dataset->GetDataSet()->RasterIO(GF_Read,
+                                                  lFirstColumn,
+                                                  lFirstLine,
+                                                  lNbColumns,
+                                                  lNbLines,
+                                                  p,
+                                                  lNbColumnsRegion,
+                                                  lNbLinesRegion,
+                                                  bufferType,
+                                                  nbBands,
+                                                  // All bands, or the selected ones
+                                                  bandMap.empty() ? ITK_NULLPTR : &bandMap[0],
+                                                  pixelOffset,
+                                                  lineOffset,
+                                                  bandOffset);
+      }
     chrono.Stop();
     otbMsgDevMacro(<< "RasterIO Read took " << chrono.GetTotal() << " sec")
 
@@ -439,6 +810,41 @@ void GDALImageIO::Read(void* buffer)
     }
 }
 
+bool GDALImageIO::CanReadBandSubset()
+{
+  if (m_Dataset.IsNull() || m_IsIndexed)
+    {
+    return false;
+    }
+
+  // Components must be the bands of the file
+  if (static_cast<int>(this->GetNumberOfComponents()) != m_NbBands)
+    {
+    return false;
+    }
+
+  return !(!GDALDataTypeIsComplex(m_PxType->pixType) && m_IsComplex && m_IsVectorImage && (m_NbBands > 1));
+}
+
+bool GDALImageIO::CanReadAsComponentType(IOComponentType type)
+{
+  // Conversion is only done in the nominal real case
+  if (!this->CanReadBandSubset() || GDALDataTypeIsComplex(m_PxType->pixType) || m_IsComplex)
+    {
+    return false;
+    }
+
+  const GDALDataType bufferType = GDALDataTypeFromComponentType(type);
+  if (bufferType == GDT_Unknown)
+    {
+    return false;
+    }
+
+  // Only accept types holding every value of the file type, so that the
+  // result is the same as the static_cast done by the reader
+  return GDALDataTypeUnion(m_PxType->pixType, bufferType) == bufferType;
+}
+
 bool GDALImageIO::GetSubDatasetInfo(std::vector<std::string> &names, std::vector<std::string> &desc)
 {
   // Note: we assume that the subdatasets are in order : SUBDATASET_ID_NAME, SUBDATASET_ID_DESC, SUBDATASET_ID+1_NAME, SUBDATASET_ID+1_DESC
@@ -621,6 +1027,7 @@ void GDALImageIO::InternalReadImageInformation()
       {
       otbMsgDevMacro(<< "Reading: " << names[m_DatasetNumber]);
       m_Dataset = GDALDriverManagerWrapper::GetInstance().Open(names[m_DatasetNumber]);
+      m_DatasetFileName = names[m_DatasetNumber];
       }
     else
       {
@@ -1336,6 +1743,36 @@ bool GDALImageIO::CanStreamWrite()
   return m_CanStreamWrite;
 }
 
+bool GDALImageIO::CanSkipEmptyRegions()
+{
+  // Streamed overviews are computed from every written pixel
+  if (FilenameToGdalDriverShortName(m_FileName) != "GTiff" || m_NumberOfOverviewsToWrite > 0)
+    {
+    return false;
+    }
+
+  for (unsigned int i = 0; i < m_CreationOptions.size(); ++i)
+    {
+    const std::string option = boost::algorithm::to_upper_copy(m_CreationOptions[i]);
+    if (option == "SPARSE_OK=TRUE" || option == "SPARSE_OK=YES"
+        || option == "SPARSE_OK=ON" || option == "SPARSE_OK=1")
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+bool GDALImageIO::CanResumeWrite()
+{
+  if (!this->CanStreamWrite())
+    {
+    return false;
+    }
+  const std::string driverShortName = FilenameToGdalDriverShortName(m_FileName);
+  return itksys::SystemTools::FileExists(GetGdalWriteImageFileName(driverShortName, m_FileName).c_str(), true);
+}
+
 void GDALImageIO::Write(const void* buffer)
 {
   // Check if we have to write the image information
@@ -1418,6 +1855,12 @@ void GDALImageIO::Write(const void* buffer)
       itkExceptionMacro(<< "Error while writing image (GDAL format) '"
         << m_FileName.c_str() << "' : " << CPLGetLastErrorMsg());
       }
+    // Decimate the region in the overviews
+    if (m_OverviewsWriter.IsNotNull())
+      {
+      m_OverviewsWriter->WriteRegion(buffer, lFirstColumn, lFirstLine, lNbColumns, lNbLines);
+      }
+
     // Flush dataset cache
     m_Dataset->GetDataSet()->FlushCache();
     }
@@ -1434,6 +1877,9 @@ void GDALImageIO::Write(const void* buffer)
       itkExceptionMacro(<< "Unable to instantiate driver " << gdalDriverShortName << " to write " << m_FileName);
       }
 
+    // Cached blocks would not see the new content
+    GDALBlockCache::GetInstance().Clear(realFileName);
+
     GDALCreationOptionsType creationOptions = m_CreationOptions;
     GDALDataset* hOutputDS = driver->CreateCopy( realFileName.c_str(), m_Dataset->GetDataSet(), FALSE,
                                                  otb::ogr::StringListConverter(creationOptions).to_ogr(),
@@ -1454,11 +1900,78 @@ void GDALImageIO::Write(const void* buffer)
       && lFirstColumn + lNbColumns == m_Dimensions[0])
     {
     // Last pixel written
+    if (m_OverviewsWriter.IsNotNull())
+      {
+      m_OverviewsWriter->Flush();
+      m_OverviewsWriter = ITK_NULLPTR;
+      }
+    if (m_RebuildOverviews && !m_Dataset.IsNull())
+      {
+      this->RebuildOverviews();
+      }
+    m_RebuildOverviews = false;
     // Reinitialize to close the file
     m_Dataset = GDALDatasetWrapperPointer();
     }
 }
 
+void GDALImageIO::RebuildOverviews()
+{
+  GDALDataset* dataset = m_Dataset->GetDataSet();
+
+  const char * resampling = "AVERAGE";
+  switch (m_OverviewsResampling)
+    {
+    case GDAL_RESAMPLING_NEAREST:
+      resampling = "NEAREST";
+      break;
+    case GDAL_RESAMPLING_GAUSS:
+      resampling = "GAUSS";
+      break;
+    case GDAL_RESAMPLING_CUBIC:
+      resampling = "CUBIC";
+      break;
+    case GDAL_RESAMPLING_MODE:
+      resampling = "MODE";
+      break;
+    case GDAL_RESAMPLING_AVERAGE_MAGPHASE:
+      resampling = "AVERAGE_MAGPHASE";
+      break;
+    default:
+      break;
+    }
+
+  // Recompute the levels created by the interrupted write
+  GDALRasterBand* band = dataset->GetRasterBand(1);
+  std::vector<int> factors;
+  for (int i = 0; i < band->GetOverviewCount(); ++i)
+    {
+    const int width = band->GetOverview(i)->GetXSize();
+    factors.push_back(static_cast<int>(vcl_floor(static_cast<double>(dataset->GetRasterXSize()) / width + 0.5)));
+    }
+  if (factors.empty())
+    {
+    for (unsigned int l = 0; l < m_NumberOfOverviewsToWrite; ++l)
+      {
+      factors.push_back(1 << (l + 1));
+      }
+    }
+
+  if (dataset->BuildOverviews(resampling, static_cast<int>(factors.size()), &factors[0], 0, ITK_NULLPTR,
+                              ITK_NULLPTR, ITK_NULLPTR) != CE_None)
+    {
+    itkExceptionMacro(<< "Error while building the overviews of " << m_FileName << " : " << CPLGetLastErrorMsg());
+    }
+}
+
+void GDALImageIO::Flush()
+{
+  if (m_CanStreamWrite && !m_Dataset.IsNull())
+    {
+    m_Dataset->GetDataSet()->FlushCache();
+    }
+}
+
 /** TODO : Methode WriteImageInformation non implementee */
 void GDALImageIO::WriteImageInformation()
 {
@@ -1469,6 +1982,8 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
   //char **     papszOptions = NULL;
   std::string driverShortName;
   m_NbBands = this->GetNumberOfComponents();
+  m_OverviewsWriter = ITK_NULLPTR;
+  m_RebuildOverviews = false;
 
   if ((m_Dimensions[0] == 0) && (m_Dimensions[1] == 0))
     {
@@ -1633,12 +2148,49 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
         }
       }
 */
-    m_Dataset = GDALDriverManagerWrapper::GetInstance().Create(
-                     driverShortName,
-                     GetGdalWriteImageFileName(driverShortName, m_FileName),
-                     m_Dimensions[0], m_Dimensions[1],
-                     m_NbBands, m_PxType->pixType,
-                     otb::ogr::StringListConverter(creationOptions).to_ogr());
+    // Overviews are meant to be read by tiles
+    if (m_NumberOfOverviewsToWrite > 0 && driverShortName == "GTiff"
+        && !CreationOptionContains("TILED="))
+      {
+      creationOptions.push_back("TILED=YES");
+      }
+
+    // Datasets pooled for reading and cached blocks would not see the
+    // new content
+    GDALDriverManagerWrapper::GetInstance().ClearDatasetPool(
+      GetGdalWriteImageFileName(driverShortName, m_FileName));
+    GDALBlockCache::GetInstance().Clear(GetGdalWriteImageFileName(driverShortName, m_FileName));
+
+    if (m_ResumeWriting)
+      {
+      // Complete the file of an interrupted write, which must have
+      // been created with the same image information
+      m_Dataset = GDALDriverManagerWrapper::GetInstance().Update(
+                       GetGdalWriteImageFileName(driverShortName, m_FileName));
+      if (m_Dataset.IsNull())
+        {
+        itkExceptionMacro(<< "Unable to reopen " << m_FileName << " to resume writing: " << CPLGetLastErrorMsg());
+        }
+      GDALDataset* existingDataset = m_Dataset->GetDataSet();
+      if (existingDataset->GetRasterXSize() != static_cast<int>(m_Dimensions[0])
+          || existingDataset->GetRasterYSize() != static_cast<int>(m_Dimensions[1])
+          || existingDataset->GetRasterCount() != static_cast<int>(m_NbBands)
+          || existingDataset->GetRasterBand(1)->GetRasterDataType() != m_PxType->pixType)
+        {
+        m_Dataset = GDALDatasetWrapperPointer();
+        itkExceptionMacro(<< "Unable to resume writing " << m_FileName
+                          << ": the existing file does not match the image to write");
+        }
+      }
+    else
+      {
+      m_Dataset = GDALDriverManagerWrapper::GetInstance().Create(
+                       driverShortName,
+                       GetGdalWriteImageFileName(driverShortName, m_FileName),
+                       m_Dimensions[0], m_Dimensions[1],
+                       m_NbBands, m_PxType->pixType,
+                       otb::ogr::StringListConverter(creationOptions).to_ogr());
+      }
     }
   else
     {
@@ -1847,6 +2399,28 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
         }
       }
     }
+
+  // Create the overviews once the image information is set
+  if (m_NumberOfOverviewsToWrite > 0)
+    {
+    if (m_ResumeWriting && m_CanStreamWrite)
+      {
+      // The pixels accumulated before the interruption are lost: the
+      // overviews are built from the whole file once it is complete
+      otbMsgDevMacro(<< "The overviews of " << m_FileName << " will be built once the resumed write is complete");
+      m_RebuildOverviews = true;
+      }
+    else if (m_CanStreamWrite && driverShortName == "GTiff")
+      {
+      m_OverviewsWriter = GDALStreamingOverviewsWriter::New();
+      m_OverviewsWriter->Initialize(dataset, m_NumberOfOverviewsToWrite, m_OverviewsResampling);
+      }
+    else
+      {
+      itkWarningMacro(<< "Overviews can only be written along with GTiff files, none will be written in "
+                      << m_FileName);
+      }
+    }
 }
 
 std::string GDALImageIO::FilenameToGdalDriverShortName(const std::string& name) const
@@ -0,0 +1,509 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGDALStreamingOverviewsWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "gdal_priv.h"
+#include "cpl_error.h"
+
+namespace otb
+{
+
+namespace
+{
+/** Add each pixel of a region to the sums of the pixel containing it
+ * at a twice lower resolution */
+template <class T>
+void AccumulateRegion(const char * buffer, int firstColumn, int firstLine, int nbColumns, int nbLines,
+                      int nbComponents, int firstSumColumn, int firstSumLine, int sumsWidth,
+                      double * sums, unsigned int * counts)
+{
+  const T * in = reinterpret_cast<const T *>(buffer);
+  for (int y = firstLine; y < firstLine + nbLines; ++y)
+    {
+    const size_t sumLine = static_cast<size_t>(y / 2 - firstSumLine) * sumsWidth;
+    for (int x = firstColumn; x < firstColumn + nbColumns; ++x)
+      {
+      const size_t p = sumLine + (x / 2 - firstSumColumn);
+      double * s = sums + p * nbComponents;
+      for (int c = 0; c < nbComponents; ++c)
+        {
+        s[c] += static_cast<double>(*in++);
+        }
+      ++counts[p];
+      }
+    }
+}
+
+/** Write the means of nbPixels pixels */
+template <class T>
+void ConvertMeans(const double * sums, const unsigned int * counts, int nbPixels, int nbComponents,
+                  char * buffer)
+{
+  T * out = reinterpret_cast<T *>(buffer);
+  for (int p = 0; p < nbPixels; ++p)
+    {
+    for (int c = 0; c < nbComponents; ++c)
+      {
+      const double mean = *sums++ / counts[p];
+      *out++ = static_cast<T>(std::numeric_limits<T>::is_integer ? std::floor(mean + 0.5) : mean);
+      }
+    }
+}
+
+void AccumulateRegion(GDALDataType type, const char * buffer, int firstColumn, int firstLine,
+                      int nbColumns, int nbLines, int nbComponents, int firstSumColumn,
+                      int firstSumLine, int sumsWidth, double * sums, unsigned int * counts)
+{
+  switch (type)
+    {
+    case GDT_Byte:
+      AccumulateRegion<unsigned char>(buffer, firstColumn, firstLine, nbColumns, nbLines, nbComponents,
+                                      firstSumColumn, firstSumLine, sumsWidth, sums, counts);
+      break;
+    case GDT_UInt16:
+      AccumulateRegion<unsigned short>(buffer, firstColumn, firstLine, nbColumns, nbLines, nbComponents,
+                                       firstSumColumn, firstSumLine, sumsWidth, sums, counts);
+      break;
+    case GDT_Int16:
+    case GDT_CInt16:
+      AccumulateRegion<short>(buffer, firstColumn, firstLine, nbColumns, nbLines, nbComponents,
+                              firstSumColumn, firstSumLine, sumsWidth, sums, counts);
+      break;
+    case GDT_UInt32:
+      AccumulateRegion<unsigned int>(buffer, firstColumn, firstLine, nbColumns, nbLines, nbComponents,
+                                     firstSumColumn, firstSumLine, sumsWidth, sums, counts);
+      break;
+    case GDT_Int32:
+    case GDT_CInt32:
+      AccumulateRegion<int>(buffer, firstColumn, firstLine, nbColumns, nbLines, nbComponents,
+                            firstSumColumn, firstSumLine, sumsWidth, sums, counts);
+      break;
+    case GDT_Float32:
+    case GDT_CFloat32:
+      AccumulateRegion<float>(buffer, firstColumn, firstLine, nbColumns, nbLines, nbComponents,
+                              firstSumColumn, firstSumLine, sumsWidth, sums, counts);
+      break;
+    default:
+      AccumulateRegion<double>(buffer, firstColumn, firstLine, nbColumns, nbLines, nbComponents,
+                               firstSumColumn, firstSumLine, sumsWidth, sums, counts);
+      break;
+    }
+}
+
+void ConvertMeans(GDALDataType type, const double * sums, const unsigned int * counts, int nbPixels,
+                  int nbComponents, char * buffer)
+{
+  switch (type)
+    {
+    case GDT_Byte:
+      ConvertMeans<unsigned char>(sums, counts, nbPixels, nbComponents, buffer);
+      break;
+    case GDT_UInt16:
+      ConvertMeans<unsigned short>(sums, counts, nbPixels, nbComponents, buffer);
+      break;
+    case GDT_Int16:
+    case GDT_CInt16:
+      ConvertMeans<short>(sums, counts, nbPixels, nbComponents, buffer);
+      break;
+    case GDT_UInt32:
+      ConvertMeans<unsigned int>(sums, counts, nbPixels, nbComponents, buffer);
+      break;
+    case GDT_Int32:
+    case GDT_CInt32:
+      ConvertMeans<int>(sums, counts, nbPixels, nbComponents, buffer);
+      break;
+    case GDT_Float32:
+    case GDT_CFloat32:
+      ConvertMeans<float>(sums, counts, nbPixels, nbComponents, buffer);
+      break;
+    default:
+      ConvertMeans<double>(sums, counts, nbPixels, nbComponents, buffer);
+      break;
+    }
+}
+}
+
+GDALStreamingOverviewsWriter
+::GDALStreamingOverviewsWriter()
+  : m_Dataset(ITK_NULLPTR),
+    m_Width(0),
+    m_Height(0),
+    m_NbBands(0),
+    m_DataType(GDT_Unknown),
+    m_BandBytes(0),
+    m_NbComponents(0),
+    m_Resampling(GDAL_RESAMPLING_AVERAGE)
+{
+}
+
+GDALStreamingOverviewsWriter
+::~GDALStreamingOverviewsWriter()
+{
+}
+
+void
+GDALStreamingOverviewsWriter
+::Initialize(GDALDataset * dataset, unsigned int nbLevels, GDALResampling resampling)
+{
+  m_Dataset = ITK_NULLPTR;
+  m_Levels.clear();
+
+  if (dataset == ITK_NULLPTR || dataset->GetRasterCount() == 0)
+    {
+    itkExceptionMacro(<< "No dataset to write the overviews in.");
+    }
+  if (resampling != GDAL_RESAMPLING_NEAREST && resampling != GDAL_RESAMPLING_AVERAGE)
+    {
+    itkExceptionMacro(<< "Only the NEAREST and AVERAGE resampling methods can be used to write the overviews along with the image.");
+    }
+  // Footprints of larger factors would overflow the pixel counts
+  if (nbLevels > 16)
+    {
+    itkExceptionMacro(<< "Can not write " << nbLevels << " overview levels (16 at most).");
+    }
+
+  m_Width = dataset->GetRasterXSize();
+  m_Height = dataset->GetRasterYSize();
+  m_NbBands = dataset->GetRasterCount();
+  const GDALDataType type = dataset->GetRasterBand(1)->GetRasterDataType();
+  m_DataType = type;
+  m_BandBytes = GDALGetDataTypeSize(type) / 8;
+  m_NbComponents = m_NbBands * (GDALDataTypeIsComplex(type) ? 2 : 1);
+  m_Resampling = resampling;
+
+  if (nbLevels == 0)
+    {
+    return;
+    }
+
+  std::vector<int> factors(nbLevels);
+  for (unsigned int l = 0; l < nbLevels; ++l)
+    {
+    factors[l] = 1 << (l + 1);
+    }
+
+  // Only create the levels: their content is written along with the
+  // full resolution
+  if (dataset->BuildOverviews("NONE", static_cast<int>(nbLevels), &factors[0], 0, ITK_NULLPTR,
+                              ITK_NULLPTR, ITK_NULLPTR) != CE_None)
+    {
+    itkExceptionMacro(<< "Unable to create the overviews : " << CPLGetLastErrorMsg());
+    }
+
+  for (unsigned int l = 0; l < nbLevels; ++l)
+    {
+    Level level;
+    level.factor = factors[l];
+    level.width = (m_Width + level.factor - 1) / level.factor;
+    level.height = (m_Height + level.factor - 1) / level.factor;
+
+    for (int band = 1; band <= m_NbBands; ++band)
+      {
+      GDALRasterBand * overview = dataset->GetRasterBand(band)->GetOverview(static_cast<int>(l));
+      if (overview == ITK_NULLPTR
+          || overview->GetXSize() != level.width
+          || overview->GetYSize() != level.height)
+        {
+        itkExceptionMacro(<< "The overview of factor " << level.factor << " of band " << band
+                          << " does not have the expected size " << level.width << "x" << level.height << ".");
+        }
+      }
+    m_Levels.push_back(level);
+    }
+
+  m_Dataset = dataset;
+}
+
+void
+GDALStreamingOverviewsWriter
+::WriteRegion(const void * buffer, int firstColumn, int firstLine, int nbColumns, int nbLines)
+{
+  if (m_Dataset == ITK_NULLPTR || m_Levels.empty() || nbColumns <= 0 || nbLines <= 0)
+    {
+    return;
+    }
+
+  const char * in = static_cast<const char *>(buffer);
+
+  if (m_Resampling == GDAL_RESAMPLING_NEAREST)
+    {
+    this->WriteNearestRegion(in, firstColumn, firstLine, nbColumns, nbLines);
+    return;
+    }
+
+  // Decimate slices of lines aligned on the largest factor: the sums
+  // of the first level then take a fraction of the size of the slice,
+  // whatever the size of the region
+  const int largestFactor = m_Levels.back().factor;
+  const int sliceHeight = largestFactor * std::max(1, 256 / largestFactor);
+  const size_t lineBytes = static_cast<size_t>(nbColumns) * m_NbBands * m_BandBytes;
+
+  const int lastLine = firstLine + nbLines;
+  for (int line = firstLine; line < lastLine; )
+    {
+    const int sliceEnd = std::min(lastLine, (line / sliceHeight + 1) * sliceHeight);
+    this->WriteAveragedRegion(in + static_cast<size_t>(line - firstLine) * lineBytes,
+                              firstColumn, line, nbColumns, sliceEnd - line);
+    line = sliceEnd;
+    }
+}
+
+void
+GDALStreamingOverviewsWriter
+::WriteAveragedRegion(const char * buffer, int firstColumn, int firstLine, int nbColumns, int nbLines)
+{
+  const int endColumn = firstColumn + nbColumns;
+  const int endLine = firstLine + nbLines;
+  const GDALDataType type = static_cast<GDALDataType>(m_DataType);
+
+  // Sums of the pixels of the current level touched by the region
+  int sumsX0 = firstColumn / 2;
+  int sumsY0 = firstLine / 2;
+  int sumsX1 = (endColumn + 1) / 2;
+  int sumsY1 = (endLine + 1) / 2;
+  int sumsWidth = sumsX1 - sumsX0;
+
+  std::vector<double> sums(static_cast<size_t>(sumsWidth) * (sumsY1 - sumsY0) * m_NbComponents, 0.);
+  std::vector<unsigned int> counts(static_cast<size_t>(sumsWidth) * (sumsY1 - sumsY0), 0);
+
+  AccumulateRegion(type, buffer, firstColumn, firstLine, nbColumns, nbLines, m_NbComponents,
+                   sumsX0, sumsY0, sumsWidth, &sums[0], &counts[0]);
+
+  for (unsigned int l = 0; l < m_Levels.size(); ++l)
+    {
+    Level & level = m_Levels[l];
+    const int f = level.factor;
+
+    // Pixels whose footprint is entirely in the region
+    const int completeX0 = (firstColumn + f - 1) / f;
+    const int completeY0 = (firstLine + f - 1) / f;
+    const int completeX1 = endColumn == m_Width ? level.width : endColumn / f;
+    const int completeY1 = endLine == m_Height ? level.height : endLine / f;
+    const bool hasComplete = completeX1 > completeX0 && completeY1 > completeY0;
+
+    if (hasComplete)
+      {
+      const size_t first = static_cast<size_t>(completeY0 - sumsY0) * sumsWidth + (completeX0 - sumsX0);
+      this->WriteMeans(l, &sums[first * m_NbComponents], &counts[first], sumsWidth,
+                       completeX0, completeY0, completeX1 - completeX0, completeY1 - completeY0);
+      }
+
+    // The other ones wait for the rest of their footprint
+    for (int y = sumsY0; y < sumsY1; ++y)
+      {
+      const bool completeLine = hasComplete && y >= completeY0 && y < completeY1;
+      for (int x = sumsX0; x < sumsX1; ++x)
+        {
+        if (completeLine && x == completeX0)
+          {
+          x = completeX1 - 1;
+          continue;
+          }
+
+        const size_t p = static_cast<size_t>(y - sumsY0) * sumsWidth + (x - sumsX0);
+        const std::pair<int, int> key(y, x);
+        PendingPixel & pending = level.pending[key];
+        if (pending.sums.empty())
+          {
+          pending.sums.assign(m_NbComponents, 0.);
+          pending.count = 0;
+          }
+        for (int c = 0; c < m_NbComponents; ++c)
+          {
+          pending.sums[c] += sums[p * m_NbComponents + c];
+          }
+        pending.count += counts[p];
+
+        if (pending.count == this->GetFootprintSize(level, x, y))
+          {
+          this->WriteMeans(l, &pending.sums[0], &pending.count, 1, x, y, 1, 1);
+          level.pending.erase(key);
+          }
+        }
+      }
+
+    if (l + 1 == m_Levels.size())
+      {
+      break;
+      }
+
+    // Sums of the next level
+    const int nextX0 = sumsX0 / 2;
+    const int nextY0 = sumsY0 / 2;
+    const int nextX1 = (sumsX1 + 1) / 2;
+    const int nextY1 = (sumsY1 + 1) / 2;
+    const int nextWidth = nextX1 - nextX0;
+
+    std::vector<double> nextSums(static_cast<size_t>(nextWidth) * (nextY1 - nextY0) * m_NbComponents, 0.);
+    std::vector<unsigned int> nextCounts(static_cast<size_t>(nextWidth) * (nextY1 - nextY0), 0);
+
+    for (int y = sumsY0; y < sumsY1; ++y)
+      {
+      for (int x = sumsX0; x < sumsX1; ++x)
+        {
+        const size_t p = static_cast<size_t>(y - sumsY0) * sumsWidth + (x - sumsX0);
+        const size_t n = static_cast<size_t>(y / 2 - nextY0) * nextWidth + (x / 2 - nextX0);
+        for (int c = 0; c < m_NbComponents; ++c)
+          {
+          nextSums[n * m_NbComponents + c] += sums[p * m_NbComponents + c];
+          }
+        nextCounts[n] += counts[p];
+        }
+      }
+
+    sums.swap(nextSums);
+    counts.swap(nextCounts);
+    sumsX0 = nextX0;
+    sumsY0 = nextY0;
+    sumsX1 = nextX1;
+    sumsY1 = nextY1;
+    sumsWidth = nextWidth;
+    }
+}
+
+void
+GDALStreamingOverviewsWriter
+::WriteNearestRegion(const char * buffer, int firstColumn, int firstLine, int nbColumns, int nbLines)
+{
+  const int endColumn = firstColumn + nbColumns;
+  const int endLine = firstLine + nbLines;
+  const size_t pixelBytes = static_cast<size_t>(m_NbBands) * m_BandBytes;
+  const size_t lineBytes = pixelBytes * nbColumns;
+
+  std::vector<char> decimated;
+
+  for (unsigned int l = 0; l < m_Levels.size(); ++l)
+    {
+    const int f = m_Levels[l].factor;
+
+    // Pixels whose top left source pixel is in the region
+    const int x0 = (firstColumn + f - 1) / f;
+    const int y0 = (firstLine + f - 1) / f;
+    const int x1 = (endColumn + f - 1) / f;
+    const int y1 = (endLine + f - 1) / f;
+    if (x1 <= x0 || y1 <= y0)
+      {
+      continue;
+      }
+
+    const int width = x1 - x0;
+    const int height = y1 - y0;
+    decimated.resize(static_cast<size_t>(width) * height * pixelBytes);
+
+    char * out = &decimated[0];
+    for (int y = y0; y < y1; ++y)
+      {
+      const char * in = buffer + static_cast<size_t>(y * f - firstLine) * lineBytes
+        + static_cast<size_t>(x0 * f - firstColumn) * pixelBytes;
+      for (int x = x0; x < x1; ++x, in += f * pixelBytes, out += pixelBytes)
+        {
+        std::memcpy(out, in, pixelBytes);
+        }
+      }
+
+    this->WriteLevel(l, &decimated[0], x0, y0, width, height);
+    }
+}
+
+void
+GDALStreamingOverviewsWriter
+::WriteMeans(unsigned int level, const double * sums, const unsigned int * counts,
+             int lineStride, int firstColumn, int firstLine, int nbColumns, int nbLines)
+{
+  const GDALDataType type = static_cast<GDALDataType>(m_DataType);
+  const size_t lineBytes = static_cast<size_t>(nbColumns) * m_NbBands * m_BandBytes;
+
+  std::vector<char> means(lineBytes * nbLines);
+  for (int y = 0; y < nbLines; ++y)
+    {
+    const size_t first = static_cast<size_t>(y) * lineStride;
+    ConvertMeans(type, sums + first * m_NbComponents, counts + first, nbColumns, m_NbComponents,
+                 &means[y * lineBytes]);
+    }
+
+  this->WriteLevel(level, &means[0], firstColumn, firstLine, nbColumns, nbLines);
+}
+
+void
+GDALStreamingOverviewsWriter
+::WriteLevel(unsigned int level, char * buffer, int firstColumn, int firstLine, int nbColumns, int nbLines)
+{
+  const int pixelBytes = m_NbBands * m_BandBytes;
+
+  for (int band = 0; band < m_NbBands; ++band)
+    {
+    GDALRasterBand * overview = m_Dataset->GetRasterBand(band + 1)->GetOverview(static_cast<int>(level));
+    CPLErr lCrGdal = overview->RasterIO(GF_Write, firstColumn, firstLine, nbColumns, nbLines,
+                                        buffer + band * m_BandBytes, nbColumns, nbLines,
+                                        static_cast<GDALDataType>(m_DataType),
+                                        pixelBytes, pixelBytes * nbColumns);
+    if (lCrGdal == CE_Failure)
+      {
+      itkExceptionMacro(<< "Error while writing the overview of factor " << m_Levels[level].factor
+                        << " : " << CPLGetLastErrorMsg());
+      }
+    }
+}
+
+void
+GDALStreamingOverviewsWriter
+::Flush()
+{
+  for (unsigned int l = 0; l < m_Levels.size(); ++l)
+    {
+    PendingPixelMapType & pending = m_Levels[l].pending;
+    for (PendingPixelMapType::iterator it = pending.begin(); it != pending.end(); ++it)
+      {
+      this->WriteMeans(l, &it->second.sums[0], &it->second.count, 1,
+                       it->first.second, it->first.first, 1, 1);
+      }
+    pending.clear();
+    }
+}
+
+size_t
+GDALStreamingOverviewsWriter
+::GetNumberOfPendingPixels() const
+{
+  size_t nbPending = 0;
+  for (unsigned int l = 0; l < m_Levels.size(); ++l)
+    {
+    nbPending += m_Levels[l].pending.size();
+    }
+  return nbPending;
+}
+
+unsigned int
+GDALStreamingOverviewsWriter
+::GetFootprintSize(const Level & level, int column, int line) const
+{
+  const int x = column * level.factor;
+  const int y = line * level.factor;
+  return static_cast<unsigned int>(std::min(level.factor, m_Width - x))
+    * static_cast<unsigned int>(std::min(level.factor, m_Height - y));
+}
+
+} // end namespace otb
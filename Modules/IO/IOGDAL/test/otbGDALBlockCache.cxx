@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGDALBlockCache.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIterator.h"
+
+namespace
+{
+typedef otb::VectorImage<float, 2>      ImageType;
+typedef otb::ImageFileReader<ImageType> ReaderType;
+typedef otb::ImageFileWriter<ImageType> WriterType;
+
+ImageType::Pointer ReadImage(const std::string& filename)
+{
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(filename);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool CompareImages(const ImageType* image, const ImageType* reference)
+{
+  if (image->GetLargestPossibleRegion() != reference->GetLargestPossibleRegion())
+    {
+    std::cerr << "Images have different regions" << std::endl;
+    return false;
+    }
+  itk::ImageRegionConstIterator<ImageType> it(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> refIt(reference, reference->GetLargestPossibleRegion());
+  for (it.GoToBegin(), refIt.GoToBegin(); !it.IsAtEnd(); ++it, ++refIt)
+    {
+    if (it.Get() != refIt.Get())
+      {
+      std::cerr << "Pixel " << it.GetIndex() << " is " << it.Get()
+                << " instead of " << refIt.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+void WriteImage(const ImageType* image, const std::string& filename)
+{
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(filename);
+  writer->SetInput(image);
+  writer->Update();
+}
+}
+
+/** Read the same file with two readers through the block cache, then
+ * rewrite it and check that the blocks of the old file are not reused */
+int otbGDALBlockCache(int itkNotUsed(argc), char* argv[])
+{
+  const std::string inputFilename = argv[1];
+  const std::string rewrittenFilename = argv[2];
+  otb::GDALBlockCache& cache = otb::GDALBlockCache::GetInstance();
+
+  // Reference, without cache
+  cache.SetMaximumSize(0);
+  ImageType::Pointer reference = ReadImage(inputFilename);
+
+  cache.SetMaximumSize(64 * 1024 * 1024);
+  cache.ResetStatistics();
+
+  ImageType::Pointer first = ReadImage(inputFilename);
+  const unsigned long long nbDecodedBlocks = cache.GetNumberOfMisses();
+  std::cout << "First reader: " << cache.GetNumberOfHits() << " hits, "
+            << nbDecodedBlocks << " misses, " << cache.GetSize() << " bytes cached" << std::endl;
+
+  ImageType::Pointer second = ReadImage(inputFilename);
+  std::cout << "Second reader: " << cache.GetNumberOfHits() << " hits, "
+            << cache.GetNumberOfMisses() << " misses, " << cache.GetSize() << " bytes cached" << std::endl;
+
+  bool ok = CompareImages(first, reference) && CompareImages(second, reference);
+
+  // The second reader must not decode any block
+  if (nbDecodedBlocks == 0
+      || cache.GetNumberOfMisses() != nbDecodedBlocks
+      || cache.GetNumberOfHits() != nbDecodedBlocks)
+    {
+    std::cerr << "The blocks of the second reader were not all found in the cache" << std::endl;
+    ok = false;
+    }
+
+  // A cache too small for a single block is not used
+  cache.SetMaximumSize(1);
+  cache.ResetStatistics();
+  ImageType::Pointer uncached = ReadImage(inputFilename);
+  ok = CompareImages(uncached, reference) && ok;
+  if (cache.GetNumberOfHits() + cache.GetNumberOfMisses() != 0 || cache.GetNumberOfBlocks() != 0)
+    {
+    std::cerr << "Blocks larger than the cache were looked up" << std::endl;
+    ok = false;
+    }
+
+  // Blocks of a file rewritten since they were cached are not reused
+  cache.SetMaximumSize(64 * 1024 * 1024);
+  WriteImage(reference, rewrittenFilename);
+  ImageType::Pointer beforeRewrite = ReadImage(rewrittenFilename);
+  ok = CompareImages(beforeRewrite, reference) && ok;
+
+  // Smaller image with other values, so that the file size changes even
+  // when the rewrite happens within the resolution of the mtime
+  ImageType::RegionType rewrittenRegion;
+  rewrittenRegion.SetSize(0, reference->GetLargestPossibleRegion().GetSize(0) / 2);
+  rewrittenRegion.SetSize(1, reference->GetLargestPossibleRegion().GetSize(1) / 2);
+  ImageType::Pointer rewritten = ImageType::New();
+  rewritten->SetRegions(rewrittenRegion);
+  rewritten->SetNumberOfComponentsPerPixel(reference->GetNumberOfComponentsPerPixel());
+  rewritten->Allocate();
+  itk::ImageRegionIterator<ImageType> rewrittenIt(rewritten, rewrittenRegion);
+  itk::ImageRegionConstIterator<ImageType> refIt(reference, rewrittenRegion);
+  for (rewrittenIt.GoToBegin(), refIt.GoToBegin(); !rewrittenIt.IsAtEnd(); ++rewrittenIt, ++refIt)
+    {
+    ImageType::PixelType pixel = refIt.Get();
+    pixel += 1;
+    rewrittenIt.Set(pixel);
+    }
+  WriteImage(rewritten, rewrittenFilename);
+
+  cache.ResetStatistics();
+  ImageType::Pointer afterRewrite = ReadImage(rewrittenFilename);
+  if (!CompareImages(afterRewrite, rewritten) || cache.GetNumberOfHits() != 0)
+    {
+    std::cerr << "Blocks of the rewritten file were read from the cache" << std::endl;
+    ok = false;
+    }
+
+  cache.SetMaximumSize(0);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
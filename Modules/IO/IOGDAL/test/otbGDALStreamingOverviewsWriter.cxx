@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cmath>
+#include <sstream>
+
+#include "otbGDALDriverManagerWrapper.h"
+#include "otbGDALStreamingOverviewsWriter.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+
+int otbGDALStreamingOverviewsWriterNew(int itkNotUsed(argc), char* itkNotUsed(argv) [])
+{
+  otb::GDALStreamingOverviewsWriter::Pointer object = otb::GDALStreamingOverviewsWriter::New();
+
+  std::cout << object << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+/** Write an image with its overviews, and check them against the
+ * overviews computed from the written file */
+int otbGDALStreamingOverviewsWriter(int itkNotUsed(argc), char* argv[])
+{
+  const char * inputFilename  = argv[1];
+  const char * outputFilename = argv[2];
+  const int    nbLevels       = atoi(argv[3]);
+  const std::string method(argv[4]);
+  const char * streaming      = argv[5];
+
+  typedef otb::VectorImage<unsigned short, 2> ImageType;
+  typedef otb::ImageFileReader<ImageType>     ReaderType;
+  typedef otb::ImageFileWriter<ImageType>     WriterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+
+  std::ostringstream extendedFilename;
+  extendedFilename << outputFilename << "?&overviews=" << nbLevels
+                   << "&overviews:method=" << method << streaming;
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(reader->GetOutput());
+  writer->SetFileName(extendedFilename.str());
+  writer->Update();
+
+  otb::GDALDatasetWrapper::Pointer wrapper = otb::GDALDriverManagerWrapper::GetInstance().Open(outputFilename);
+  if (wrapper.IsNull())
+    {
+    std::cerr << "Unable to open " << outputFilename << std::endl;
+    return EXIT_FAILURE;
+    }
+  GDALDataset * dataset = wrapper->GetDataSet();
+  const int width = dataset->GetRasterXSize();
+  const int height = dataset->GetRasterYSize();
+
+  bool ok = true;
+  for (int band = 1; band <= dataset->GetRasterCount(); ++band)
+    {
+    GDALRasterBand * rasterBand = dataset->GetRasterBand(band);
+    if (rasterBand->GetOverviewCount() != nbLevels)
+      {
+      std::cerr << "Band " << band << " has " << rasterBand->GetOverviewCount()
+                << " overviews instead of " << nbLevels << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    std::vector<double> image(static_cast<size_t>(width) * height);
+    if (rasterBand->RasterIO(GF_Read, 0, 0, width, height, &image[0], width, height,
+                             GDT_Float64, 0, 0) != CE_None)
+      {
+      std::cerr << "Unable to read band " << band << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    for (int level = 0; level < nbLevels; ++level)
+      {
+      const int factor = 1 << (level + 1);
+      GDALRasterBand * overview = rasterBand->GetOverview(level);
+      const int ovWidth = overview->GetXSize();
+      const int ovHeight = overview->GetYSize();
+      if (ovWidth != (width + factor - 1) / factor || ovHeight != (height + factor - 1) / factor)
+        {
+        std::cerr << "Overview " << level << " of band " << band << " has a wrong size: "
+                  << ovWidth << "x" << ovHeight << std::endl;
+        ok = false;
+        continue;
+        }
+
+      std::vector<double> values(static_cast<size_t>(ovWidth) * ovHeight);
+      overview->RasterIO(GF_Read, 0, 0, ovWidth, ovHeight, &values[0], ovWidth, ovHeight,
+                         GDT_Float64, 0, 0);
+
+      unsigned int nbErrors = 0;
+      for (int y = 0; y < ovHeight; ++y)
+        {
+        for (int x = 0; x < ovWidth; ++x)
+          {
+          double expected = image[static_cast<size_t>(y * factor) * width + x * factor];
+          if (method == "average")
+            {
+            double sum = 0.;
+            unsigned int count = 0;
+            for (int j = y * factor; j < std::min(height, (y + 1) * factor); ++j)
+              {
+              for (int i = x * factor; i < std::min(width, (x + 1) * factor); ++i)
+                {
+                sum += image[static_cast<size_t>(j) * width + i];
+                ++count;
+                }
+              }
+            expected = std::floor(sum / count + 0.5);
+            }
+
+          const double value = values[static_cast<size_t>(y) * ovWidth + x];
+          if (value != expected)
+            {
+            if (nbErrors < 10)
+              {
+              std::cerr << "Overview " << level << " of band " << band << ", pixel (" << x << ", " << y
+                        << "): " << value << " instead of " << expected << std::endl;
+              }
+            ++nbErrors;
+            }
+          }
+        }
+      ok = ok && nbErrors == 0;
+      }
+    }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -25,8 +25,11 @@ void RegisterTests()
   REGISTER_TEST(otbGDALImageIOTest_uint8);
   REGISTER_TEST(otbGDALImageIOTest_uint16);
   REGISTER_TEST(otbGDALImageIOTestWriteMetadata);
+  REGISTER_TEST(otbGDALBlockCache);
   REGISTER_TEST(otbGDALOverviewsBuilderNew);
   REGISTER_TEST(otbGDALOverviewsBuilder);
+  REGISTER_TEST(otbGDALStreamingOverviewsWriterNew);
+  REGISTER_TEST(otbGDALStreamingOverviewsWriter);
   REGISTER_TEST(otbOGRVectorDataIONew);
   REGISTER_TEST(otbGDALImageIOTestCanWrite);
   REGISTER_TEST(otbOGRVectorDataIOCanWrite);
@@ -22,6 +22,7 @@
 #define otbLUMImageIO_h
 
 #include "otbImageIOBase.h"
+#include "otbMemoryMappedFile.h"
 #include <fstream>
 #include <string>
 #include <vector>
@@ -190,6 +191,8 @@ private:
   std::string                 m_TypeLum; //used for write
   otb::ImageIOBase::ByteOrder m_FileByteOrder;
   std::fstream                m_File;
+  /** Mapping of the file, used for reading when possible */
+  MemoryMappedFile            m_FileMapping;
 
 };
 
@@ -147,7 +147,20 @@ void LUMImageIO::Read(void* buffer)
   std::streamsize numberOfBytesToBeRead = static_cast<std::streamsize>(this->GetComponentSize() * lNbColumns);
   std::streamsize numberOfBytesRead;
   std::streamsize cpt = 0;
-  for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+
+  // Copy the region directly from the mapped file if possible
+  const bool mappedRead = m_FileMapping.Open(m_FileName)
+    && m_FileMapping.ReadRegion(
+         static_cast<size_t>(headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine)
+                             + static_cast<std::streamoff>(this->GetComponentSize() * lFirstColumn)),
+         static_cast<size_t>(numberOfBytesPerLines),
+         static_cast<size_t>(lNbLines),
+         static_cast<size_t>(numberOfBytesToBeRead),
+         this->GetComponentSize(),
+         this->GetComponentSize(),
+         p);
+
+  for (int LineNo = lFirstLine; !mappedRead && LineNo < lFirstLine + lNbLines; LineNo++)
     {
     offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
     offset +=  static_cast<std::streamoff>(this->GetComponentSize() * lFirstColumn);
@@ -191,6 +204,7 @@ void LUMImageIO::ReadImageInformation()
     {
     m_File.close();
     }
+  m_FileMapping.Close();
 
   m_File.open(m_FileName.c_str(),  std::ios::in | std::ios::binary);
   if (m_File.fail())
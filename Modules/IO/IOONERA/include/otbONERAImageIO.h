@@ -23,6 +23,7 @@
 
 #include "itkByteSwapper.h"
 #include "otbImageIOBase.h"
+#include "otbMemoryMappedFile.h"
 #include <fstream>
 
 namespace otb
@@ -147,6 +148,8 @@ protected:
   /** Buffer*/
   //float **pafimas;
   std::fstream m_Datafile;
+  /** Mapping of the data file, used for reading when possible */
+  MemoryMappedFile m_DataMapping;
   std::fstream m_Headerfile;
 
 private:
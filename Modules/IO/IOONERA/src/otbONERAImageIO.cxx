@@ -185,22 +185,35 @@ void ONERAImageIO::Read(void* buffer)
   otbMsgDevMacro(<< " Region read (IORegion)  : " << this->GetIORegion());
   otbMsgDevMacro(<< " Nb Of Components  : " << this->GetNumberOfComponents());
 
-  //read header information file:
-  if (!this->OpenOneraDataFileForReading(m_FileName.c_str()))
-    {
-    itkExceptionMacro(<< "Cannot read requested file");
-    }
-
   std::streamoff  numberOfBytesPerLines = static_cast<std::streamoff>(2 * m_width * m_BytePerPixel);
   std::streamoff  headerLength = ONERA_HEADER_LENGTH + numberOfBytesPerLines;
   std::streamoff  offset;
   std::streamsize numberOfBytesToBeRead = 2 * m_BytePerPixel * lNbColumns;
   std::streamsize numberOfBytesRead;
 
+  // Copy the region directly from the mapped data file if possible,
+  // which also avoids reopening the data file at each read
+  const bool mappedRead = m_DataMapping.Open(System::GetRootName(m_FileName) + ".dat")
+    && m_DataMapping.ReadRegion(
+         static_cast<size_t>(headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine)
+                             + static_cast<std::streamoff>(m_BytePerPixel * lFirstColumn)),
+         static_cast<size_t>(numberOfBytesPerLines),
+         static_cast<size_t>(lNbLines),
+         static_cast<size_t>(numberOfBytesToBeRead),
+         static_cast<size_t>(m_BytePerPixel),
+         static_cast<size_t>(m_BytePerPixel),
+         reinterpret_cast<char*>(p));
+
+  //read header information file:
+  if (!mappedRead && !this->OpenOneraDataFileForReading(m_FileName.c_str()))
+    {
+    itkExceptionMacro(<< "Cannot read requested file");
+    }
+
   char*           value = new char[numberOfBytesToBeRead];
   std::streamsize cpt = 0;
 
-  for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+  for (int LineNo = lFirstLine; !mappedRead && LineNo < lFirstLine + lNbLines; LineNo++)
     {
     offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
     offset +=  static_cast<std::streamoff>(m_BytePerPixel * lFirstColumn);
@@ -299,6 +312,7 @@ void ONERAImageIO::ReadImageInformation()
 
 void ONERAImageIO::InternalReadImageInformation()
 {
+  m_DataMapping.Close();
 
   if (!this->OpenOneraDataFileForReading(m_FileName.c_str()))
     {
@@ -22,6 +22,7 @@
 #define otbRADImageIO_h
 
 #include "otbImageIOBase.h"
+#include "otbMemoryMappedFile.h"
 #include <fstream>
 #include <string>
 #include <vector>
@@ -181,6 +182,8 @@ private:
   std::string                 m_TypeRAD;
   std::vector<std::string>    m_ChannelsFileName;
   std::fstream *              m_ChannelsFile;
+  /** Mappings of the channel files, used for reading when possible */
+  MemoryMappedFile *          m_ChannelsMapping;
   unsigned int                m_NbOfChannels;
   int                         m_BytePerPixel;
 
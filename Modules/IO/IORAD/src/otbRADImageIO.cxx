@@ -65,6 +65,7 @@ RADImageIO::RADImageIO()
   m_Origin[0] = 0.5;
   m_Origin[1] = 0.5;
   m_ChannelsFile = ITK_NULLPTR;
+  m_ChannelsMapping = ITK_NULLPTR;
   m_FlagWriteImageInformation = true;
 
   this->AddSupportedWriteExtension(".rad");
@@ -93,6 +94,7 @@ RADImageIO::~RADImageIO()
       }
     delete[] m_ChannelsFile;
     }
+  delete[] m_ChannelsMapping;
 }
 
 bool RADImageIO::CanReadFile(const char* filename)
@@ -177,6 +179,23 @@ void RADImageIO::Read(void* buffer)
   for (unsigned int numChannel = 0; numChannel < m_NbOfChannels; ++numChannel)
     {
     cpt = (unsigned long) (numChannel) * (unsigned long) (m_BytePerPixel);
+
+    // Copy the region directly from the mapped channel file if possible
+    if (m_ChannelsMapping != ITK_NULLPTR
+        && m_ChannelsMapping[numChannel].Open(m_ChannelsFileName[numChannel])
+        && m_ChannelsMapping[numChannel].ReadRegion(
+             static_cast<size_t>(headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine)
+                                 + static_cast<std::streamoff>(m_BytePerPixel * lFirstColumn)),
+             static_cast<size_t>(numberOfBytesPerLines),
+             static_cast<size_t>(lNbLines),
+             static_cast<size_t>(numberOfBytesToBeRead),
+             static_cast<size_t>(m_BytePerPixel),
+             step,
+             p + cpt))
+      {
+      continue;
+      }
+
     //Read region of the channel
     for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
       {
@@ -467,6 +486,10 @@ bool RADImageIO::InternalReadHeaderInformation(const std::string& file_name, std
 
   m_ChannelsFile = new std::fstream[m_NbOfChannels];
 
+  // Channel files are mapped at the first read
+  delete[] m_ChannelsMapping;
+  m_ChannelsMapping = new MemoryMappedFile[m_NbOfChannels];
+
   // Try to open channels file
   for (unsigned int channels = 0; channels < m_ChannelsFileName.size(); ++channels)
     {
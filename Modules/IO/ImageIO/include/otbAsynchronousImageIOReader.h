@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbAsynchronousImageIOReader_h
+#define otbAsynchronousImageIOReader_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "otbImageIOBase.h"
+
+#include <thread>
+
+namespace otb
+{
+
+/** \class AsynchronousImageIOReader
+ * \brief Reads a region through an ImageIO from a background thread.
+ *
+ * This class is used by ImageFileReader to read the region the
+ * streaming will request next while the current one is being
+ * processed downstream. Start() reads the given region into a staging
+ * buffer from a dedicated thread, and Take() later hands this buffer
+ * over if the region finally requested is the same, so that the caller
+ * swaps it with its own buffer instead of copying it. The staging
+ * buffer is given by the caller along with the object owning it.
+ *
+ * Once Start() has been called, the ImageIO must not be used by any
+ * other thread until Wait() or Take() returns. The ImageIO settings
+ * other than the IO region and the read component type (file name,
+ * band list, ...) are the ones it holds when Start() is called.
+ *
+ * Errors raised while reading ahead are not reported: the staged
+ * region is discarded, so that the next regular read raises them.
+ *
+ * \sa ImageFileReader
+ *
+ * \ingroup OTBImageIO
+ */
+class ITK_EXPORT AsynchronousImageIOReader : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef AsynchronousImageIOReader     Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(AsynchronousImageIOReader, itk::Object);
+
+  /** Set/Get the ImageIO used to read ahead */
+  itkSetObjectMacro(ImageIO, otb::ImageIOBase);
+  itkGetObjectMacro(ImageIO, otb::ImageIOBase);
+
+  /** Start reading size bytes of the given region into buffer,
+   * converted to the given component type (UNKNOWNCOMPONENTTYPE to keep
+   * the file type). bufferOwner is held until the staged region is
+   * taken or released, and must keep buffer allocated. Any region
+   * previously staged is discarded. */
+  void Start(const itk::ImageIORegion& region,
+             ImageIOBase::IOComponentType componentType,
+             itk::LightObject* bufferOwner, void* buffer, size_t size);
+
+  /** Wait for the read ahead to complete. The staged region is kept. */
+  void Wait();
+
+  /** Wait for the read ahead to complete, and return the owner of the
+   * staging buffer if it matches the given region, component type and
+   * size, a null pointer otherwise. The staged region is released in
+   * any case. */
+  itk::LightObject::Pointer Take(const itk::ImageIORegion& region,
+                                 ImageIOBase::IOComponentType componentType,
+                                 size_t size);
+
+  /** Wait for the read ahead to complete and release the staged
+   * region and its buffer */
+  void Clear();
+
+  /** Return true if the background thread is running */
+  bool IsRunning() const
+  {
+    return m_Thread.joinable();
+  }
+
+  /** Return true if a region is being read or has been read ahead */
+  bool HasStagedRegion() const
+  {
+    return m_Staged;
+  }
+
+protected:
+  AsynchronousImageIOReader();
+  ~AsynchronousImageIOReader() ITK_OVERRIDE;
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  AsynchronousImageIOReader(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** Body of the background thread */
+  void ThreadedRead();
+
+  otb::ImageIOBase::Pointer m_ImageIO;
+
+  std::thread m_Thread;
+
+  itk::ImageIORegion           m_Region;
+  ImageIOBase::IOComponentType m_ComponentType;
+
+  /** Staging buffer and the object owning it */
+  itk::LightObject::Pointer    m_BufferOwner;
+  void*                        m_Buffer;
+  size_t                       m_BufferSize;
+
+  /** True between Start() and the release of the staged region */
+  bool m_Staged;
+
+  /** Set by the background thread if the read failed */
+  bool m_Failed;
+};
+
+} // end namespace otb
+
+#endif
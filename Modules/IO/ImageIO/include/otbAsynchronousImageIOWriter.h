@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbAsynchronousImageIOWriter_h
+#define otbAsynchronousImageIOWriter_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "otbImageIOBase.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace otb
+{
+
+/** \class AsynchronousImageIOWriter
+ * \brief Writes buffers through an ImageIO from a dedicated I/O thread.
+ *
+ * This class is used by ImageFileWriter to overlap the computation of
+ * a stream division with the writing (and compression) of the
+ * previous one. Buffers are queued with Push(), which only blocks when
+ * the maximum number of pending buffers is reached, and are written in
+ * order by a single thread owning the ImageIO.
+ *
+ * Once Start() has been called, the ImageIO must not be used by any
+ * other thread until Stop() returns. Errors raised by the ImageIO in
+ * the I/O thread are rethrown by the next call to Push() or Stop().
+ *
+ * Buffers handed back to the writer are recycled: AcquireBuffer()
+ * returns a previously written buffer when one is available, so that
+ * at most MaximumNumberOfPendingBuffers + 1 buffers are allocated
+ * during a whole streamed write.
+ *
+ * \sa ImageFileWriter
+ *
+ * \ingroup OTBImageIO
+ */
+class ITK_EXPORT AsynchronousImageIOWriter : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef AsynchronousImageIOWriter     Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(AsynchronousImageIOWriter, itk::Object);
+
+  typedef std::vector<char> BufferType;
+
+  /** Function called by the I/O thread once a buffer is written */
+  typedef std::function<void()> WrittenCallbackType;
+
+  /** Set/Get the ImageIO used to write the buffers */
+  itkSetObjectMacro(ImageIO, otb::ImageIOBase);
+  itkGetObjectMacro(ImageIO, otb::ImageIOBase);
+
+  /** Set/Get the maximum number of buffers waiting to be written. Push()
+   * blocks as long as this number is reached. Default is 1, values
+   * lower than 1 are treated as 1. */
+  itkSetMacro(MaximumNumberOfPendingBuffers, unsigned int);
+  itkGetConstMacro(MaximumNumberOfPendingBuffers, unsigned int);
+
+  /** Start the I/O thread */
+  void Start();
+
+  /** Get a buffer of the given size in bytes, reusing an already
+   * written one if possible */
+  void AcquireBuffer(BufferType& buffer, size_t size);
+
+  /** Queue the buffer to be written in the given IO region. The
+   * content of buffer is swapped with an empty buffer. The optional
+   * callback is called from the I/O thread right after the buffer is
+   * written, with the ImageIO still owned by this thread. */
+  void Push(const itk::ImageIORegion& region, BufferType& buffer,
+            const WrittenCallbackType& written = WrittenCallbackType());
+
+  /** Wait for all pending buffers to be written and stop the I/O
+   * thread. */
+  void Stop();
+
+  /** Stop the I/O thread without reporting errors. Pending buffers are
+   * discarded. Used to clean up when the streaming is interrupted. */
+  void Abort();
+
+  /** Return true if the I/O thread is running */
+  bool IsRunning() const
+  {
+    return m_Thread.joinable();
+  }
+
+protected:
+  AsynchronousImageIOWriter();
+  ~AsynchronousImageIOWriter() ITK_OVERRIDE;
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  AsynchronousImageIOWriter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  struct JobType
+  {
+    itk::ImageIORegion  Region;
+    BufferType          Buffer;
+    WrittenCallbackType Written;
+  };
+
+  /** Body of the I/O thread */
+  void ThreadedWrite();
+
+  /** Rethrow the error raised in the I/O thread, if any */
+  void RethrowPendingError();
+
+  otb::ImageIOBase::Pointer m_ImageIO;
+
+  unsigned int m_MaximumNumberOfPendingBuffers;
+
+  std::thread             m_Thread;
+  std::mutex              m_Mutex;
+  std::condition_variable m_QueueNotEmpty;
+  std::condition_variable m_QueueNotFull;
+
+  std::deque<JobType>     m_Queue;
+  std::vector<BufferType> m_FreeBuffers;
+
+  /** True while the I/O thread is writing a buffer popped from the queue */
+  bool m_Writing;
+  bool m_StopRequested;
+
+  std::exception_ptr m_Error;
+};
+
+} // end namespace otb
+
+#endif
@@ -32,10 +32,13 @@
 #include "otbImageIOBase.h"
 #include "itkExceptionObject.h"
 #include "itkImageRegion.h"
+#include "itkImportImageContainer.h"
 
 #include "otbDefaultConvertPixelTraits.h"
 #include "otbImageKeywordlist.h"
 #include "otbExtendedFilenameToReaderOptions.h"
+#include "otbAsynchronousImageIOReader.h"
+#include "otbReadAheadInterface.h"
 
 namespace otb
 {
@@ -76,6 +79,14 @@ public:
  * http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for more
  * information.
  *
+ * When ReadAhead is on, the reader starts reading the region the
+ * streaming will request next from a background thread as soon as the
+ * current region has been read, so that reading overlaps with the
+ * processing of the current region. The next region is given by the
+ * streaming sink (see ReadAheadInterface). It is read in a buffer of
+ * its own, which becomes the pixel container of the output when the
+ * region is requested, so that no copy is done.
+ *
  * \sa ExtendedFilenameToReaderOptions
  * \sa ImageSeriesReader
  * \sa ImageIOBase
@@ -88,7 +99,8 @@ public:
 template <class TOutputImage,
           class ConvertPixelTraits=DefaultConvertPixelTraits<
                    typename TOutputImage::IOPixelType > >
-class ITK_EXPORT ImageFileReader : public itk::ImageSource<TOutputImage>
+class ITK_EXPORT ImageFileReader : public itk::ImageSource<TOutputImage>,
+                                   public ReadAheadInterface
 {
 public:
   /** Standard class typedefs. */
@@ -114,6 +126,9 @@ public:
   /** The pixel type of the output image. */
   typedef typename TOutputImage::InternalPixelType OutputImagePixelType;
 
+  /** The pixel container of the output image. */
+  typedef typename TOutputImage::PixelContainer      PixelContainerType;
+
   /** The Filename Helper. */
   typedef ExtendedFilenameToReaderOptions            FNameHelperType;
 
@@ -156,6 +171,28 @@ public:
    * Returns: overview info, empty if none.*/
   std::vector<std::string> GetOverviewsInfo();
 
+  /** Set/Get whether the next streaming region is read in advance.
+   * Off by default, also set by the readahead extended filename
+   * option. */
+  itkSetMacro(ReadAhead, bool);
+  itkGetConstMacro(ReadAhead, bool);
+  itkBooleanMacro(ReadAhead);
+
+  /** Read the region currently requested to the output after the next
+   * update (ReadAheadInterface) */
+  void RecordReadAheadRegion() ITK_OVERRIDE;
+
+  /** Forget the region to read ahead (ReadAheadInterface) */
+  void ResetReadAhead() ITK_OVERRIDE;
+
+  /** Bytes of the buffer reading the whole output ahead
+   * (ReadAheadInterface) */
+  unsigned long long GetReadAheadMemoryPrint() const ITK_OVERRIDE;
+
+  /** Get the number of regions taken from the data read ahead instead
+   * of being read by the update requesting them */
+  itkGetConstMacro(NumberOfRegionsReadAhead, unsigned int);
+
 protected:
   ImageFileReader();
   ~ImageFileReader() ITK_OVERRIDE;
@@ -170,6 +207,27 @@ private:
    * an appropriate message otherwise. */
   void TestValidImageIO();
 
+  /** Compute the IO region to read for the given output region */
+  itk::ImageIORegion ComputeIORegion(const ImageRegionType& region) const;
+
+  /** Buffer the ImageIO reads into before a type conversion */
+  typedef itk::ImportImageContainer<itk::SizeValueType, char> LoadBufferType;
+
+  /** Read the current IO region of m_ImageIO. Return the container
+   * read ahead if it holds this region, so that it replaces the given
+   * one, or read the region in the given container and return it. */
+  template <class TContainer>
+  typename TContainer::Pointer ReadIORegion(TContainer* container,
+                                            ImageIOBase::IOComponentType componentType);
+
+  /** Start reading the recorded region ahead, with as many container
+   * elements per pixel as the region read last. The read is done in
+   * spare, a container no longer used, if it has the right size, in a
+   * new container otherwise. */
+  template <class TContainer>
+  void StartReadAhead(TContainer* spare, size_t nbElementsPerPixel,
+                      ImageIOBase::IOComponentType componentType);
+
   /** Generate the filename (for GDALImageI for example). If filename is a directory, look if is a
     * CEOS product (file "DAT...") In this case, the GdalFileName contain the open image file.
     */
@@ -207,6 +265,16 @@ private:
    *  This variable can be the number of components in m_ImageIO or the
    *  number of components in the m_BandList (if used) */
   unsigned int m_IOComponents;
+
+  bool m_ReadAhead;
+
+  /** Output region to read after the next update */
+  ImageRegionType m_ReadAheadRegion;
+  bool            m_ReadAheadRegionIsSet;
+
+  unsigned int    m_NumberOfRegionsReadAhead;
+
+  AsynchronousImageIOReader::Pointer m_AsynchronousReader;
 };
 
 } //namespace otb
@@ -26,6 +26,7 @@
 
 #include "otbSystem.h"
 #include <itksys/SystemTools.hxx>
+#include <algorithm>
 #include <fstream>
 #include <string>
 
@@ -33,6 +34,7 @@
 #include "itkPixelTraits.h"
 #include "itkVectorImage.h"
 #include "itkMetaDataObject.h"
+#include "itkMultiThreader.h"
 
 #include "otbConvertPixelBuffer.h"
 #include "otbImageIOFactory.h"
@@ -69,7 +71,12 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
    m_FilenameHelper(FNameHelperType::New()),
    m_AdditionalNumber(0),
    m_KeywordListUpToDate(false),
-   m_IOComponents(0)
+   m_IOComponents(0),
+   m_ReadAhead(false),
+   m_ReadAheadRegion(),
+   m_ReadAheadRegionIsSet(false),
+   m_NumberOfRegionsReadAhead(0),
+   m_AsynchronousReader(AsynchronousImageIOReader::New())
 {
 }
 
@@ -77,6 +84,8 @@ template <class TOutputImage, class ConvertPixelTraits>
 ImageFileReader<TOutputImage, ConvertPixelTraits>
 ::~ImageFileReader()
 {
+  // The background thread may still use the ImageIO
+  m_AsynchronousReader->Clear();
 }
 
 template <class TOutputImage, class ConvertPixelTraits>
@@ -100,6 +109,8 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>
   os << indent << "m_UseStreaming flag: " << this->m_UseStreaming << "\n";
   os << indent << "m_ActualIORegion: " << this->m_ActualIORegion << "\n";
   os << indent << "m_AdditionalNumber: " << this->m_AdditionalNumber << "\n";
+  os << indent << "m_ReadAhead flag: " << this->m_ReadAhead << "\n";
+  os << indent << "m_NumberOfRegionsReadAhead: " << this->m_NumberOfRegionsReadAhead << "\n";
 }
 
 template <class TOutputImage, class ConvertPixelTraits>
@@ -110,6 +121,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
   itkDebugMacro("setting ImageIO to " << imageIO );
   if (this->m_ImageIO != imageIO )
     {
+    m_AsynchronousReader->Clear();
     this->m_ImageIO = imageIO;
     this->Modified();
     }
@@ -132,11 +144,133 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
   // i.e. if this->m_ImageIO is Null
   this->TestValidImageIO();
 
+  // The ImageIO may still be reading ahead
+  m_AsynchronousReader->Wait();
+
   // Tell the ImageIO to read the file
-  OutputImagePixelType *buffer =
-    output->GetPixelContainer()->GetBufferPointer();
   this->m_ImageIO->SetFileName(this->m_FileName.c_str());
 
+  itk::ImageIORegion ioRegion = this->ComputeIORegion(output->GetRequestedRegion());
+  this->m_ImageIO->SetIORegion(ioRegion);
+
+  // When a band range is set, let the ImageIO read only the selected bands
+  // if it supports it, instead of reading all of them and remapping
+  const bool readBandSubset = m_FilenameHelper->BandRangeIsSet()
+                              && this->m_ImageIO->CanReadBandSubset();
+  if (readBandSubset)
+    {
+    this->m_ImageIO->SetBandList(m_BandList);
+    }
+  else
+    {
+    this->m_ImageIO->SetBandList(std::vector<unsigned int>());
+    }
+
+  // Let the ImageIO decode the blocks of the region concurrently
+  unsigned int nbReadThreads = 1;
+  if (m_FilenameHelper->ReadThreadsIsSet())
+    {
+    nbReadThreads = m_FilenameHelper->GetReadThreads();
+    if (nbReadThreads == 0)
+      {
+      nbReadThreads = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+      }
+    }
+  this->m_ImageIO->SetNumberOfReadThreads(nbReadThreads);
+
+  const size_t nbPixels = output->GetBufferedRegion().GetNumberOfPixels();
+
+  typedef otb::DefaultConvertPixelTraits<typename TOutputImage::IOPixelType> ConvertIOPixelTraits;
+  typedef otb::DefaultConvertPixelTraits<typename TOutputImage::PixelType>   ConvertOutputPixelTraits;
+
+  // Component type of the output buffer, used to let the ImageIO do the
+  // type conversion itself when it can
+  const ImageIOBase::IOComponentType outputComponentType =
+    ImageIOBase::MapComponentType(typeid(typename ConvertOutputPixelTraits::ComponentType));
+  this->m_ImageIO->SetReadComponentType(ImageIOBase::UNKNOWNCOMPONENTTYPE);
+
+  bool readIntoOutput = false;
+  ImageIOBase::IOComponentType readComponentType = ImageIOBase::UNKNOWNCOMPONENTTYPE;
+
+  if (this->m_ImageIO->GetComponentTypeInfo()
+      == typeid(typename ConvertOutputPixelTraits::ComponentType)
+      && (m_IOComponents == ConvertIOPixelTraits::GetNumberOfComponents())
+      && (!m_FilenameHelper->BandRangeIsSet() || readBandSubset))
+    {
+    // Have the ImageIO read directly into the allocated buffer
+    readComponentType = ImageIOBase::UNKNOWNCOMPONENTTYPE;
+    readIntoOutput = true;
+    }
+  else if (ConvertIOPixelTraits::GetNumberOfComponents() == 1
+           && m_IOComponents == output->GetNumberOfComponentsPerPixel()
+           && (!m_FilenameHelper->BandRangeIsSet() || readBandSubset)
+           && this->m_ImageIO->CanReadAsComponentType(outputComponentType))
+    {
+    // Components only differ by their type (e.g. uint16 file read in a
+    // float image): have the ImageIO convert them while reading directly
+    // into the allocated buffer
+    readComponentType = outputComponentType;
+    readIntoOutput = true;
+    }
+
+  if (readIntoOutput)
+    {
+    typename PixelContainerType::Pointer allocated = output->GetPixelContainer();
+    typename PixelContainerType::Pointer filled =
+      this->ReadIORegion(allocated.GetPointer(), readComponentType);
+    if (filled != allocated)
+      {
+      // Swap the pixel containers: the one just allocated reads the next
+      // region ahead
+      output->SetPixelContainer(filled);
+      }
+    this->StartReadAhead(filled != allocated ? allocated.GetPointer() : ITK_NULLPTR,
+                         nbPixels > 0 ? filled->Size() / nbPixels : 0,
+                         readComponentType);
+    }
+  else // a type conversion is necessary
+    {
+    // note: char is used here because the buffer is read in bytes
+    // regardless of the actual type of the pixels.
+    ImageRegionType region = output->GetBufferedRegion();
+
+    // Adapt the image size with the region and take into account a potential
+    // remapping of the components. m_BandList is empty if no band range is set
+    const unsigned int nbLoadedComponents = readBandSubset
+      ? static_cast<unsigned int>(m_BandList.size())
+      : std::max(this->m_ImageIO->GetNumberOfComponents(),(unsigned int) m_BandList.size());
+    std::streamoff nbBytes =
+      ( this->m_ImageIO->GetComponentSize() * nbLoadedComponents )
+      * static_cast<std::streamoff>(region.GetNumberOfPixels());
+
+    LoadBufferType::Pointer loadBuffer = LoadBufferType::New();
+    loadBuffer->Reserve(static_cast<itk::SizeValueType>(nbBytes));
+
+    otbMsgDevMacro(<< "buffer size for ImageIO::read = " << nbBytes << " = \n"
+        << "ComponentSize ("<< this->m_ImageIO->GetComponentSize() << ") x " \
+        << "Nb of Component (" << nbLoadedComponents << ") x " \
+        << "Nb of Pixel to read (" << region.GetNumberOfPixels() << ")");
+
+    LoadBufferType::Pointer filledBuffer =
+      this->ReadIORegion(loadBuffer.GetPointer(), ImageIOBase::UNKNOWNCOMPONENTTYPE);
+
+    if (m_FilenameHelper->BandRangeIsSet() && !readBandSubset)
+      this->m_ImageIO->DoMapBuffer(filledBuffer->GetBufferPointer(), region.GetNumberOfPixels(), this->m_BandList);
+
+    this->DoConvertBuffer(filledBuffer->GetBufferPointer(), region.GetNumberOfPixels());
+
+    // The buffer read ahead can be used again for the next region
+    this->StartReadAhead(filledBuffer.GetPointer(),
+                         nbPixels > 0 ? static_cast<size_t>(nbBytes) / nbPixels : 0,
+                         ImageIOBase::UNKNOWNCOMPONENTTYPE);
+    }
+}
+
+template <class TOutputImage, class ConvertPixelTraits>
+itk::ImageIORegion
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::ComputeIORegion(const ImageRegionType& region) const
+{
   itk::ImageIORegion ioRegion(TOutputImage::ImageDimension);
 
   itk::ImageIORegion::SizeType  ioSize = ioRegion.GetSize();
@@ -149,7 +283,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
     if (i < this->m_ImageIO->GetNumberOfDimensions())
       {
       if (!this->m_ImageIO->CanStreamRead()) dimSize[i] = this->m_ImageIO->GetDimensions(i);
-      else dimSize[i] = output->GetRequestedRegion().GetSize()[i];
+      else dimSize[i] = region.GetSize()[i];
       }
     else
       {
@@ -165,10 +299,9 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
     ioSize[i] = dimSize[i];
     }
 
-  typedef typename TOutputImage::IndexType IndexType;
   IndexType start;
   if (!this->m_ImageIO->CanStreamRead()) start.Fill(0);
-  else start = output->GetRequestedRegion().GetIndex();
+  else start = region.GetIndex();
   for (unsigned int i = 0; i < start.GetIndexDimension(); ++i)
     {
     ioStart[i] = start[i];
@@ -177,51 +310,114 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
   ioRegion.SetSize(ioSize);
   ioRegion.SetIndex(ioStart);
 
-  this->m_ImageIO->SetIORegion(ioRegion);
+  return ioRegion;
+}
 
-  typedef otb::DefaultConvertPixelTraits<typename TOutputImage::IOPixelType> ConvertIOPixelTraits;
-  typedef otb::DefaultConvertPixelTraits<typename TOutputImage::PixelType>   ConvertOutputPixelTraits;
+template <class TOutputImage, class ConvertPixelTraits>
+template <class TContainer>
+typename TContainer::Pointer
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::ReadIORegion(TContainer* container, ImageIOBase::IOComponentType componentType)
+{
+  const size_t size = container->Size() * sizeof(typename TContainer::Element);
 
-  if (this->m_ImageIO->GetComponentTypeInfo()
-      == typeid(typename ConvertOutputPixelTraits::ComponentType)
-      && (this->m_ImageIO->GetNumberOfComponents()
-          == ConvertIOPixelTraits::GetNumberOfComponents())
-      && !m_FilenameHelper->BandRangeIsSet())
+  if (m_AsynchronousReader->HasStagedRegion())
+    {
+    itk::LightObject::Pointer staged =
+      m_AsynchronousReader->Take(this->m_ImageIO->GetIORegion(), componentType, size);
+    TContainer* stagedContainer = dynamic_cast<TContainer*>(staged.GetPointer());
+    if (stagedContainer != ITK_NULLPTR)
+      {
+      ++m_NumberOfRegionsReadAhead;
+      return stagedContainer;
+      }
+    }
+
+  this->m_ImageIO->SetReadComponentType(componentType);
+  this->m_ImageIO->Read(container->GetBufferPointer());
+  this->m_ImageIO->SetReadComponentType(ImageIOBase::UNKNOWNCOMPONENTTYPE);
+  return container;
+}
+
+template <class TOutputImage, class ConvertPixelTraits>
+template <class TContainer>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::StartReadAhead(TContainer* spare, size_t nbElementsPerPixel,
+                 ImageIOBase::IOComponentType componentType)
+{
+  if (!m_ReadAhead || !m_ReadAheadRegionIsSet || nbElementsPerPixel == 0
+      || !this->m_ImageIO->CanStreamRead())
     {
-    // Have the ImageIO read directly into the allocated buffer
-    this->m_ImageIO->Read(buffer);
     return;
     }
-  else // a type conversion is necessary
+  m_ReadAheadRegionIsSet = false;
+
+  // The next region is usually the same size as this one: read it with
+  // the same number of bytes per pixel and the same ImageIO settings
+  ImageRegionType nextRegion = m_ReadAheadRegion;
+  if (!nextRegion.Crop(this->GetOutput()->GetLargestPossibleRegion())
+      || nextRegion == this->GetOutput()->GetBufferedRegion())
     {
-    // note: char is used here because the buffer is read in bytes
-    // regardless of the actual type of the pixels.
-    ImageRegionType region = output->GetBufferedRegion();
+    return;
+    }
 
-    // Adapt the image size with the region and take into account a potential
-    // remapping of the components. m_BandList is empty if no band range is set
-    std::streamoff nbBytes =
-      ( this->m_ImageIO->GetComponentSize()
-      * std::max(this->m_ImageIO->GetNumberOfComponents(),(unsigned int) m_BandList.size()))
-      * static_cast<std::streamoff>(region.GetNumberOfPixels());
+  const size_t nbElements = nbElementsPerPixel * nextRegion.GetNumberOfPixels();
+  typename TContainer::Pointer buffer = spare;
+  if (buffer.IsNull() || buffer->Size() != nbElements)
+    {
+    buffer = TContainer::New();
+    buffer->Reserve(nbElements);
+    }
 
-    char * loadBuffer = new char[nbBytes];
+  otbMsgDevMacro(<< "Reading region " << nextRegion << " ahead");
+  m_AsynchronousReader->SetImageIO(this->m_ImageIO);
+  m_AsynchronousReader->Start(this->ComputeIORegion(nextRegion), componentType,
+                              buffer.GetPointer(), buffer->GetBufferPointer(),
+                              nbElements * sizeof(typename TContainer::Element));
+}
 
-    otbMsgDevMacro(<< "buffer size for ImageIO::read = " << nbBytes << " = \n"
-        << "ComponentSize ("<< this->m_ImageIO->GetComponentSize() << ") x " \
-        << "Nb of Component ( max(" << this->m_ImageIO->GetNumberOfComponents() \
-        << " , "<<m_BandList.size() << ") ) x " \
-        << "Nb of Pixel to read (" << region.GetNumberOfPixels() << ")");
+template <class TOutputImage, class ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::RecordReadAheadRegion()
+{
+  m_ReadAheadRegion = this->GetOutput()->GetRequestedRegion();
+  m_ReadAheadRegionIsSet = true;
+}
 
-    this->m_ImageIO->Read(loadBuffer);
+template <class TOutputImage, class ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::ResetReadAhead()
+{
+  m_ReadAheadRegionIsSet = false;
+  m_AsynchronousReader->Clear();
+}
 
-    if (m_FilenameHelper->BandRangeIsSet())
-      this->m_ImageIO->DoMapBuffer(loadBuffer, region.GetNumberOfPixels(), this->m_BandList);
+template <class TOutputImage, class ConvertPixelTraits>
+unsigned long long
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::GetReadAheadMemoryPrint() const
+{
+  if (!m_ReadAhead || this->m_ImageIO.IsNull())
+    {
+    return 0;
+    }
 
-    this->DoConvertBuffer(loadBuffer, region.GetNumberOfPixels());
+  // The region is read ahead either in the output pixel container or in
+  // a buffer of the file components, before their conversion
+  typedef otb::DefaultConvertPixelTraits<typename TOutputImage::PixelType> ConvertOutputPixelTraits;
+  const unsigned long long componentSize = std::max<unsigned long long>(
+    this->m_ImageIO->GetComponentSize(), sizeof(typename ConvertOutputPixelTraits::ComponentType));
 
-    delete[] loadBuffer;
+  unsigned long long nbPixels = 1;
+  for (unsigned int i = 0; i < this->m_ImageIO->GetNumberOfDimensions(); ++i)
+    {
+    nbPixels *= this->m_ImageIO->GetDimensions(i);
     }
+
+  return componentSize * this->m_ImageIO->GetNumberOfComponents() * nbPixels;
 }
 
 template <class TOutputImage, class ConvertPixelTraits>
@@ -253,6 +449,14 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
 {
   typename TOutputImage::Pointer output = this->GetOutput();
 
+  // The file or the options may have changed: drop what was read ahead
+  this->ResetReadAhead();
+
+  if (m_FilenameHelper->ReadAheadIsSet())
+    {
+    m_ReadAhead = m_FilenameHelper->GetReadAhead();
+    }
+
   // Check to see if we can read the file given the name or prefix
   if (this->m_FileName == "")
   {
@@ -25,6 +25,12 @@
 #include "itkProcessObject.h"
 #include "otbStreamingManager.h"
 #include "otbExtendedFilenameToWriterOptions.h"
+#include "otbAsynchronousImageIOWriter.h"
+#include "otbReadAheadInterface.h"
+#include "otbEmptyDivisionPredicate.h"
+#include "otbStreamingWriteJournal.h"
+
+#include <map>
 
 namespace otb
 {
@@ -46,6 +52,40 @@ namespace otb
  * ImageFileWriter will write directly the streaming buffer in the image file, so
  * that the output image never needs to be completely allocated
  *
+ * When the number of asynchronous buffers is greater than 0 (see
+ * SetNumberOfAsynchronousBuffers() or the asyncwrite extended filename
+ * option), each division is copied to a buffer which is written by a
+ * dedicated I/O thread, so that the next division is computed while
+ * the previous one is being written. These buffers are accounted for
+ * by the RAM driven streaming managers.
+ *
+ * Before updating a division, ImageFileWriter tells the upstream
+ * sources reading ahead (see ReadAheadInterface, for instance an
+ * ImageFileReader with the readahead option) which region the next
+ * division will request them, so that they read it while the current
+ * division is processed.
+ *
+ * Pipelines scaling poorly inside a division can be given concurrent
+ * inputs (see AddConcurrentInput()): copies of the input pipeline,
+ * made of distinct objects, computing the same image. Consecutive
+ * divisions are then computed at the same time, one per pipeline, and
+ * written in order. The available RAM is shared between the pipelines.
+ *
+ * Divisions holding no data can be detected beforehand by an
+ * EmptyDivisionPredicate (see SetEmptyDivisionPredicate()). They are
+ * not computed: they are filled with the no-data value of the input,
+ * or left unwritten when the ImageIO reads unwritten regions back as
+ * no-data (GeoTIFF created with the SPARSE_OK option).
+ *
+ * A resumable write (see SetResumable(), or the resume extended
+ * filename option) records each division once it is stored in the file
+ * in a journal next to the output (see StreamingWriteJournal). If the
+ * write is interrupted and run again with the same output (region,
+ * pixel type, origin and spacing), streaming and pipeline signature
+ * (see SetPipelineSignature()), the output is reopened and only the
+ * divisions missing from the journal are computed. The journal is
+ * removed once the write completes.
+ *
  * ImageFileWriter supports extended filenames, which allow controlling
  * some properties of the output file. See
  * http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for more
@@ -93,6 +133,10 @@ public:
   itkStaticConstMacro(InputImageDimension, unsigned int,
                       InputImageType::ImageDimension);
 
+  /** Predicate telling which divisions hold no data */
+  typedef EmptyDivisionPredicate<InputImageType>         EmptyDivisionPredicateType;
+  typedef typename EmptyDivisionPredicateType::Pointer   EmptyDivisionPredicatePointerType;
+
   /** Streaming manager base class pointer */
   typedef StreamingManager<InputImageType>       StreamingManagerType;
   typedef typename StreamingManagerType::Pointer StreamingManagerPointerType;
@@ -159,6 +203,15 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /**  Set the streaming mode to 'blocks' and configure the number of MB
+   *   available. The actual number of divisions is computed automatically
+   *   by estimating the memory consumption of the pipeline.
+   *   Splits are made of whole blocks of the input files, aligned on
+   *   them, and never exceed the available RAM.
+   *   Setting the availableRAM parameter to 0 means that the available RAM
+   *   is set from the CMake configuration option */
+  void SetAutomaticBlockAlignedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
   /** Set the only input of the writer */
   using Superclass::SetInput;
   virtual void SetInput(const InputImageType *input);
@@ -166,6 +219,43 @@ public:
   /** Get writer only input */
   const InputImageType* GetInput();
 
+  /** Add an image produced by an independent copy of the pipeline of
+   * the input: same filters with the same parameters, but no shared
+   * process object. Each concurrent input computes one division while
+   * the input computes another one, in a separate thread. During the
+   * write, the filters of each pipeline are given their share of the
+   * threads. Persistent filters and filters that are not thread-safe
+   * across instances must not be part of these pipelines. */
+  void AddConcurrentInput(const InputImageType *input);
+
+  /** Remove all the concurrent inputs */
+  void ClearConcurrentInputs();
+
+  /** Get the number of concurrent inputs */
+  unsigned int GetNumberOfConcurrentInputs() const
+  {
+    return static_cast<unsigned int>(m_ConcurrentInputs.size());
+  }
+
+  /** Set/Get the predicate telling which divisions hold no data. The
+   * divisions it reports as empty are not computed: they are filled
+   * with the no-data value of each band of the input (0 for the bands
+   * without one), or not written at all if the ImageIO can skip them
+   * (see ImageIOBase::CanSkipEmptyRegions()). */
+  void SetEmptyDivisionPredicate(EmptyDivisionPredicateType * predicate)
+  {
+    m_EmptyDivisionPredicate = predicate;
+    this->Modified();
+  }
+
+  EmptyDivisionPredicateType * GetEmptyDivisionPredicate()
+  {
+    return m_EmptyDivisionPredicate;
+  }
+
+  /** Get the number of divisions found empty by the last update */
+  itkGetConstMacro(NumberOfEmptyDivisions, unsigned int);
+
   /** Override Update() from ProcessObject because this filter
    *  has no output. */
   void Update() ITK_OVERRIDE;
@@ -199,6 +289,34 @@ public:
   itkGetObjectMacro(ImageIO, otb::ImageIOBase);
   itkGetConstObjectMacro(ImageIO, otb::ImageIOBase);
 
+  /** Set/Get the maximum number of divisions waiting to be written by
+   * the I/O thread while the pipeline computes the next one. 0 (the
+   * default) disables asynchronous writing. */
+  itkSetMacro(NumberOfAsynchronousBuffers, unsigned int);
+  itkGetConstMacro(NumberOfAsynchronousBuffers, unsigned int);
+
+  /** Set/Get whether an interrupted write can be resumed. The divisions
+   * are then flushed to the file and recorded in the journal
+   * <filename>.journal as soon as they are written. The ImageIO must be
+   * able to reopen the file (see ImageIOBase::CanResumeWrite()). The
+   * upstream pipeline is expected to compute the same image as the
+   * interrupted write. Default is false. */
+  itkSetMacro(Resumable, bool);
+  itkGetConstMacro(Resumable, bool);
+  itkBooleanMacro(Resumable);
+
+  /** Get the number of divisions already written by an interrupted
+   * write and skipped by the last update */
+  itkGetConstMacro(NumberOfResumedDivisions, unsigned int);
+
+  /** Set/Get a string identifying how the input is computed, for
+   * instance a hash of the parameters of the application producing it.
+   * It is part of the journal signature of a resumable write, so that
+   * the divisions written by a different computation are not kept.
+   * Empty by default. */
+  itkSetStringMacro(PipelineSignature);
+  itkGetStringMacro(PipelineSignature);
+
 protected:
   ImageFileWriter();
   ~ImageFileWriter() ITK_OVERRIDE;
@@ -207,6 +325,57 @@ protected:
   /** Does the real work. */
   void GenerateData(void) ITK_OVERRIDE;
 
+  /** Write the current IO region from the buffer of input, which is
+   * either the input or one of the concurrent inputs */
+  void WriteInputRegion(const InputImageType * input);
+
+  /** Update the divisions from first on, one per pipeline (the input
+   * and the concurrent inputs), at the same time */
+  void UpdateConcurrentDivisions(unsigned int first);
+
+  /** Write the current IO region filled with the no-data value of
+   * input */
+  void WriteNoDataRegion(const InputImageType * input);
+
+  /** Return true if the given division was found empty */
+  bool IsEmptyDivision(unsigned int division) const
+  {
+    return !m_EmptyDivisions.empty() && m_EmptyDivisions[division];
+  }
+
+  /** Return true if the given division was written by an interrupted
+   * write */
+  bool IsCompletedDivision(unsigned int division) const
+  {
+    return m_Journal.IsNotNull() && m_Journal->IsCompleted(division);
+  }
+
+  /** Store the division in the file and record it in the journal. Called
+   * from the I/O thread in asynchronous mode. */
+  void CommitDivision(unsigned int division);
+
+  /** Describe the output and its divisions, so that a journal is only
+   * resumed by the same write */
+  std::string ComputeJournalSignature(const InputImageRegionType& inputRegion);
+
+  /** Copy the data to write in a buffer (applying the band mapping if
+   * any) and queue it to the asynchronous writer */
+  void QueueAsynchronousWrite(const void* dataPtr, size_t numberOfPixels);
+
+  /** Find the sources upstream of the input which read ahead */
+  void FindReadAheadSources(std::vector<ReadAheadInterface*>& sources);
+
+  typedef std::map<itk::ProcessObject*, itk::ThreadIdType> NumberOfThreadsMapType;
+
+  /** Share the default number of threads between the pipelines of the
+   * input and of the concurrent inputs: their process objects are given
+   * at most their share. Their previous number of threads is stored in
+   * previousNumberOfThreads. */
+  void ShareThreadsBetweenPipelines(NumberOfThreadsMapType& previousNumberOfThreads);
+
+  /** Give the process objects their number of threads back */
+  void RestoreNumberOfThreads(const NumberOfThreadsMapType& previousNumberOfThreads);
+
 private:
   ImageFileWriter(const ImageFileWriter &); //purposely not implemented
   void operator =(const ImageFileWriter&); //purposely not implemented
@@ -270,6 +439,37 @@ private:
    *  This variable can be the number of components in m_ImageIO or the
    *  number of components in the m_BandList (if used) */
   unsigned int m_IOComponents;
+
+  /** Maximum number of divisions queued for asynchronous writing */
+  unsigned int m_NumberOfAsynchronousBuffers;
+
+  /** Whether the current Update() writes asynchronously */
+  bool m_AsynchronousWriting;
+
+  /** Size in bytes of a component and of a pixel before band mapping,
+   * cached for asynchronous writing since the ImageIO then belongs to
+   * the I/O thread */
+  size_t m_IOComponentSize;
+  size_t m_InputPixelSize;
+
+  AsynchronousImageIOWriter::Pointer m_AsynchronousWriter;
+
+  /** Copies of the input computing divisions concurrently */
+  std::vector<InputImagePointer> m_ConcurrentInputs;
+
+  EmptyDivisionPredicatePointerType m_EmptyDivisionPredicate;
+
+  /** Divisions found empty by the predicate, if any */
+  std::vector<bool> m_EmptyDivisions;
+  unsigned int      m_NumberOfEmptyDivisions;
+
+  bool m_Resumable;
+
+  std::string m_PipelineSignature;
+
+  /** Journal of the divisions written, during a resumable write */
+  StreamingWriteJournal::Pointer m_Journal;
+  unsigned int                   m_NumberOfResumedDivisions;
 };
 
 } // end namespace otb
@@ -30,12 +30,17 @@
 #include "otbImageIOFactory.h"
 
 #include "itkImageRegionIterator.h"
+#include "itkMultiThreader.h"
+#include "itksys/SystemTools.hxx"
 
 #include "itkMetaDataObject.h"
 #include "otbImageKeywordlist.h"
 #include "otbMetaDataKey.h"
+#include "otbNoDataHelper.h"
+#include "otbDefaultConvertPixelTraits.h"
 
 #include "otbConfigure.h"
+#include "otbConfigurationManager.h"
 
 #include "otbNumberOfDivisionsStrippedStreamingManager.h"
 #include "otbNumberOfDivisionsTiledStreamingManager.h"
@@ -44,11 +49,19 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
 
 #include "otb_boost_tokenizer_header.h"
 
 #include "otbStringUtils.h"
 
+#include <algorithm>
+#include <exception>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <thread>
+
 namespace otb
 {
 
@@ -70,7 +83,15 @@ ImageFileWriter<TInputImage>
     m_FilenameHelper(),
     m_IsObserving(true),
     m_ObserverID(0),
-    m_IOComponents(0)
+    m_IOComponents(0),
+    m_NumberOfAsynchronousBuffers(0),
+    m_AsynchronousWriting(false),
+    m_IOComponentSize(0),
+    m_InputPixelSize(0),
+    m_NumberOfEmptyDivisions(0),
+    m_Resumable(false),
+    m_PipelineSignature(),
+    m_NumberOfResumedDivisions(0)
 {
   //Init output index shift
   m_ShiftOutputIndex.Fill(0);
@@ -80,6 +101,8 @@ ImageFileWriter<TInputImage>
   this->SetAutomaticAdaptativeStreaming();
 
   m_FilenameHelper = FNameHelperType::New();
+
+  m_AsynchronousWriter = AsynchronousImageIOWriter::New();
 }
 
 /**
@@ -176,6 +199,18 @@ ImageFileWriter<TInputImage>
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::SetAutomaticBlockAlignedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef RAMDrivenBlockAlignedStreamingManager<TInputImage> RAMDrivenBlockAlignedStreamingManagerType;
+  typename RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager = RAMDrivenBlockAlignedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  m_StreamingManager = streamingManager;
+}
+
 #ifndef ITK_LEGACY_REMOVE
 
 #endif // ITK_LEGACY_REMOVE
@@ -230,6 +265,11 @@ ImageFileWriter<TInputImage>
     {
     os << indent << "FactorySpecifiedmageIO: Off\n";
     }
+
+  os << indent << "NumberOfAsynchronousBuffers: " << m_NumberOfAsynchronousBuffers << "\n";
+  os << indent << "NumberOfConcurrentInputs: " << m_ConcurrentInputs.size() << "\n";
+  os << indent << "Resumable: " << (m_Resumable ? "On" : "Off") << "\n";
+  os << indent << "PipelineSignature: " << m_PipelineSignature << "\n";
 }
 
 //---------------------------------------------------------
@@ -268,6 +308,24 @@ ImageFileWriter<TInputImage>
   return static_cast<const InputImageType*>(this->ProcessObject::GetInput(0));
 }
 
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::AddConcurrentInput(const InputImageType *input)
+{
+  m_ConcurrentInputs.push_back(const_cast<InputImageType *>(input));
+  this->Modified();
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::ClearConcurrentInputs()
+{
+  m_ConcurrentInputs.clear();
+  this->Modified();
+}
+
 /**
  * Update method : update output information of input and write to file
  */
@@ -319,6 +377,18 @@ ImageFileWriter<TInputImage>
         }
       this->SetAutomaticAdaptativeStreaming(sizevalue);
       }
+    else if(type == "blocks")
+      {
+      if(sizemode != "auto")
+        {
+        itkWarningMacro(<<"In blocks streaming type, the sizemode option will be ignored.");
+        }
+      if(sizevalue == 0.)
+        {
+        itkWarningMacro("sizemode is auto but sizevalue is 0. Value will be fetched from the OTB_MAX_RAM_HINT environment variable if set, or else use the default value");
+        }
+      this->SetAutomaticBlockAlignedStreaming(sizevalue);
+      }
     else if(type == "tiled")
       {
       if(sizemode == "auto")
@@ -393,6 +463,16 @@ ImageFileWriter<TInputImage>
       }
     }
 
+  if(m_FilenameHelper->AsyncWriteIsSet())
+    {
+    this->SetNumberOfAsynchronousBuffers(m_FilenameHelper->GetAsyncWrite());
+    }
+
+  if(m_FilenameHelper->ResumeIsSet())
+    {
+    this->SetResumable(m_FilenameHelper->GetResume());
+    }
+
   this->SetAbortGenerateData(0);
   this->SetProgress(0.0);
 
@@ -456,7 +536,8 @@ ImageFileWriter<TInputImage>
 
   // Manage extended filename
   if ((strcmp(m_ImageIO->GetNameOfClass(), "GDALImageIO") == 0)
-      && (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet())  )
+      && (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet()
+          || m_FilenameHelper->OverviewsIsSet())  )
     {
     typename GDALImageIO::Pointer imageIO = dynamic_cast<GDALImageIO*>(m_ImageIO.GetPointer());
 
@@ -471,6 +552,13 @@ ImageFileWriter<TInputImage>
 
     imageIO->SetOptions(m_FilenameHelper->GetgdalCreationOptions());
     imageIO->SetWriteRPCTags(m_FilenameHelper->GetWriteRPCTags());
+
+    if (m_FilenameHelper->OverviewsIsSet())
+      {
+      imageIO->SetNumberOfOverviewsToWrite(m_FilenameHelper->GetOverviews());
+      imageIO->SetOverviewsResampling(m_FilenameHelper->GetOverviewsMethod() == "nearest" ?
+                                      GDAL_RESAMPLING_NEAREST : GDAL_RESAMPLING_AVERAGE);
+      }
     }
 
 
@@ -482,6 +570,17 @@ ImageFileWriter<TInputImage>
   inputPtr->UpdateOutputInformation();
   InputImageRegionType inputRegion = inputPtr->GetLargestPossibleRegion();
 
+  for (unsigned int i = 0; i < m_ConcurrentInputs.size(); ++i)
+    {
+    m_ConcurrentInputs[i]->UpdateOutputInformation();
+    if (m_ConcurrentInputs[i]->GetLargestPossibleRegion() != inputRegion)
+      {
+      itkExceptionMacro(<< "The largest possible region of concurrent input " << i
+                        << " (" << m_ConcurrentInputs[i]->GetLargestPossibleRegion()
+                        << ") differs from the one of the input (" << inputRegion << ")");
+      }
+    }
+
   /** Parse region size modes */
   if(m_FilenameHelper->BoxIsSet())
     {
@@ -540,10 +639,59 @@ ImageFileWriter<TInputImage>
     otbMsgDevMacro(<< "Buffered region is the largest possible region, there is no need for streaming.");
     this->SetNumberOfDivisionsStrippedStreaming(1);
     }
+
+  // Buffers queued to the I/O thread, plus the one being filled
+  m_StreamingManager->SetNumberOfExtraOutputBuffers(
+    m_NumberOfAsynchronousBuffers > 0 ? m_NumberOfAsynchronousBuffers + 1 : 0);
+
+  // Buffers the sources read the next division ahead into, when the
+  // divisions are processed one after the other
+  typename StreamingManagerType::MemoryPrintType readAheadPrint = 0;
+  if (m_ConcurrentInputs.empty())
+    {
+    std::vector<ReadAheadInterface*> readAheadSources;
+    this->FindReadAheadSources(readAheadSources);
+    for (unsigned int i = 0; i < readAheadSources.size(); ++i)
+      {
+      readAheadPrint += readAheadSources[i]->GetReadAheadMemoryPrint();
+      }
+    }
+  m_StreamingManager->SetExtraInputBuffersPrint(readAheadPrint);
+
+  // The pipelines of the concurrent inputs share the available RAM
+  m_StreamingManager->SetNumberOfConcurrentDivisions(static_cast<unsigned int>(m_ConcurrentInputs.size()) + 1);
+
+  // Measure the memory used by the pipeline on probe regions instead
+  // of estimating it, if requested. Set on each update, as the
+  // streaming manager is kept between updates.
+  m_StreamingManager->SetMemoryCalibration(ConfigurationManager::GetUseMemoryCalibration());
+
   m_StreamingManager->PrepareStreaming(inputPtr, inputRegion);
   m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
   otbMsgDebugMacro(<< "Number Of Stream Divisions : " << m_NumberOfDivisions);
 
+  // Find the divisions holding no data, which are not computed
+  m_EmptyDivisions.clear();
+  m_NumberOfEmptyDivisions = 0;
+  if (m_EmptyDivisionPredicate.IsNotNull())
+    {
+    m_EmptyDivisionPredicate->Initialize(inputPtr);
+    m_EmptyDivisions.resize(m_NumberOfDivisions, false);
+    for (unsigned int i = 0; i < m_NumberOfDivisions; ++i)
+      {
+      if (m_EmptyDivisionPredicate->IsEmpty(m_StreamingManager->GetSplit(i)))
+        {
+        m_EmptyDivisions[i] = true;
+        ++m_NumberOfEmptyDivisions;
+        }
+      }
+    otbMsgDevMacro(<< m_NumberOfEmptyDivisions << " empty divisions out of " << m_NumberOfDivisions);
+    }
+
+  // There is nothing to overlap with a single division
+  m_AsynchronousWriting = (m_NumberOfAsynchronousBuffers > 0 && m_NumberOfDivisions > 1);
+  m_AsynchronousWriter->SetMaximumNumberOfPendingBuffers(m_NumberOfAsynchronousBuffers);
+
   /**
    * Loop over the number of pieces, execute the upstream pipeline on each
    * piece, and copy the results into the output image.
@@ -583,12 +731,70 @@ ImageFileWriter<TInputImage>
   //
   m_ImageIO->SetFileName(m_FileName.c_str());
 
+  // Open the journal of a resumable write, and reopen the output if it
+  // holds the divisions recorded by the journal of the same write. The
+  // journal is started anew if the output has been deleted since.
+  m_Journal = ITK_NULLPTR;
+  m_NumberOfResumedDivisions = 0;
+  m_ImageIO->SetResumeWriting(false);
+  if (m_Resumable)
+    {
+    if (m_ImageIO->CanStreamWrite())
+      {
+      m_Journal = StreamingWriteJournal::New();
+      const bool resume = m_ImageIO->CanResumeWrite()
+        && itksys::SystemTools::FileExists(m_FileName.c_str(), true);
+      const bool resumed = m_Journal->Open(m_FileName + ".journal",
+                                           this->ComputeJournalSignature(inputRegion),
+                                           resume);
+      m_ImageIO->SetResumeWriting(resumed);
+      m_NumberOfResumedDivisions = m_Journal->GetNumberOfCompletedDivisions();
+      if (resumed)
+        {
+        otbMsgDevMacro(<< "Resuming the write of " << m_FileName << ": " << m_NumberOfResumedDivisions
+                       << " divisions out of " << m_NumberOfDivisions << " already written");
+        }
+      }
+    else
+      {
+      itkWarningMacro(<< "The ImageIO selected for " << m_FileName << " can not resume a write");
+      }
+    }
+
   m_ImageIO->WriteImageInformation();
 
+  // Empty divisions are not written at all if they read back as
+  // no-data. A division is always written first, so that the ImageIO
+  // creates the file, unless it is reopened. The last division is
+  // always written too, since the ImageIO finalizes the file once its
+  // last pixel is written.
+  const bool skipEmptyDivisions = (m_NumberOfEmptyDivisions > 0 && m_ImageIO->CanSkipEmptyRegions());
+  bool fileCreated = m_ImageIO->GetResumeWriting();
+
   this->UpdateProgress(0);
   m_CurrentDivision = 0;
   m_DivisionProgress = 0;
 
+  // Divisions are computed by batches when there are concurrent inputs
+  const bool concurrentDivisions = (!m_ConcurrentInputs.empty() && m_NumberOfDivisions > 1);
+  const unsigned int nbPipelines = static_cast<unsigned int>(m_ConcurrentInputs.size()) + 1;
+
+  // Sources able to read the next division while the current one is
+  // processed. The next division is already computed concurrently by
+  // another pipeline otherwise.
+  std::vector<ReadAheadInterface*> readAheadSources;
+  if (m_NumberOfDivisions > 1 && !concurrentDivisions)
+    {
+    this->FindReadAheadSources(readAheadSources);
+    }
+
+  // The pipelines computing divisions at the same time share the threads
+  NumberOfThreadsMapType previousNumberOfThreads;
+  if (concurrentDivisions)
+    {
+    this->ShareThreadsBetweenPipelines(previousNumberOfThreads);
+    }
+
   // Get the source process object
   itk::ProcessObject* source = inputPtr->GetSource();
   m_IsObserving = false;
@@ -611,30 +817,132 @@ ImageFileWriter<TInputImage>
     itkWarningMacro(<< "Could not get the source process object. Progress report might be buggy");
     }
 
-  for (m_CurrentDivision = 0;
-       m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
-       m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+  try
     {
-    streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    for (m_CurrentDivision = 0;
+         m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
+         m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+      {
+      streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+      const InputImageType* divisionInput = inputPtr;
+      const bool emptyDivision = this->IsEmptyDivision(m_CurrentDivision);
+      const bool completedDivision = this->IsCompletedDivision(m_CurrentDivision);
+
+      if (concurrentDivisions)
+        {
+        // Division i is computed by pipeline i % nbPipelines, the
+        // whole batch at once when its first division is reached
+        const unsigned int pipeline = m_CurrentDivision % nbPipelines;
+        if (pipeline == 0)
+          {
+          this->UpdateConcurrentDivisions(m_CurrentDivision);
+          }
+        else
+          {
+          divisionInput = m_ConcurrentInputs[pipeline - 1];
+          }
+        }
+      else if (!emptyDivision && !completedDivision)
+        {
+        if (!readAheadSources.empty() && m_CurrentDivision + 1 < m_NumberOfDivisions
+            && !this->IsEmptyDivision(m_CurrentDivision + 1)
+            && !this->IsCompletedDivision(m_CurrentDivision + 1))
+          {
+          // Propagate the next division first, so that the sources know
+          // what to read once the current one has been read
+          inputPtr->SetRequestedRegion(m_StreamingManager->GetSplit(m_CurrentDivision + 1));
+          inputPtr->PropagateRequestedRegion();
+          for (unsigned int i = 0; i < readAheadSources.size(); ++i)
+            {
+            readAheadSources[i]->RecordReadAheadRegion();
+            }
+          }
+
+        inputPtr->SetRequestedRegion(streamRegion);
+        inputPtr->PropagateRequestedRegion();
+        inputPtr->UpdateOutputData();
+        }
+
+      const bool lastDivision = (m_CurrentDivision + 1 == m_NumberOfDivisions);
+      if (completedDivision || (emptyDivision && skipEmptyDivisions && fileCreated && !lastDivision))
+        {
+        continue;
+        }
+
+      // Write the whole image
+      itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
+      for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+        {
+        ioRegion.SetSize(i, streamRegion.GetSize(i));
+        ioRegion.SetIndex(i, streamRegion.GetIndex(i));
+        //Set the ioRegion index using the shifted index ( (0,0 without box parameter))
+        ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+        }
+      this->SetIORegion(ioRegion);
+
+      // In asynchronous mode, the ImageIO belongs to the I/O thread
+      // once started: the region is passed along with the buffer
+      if (!m_AsynchronousWriter->IsRunning())
+        {
+        m_ImageIO->SetIORegion(m_IORegion);
+        }
+
+      // Start writing stream region in the image file
+      if (emptyDivision)
+        {
+        this->WriteNoDataRegion(divisionInput);
+        }
+      else
+        {
+        this->WriteInputRegion(divisionInput);
+        }
+      fileCreated = true;
+      }
 
-    inputPtr->SetRequestedRegion(streamRegion);
-    inputPtr->PropagateRequestedRegion();
-    inputPtr->UpdateOutputData();
+    // Wait for the last divisions to be written
+    m_AsynchronousWriter->Stop();
 
-    // Write the whole image
-    itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
-    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+    // The journal is only needed to resume an interrupted write
+    if (m_Journal.IsNotNull())
       {
-      ioRegion.SetSize(i, streamRegion.GetSize(i));
-      ioRegion.SetIndex(i, streamRegion.GetIndex(i));
-      //Set the ioRegion index using the shifted index ( (0,0 without box parameter))
-      ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+      if (this->GetAbortGenerateData())
+        {
+        m_Journal->Close();
+        }
+      else
+        {
+        m_Journal->Remove();
+        }
+      m_Journal = ITK_NULLPTR;
       }
-    this->SetIORegion(ioRegion);
-    m_ImageIO->SetIORegion(m_IORegion);
 
-    // Start writing stream region in the image file
-    this->GenerateData();
+    // Release what was read ahead if the streaming was aborted
+    for (unsigned int i = 0; i < readAheadSources.size(); ++i)
+      {
+      readAheadSources[i]->ResetReadAhead();
+      }
+    this->RestoreNumberOfThreads(previousNumberOfThreads);
+    }
+  catch (...)
+    {
+    m_AsynchronousWriter->Abort();
+    this->RestoreNumberOfThreads(previousNumberOfThreads);
+    if (m_Journal.IsNotNull())
+      {
+      m_Journal->Close();
+      m_Journal = ITK_NULLPTR;
+      }
+    for (unsigned int i = 0; i < readAheadSources.size(); ++i)
+      {
+      readAheadSources[i]->ResetReadAhead();
+      }
+    if (m_IsObserving)
+      {
+      m_IsObserving = false;
+      source->RemoveObserver(m_ObserverID);
+      }
+    m_ShiftOutputIndex.Fill(0);
+    throw;
     }
 
   /**
@@ -684,38 +992,166 @@ void
 ImageFileWriter<TInputImage>
 ::GenerateData(void)
 {
-  const InputImageType * input = this->GetInput();
+  this->WriteInputRegion(this->GetInput());
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::UpdateConcurrentDivisions(unsigned int first)
+{
+  const unsigned int nbPipelines = static_cast<unsigned int>(m_ConcurrentInputs.size()) + 1;
+  const unsigned int count = std::min(nbPipelines, m_NumberOfDivisions - first);
+
+  std::vector<InputImageType*> inputs(count);
+  std::vector<InputImageRegionType> regions(count);
+  for (unsigned int i = 0; i < count; ++i)
+    {
+    inputs[i] = (i == 0 ? const_cast<InputImageType*>(this->GetInput()) : m_ConcurrentInputs[i - 1].GetPointer());
+    regions[i] = m_StreamingManager->GetSplit(first + i);
+    }
+
+  std::vector<std::exception_ptr> errors(count);
+  auto updateDivision = [&inputs, &regions, &errors](unsigned int i)
+    {
+    try
+      {
+      inputs[i]->SetRequestedRegion(regions[i]);
+      inputs[i]->PropagateRequestedRegion();
+      inputs[i]->UpdateOutputData();
+      }
+    catch (...)
+      {
+      errors[i] = std::current_exception();
+      }
+    };
+
+  // Empty divisions and divisions written by an interrupted write are
+  // not computed
+  std::vector<unsigned int> updated;
+  for (unsigned int i = 0; i < count; ++i)
+    {
+    if (!this->IsEmptyDivision(first + i) && !this->IsCompletedDivision(first + i))
+      {
+      updated.push_back(i);
+      }
+    }
+  if (updated.empty())
+    {
+    return;
+    }
+
+  // The first division is computed in this thread, so that the
+  // progress of the input pipeline is reported as usual
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < updated.size(); ++i)
+    {
+    threads.push_back(std::thread(updateDivision, updated[i]));
+    }
+  updateDivision(updated[0]);
+  for (unsigned int i = 0; i < threads.size(); ++i)
+    {
+    threads[i].join();
+    }
+
+  for (unsigned int i = 0; i < count; ++i)
+    {
+    if (errors[i])
+      {
+      std::rethrow_exception(errors[i]);
+      }
+    }
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::WriteNoDataRegion(const InputImageType * input)
+{
+  typedef typename InputImageType::InternalPixelType InternalPixelType;
+
+  InputImageRegionType region;
+  itk::ImageIORegionAdaptor<TInputImage::ImageDimension>::
+    Convert(m_IORegion, region, m_ShiftOutputIndex);
+
+  InputImagePointer noDataImage = InputImageType::New();
+  noDataImage->CopyInformation(input);
+  noDataImage->SetNumberOfComponentsPerPixel(input->GetNumberOfComponentsPerPixel());
+  noDataImage->SetBufferedRegion(region);
+  noDataImage->Allocate();
+
+  // One internal component per band for vector images, one per pixel
+  // otherwise
+  const unsigned int nbBands =
+    (strcmp(input->GetNameOfClass(), "VectorImage") == 0 ? input->GetNumberOfComponentsPerPixel() : 1);
+
+  std::vector<bool>   noDataFlags;
+  std::vector<double> noDataValues;
+  ReadNoDataFlags(input->GetMetaDataDictionary(), noDataFlags, noDataValues);
+
+  std::vector<InternalPixelType> bandValues(nbBands, itk::NumericTraits<InternalPixelType>::ZeroValue());
+  for (unsigned int band = 0; band < nbBands && band < noDataFlags.size(); ++band)
+    {
+    if (noDataFlags[band])
+      {
+      bandValues[band] = static_cast<InternalPixelType>(noDataValues[band]);
+      }
+    }
+
+  InternalPixelType * buffer = noDataImage->GetBufferPointer();
+  const size_t nbPixels = region.GetNumberOfPixels();
+  for (size_t pixel = 0; pixel < nbPixels; ++pixel)
+    {
+    for (unsigned int band = 0; band < nbBands; ++band, ++buffer)
+      {
+      *buffer = bandValues[band];
+      }
+    }
+
+  this->WriteInputRegion(noDataImage);
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::WriteInputRegion(const InputImageType * input)
+{
   InputImagePointer cacheImage;
 
   // Make sure that the image is the right type and no more than
   // four components.
   typedef typename InputImageType::PixelType ImagePixelType;
 
-  if (strcmp(input->GetNameOfClass(), "VectorImage") == 0)
+  // In asynchronous mode, the ImageIO is configured once, before the
+  // I/O thread is started
+  if (!m_AsynchronousWriter->IsRunning())
     {
-    typedef typename InputImageType::InternalPixelType VectorImagePixelType;
-    m_ImageIO->SetPixelTypeInfo(typeid(VectorImagePixelType));
+    if (strcmp(input->GetNameOfClass(), "VectorImage") == 0)
+      {
+      typedef typename InputImageType::InternalPixelType VectorImagePixelType;
+      m_ImageIO->SetPixelTypeInfo(typeid(VectorImagePixelType));
 
-    typedef typename InputImageType::AccessorFunctorType AccessorFunctorType;
-    m_ImageIO->SetNumberOfComponents(AccessorFunctorType::GetVectorLength(input));
+      typedef typename InputImageType::AccessorFunctorType AccessorFunctorType;
+      m_ImageIO->SetNumberOfComponents(AccessorFunctorType::GetVectorLength(input));
 
-    m_IOComponents = m_ImageIO->GetNumberOfComponents();
-    m_BandList.clear();
-    if (m_FilenameHelper->BandRangeIsSet())
-      {
-      // get band range
-      bool retBandRange = m_FilenameHelper->ResolveBandRange(m_FilenameHelper->GetBandRange(), m_IOComponents, m_BandList);
-      if (retBandRange == false || m_BandList.empty())
+      m_IOComponents = m_ImageIO->GetNumberOfComponents();
+      m_BandList.clear();
+      if (m_FilenameHelper->BandRangeIsSet())
         {
-        // invalid range
-        itkGenericExceptionMacro("The given band range is either empty or invalid for a " << m_IOComponents <<" bands input image!");
+        // get band range
+        bool retBandRange = m_FilenameHelper->ResolveBandRange(m_FilenameHelper->GetBandRange(), m_IOComponents, m_BandList);
+        if (retBandRange == false || m_BandList.empty())
+          {
+          // invalid range
+          itkGenericExceptionMacro("The given band range is either empty or invalid for a " << m_IOComponents <<" bands input image!");
+          }
         }
       }
-    }
-  else
-    {
-    // Set the pixel and component type; the number of components.
-    m_ImageIO->SetPixelTypeInfo(typeid(ImagePixelType));
+    else
+      {
+      // Set the pixel and component type; the number of components.
+      m_ImageIO->SetPixelTypeInfo(typeid(ImagePixelType));
+      }
     }
 
   // Setup the image IO for writing.
@@ -732,7 +1168,7 @@ ImageFileWriter<TInputImage>
   tmpIndex.Fill(0);
   itk::ImageIORegionAdaptor<TInputImage::ImageDimension>::
     //Convert(m_ImageIO->GetIORegion(), ioRegion, tmpIndex);
-    Convert(m_ImageIO->GetIORegion(), ioRegion, m_ShiftOutputIndex);
+    Convert(m_IORegion, ioRegion, m_ShiftOutputIndex);
   InputImageRegionType bufferedRegion = input->GetBufferedRegion();
 
   // before this test, bad stuff would happened when they don't match.
@@ -793,15 +1229,27 @@ ImageFileWriter<TInputImage>
       }
     }
 
-  if (m_FilenameHelper->BandRangeIsSet() && (!m_BandList.empty()))
-  {
-    // Adapt the image size with the region and take into account a potential
-    // remapping of the components. m_BandList is empty if no band range is set
-    m_ImageIO->DoMapBuffer(const_cast< void* >(dataPtr), bufferedRegion.GetNumberOfPixels(), this->m_BandList);
-    m_ImageIO->SetNumberOfComponents(m_BandList.size());
-  }
+  if (m_AsynchronousWriting)
+    {
+    this->QueueAsynchronousWrite(dataPtr, ioRegion.GetNumberOfPixels());
+    }
+  else
+    {
+    if (m_FilenameHelper->BandRangeIsSet() && (!m_BandList.empty()))
+    {
+      // Adapt the image size with the region and take into account a potential
+      // remapping of the components. m_BandList is empty if no band range is set
+      m_ImageIO->DoMapBuffer(const_cast< void* >(dataPtr), bufferedRegion.GetNumberOfPixels(), this->m_BandList);
+      m_ImageIO->SetNumberOfComponents(m_BandList.size());
+    }
+
+    m_ImageIO->Write(dataPtr);
 
-  m_ImageIO->Write(dataPtr);
+    if (m_Journal.IsNotNull())
+      {
+      this->CommitDivision(m_CurrentDivision);
+      }
+    }
 
   if (m_WriteGeomFile  || m_FilenameHelper->GetWriteGEOMFile())
     {
@@ -812,6 +1260,229 @@ ImageFileWriter<TInputImage>
     }
 }
 
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::FindReadAheadSources(std::vector<ReadAheadInterface*>& sources)
+{
+  std::vector<itk::DataObject*>  dataObjects(1, const_cast<InputImageType*>(this->GetInput()));
+  std::set<itk::ProcessObject*> visited;
+
+  while (!dataObjects.empty())
+    {
+    itk::ProcessObject* source = dataObjects.back()->GetSource();
+    dataObjects.pop_back();
+    if (source == ITK_NULLPTR || !visited.insert(source).second)
+      {
+      continue;
+      }
+
+    ReadAheadInterface* readAheadSource = dynamic_cast<ReadAheadInterface*>(source);
+    if (readAheadSource != ITK_NULLPTR && readAheadSource->GetReadAhead())
+      {
+      sources.push_back(readAheadSource);
+      }
+
+    itk::ProcessObject::DataObjectPointerArray inputs = source->GetInputs();
+    for (unsigned int i = 0; i < inputs.size(); ++i)
+      {
+      if (inputs[i].IsNotNull())
+        {
+        dataObjects.push_back(inputs[i].GetPointer());
+        }
+      }
+    }
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::ShareThreadsBetweenPipelines(NumberOfThreadsMapType& previousNumberOfThreads)
+{
+  const unsigned int nbPipelines = static_cast<unsigned int>(m_ConcurrentInputs.size()) + 1;
+  const itk::ThreadIdType share = std::max<itk::ThreadIdType>(
+    itk::MultiThreader::GetGlobalDefaultNumberOfThreads() / nbPipelines, 1);
+
+  std::vector<itk::DataObject*> dataObjects(1, const_cast<InputImageType*>(this->GetInput()));
+  for (unsigned int i = 0; i < m_ConcurrentInputs.size(); ++i)
+    {
+    dataObjects.push_back(m_ConcurrentInputs[i].GetPointer());
+    }
+
+  while (!dataObjects.empty())
+    {
+    itk::ProcessObject* source = dataObjects.back()->GetSource();
+    dataObjects.pop_back();
+    if (source == ITK_NULLPTR || previousNumberOfThreads.count(source))
+      {
+      continue;
+      }
+
+    previousNumberOfThreads[source] = source->GetNumberOfThreads();
+    if (source->GetNumberOfThreads() > share)
+      {
+      source->SetNumberOfThreads(share);
+      }
+
+    itk::ProcessObject::DataObjectPointerArray inputs = source->GetInputs();
+    for (unsigned int i = 0; i < inputs.size(); ++i)
+      {
+      if (inputs[i].IsNotNull())
+        {
+        dataObjects.push_back(inputs[i].GetPointer());
+        }
+      }
+    }
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::RestoreNumberOfThreads(const NumberOfThreadsMapType& previousNumberOfThreads)
+{
+  for (typename NumberOfThreadsMapType::const_iterator it = previousNumberOfThreads.begin();
+       it != previousNumberOfThreads.end();
+       ++it)
+    {
+    it->first->SetNumberOfThreads(it->second);
+    }
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::QueueAsynchronousWrite(const void* dataPtr, size_t numberOfPixels)
+{
+  const bool mapBands = m_FilenameHelper->BandRangeIsSet() && (!m_BandList.empty());
+
+  if (!m_AsynchronousWriter->IsRunning())
+    {
+    // First division: finish the ImageIO configuration and hand it
+    // over to the I/O thread
+    m_IOComponentSize = m_ImageIO->GetComponentSize();
+    m_InputPixelSize = m_IOComponentSize * m_ImageIO->GetNumberOfComponents();
+
+    if (mapBands)
+      {
+      m_ImageIO->SetNumberOfComponents(m_BandList.size());
+      }
+
+    m_AsynchronousWriter->SetImageIO(m_ImageIO);
+    m_AsynchronousWriter->Start();
+    }
+
+  const size_t outPixelSize = mapBands ? m_IOComponentSize * m_BandList.size() : m_InputPixelSize;
+
+  AsynchronousImageIOWriter::BufferType buffer;
+  m_AsynchronousWriter->AcquireBuffer(buffer, numberOfPixels * outPixelSize);
+
+  const char* inPos = static_cast<const char*>(dataPtr);
+  char* outPos = &buffer[0];
+
+  if (mapBands)
+    {
+    // Copy and remap the components at once, leaving the input buffer
+    // untouched
+    for (size_t n = 0; n < numberOfPixels; ++n)
+      {
+      for (unsigned int i = 0; i < m_BandList.size(); ++i)
+        {
+        memcpy(outPos + i * m_IOComponentSize, inPos + m_BandList[i] * m_IOComponentSize, m_IOComponentSize);
+        }
+      inPos += m_InputPixelSize;
+      outPos += outPixelSize;
+      }
+    }
+  else
+    {
+    memcpy(outPos, inPos, numberOfPixels * outPixelSize);
+    }
+
+  AsynchronousImageIOWriter::WrittenCallbackType written;
+  if (m_Journal.IsNotNull())
+    {
+    const unsigned int division = m_CurrentDivision;
+    written = [this, division]()
+      {
+      this->CommitDivision(division);
+      };
+    }
+
+  m_AsynchronousWriter->Push(m_IORegion, buffer, written);
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::CommitDivision(unsigned int division)
+{
+  m_ImageIO->Flush();
+  m_Journal->MarkCompleted(division);
+}
+
+template<class TInputImage>
+std::string
+ImageFileWriter<TInputImage>
+::ComputeJournalSignature(const InputImageRegionType& inputRegion)
+{
+  // FNV-1a hash of the divisions, which may be numerous
+  unsigned long long divisionsHash = 14695981039346656037ULL;
+  for (unsigned int i = 0; i < m_NumberOfDivisions; ++i)
+    {
+    const InputImageRegionType split = m_StreamingManager->GetSplit(i);
+    for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+      {
+      const unsigned long long values[2] =
+        {
+        static_cast<unsigned long long>(split.GetIndex(dim)),
+        static_cast<unsigned long long>(split.GetSize(dim))
+        };
+      for (unsigned int v = 0; v < 2; ++v)
+        {
+        divisionsHash = (divisionsHash ^ values[v]) * 1099511628211ULL;
+        }
+      }
+    }
+
+  std::ostringstream oss;
+  oss << "region=";
+  for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+    {
+    oss << (dim > 0 ? "," : "") << inputRegion.GetIndex(dim);
+    }
+  oss << ":";
+  for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+    {
+    oss << (dim > 0 ? "," : "") << inputRegion.GetSize(dim);
+    }
+  typedef otb::DefaultConvertPixelTraits<typename InputImageType::PixelType> ConvertPixelTraitsType;
+  oss << " pixel=" << m_ImageIO->GetComponentTypeAsString(
+    ImageIOBase::MapComponentType(typeid(typename ConvertPixelTraitsType::ComponentType)));
+  oss << " components=" << this->GetInput()->GetNumberOfComponentsPerPixel()
+      << " bands=" << m_FilenameHelper->GetBandRange();
+
+  // Exact decimal representation of the geometry
+  oss << std::setprecision(17) << " origin=";
+  for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+    {
+    oss << (dim > 0 ? "," : "") << this->GetInput()->GetOrigin()[dim];
+    }
+  oss << " spacing=";
+  for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+    {
+    oss << (dim > 0 ? "," : "") << this->GetInput()->GetSpacing()[dim];
+    }
+
+  oss << " divisions=" << m_NumberOfDivisions
+      << " layout=" << std::hex << divisionsHash;
+
+  // The signature is stored on a single line of the journal
+  std::string pipelineSignature = m_PipelineSignature;
+  std::replace(pipelineSignature.begin(), pipelineSignature.end(), '\n', ' ');
+  oss << " pipeline=" << pipelineSignature;
+  return oss.str();
+}
+
 template <class TInputImage>
 void
 ImageFileWriter<TInputImage>
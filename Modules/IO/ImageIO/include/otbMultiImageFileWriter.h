@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMultiImageFileWriter_h
+#define otbMultiImageFileWriter_h
+
+#include <string>
+#include <vector>
+
+#include "itkProcessObject.h"
+#include "otbImage.h"
+#include "otbImageIOBase.h"
+#include "otbStreamingManager.h"
+#include "otbExtendedFilenameToWriterOptions.h"
+
+namespace otb
+{
+
+/** \class MultiImageFileWriter
+ * \brief Writes several images computed by the same pipeline, with a
+ * single streaming.
+ *
+ * Writing each output of a pipeline with its own ImageFileWriter
+ * streams the pipeline once per output, so that its shared part (the
+ * reading of the input, typically) is computed several times. This
+ * writer takes all the images with AddInputImage(), along with their
+ * file names, and streams them with a single division schedule: for
+ * each division, every image is updated on the division, the shared
+ * part of their pipelines being computed once, then each image is
+ * written to its file.
+ *
+ * All the images must have the same largest possible region. The
+ * streaming is configured with the same methods as ImageFileWriter,
+ * the memory print being estimated on the pipelines of all the images
+ * at once. The extended file names may hold the GDAL creation options,
+ * writerpctags, writegeom and gdal:ov options; the ones changing the
+ * written region or the streaming (box, bands, streaming:*, asyncwrite,
+ * resume) are not supported, see IsSupportedFileName().
+ *
+ * The requested regions of all the images are propagated before any of
+ * them is updated: an image shared by several pipelines is requested
+ * the union of the regions they need, so that a filter with a radius
+ * on one pipeline does not make the shared part compute the division
+ * again for the others.
+ *
+ * \sa ImageFileWriter
+ * \sa StreamingImageMultiSinkVirtualWriter
+ *
+ * \ingroup OTBImageIO
+ */
+class ITK_EXPORT MultiImageFileWriter : public itk::ProcessObject
+{
+public:
+  /** Standard class typedefs. */
+  typedef MultiImageFileWriter          Self;
+  typedef itk::ProcessObject            Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MultiImageFileWriter, itk::ProcessObject);
+
+  /** Image standing for all the inputs in the streaming: it has their
+   * geometry, and its source is the writer */
+  typedef otb::Image<unsigned char, 2>           StreamingImageType;
+  typedef StreamingImageType::RegionType         RegionType;
+  typedef itk::ImageBase<2>                      ImageBaseType;
+  typedef StreamingManager<StreamingImageType>   StreamingManagerType;
+  typedef StreamingManagerType::Pointer          StreamingManagerPointerType;
+
+  /** Add an image to write in the given (extended) file name. TImage
+   * is an otb::Image or an otb::VectorImage of dimension 2. */
+  template <class TImage>
+  void AddInputImage(const TImage * image, const std::string & fileName);
+
+  /** Remove all the images to write */
+  void ClearInputImages();
+
+  /** Get the number of images to write */
+  unsigned int GetNumberOfInputImages() const
+  {
+    return static_cast<unsigned int>(m_Sinks.size());
+  }
+
+  /** Return true if the extended file name can be written by this
+   * writer, false if it uses options changing the written region or
+   * the streaming */
+  static bool IsSupportedFileName(const std::string & fileName);
+
+  /**  Set the streaming mode to 'stripped' and configure the number of strips
+   *   which will be used to stream the image */
+  void SetNumberOfDivisionsStrippedStreaming(unsigned int nbDivisions);
+
+  /**  Set the streaming mode to 'tiled' and configure the number of tiles
+   *   which will be used to stream the image */
+  void SetNumberOfDivisionsTiledStreaming(unsigned int nbDivisions);
+
+  /**  Set the streaming mode to 'stripped' and configure the number of strips
+   *   which will be used to stream the image with respect to a number of line
+   *   per strip */
+  void SetNumberOfLinesStrippedStreaming(unsigned int nbLinesPerStrip);
+
+  /**  Set the streaming mode to 'stripped' and configure the number of MB
+   *   available. The actual number of divisions is computed automatically
+   *   by estimating the memory consumption of the pipelines of all the
+   *   images. Setting the availableRAM parameter to 0 means that the
+   *   available RAM is set from the CMake configuration option */
+  void SetAutomaticStrippedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
+  /**  Set the streaming mode to 'tiled' and configure the dimension of the tiles
+   *   in pixels for each dimension (square tiles will be generated) */
+  void SetTileDimensionTiledStreaming(unsigned int tileDimension);
+
+  /**  Set the streaming mode to 'tiled' and configure the number of MB
+   *   available. The actual number of divisions is computed automatically
+   *   by estimating the memory consumption of the pipelines of all the
+   *   images. Tiles will be square. */
+  void SetAutomaticTiledStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
+  /**  Set the streaming mode to 'adaptative' and configure the number of MB
+   *   available. The actual number of divisions is computed automatically
+   *   by estimating the memory consumption of the pipelines of all the
+   *   images. Tiles will try to match the input file tile scheme. */
+  void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
+  /** Get the number of divisions of the last streaming */
+  itkGetConstMacro(NumberOfDivisions, unsigned int);
+
+  /** Write all the images */
+  void Update() ITK_OVERRIDE;
+
+  using Superclass::MakeOutput;
+
+protected:
+  MultiImageFileWriter();
+  ~MultiImageFileWriter() ITK_OVERRIDE {}
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+  /** The streaming image is the only output */
+  itk::DataObject::Pointer MakeOutput(DataObjectPointerArraySizeType idx) ITK_OVERRIDE;
+
+  /** Copy the information of the first image to the streaming image,
+   * and check that all the images have the same largest possible
+   * region */
+  void GenerateOutputInformation() ITK_OVERRIDE;
+
+  /** Request the region of the streaming image to every image */
+  void GenerateInputRequestedRegion() ITK_OVERRIDE;
+
+  /** Only reached when the memory print of the pipeline is measured:
+   * the streaming image is allocated on its requested region */
+  void GenerateData() ITK_OVERRIDE;
+
+private:
+  MultiImageFileWriter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  StreamingImageType * GetStreamingImage();
+
+  /** Compute every image on the region. The region is propagated to
+   * all the pipelines first, each upstream image being requested the
+   * union of the regions requested by the pipelines sharing it, then
+   * the images are updated. */
+  void UpdateRegion(const RegionType & region);
+
+  /** Image to write, independently of its type */
+  class Sink : public itk::LightObject
+  {
+  public:
+    typedef Sink                    Self;
+    typedef itk::SmartPointer<Self> Pointer;
+
+    /** Create and configure the ImageIO. Return false if it can not
+     * stream the writing. */
+    virtual bool PrepareImageIO() = 0;
+
+    /** Create the file, for an image of the given region */
+    virtual void WriteImageInformation(const RegionType & region) = 0;
+
+    /** Write the region, computed by UpdateRegion(), in the file */
+    virtual void Write(const RegionType & region) = 0;
+
+    /** Write the geometry file of the image, if requested */
+    virtual void WriteGeometry() = 0;
+
+    virtual const std::string & GetFileName() const = 0;
+  };
+
+  template <class TImage>
+  class ImageSink : public Sink
+  {
+  public:
+    typedef ImageSink               Self;
+    typedef itk::SmartPointer<Self> Pointer;
+
+    itkSimpleNewMacro(Self);
+
+    void SetImage(const TImage * image)
+    {
+      m_Image = image;
+    }
+
+    void SetFileName(const std::string & fileName);
+
+    bool PrepareImageIO() ITK_OVERRIDE;
+
+    void WriteImageInformation(const RegionType & region) ITK_OVERRIDE;
+
+    void Write(const RegionType & region) ITK_OVERRIDE;
+
+    void WriteGeometry() ITK_OVERRIDE;
+
+    const std::string & GetFileName() const ITK_OVERRIDE
+    {
+      return m_FileName;
+    }
+
+  private:
+    typename TImage::ConstPointer                  m_Image;
+    std::string                                    m_FileName;
+    ExtendedFilenameToWriterOptions::Pointer       m_FilenameHelper;
+    ImageIOBase::Pointer                           m_ImageIO;
+    RegionType                                     m_LargestRegion;
+  };
+
+  typedef std::vector<Sink::Pointer> SinkListType;
+
+  SinkListType                m_Sinks;
+  StreamingManagerPointerType m_StreamingManager;
+  unsigned int                m_NumberOfDivisions;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbMultiImageFileWriter.txx"
+#endif
+
+#endif
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMultiImageFileWriter_txx
+#define otbMultiImageFileWriter_txx
+
+#include "otbMultiImageFileWriter.h"
+#include "otbImageIOFactory.h"
+#include "otbGDALImageIO.h"
+#include "otbImageKeywordlist.h"
+#include "otbMetaDataKey.h"
+
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMetaDataObject.h"
+
+#include <cstring>
+#include <sstream>
+#include <typeinfo>
+
+namespace otb
+{
+
+template <class TImage>
+void
+MultiImageFileWriter
+::AddInputImage(const TImage * image, const std::string & fileName)
+{
+  if (image == ITK_NULLPTR)
+    {
+    itkExceptionMacro(<< "No image given for " << fileName);
+    }
+
+  typename ImageSink<TImage>::Pointer sink = ImageSink<TImage>::New();
+  sink->SetImage(image);
+  sink->SetFileName(fileName);
+
+  this->SetNthInput(m_Sinks.size(), const_cast<TImage *>(image));
+  m_Sinks.push_back(sink.GetPointer());
+  this->Modified();
+}
+
+template <class TImage>
+void
+MultiImageFileWriter::ImageSink<TImage>
+::SetFileName(const std::string & fileName)
+{
+  m_FilenameHelper = ExtendedFilenameToWriterOptions::New();
+  m_FilenameHelper->SetExtendedFileName(fileName.c_str());
+  m_FileName = m_FilenameHelper->GetSimpleFileName();
+  m_ImageIO = ITK_NULLPTR;
+}
+
+template <class TImage>
+bool
+MultiImageFileWriter::ImageSink<TImage>
+::PrepareImageIO()
+{
+  if (m_FileName.empty())
+    {
+    itkGenericExceptionMacro(<< "No filename was specified");
+    }
+
+  m_ImageIO = ImageIOFactory::CreateImageIO(m_FileName.c_str(), otb::ImageIOFactory::WriteMode);
+
+  if (m_ImageIO.IsNull())
+    {
+    itk::ImageFileWriterException e(__FILE__, __LINE__);
+    std::ostringstream msg;
+    msg << "Cannot write image " << m_FileName << ". Probably unsupported format or incorrect filename extension.";
+    e.SetDescription(msg.str().c_str());
+    e.SetLocation(ITK_LOCATION);
+    throw e;
+    }
+
+  // Manage extended filename
+  GDALImageIO * gdalImageIO = dynamic_cast<GDALImageIO *>(m_ImageIO.GetPointer());
+  if (gdalImageIO != ITK_NULLPTR)
+    {
+    if (m_FilenameHelper->gdalCreationOptionsIsSet())
+      {
+      gdalImageIO->SetOptions(m_FilenameHelper->GetgdalCreationOptions());
+      }
+    if (m_FilenameHelper->WriteRPCTagsIsSet())
+      {
+      gdalImageIO->SetWriteRPCTags(m_FilenameHelper->GetWriteRPCTags());
+      }
+    if (m_FilenameHelper->OverviewsIsSet())
+      {
+      gdalImageIO->SetNumberOfOverviewsToWrite(m_FilenameHelper->GetOverviews());
+      gdalImageIO->SetOverviewsResampling(m_FilenameHelper->GetOverviewsMethod() == "nearest" ?
+                                          GDAL_RESAMPLING_NEAREST : GDAL_RESAMPLING_AVERAGE);
+      }
+    }
+
+  return m_ImageIO->CanStreamWrite();
+}
+
+template <class TImage>
+void
+MultiImageFileWriter::ImageSink<TImage>
+::WriteImageInformation(const RegionType & region)
+{
+  m_LargestRegion = region;
+
+  m_ImageIO->SetNumberOfDimensions(2);
+  const typename TImage::SpacingType&   spacing = m_Image->GetSpacing();
+  const typename TImage::PointType&     origin = m_Image->GetOrigin();
+  const typename TImage::DirectionType& direction = m_Image->GetDirection();
+
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+    m_ImageIO->SetDimensions(i, region.GetSize(i));
+    m_ImageIO->SetSpacing(i, spacing[i]);
+    m_ImageIO->SetOrigin(i, origin[i] + static_cast<double>(region.GetIndex()[i]) * spacing[i]);
+
+    // Please note: direction cosines are stored as columns of the
+    // direction matrix
+    vnl_vector<double> axisDirection(2);
+    for (unsigned int j = 0; j < 2; ++j)
+      {
+      axisDirection[j] = direction[j][i];
+      }
+    m_ImageIO->SetDirection(i, axisDirection);
+    }
+
+  m_ImageIO->SetMetaDataDictionary(m_Image->GetMetaDataDictionary());
+
+  if (strcmp(m_Image->GetNameOfClass(), "VectorImage") == 0)
+    {
+    m_ImageIO->SetPixelTypeInfo(typeid(typename TImage::InternalPixelType));
+    m_ImageIO->SetNumberOfComponents(m_Image->GetNumberOfComponentsPerPixel());
+    }
+  else
+    {
+    m_ImageIO->SetPixelTypeInfo(typeid(typename TImage::PixelType));
+    }
+
+  m_ImageIO->SetFileName(m_FileName.c_str());
+  m_ImageIO->WriteImageInformation();
+}
+
+template <class TImage>
+void
+MultiImageFileWriter::ImageSink<TImage>
+::Write(const RegionType & region)
+{
+  itk::ImageIORegion ioRegion(2);
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+    ioRegion.SetSize(i, region.GetSize(i));
+    ioRegion.SetIndex(i, region.GetIndex(i) - m_LargestRegion.GetIndex(i));
+    }
+  m_ImageIO->SetIORegion(ioRegion);
+
+  const void * dataPtr = static_cast<const void *>(m_Image->GetBufferPointer());
+
+  // Copy the division in a buffer of its own if the image has been
+  // computed on a larger region
+  typename TImage::Pointer cacheImage;
+  if (m_Image->GetBufferedRegion() != region)
+    {
+    cacheImage = TImage::New();
+    cacheImage->CopyInformation(m_Image);
+    cacheImage->SetBufferedRegion(region);
+    cacheImage->Allocate();
+
+    itk::ImageRegionConstIterator<TImage> in(m_Image, region);
+    itk::ImageRegionIterator<TImage>      out(cacheImage, region);
+    for (in.GoToBegin(), out.GoToBegin(); !in.IsAtEnd(); ++in, ++out)
+      {
+      out.Set(in.Get());
+      }
+
+    dataPtr = static_cast<const void *>(cacheImage->GetBufferPointer());
+    }
+
+  m_ImageIO->Write(dataPtr);
+}
+
+template <class TImage>
+void
+MultiImageFileWriter::ImageSink<TImage>
+::WriteGeometry()
+{
+  if (m_FilenameHelper->GetWriteGEOMFile())
+    {
+    ImageKeywordlist otb_kwl;
+    itk::MetaDataDictionary dict = m_Image->GetMetaDataDictionary();
+    itk::ExposeMetaData<ImageKeywordlist>(dict, MetaDataKey::OSSIMKeywordlistKey, otb_kwl);
+    otb::WriteGeometry(otb_kwl, m_FileName);
+    }
+}
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbReadAheadInterface_h
+#define otbReadAheadInterface_h
+
+namespace otb
+{
+
+/** \class ReadAheadInterface
+ * \brief Interface of the pipeline sources able to read the next
+ * streaming region in advance.
+ *
+ * Streaming sinks such as ImageFileWriter look for the sources
+ * implementing this interface upstream of their input. Before
+ * updating a division, they propagate the region of the following
+ * division through the pipeline and call RecordReadAheadRegion(), so
+ * that the source starts reading it as soon as the current division
+ * has been read. They also account for the buffers the sources read
+ * ahead into when choosing the number of divisions.
+ *
+ * \sa ImageFileReader
+ *
+ * \ingroup OTBImageIO
+ */
+class ReadAheadInterface
+{
+public:
+  /** Return true if the source reads ahead */
+  virtual bool GetReadAhead() const = 0;
+
+  /** Remember the region currently requested to the output as the one
+   * to read after the next update */
+  virtual void RecordReadAheadRegion() = 0;
+
+  /** Forget the recorded region and release the data read ahead */
+  virtual void ResetReadAhead() = 0;
+
+  /** Bytes of a buffer reading ahead the whole largest possible region
+   * of the output. A division of the output is read ahead in a buffer
+   * of the matching fraction of it. Output information must be up to
+   * date. */
+  virtual unsigned long long GetReadAheadMemoryPrint() const = 0;
+
+protected:
+  ReadAheadInterface() {}
+  virtual ~ReadAheadInterface() {}
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingWriteJournal_h
+#define otbStreamingWriteJournal_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace otb
+{
+
+/** \class StreamingWriteJournal
+ * \brief Records the streaming divisions completely written in a file.
+ *
+ * This class is used by ImageFileWriter to resume an interrupted
+ * streamed write. The journal is a text file next to the output: a
+ * header line, a signature describing the output and its streaming
+ * divisions, then the index of each division written, one per line.
+ * Each line is flushed as soon as it is recorded.
+ *
+ * When a journal is opened for resuming, the divisions it records are
+ * loaded only if its signature is the one given, so that a journal
+ * left by a different write is started anew.
+ *
+ * MarkCompleted() may be called from the I/O thread of an
+ * asynchronous write while the other methods are called from the
+ * streaming loop.
+ *
+ * \sa ImageFileWriter
+ *
+ * \ingroup OTBImageIO
+ */
+class ITK_EXPORT StreamingWriteJournal : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef StreamingWriteJournal         Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(StreamingWriteJournal, itk::Object);
+
+  /** Open the journal file. If resume is true and the file holds the
+   * given signature, the divisions it records are loaded and the next
+   * ones are appended. The journal is started anew otherwise. Return
+   * true if the journal has been resumed. Throw an exception if the
+   * file can not be written. */
+  bool Open(const std::string& filename, const std::string& signature, bool resume);
+
+  /** Return true if the division is recorded as written */
+  bool IsCompleted(unsigned int division) const;
+
+  /** Record the division as written */
+  void MarkCompleted(unsigned int division);
+
+  /** Get the number of divisions recorded as written */
+  unsigned int GetNumberOfCompletedDivisions() const;
+
+  /** Close the journal file, keeping it */
+  void Close();
+
+  /** Close and delete the journal file, once the write is over */
+  void Remove();
+
+  /** Get the name of the journal file */
+  itkGetStringMacro(FileName);
+
+protected:
+  StreamingWriteJournal();
+  ~StreamingWriteJournal() ITK_OVERRIDE;
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  StreamingWriteJournal(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** Load the divisions of an existing journal with the given
+   * signature. Return false if there is no such journal. */
+  bool Load(const std::string& signature);
+
+  std::string             m_FileName;
+  std::ofstream           m_File;
+  std::set<unsigned int>  m_CompletedDivisions;
+  mutable std::mutex      m_Mutex;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbAsynchronousImageIOReader.h"
+#include "otbMacro.h"
+
+namespace otb
+{
+
+AsynchronousImageIOReader
+::AsynchronousImageIOReader()
+  : m_ImageIO(),
+    m_Region(),
+    m_ComponentType(ImageIOBase::UNKNOWNCOMPONENTTYPE),
+    m_BufferOwner(),
+    m_Buffer(ITK_NULLPTR),
+    m_BufferSize(0),
+    m_Staged(false),
+    m_Failed(false)
+{
+}
+
+AsynchronousImageIOReader
+::~AsynchronousImageIOReader()
+{
+  this->Clear();
+}
+
+void
+AsynchronousImageIOReader
+::Start(const itk::ImageIORegion& region,
+        ImageIOBase::IOComponentType componentType,
+        itk::LightObject* bufferOwner, void* buffer, size_t size)
+{
+  if (m_ImageIO.IsNull())
+    {
+    itkExceptionMacro(<< "No ImageIO set");
+    }
+
+  this->Clear();
+
+  m_Region = region;
+  m_ComponentType = componentType;
+  m_BufferOwner = bufferOwner;
+  m_Buffer = buffer;
+  m_BufferSize = size;
+  m_Failed = false;
+  m_Staged = true;
+
+  m_Thread = std::thread(&Self::ThreadedRead, this);
+}
+
+void
+AsynchronousImageIOReader
+::Wait()
+{
+  if (this->IsRunning())
+    {
+    m_Thread.join();
+    }
+}
+
+itk::LightObject::Pointer
+AsynchronousImageIOReader
+::Take(const itk::ImageIORegion& region,
+       ImageIOBase::IOComponentType componentType,
+       size_t size)
+{
+  this->Wait();
+
+  const bool match = m_Staged && !m_Failed
+                     && region == m_Region
+                     && componentType == m_ComponentType
+                     && size == m_BufferSize;
+
+  otbMsgDevMacro(<< "Read ahead of region " << m_Region
+                 << (match ? " used" : " discarded"));
+
+  itk::LightObject::Pointer owner;
+  if (match)
+    {
+    owner = m_BufferOwner;
+    }
+  this->Clear();
+  return owner;
+}
+
+void
+AsynchronousImageIOReader
+::Clear()
+{
+  this->Wait();
+  m_Staged = false;
+  m_BufferOwner = ITK_NULLPTR;
+  m_Buffer = ITK_NULLPTR;
+  m_BufferSize = 0;
+}
+
+void
+AsynchronousImageIOReader
+::ThreadedRead()
+{
+  try
+    {
+    m_ImageIO->SetIORegion(m_Region);
+    m_ImageIO->SetReadComponentType(m_ComponentType);
+    m_ImageIO->Read(m_BufferSize == 0 ? ITK_NULLPTR : m_Buffer);
+    m_ImageIO->SetReadComponentType(ImageIOBase::UNKNOWNCOMPONENTTYPE);
+    }
+  catch (...)
+    {
+    m_Failed = true;
+    m_ImageIO->SetReadComponentType(ImageIOBase::UNKNOWNCOMPONENTTYPE);
+    }
+}
+
+void
+AsynchronousImageIOReader
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Running: " << (this->IsRunning() ? "On" : "Off") << std::endl;
+  os << indent << "Staged region: " << (m_Staged ? "On" : "Off") << std::endl;
+}
+
+} // end namespace otb
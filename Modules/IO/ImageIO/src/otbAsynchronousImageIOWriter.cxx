@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbAsynchronousImageIOWriter.h"
+#include "otbMacro.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+AsynchronousImageIOWriter
+::AsynchronousImageIOWriter()
+  : m_ImageIO(),
+    m_MaximumNumberOfPendingBuffers(1),
+    m_Writing(false),
+    m_StopRequested(false)
+{
+}
+
+AsynchronousImageIOWriter
+::~AsynchronousImageIOWriter()
+{
+  this->Abort();
+}
+
+void
+AsynchronousImageIOWriter
+::Start()
+{
+  if (m_ImageIO.IsNull())
+    {
+    itkExceptionMacro(<< "No ImageIO set");
+    }
+
+  if (this->IsRunning())
+    {
+    itkExceptionMacro(<< "I/O thread is already running");
+    }
+
+  m_StopRequested = false;
+  m_Writing = false;
+  m_Error = std::exception_ptr();
+  m_Queue.clear();
+
+  m_Thread = std::thread(&Self::ThreadedWrite, this);
+}
+
+void
+AsynchronousImageIOWriter
+::AcquireBuffer(BufferType& buffer, size_t size)
+{
+  {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (!m_FreeBuffers.empty())
+    {
+    buffer.swap(m_FreeBuffers.back());
+    m_FreeBuffers.pop_back();
+    }
+  }
+  buffer.resize(size);
+}
+
+void
+AsynchronousImageIOWriter
+::Push(const itk::ImageIORegion& region, BufferType& buffer, const WrittenCallbackType& written)
+{
+  if (!this->IsRunning())
+    {
+    itkExceptionMacro(<< "I/O thread is not running, call Start() first");
+    }
+
+  const size_t maxPending = std::max(m_MaximumNumberOfPendingBuffers, 1U);
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_QueueNotFull.wait(lock, [this, maxPending]
+    {
+    return m_Error || (m_Queue.size() + (m_Writing ? 1 : 0)) < maxPending;
+    });
+
+  if (m_Error)
+    {
+    lock.unlock();
+    this->RethrowPendingError();
+    }
+
+  m_Queue.push_back(JobType());
+  m_Queue.back().Region = region;
+  m_Queue.back().Buffer.swap(buffer);
+  m_Queue.back().Written = written;
+  lock.unlock();
+
+  m_QueueNotEmpty.notify_one();
+}
+
+void
+AsynchronousImageIOWriter
+::Stop()
+{
+  if (!this->IsRunning())
+    {
+    return;
+    }
+
+  {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_StopRequested = true;
+  }
+  m_QueueNotEmpty.notify_all();
+  m_Thread.join();
+  m_FreeBuffers.clear();
+
+  this->RethrowPendingError();
+}
+
+void
+AsynchronousImageIOWriter
+::Abort()
+{
+  if (!this->IsRunning())
+    {
+    return;
+    }
+
+  {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_StopRequested = true;
+  m_Queue.clear();
+  }
+  m_QueueNotEmpty.notify_all();
+  m_Thread.join();
+  m_FreeBuffers.clear();
+
+  m_Error = std::exception_ptr();
+}
+
+void
+AsynchronousImageIOWriter
+::ThreadedWrite()
+{
+  while (true)
+    {
+    JobType job;
+
+    {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_QueueNotEmpty.wait(lock, [this]
+      {
+      return !m_Queue.empty() || m_StopRequested;
+      });
+
+    if (m_Queue.empty())
+      {
+      // Stop was requested and every buffer has been written
+      break;
+      }
+
+    job.Region = m_Queue.front().Region;
+    job.Buffer.swap(m_Queue.front().Buffer);
+    job.Written.swap(m_Queue.front().Written);
+    m_Queue.pop_front();
+    m_Writing = !m_Error;
+    }
+
+    if (m_Writing)
+      {
+      try
+        {
+        otbMsgDevMacro(<< "Asynchronous write of region " << job.Region);
+        m_ImageIO->SetIORegion(job.Region);
+        m_ImageIO->Write(&job.Buffer[0]);
+        if (job.Written)
+          {
+          job.Written();
+          }
+        }
+      catch (...)
+        {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Error = std::current_exception();
+        }
+      }
+
+    {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Writing = false;
+    if (m_FreeBuffers.size() <= m_MaximumNumberOfPendingBuffers)
+      {
+      m_FreeBuffers.push_back(BufferType());
+      m_FreeBuffers.back().swap(job.Buffer);
+      }
+    }
+    m_QueueNotFull.notify_all();
+    }
+}
+
+void
+AsynchronousImageIOWriter
+::RethrowPendingError()
+{
+  std::exception_ptr error;
+  {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  error = m_Error;
+  m_Error = std::exception_ptr();
+  }
+
+  if (error)
+    {
+    std::rethrow_exception(error);
+    }
+}
+
+void
+AsynchronousImageIOWriter
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumNumberOfPendingBuffers: " << m_MaximumNumberOfPendingBuffers << std::endl;
+  os << indent << "Running: " << (this->IsRunning() ? "On" : "Off") << std::endl;
+}
+
+} // end namespace otb
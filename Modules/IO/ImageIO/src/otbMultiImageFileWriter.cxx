@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMultiImageFileWriter.h"
+#include "otbMacro.h"
+#include "otbConfigurationManager.h"
+
+#include "otbNumberOfDivisionsStrippedStreamingManager.h"
+#include "otbNumberOfDivisionsTiledStreamingManager.h"
+#include "otbNumberOfLinesStrippedStreamingManager.h"
+#include "otbRAMDrivenStrippedStreamingManager.h"
+#include "otbTileDimensionTiledStreamingManager.h"
+#include "otbRAMDrivenTiledStreamingManager.h"
+#include "otbRAMDrivenAdaptativeStreamingManager.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+namespace otb
+{
+
+namespace
+{
+typedef itk::ImageBase<2>                                 UpstreamImageType;
+typedef UpstreamImageType::RegionType                     UpstreamRegionType;
+typedef std::map<UpstreamImageType *, UpstreamRegionType> RequestedRegionMapType;
+
+/** Merge the regions requested to the upstream images of the data
+ * object, after the propagation of its requested region */
+void CollectRequestedRegions(itk::DataObject * data,
+                             std::set<itk::DataObject *> & visited,
+                             RequestedRegionMapType & requestedRegions)
+{
+  if (data == ITK_NULLPTR || !visited.insert(data).second)
+    {
+    return;
+    }
+
+  UpstreamImageType * image = dynamic_cast<UpstreamImageType *>(data);
+  if (image != ITK_NULLPTR && image->GetRequestedRegion().GetNumberOfPixels() > 0)
+    {
+    const UpstreamRegionType & requested = image->GetRequestedRegion();
+    RequestedRegionMapType::iterator it = requestedRegions.find(image);
+    if (it == requestedRegions.end())
+      {
+      requestedRegions[image] = requested;
+      }
+    else
+      {
+      UpstreamRegionType::IndexType index;
+      UpstreamRegionType::SizeType  size;
+      for (unsigned int d = 0; d < 2; ++d)
+        {
+        const itk::IndexValueType lower = std::min(it->second.GetIndex(d), requested.GetIndex(d));
+        const itk::IndexValueType upper =
+          std::max(it->second.GetIndex(d) + static_cast<itk::IndexValueType>(it->second.GetSize(d)),
+                   requested.GetIndex(d) + static_cast<itk::IndexValueType>(requested.GetSize(d)));
+        index[d] = lower;
+        size[d] = static_cast<UpstreamRegionType::SizeValueType>(upper - lower);
+        }
+      it->second = UpstreamRegionType(index, size);
+      }
+    }
+
+  itk::ProcessObject * source = data->GetSource();
+  if (source != ITK_NULLPTR)
+    {
+    itk::ProcessObject::DataObjectPointerArray inputs = source->GetInputs();
+    for (unsigned int i = 0; i < inputs.size(); ++i)
+      {
+      CollectRequestedRegions(inputs[i].GetPointer(), visited, requestedRegions);
+      }
+    }
+}
+}
+
+MultiImageFileWriter
+::MultiImageFileWriter()
+  : m_NumberOfDivisions(0)
+{
+  this->SetNumberOfRequiredOutputs(1);
+  this->SetNthOutput(0, this->MakeOutput(0));
+
+  // By default, we use tiled streaming, with automatic tile size
+  // We don't set any parameter, so the memory size is retrieved from the OTB configuration options
+  this->SetAutomaticAdaptativeStreaming();
+}
+
+itk::DataObject::Pointer
+MultiImageFileWriter
+::MakeOutput(DataObjectPointerArraySizeType)
+{
+  return StreamingImageType::New().GetPointer();
+}
+
+MultiImageFileWriter::StreamingImageType *
+MultiImageFileWriter
+::GetStreamingImage()
+{
+  return static_cast<StreamingImageType *>(this->GetOutput(0));
+}
+
+void
+MultiImageFileWriter
+::ClearInputImages()
+{
+  m_Sinks.clear();
+  this->SetNumberOfIndexedInputs(0);
+  this->Modified();
+}
+
+bool
+MultiImageFileWriter
+::IsSupportedFileName(const std::string & fileName)
+{
+  ExtendedFilenameToWriterOptions::Pointer helper = ExtendedFilenameToWriterOptions::New();
+  helper->SetExtendedFileName(fileName.c_str());
+  return !(helper->BoxIsSet() || helper->BandRangeIsSet() || helper->StreamingTypeIsSet()
+           || helper->StreamingSizeModeIsSet() || helper->StreamingSizeValueIsSet()
+           || helper->AsyncWriteIsSet() || helper->ResumeIsSet());
+}
+
+void
+MultiImageFileWriter
+::SetNumberOfDivisionsStrippedStreaming(unsigned int nbDivisions)
+{
+  typedef NumberOfDivisionsStrippedStreamingManager<StreamingImageType> NumberOfDivisionsStrippedStreamingManagerType;
+  NumberOfDivisionsStrippedStreamingManagerType::Pointer streamingManager = NumberOfDivisionsStrippedStreamingManagerType::New();
+  streamingManager->SetNumberOfDivisions(nbDivisions);
+
+  m_StreamingManager = streamingManager;
+}
+
+void
+MultiImageFileWriter
+::SetNumberOfDivisionsTiledStreaming(unsigned int nbDivisions)
+{
+  typedef NumberOfDivisionsTiledStreamingManager<StreamingImageType> NumberOfDivisionsTiledStreamingManagerType;
+  NumberOfDivisionsTiledStreamingManagerType::Pointer streamingManager = NumberOfDivisionsTiledStreamingManagerType::New();
+  streamingManager->SetNumberOfDivisions(nbDivisions);
+
+  m_StreamingManager = streamingManager;
+}
+
+void
+MultiImageFileWriter
+::SetNumberOfLinesStrippedStreaming(unsigned int nbLinesPerStrip)
+{
+  typedef NumberOfLinesStrippedStreamingManager<StreamingImageType> NumberOfLinesStrippedStreamingManagerType;
+  NumberOfLinesStrippedStreamingManagerType::Pointer streamingManager = NumberOfLinesStrippedStreamingManagerType::New();
+  streamingManager->SetNumberOfLinesPerStrip(nbLinesPerStrip);
+
+  m_StreamingManager = streamingManager;
+}
+
+void
+MultiImageFileWriter
+::SetAutomaticStrippedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef RAMDrivenStrippedStreamingManager<StreamingImageType> RAMDrivenStrippedStreamingManagerType;
+  RAMDrivenStrippedStreamingManagerType::Pointer streamingManager = RAMDrivenStrippedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+
+  m_StreamingManager = streamingManager;
+}
+
+void
+MultiImageFileWriter
+::SetTileDimensionTiledStreaming(unsigned int tileDimension)
+{
+  typedef TileDimensionTiledStreamingManager<StreamingImageType> TileDimensionTiledStreamingManagerType;
+  TileDimensionTiledStreamingManagerType::Pointer streamingManager = TileDimensionTiledStreamingManagerType::New();
+  streamingManager->SetTileDimension(tileDimension);
+
+  m_StreamingManager = streamingManager;
+}
+
+void
+MultiImageFileWriter
+::SetAutomaticTiledStreaming(unsigned int availableRAM, double bias)
+{
+  typedef RAMDrivenTiledStreamingManager<StreamingImageType> RAMDrivenTiledStreamingManagerType;
+  RAMDrivenTiledStreamingManagerType::Pointer streamingManager = RAMDrivenTiledStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+
+  m_StreamingManager = streamingManager;
+}
+
+void
+MultiImageFileWriter
+::SetAutomaticAdaptativeStreaming(unsigned int availableRAM, double bias)
+{
+  typedef RAMDrivenAdaptativeStreamingManager<StreamingImageType> RAMDrivenAdaptativeStreamingManagerType;
+  RAMDrivenAdaptativeStreamingManagerType::Pointer streamingManager = RAMDrivenAdaptativeStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+
+  m_StreamingManager = streamingManager;
+}
+
+void
+MultiImageFileWriter
+::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const RegionType largestRegion = this->GetStreamingImage()->GetLargestPossibleRegion();
+  for (unsigned int i = 0; i < m_Sinks.size(); ++i)
+    {
+    const ImageBaseType * image = dynamic_cast<const ImageBaseType *>(this->GetInput(i));
+    if (image == ITK_NULLPTR)
+      {
+      itkExceptionMacro(<< "The image to write in " << m_Sinks[i]->GetFileName() << " is not a 2D image");
+      }
+    if (image->GetLargestPossibleRegion() != largestRegion)
+      {
+      itkExceptionMacro(<< "The largest possible region of the image to write in " << m_Sinks[i]->GetFileName()
+                        << " (" << image->GetLargestPossibleRegion()
+                        << ") differs from the one of the first image (" << largestRegion << ")");
+      }
+    }
+}
+
+void
+MultiImageFileWriter
+::UpdateRegion(const RegionType & region)
+{
+  // Propagate the region to all the pipelines before updating any of
+  // them: propagating the region of an image overwrites the regions
+  // requested to the upstream images by the previous ones
+  RequestedRegionMapType requestedRegions;
+  for (unsigned int i = 0; i < m_Sinks.size(); ++i)
+    {
+    ImageBaseType * image = static_cast<ImageBaseType *>(this->GetInput(i));
+    image->SetRequestedRegion(region);
+    image->PropagateRequestedRegion();
+
+    std::set<itk::DataObject *> visited;
+    CollectRequestedRegions(image, visited, requestedRegions);
+    }
+
+  // The shared part of the pipelines is computed once on the union of
+  // the regions, when the first image going through it is updated
+  for (RequestedRegionMapType::iterator it = requestedRegions.begin();
+       it != requestedRegions.end(); ++it)
+    {
+    it->first->SetRequestedRegion(it->second);
+    }
+  for (unsigned int i = 0; i < m_Sinks.size(); ++i)
+    {
+    this->GetInput(i)->UpdateOutputData();
+    }
+}
+
+void
+MultiImageFileWriter
+::GenerateInputRequestedRegion()
+{
+  const RegionType requestedRegion = this->GetStreamingImage()->GetRequestedRegion();
+  for (unsigned int i = 0; i < m_Sinks.size(); ++i)
+    {
+    ImageBaseType * image = dynamic_cast<ImageBaseType *>(this->GetInput(i));
+    if (image != ITK_NULLPTR)
+      {
+      image->SetRequestedRegion(requestedRegion);
+      }
+    }
+}
+
+void
+MultiImageFileWriter
+::GenerateData()
+{
+  StreamingImageType * streamingImage = this->GetStreamingImage();
+  streamingImage->SetBufferedRegion(streamingImage->GetRequestedRegion());
+  streamingImage->Allocate();
+}
+
+void
+MultiImageFileWriter
+::Update()
+{
+  if (m_Sinks.empty())
+    {
+    itkExceptionMacro(<< "No image to write");
+    }
+
+  this->SetAbortGenerateData(0);
+  this->SetProgress(0.0);
+
+  /**
+   * Tell all Observers that the filter is starting
+   */
+  this->InvokeEvent(itk::StartEvent());
+
+  this->UpdateOutputInformation();
+  StreamingImageType * streamingImage = this->GetStreamingImage();
+  const RegionType largestRegion = streamingImage->GetLargestPossibleRegion();
+
+  bool canStreamWrite = true;
+  for (unsigned int i = 0; i < m_Sinks.size(); ++i)
+    {
+    if (!m_Sinks[i]->PrepareImageIO())
+      {
+      otbWarningMacro(<< "The ImageFactory selected for the image file <" << m_Sinks[i]->GetFileName()
+                      << "> does not support streaming.");
+      canStreamWrite = false;
+      }
+    }
+  if (!canStreamWrite)
+    {
+    this->SetNumberOfDivisionsStrippedStreaming(1);
+    }
+
+  // Measure the memory used by the pipeline on probe regions instead
+  // of estimating it, if requested. Set on each update, as the
+  // streaming manager is kept between updates.
+  m_StreamingManager->SetMemoryCalibration(ConfigurationManager::GetUseMemoryCalibration());
+
+  // The memory print is the one of the pipelines of all the images,
+  // which are the inputs of the streaming image
+  m_StreamingManager->PrepareStreaming(streamingImage, largestRegion);
+  m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
+  otbMsgDebugMacro(<< "Number Of Stream Divisions : " << m_NumberOfDivisions);
+
+  for (unsigned int i = 0; i < m_Sinks.size(); ++i)
+    {
+    m_Sinks[i]->WriteImageInformation(largestRegion);
+    }
+
+  for (unsigned int division = 0;
+       division < m_NumberOfDivisions && !this->GetAbortGenerateData();
+       ++division)
+    {
+    const RegionType streamRegion = m_StreamingManager->GetSplit(division);
+
+    this->UpdateRegion(streamRegion);
+    for (unsigned int i = 0; i < m_Sinks.size(); ++i)
+      {
+      m_Sinks[i]->Write(streamRegion);
+      }
+
+    this->UpdateProgress(static_cast<float>(division + 1) / m_NumberOfDivisions);
+    }
+
+  for (unsigned int i = 0; i < m_Sinks.size(); ++i)
+    {
+    m_Sinks[i]->WriteGeometry();
+    }
+
+  /**
+   * If we ended due to aborting, push the progress up to 1.0 (since
+   * it probably didn't end there)
+   */
+  if (!this->GetAbortGenerateData())
+    {
+    this->UpdateProgress(1.0);
+    }
+
+  // Notify end event observers
+  this->InvokeEvent(itk::EndEvent());
+
+  /**
+   * Release any inputs if marked for release
+   */
+  this->ReleaseInputs();
+}
+
+void
+MultiImageFileWriter
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of images: " << m_Sinks.size() << std::endl;
+  for (unsigned int i = 0; i < m_Sinks.size(); ++i)
+    {
+    os << indent << "File name " << i << ": " << m_Sinks[i]->GetFileName() << std::endl;
+    }
+  os << indent << "Number of divisions: " << m_NumberOfDivisions << std::endl;
+}
+
+} // end namespace otb
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbStreamingWriteJournal.h"
+#include "otbMacro.h"
+#include "itksys/SystemTools.hxx"
+
+#include <cstdlib>
+
+namespace otb
+{
+
+namespace
+{
+// First line of a journal, changed if the format changes
+const char * const JournalHeader = "OTB streaming write journal 1";
+}
+
+StreamingWriteJournal
+::StreamingWriteJournal()
+  : m_FileName()
+{
+}
+
+StreamingWriteJournal
+::~StreamingWriteJournal()
+{
+  this->Close();
+}
+
+bool
+StreamingWriteJournal
+::Open(const std::string& filename, const std::string& signature, bool resume)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (m_File.is_open())
+    {
+    m_File.close();
+    }
+  m_FileName = filename;
+  m_CompletedDivisions.clear();
+
+  const bool resumed = resume && this->Load(signature);
+  if (resumed)
+    {
+    m_File.open(m_FileName.c_str(), std::ios::out | std::ios::app);
+    }
+  else
+    {
+    m_CompletedDivisions.clear();
+    m_File.open(m_FileName.c_str(), std::ios::out | std::ios::trunc);
+    m_File << JournalHeader << "\n" << signature << "\n";
+    m_File.flush();
+    }
+
+  if (!m_File.good())
+    {
+    itkExceptionMacro(<< "Unable to write the journal " << m_FileName);
+    }
+
+  otbMsgDevMacro(<< "Journal " << m_FileName << (resumed ? " resumed with " : " started with ")
+                 << m_CompletedDivisions.size() << " divisions written");
+  return resumed;
+}
+
+bool
+StreamingWriteJournal
+::Load(const std::string& signature)
+{
+  std::ifstream file(m_FileName.c_str());
+  if (!file.good())
+    {
+    return false;
+    }
+
+  std::string line;
+  if (!std::getline(file, line) || line != JournalHeader)
+    {
+    return false;
+    }
+  if (!std::getline(file, line) || line != signature)
+    {
+    return false;
+    }
+
+  while (std::getline(file, line))
+    {
+    // The last line may have been cut by the interruption
+    char * end = ITK_NULLPTR;
+    const unsigned long division = strtoul(line.c_str(), &end, 10);
+    if (!line.empty() && end == line.c_str() + line.size())
+      {
+      m_CompletedDivisions.insert(static_cast<unsigned int>(division));
+      }
+    }
+  return true;
+}
+
+bool
+StreamingWriteJournal
+::IsCompleted(unsigned int division) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_CompletedDivisions.count(division) > 0;
+}
+
+void
+StreamingWriteJournal
+::MarkCompleted(unsigned int division)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (!m_CompletedDivisions.insert(division).second)
+    {
+    return;
+    }
+  if (m_File.is_open())
+    {
+    m_File << division << "\n";
+    m_File.flush();
+    }
+}
+
+unsigned int
+StreamingWriteJournal
+::GetNumberOfCompletedDivisions() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return static_cast<unsigned int>(m_CompletedDivisions.size());
+}
+
+void
+StreamingWriteJournal
+::Close()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_File.is_open())
+    {
+    m_File.close();
+    }
+}
+
+void
+StreamingWriteJournal
+::Remove()
+{
+  this->Close();
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (!m_FileName.empty() && itksys::SystemTools::FileExists(m_FileName.c_str(), true))
+    {
+    itksys::SystemTools::RemoveFile(m_FileName.c_str());
+    }
+  m_CompletedDivisions.clear();
+}
+
+void
+StreamingWriteJournal
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "Completed divisions: " << this->GetNumberOfCompletedDivisions() << std::endl;
+}
+
+} // end namespace otb
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "itkImageRegionConstIterator.h"
+
+#include <sstream>
+
+int otbImageFileReaderBandSubset(int itkNotUsed(argc), char* argv[])
+{
+  const std::string  inputFilename(argv[1]);
+  const unsigned int firstBand = atoi(argv[2]);
+  const unsigned int lastBand  = atoi(argv[3]);
+
+  typedef otb::VectorImage<double, 2>                ImageType;
+  typedef otb::ImageFileReader<ImageType>            ReaderType;
+  typedef itk::ImageRegionConstIterator<ImageType>   IteratorType;
+
+  // Selected bands, read by the ImageIO itself
+  std::ostringstream subsetFilename;
+  subsetFilename << inputFilename << "?&bands=" << firstBand << ":" << lastBand;
+  ReaderType::Pointer subsetReader = ReaderType::New();
+  subsetReader->SetFileName(subsetFilename.str());
+  subsetReader->Update();
+
+  if (!subsetReader->GetImageIO()->CanReadBandSubset())
+    {
+    std::cerr << "The ImageIO of " << inputFilename << " does not read the band subset" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Reference: every band, the selected ones being extracted afterwards
+  ReaderType::Pointer fullReader = ReaderType::New();
+  fullReader->SetFileName(inputFilename);
+  fullReader->Update();
+
+  const ImageType* subset = subsetReader->GetOutput();
+  const ImageType* full = fullReader->GetOutput();
+  const unsigned int nbBands = lastBand - firstBand + 1;
+  if (subset->GetNumberOfComponentsPerPixel() != nbBands)
+    {
+    std::cerr << subset->GetNumberOfComponentsPerPixel() << " bands read instead of " << nbBands << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (subset->GetLargestPossibleRegion() != full->GetLargestPossibleRegion())
+    {
+    std::cerr << "The regions of the images differ" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  IteratorType subsetIt(subset, subset->GetLargestPossibleRegion());
+  IteratorType fullIt(full, full->GetLargestPossibleRegion());
+  for (subsetIt.GoToBegin(), fullIt.GoToBegin(); !subsetIt.IsAtEnd(); ++subsetIt, ++fullIt)
+    {
+    for (unsigned int band = 0; band < nbBands; ++band)
+      {
+      if (subsetIt.Get()[band] != fullIt.Get()[firstBand - 1 + band])
+        {
+        std::cerr << "Band " << firstBand + band << " differs at " << subsetIt.GetIndex() << ": "
+                  << subsetIt.Get()[band] << " instead of " << fullIt.Get()[firstBand - 1 + band] << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "itkImageRegionConstIterator.h"
+
+int otbImageFileReaderConvertComponents(int itkNotUsed(argc), char* argv[])
+{
+  const char * inputFilename = argv[1];
+
+  // The file holds 8 bits components
+  typedef otb::VectorImage<unsigned char, 2>             FileImageType;
+  typedef otb::VectorImage<float, 2>                     ConvertedImageType;
+  typedef otb::ImageFileReader<FileImageType>            FileReaderType;
+  typedef otb::ImageFileReader<ConvertedImageType>       ConvertedReaderType;
+
+  // Components converted by the ImageIO while reading
+  ConvertedReaderType::Pointer convertedReader = ConvertedReaderType::New();
+  convertedReader->SetFileName(inputFilename);
+  convertedReader->Update();
+
+  otb::ImageIOBase* imageIO = convertedReader->GetImageIO();
+  if (imageIO->GetComponentType() != otb::ImageIOBase::UCHAR)
+    {
+    std::cerr << inputFilename << " does not hold 8 bits components" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (!imageIO->CanReadAsComponentType(otb::ImageIOBase::FLOAT))
+    {
+    std::cerr << "The ImageIO of " << inputFilename << " does not convert the components" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Reference: components read with their own type, then converted
+  // as the reader did before
+  FileReaderType::Pointer fileReader = FileReaderType::New();
+  fileReader->SetFileName(inputFilename);
+  fileReader->Update();
+
+  const ConvertedImageType* converted = convertedReader->GetOutput();
+  const FileImageType* reference = fileReader->GetOutput();
+  const unsigned int nbComponents = reference->GetNumberOfComponentsPerPixel();
+  if (converted->GetNumberOfComponentsPerPixel() != nbComponents
+      || converted->GetLargestPossibleRegion() != reference->GetLargestPossibleRegion())
+    {
+    std::cerr << "The images differ in size or number of components" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  itk::ImageRegionConstIterator<ConvertedImageType> convertedIt(converted, converted->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FileImageType> referenceIt(reference, reference->GetLargestPossibleRegion());
+  for (convertedIt.GoToBegin(), referenceIt.GoToBegin(); !convertedIt.IsAtEnd(); ++convertedIt, ++referenceIt)
+    {
+    for (unsigned int k = 0; k < nbComponents; ++k)
+      {
+      if (convertedIt.Get()[k] != static_cast<float>(referenceIt.Get()[k]))
+        {
+        std::cerr << "Component " << k << " differs at " << convertedIt.GetIndex() << ": "
+                  << convertedIt.Get()[k] << " instead of " << +referenceIt.Get()[k] << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
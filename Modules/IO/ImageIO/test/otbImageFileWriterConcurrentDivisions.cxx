@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "itkMeanImageFilter.h"
+
+#include <vector>
+
+int otbImageFileWriterConcurrentDivisions(int itkNotUsed(argc), char* argv[])
+{
+  const char * inputFilename  = argv[1];
+  const char * outputFilename = argv[2];
+  const unsigned int radius = atoi(argv[3]);
+  const unsigned int nbPipelines = atoi(argv[4]);
+  const unsigned int nbDivisions = atoi(argv[5]);
+
+  typedef otb::Image<unsigned char, 2>                          ImageType;
+  typedef otb::ImageFileReader<ImageType>                       ReaderType;
+  typedef otb::ImageFileWriter<ImageType>                       WriterType;
+  typedef itk::MeanImageFilter<ImageType, ImageType>            FilterType;
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(outputFilename);
+  writer->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+
+  // One independent pipeline per concurrent division
+  std::vector<ReaderType::Pointer> readers;
+  std::vector<FilterType::Pointer> filters;
+  for (unsigned int i = 0; i < nbPipelines; ++i)
+    {
+    readers.push_back(ReaderType::New());
+    readers.back()->SetFileName(inputFilename);
+
+    filters.push_back(FilterType::New());
+    filters.back()->SetInput(readers.back()->GetOutput());
+    ImageType::SizeType rad;
+    rad.Fill(radius);
+    filters.back()->SetRadius(rad);
+
+    if (i == 0)
+      {
+      writer->SetInput(filters.back()->GetOutput());
+      }
+    else
+      {
+      writer->AddConcurrentInput(filters.back()->GetOutput());
+      }
+    }
+
+  if (writer->GetNumberOfConcurrentInputs() != nbPipelines - 1)
+    {
+    std::cerr << "Wrong number of concurrent inputs: " << writer->GetNumberOfConcurrentInputs() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  writer->Update();
+
+  // Each pipeline must have computed its share of the divisions
+  for (unsigned int i = 0; i < nbPipelines && i < nbDivisions; ++i)
+    {
+    if (filters[i]->GetOutput()->GetBufferedRegion().GetNumberOfPixels() == 0)
+      {
+      std::cerr << "Pipeline " << i << " computed no division" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "otbMaskEmptyDivisionPredicate.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+int otbImageFileWriterEmptyDivisions(int itkNotUsed(argc), char* argv[])
+{
+  const char * inputFilename  = argv[1];
+  const char * outputFilename = argv[2];
+  const unsigned int nbDivisions = atoi(argv[3]);
+
+  typedef otb::Image<unsigned char, 2>                                 ImageType;
+  typedef otb::ImageFileReader<ImageType>                              ReaderType;
+  typedef otb::ImageFileWriter<ImageType>                              WriterType;
+  typedef otb::MaskEmptyDivisionPredicate<ImageType, ImageType>        PredicateType;
+  typedef itk::ImageRegionConstIterator<ImageType>                     IteratorType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+  reader->UpdateOutputInformation();
+
+  // The upper half of the image holds no data
+  ImageType::Pointer mask = ImageType::New();
+  mask->CopyInformation(reader->GetOutput());
+  mask->SetRegions(reader->GetOutput()->GetLargestPossibleRegion());
+  mask->Allocate();
+  mask->FillBuffer(1);
+
+  ImageType::RegionType emptyRegion = mask->GetLargestPossibleRegion();
+  emptyRegion.SetSize(1, emptyRegion.GetSize(1) / 2);
+  for (itk::ImageRegionIterator<ImageType> it(mask, emptyRegion); !it.IsAtEnd(); ++it)
+    {
+    it.Set(0);
+    }
+
+  PredicateType::Pointer predicate = PredicateType::New();
+  predicate->SetMask(mask);
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(reader->GetOutput());
+  writer->SetFileName(outputFilename);
+  writer->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+  writer->SetEmptyDivisionPredicate(predicate);
+  writer->Update();
+
+  if (writer->GetNumberOfEmptyDivisions() == 0)
+    {
+    std::cerr << "No empty division found" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  ReaderType::Pointer outputReader = ReaderType::New();
+  // Drop the writer options from the extended filename
+  const std::string outputPath(outputFilename);
+  outputReader->SetFileName(outputPath.substr(0, outputPath.find('?')));
+  outputReader->Update();
+
+  ReaderType::Pointer inputReader = ReaderType::New();
+  inputReader->SetFileName(inputFilename);
+  inputReader->Update();
+
+  // Pixels are either copied from the input, or no-data in the masked
+  // part. The first line is in an empty division.
+  IteratorType outIt(outputReader->GetOutput(), outputReader->GetOutput()->GetLargestPossibleRegion());
+  IteratorType inIt(inputReader->GetOutput(), inputReader->GetOutput()->GetLargestPossibleRegion());
+  IteratorType maskIt(mask, mask->GetLargestPossibleRegion());
+  for (; !outIt.IsAtEnd(); ++outIt, ++inIt, ++maskIt)
+    {
+    const bool firstLine = (outIt.GetIndex()[1] == emptyRegion.GetIndex(1));
+    const bool copied = (outIt.Get() == inIt.Get() && !firstLine);
+    const bool noData = (outIt.Get() == 0 && maskIt.Get() == 0);
+    if (!copied && !noData)
+      {
+      std::cerr << "Wrong pixel at " << outIt.GetIndex() << ": " << static_cast<int>(outIt.Get())
+                << " (input is " << static_cast<int>(inIt.Get()) << ")" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
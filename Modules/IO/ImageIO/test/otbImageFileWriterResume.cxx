@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "itkCommand.h"
+#include "itksys/SystemTools.hxx"
+
+namespace
+{
+// Interrupt the writer once half of the image is written
+class AbortCommand : public itk::Command
+{
+public:
+  typedef AbortCommand            Self;
+  typedef itk::Command            Superclass;
+  typedef itk::SmartPointer<Self> Pointer;
+  itkNewMacro(Self);
+
+  void Execute(itk::Object * caller, const itk::EventObject & event) ITK_OVERRIDE
+  {
+    itk::ProcessObject * process = dynamic_cast<itk::ProcessObject *>(caller);
+    if (process != ITK_NULLPTR && itk::ProgressEvent().CheckEvent(&event) && process->GetProgress() >= 0.5)
+      {
+      process->AbortGenerateDataOn();
+      }
+  }
+
+  void Execute(const itk::Object *, const itk::EventObject &) ITK_OVERRIDE
+  {
+  }
+};
+}
+
+int otbImageFileWriterResume(int itkNotUsed(argc), char* argv[])
+{
+  const char * inputFilename  = argv[1];
+  const char * outputFilename = argv[2];
+  const unsigned int nbDivisions = atoi(argv[3]);
+
+  typedef otb::Image<unsigned char, 2>    ImageType;
+  typedef otb::ImageFileReader<ImageType> ReaderType;
+  typedef otb::ImageFileWriter<ImageType> WriterType;
+
+  const std::string journalFilename = std::string(outputFilename) + ".journal";
+  itksys::SystemTools::RemoveFile(outputFilename);
+  itksys::SystemTools::RemoveFile(journalFilename.c_str());
+
+  // Interrupted write
+  {
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(reader->GetOutput());
+  writer->SetFileName(outputFilename);
+  writer->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+  writer->ResumableOn();
+  writer->AddObserver(itk::ProgressEvent(), AbortCommand::New());
+  writer->Update();
+
+  if (!itksys::SystemTools::FileExists(journalFilename.c_str(), true))
+    {
+    std::cerr << "The journal of the interrupted write is missing" << std::endl;
+    return EXIT_FAILURE;
+    }
+  }
+
+  // Resumed write
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(reader->GetOutput());
+  writer->SetFileName(outputFilename);
+  writer->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+  writer->ResumableOn();
+  writer->Update();
+
+  std::cout << writer->GetNumberOfResumedDivisions() << " divisions resumed out of " << nbDivisions << std::endl;
+  if (writer->GetNumberOfResumedDivisions() == 0 || writer->GetNumberOfResumedDivisions() >= nbDivisions)
+    {
+    std::cerr << "The write has not been resumed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (itksys::SystemTools::FileExists(journalFilename.c_str(), true))
+    {
+    std::cerr << "The journal has not been removed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -100,6 +100,12 @@ void RegisterTests()
   REGISTER_TEST(otbVectorImageFileWriterComplexTestWithoutInputDouble);
   REGISTER_TEST(otbWritingComplexDataWithComplexImageTest);
   REGISTER_TEST(otbImageFileWriterWithFilterTest);
+  REGISTER_TEST(otbImageFileWriterConcurrentDivisions);
+  REGISTER_TEST(otbImageFileWriterEmptyDivisions);
+  REGISTER_TEST(otbImageFileWriterResume);
+  REGISTER_TEST(otbMultiImageFileWriter);
+  REGISTER_TEST(otbImageFileReaderBandSubset);
+  REGISTER_TEST(otbImageFileReaderConvertComponents);
   REGISTER_TEST(otbImageFileReaderRADComplexDouble);
   REGISTER_TEST(otbPipeline);
   REGISTER_TEST(otbStreamingImageFilterTest);
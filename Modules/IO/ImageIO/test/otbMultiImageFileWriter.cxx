@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbVectorImage.h"
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbMultiImageFileWriter.h"
+#include "itkCastImageFilter.h"
+#include "itkVectorIndexSelectionCastImageFilter.h"
+#include "itkMeanImageFilter.h"
+#include "itkCommand.h"
+
+namespace
+{
+// Count the updates of the reader
+class CountCommand : public itk::Command
+{
+public:
+  typedef CountCommand            Self;
+  typedef itk::Command            Superclass;
+  typedef itk::SmartPointer<Self> Pointer;
+  itkNewMacro(Self);
+
+  void Execute(itk::Object *, const itk::EventObject & event) ITK_OVERRIDE
+  {
+    if (itk::StartEvent().CheckEvent(&event))
+      {
+      ++m_Count;
+      }
+  }
+
+  void Execute(const itk::Object *, const itk::EventObject &) ITK_OVERRIDE
+  {
+  }
+
+  unsigned int m_Count;
+
+protected:
+  CountCommand() : m_Count(0) {}
+};
+}
+
+int otbMultiImageFileWriter(int itkNotUsed(argc), char* argv[])
+{
+  const char * inputFilename   = argv[1];
+  const char * outputFilename1 = argv[2];
+  const char * outputFilename2 = argv[3];
+  const char * outputFilename3 = argv[4];
+  const char * outputFilename4 = argv[5];
+  const unsigned int nbDivisions = atoi(argv[6]);
+
+  typedef otb::VectorImage<unsigned char, 2>                                   ImageType;
+  typedef otb::VectorImage<float, 2>                                           FloatImageType;
+  typedef otb::Image<float, 2>                                                 BandImageType;
+  typedef otb::ImageFileReader<ImageType>                                      ReaderType;
+  typedef itk::CastImageFilter<ImageType, FloatImageType>                      CastFilterType;
+  typedef itk::VectorIndexSelectionCastImageFilter<ImageType, BandImageType>   ExtractFilterType;
+  typedef itk::MeanImageFilter<BandImageType, BandImageType>                   MeanFilterType;
+  typedef otb::MultiImageFileWriter                                            WriterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+
+  CountCommand::Pointer counter = CountCommand::New();
+  reader->AddObserver(itk::StartEvent(), counter);
+
+  CastFilterType::Pointer cast = CastFilterType::New();
+  cast->SetInput(reader->GetOutput());
+
+  // Two means of different radii on the same band: the pipelines
+  // request regions larger than the division to the shared part
+  ExtractFilterType::Pointer extract = ExtractFilterType::New();
+  extract->SetInput(reader->GetOutput());
+  extract->SetIndex(0);
+
+  MeanFilterType::InputSizeType radius;
+  radius.Fill(2);
+  MeanFilterType::Pointer mean2 = MeanFilterType::New();
+  mean2->SetInput(extract->GetOutput());
+  mean2->SetRadius(radius);
+
+  radius.Fill(4);
+  MeanFilterType::Pointer mean4 = MeanFilterType::New();
+  mean4->SetInput(extract->GetOutput());
+  mean4->SetRadius(radius);
+
+  CountCommand::Pointer extractCounter = CountCommand::New();
+  extract->AddObserver(itk::StartEvent(), extractCounter);
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->AddInputImage(reader->GetOutput(), outputFilename1);
+  writer->AddInputImage(cast->GetOutput(), outputFilename2);
+  writer->AddInputImage(mean2->GetOutput(), outputFilename3);
+  writer->AddInputImage(mean4->GetOutput(), outputFilename4);
+  writer->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+  writer->Update();
+
+  std::cout << "Reader updated " << counter->m_Count << " times for "
+            << writer->GetNumberOfDivisions() << " divisions" << std::endl;
+
+  // All the images are written from the same read of each division,
+  // whatever the radius of their pipeline
+  if (counter->m_Count != writer->GetNumberOfDivisions())
+    {
+    std::cerr << "The input has been read more than once per division" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (extractCounter->m_Count != writer->GetNumberOfDivisions())
+    {
+    std::cerr << "The band has been extracted " << extractCounter->m_Count << " times for "
+              << writer->GetNumberOfDivisions() << " divisions" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
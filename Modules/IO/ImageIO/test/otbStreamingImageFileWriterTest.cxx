@@ -29,7 +29,7 @@
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
 
-int otbStreamingImageFileWriterTest(int itkNotUsed(argc), char* argv[])
+int otbStreamingImageFileWriterTest(int argc, char* argv[])
 {
   // Verify the number of parameters in the command line
   const char * inputFilename  = argv[1];
@@ -61,5 +61,18 @@ int otbStreamingImageFileWriterTest(int itkNotUsed(argc), char* argv[])
     writer->SetInput(reader->GetOutput());
     writer->Update();
 
+  // Check that the regions read ahead have been used, if requested
+  if (argc > 4)
+    {
+    const unsigned int expectedRegionsReadAhead = atoi(argv[4]);
+    std::cout << "Regions read ahead: " << reader->GetNumberOfRegionsReadAhead() << std::endl;
+    if (reader->GetNumberOfRegionsReadAhead() < expectedRegionsReadAhead)
+      {
+      std::cerr << "Only " << reader->GetNumberOfRegionsReadAhead() << " regions read ahead instead of "
+                << expectedRegionsReadAhead << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
   return EXIT_SUCCESS;
 }
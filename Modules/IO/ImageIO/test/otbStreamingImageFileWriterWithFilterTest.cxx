@@ -32,7 +32,7 @@
 #include "itkUnaryFunctorImageFilter.h"
 #include "itkMeanImageFilter.h"
 
-int otbImageFileWriterWithFilterTest(int itkNotUsed(argc), char* argv[])
+int otbImageFileWriterWithFilterTest(int argc, char* argv[])
 {
   // Verify the number of parameters in the command line
   const char * inputFilename  = argv[1];
@@ -84,5 +84,18 @@ int otbImageFileWriterWithFilterTest(int itkNotUsed(argc), char* argv[])
     writer->Update();
     }
 
+  // Check that the regions read ahead have been used, if requested
+  if (argc > 6)
+    {
+    const unsigned int expectedRegionsReadAhead = atoi(argv[6]);
+    std::cout << "Regions read ahead: " << reader->GetNumberOfRegionsReadAhead() << std::endl;
+    if (reader->GetNumberOfRegionsReadAhead() < expectedRegionsReadAhead)
+      {
+      std::cerr << "Only " << reader->GetNumberOfRegionsReadAhead() << " regions read ahead instead of "
+                << expectedRegionsReadAhead << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
   return EXIT_SUCCESS;
 }
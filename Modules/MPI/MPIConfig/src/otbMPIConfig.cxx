@@ -19,6 +19,7 @@
  */
 
 #include "otbMPIConfig.h"
+#include "otbDistributedReducer.h"
 
 #include <exception>
 #include <cstdlib>
@@ -26,6 +27,8 @@
 #include <sstream>
 #include <string>
 #include <cassert>
+#include <climits>
+#include <algorithm>
 
 #if defined(__GNUC__) || defined(__clang__)
 # pragma GCC diagnostic push
@@ -58,6 +61,73 @@
 
 namespace otb {
 
+namespace
+{
+/** Reductions over the processes of MPI_COMM_WORLD, used by the
+ * persistent filters to combine their results in Synthetize() */
+class MPIDistributedReducer : public DistributedReducer
+{
+public:
+  typedef MPIDistributedReducer   Self;
+  typedef DistributedReducer      Superclass;
+  typedef itk::SmartPointer<Self> Pointer;
+
+  itkSimpleNewMacro(Self);
+
+  using Superclass::AllReduce;
+
+  void SetRank(unsigned int rank)
+  {
+    m_Rank = rank;
+  }
+
+  void SetNumberOfProcesses(unsigned int nbProcs)
+  {
+    m_NumberOfProcesses = nbProcs;
+  }
+
+  unsigned int GetRank() const ITK_OVERRIDE
+  {
+    return m_Rank;
+  }
+
+  unsigned int GetNumberOfProcesses() const ITK_OVERRIDE
+  {
+    return m_NumberOfProcesses;
+  }
+
+  void AllReduce(double * values, size_t size, OperationType operation) ITK_OVERRIDE
+  {
+    MPI_Op op = MPI_SUM;
+    if (operation == MIN)
+      {
+      op = MPI_MIN;
+      }
+    else if (operation == MAX)
+      {
+      op = MPI_MAX;
+      }
+
+    // MPI counts are int
+    while (size > 0)
+      {
+      const int count = static_cast<int>(std::min(size, static_cast<size_t>(INT_MAX)));
+      OTB_MPI_CHECK_RESULT( MPI_Allreduce, ( MPI_IN_PLACE, values, count, MPI_DOUBLE, op, MPI_COMM_WORLD ));
+      values += count;
+      size -= count;
+      }
+  }
+
+protected:
+  MPIDistributedReducer() : m_Rank(0), m_NumberOfProcesses(1) {}
+  ~MPIDistributedReducer() ITK_OVERRIDE {}
+
+private:
+  unsigned int m_Rank;
+  unsigned int m_NumberOfProcesses;
+};
+}
+
 /** Initialize the singleton */
 MPIConfig::Pointer MPIConfig::m_Singleton = NULL;
 
@@ -134,6 +204,15 @@ void MPIConfig::Init(int &argc, char **&argv, bool abortOnException) {
       }
 
     m_NbProcs = static_cast<unsigned int>(inbprocs);
+
+    // Let the persistent filters share the streaming between the processes
+    if( m_NbProcs > 1 )
+      {
+      MPIDistributedReducer::Pointer reducer = MPIDistributedReducer::New();
+      reducer->SetRank( m_MyRank );
+      reducer->SetNumberOfProcesses( m_NbProcs );
+      DistributedReducer::SetInstance( reducer );
+      }
     }
 }
 
@@ -142,6 +221,7 @@ void MPIConfig::terminate()
 {
   if( m_initialized && !m_terminated )
     {
+    DistributedReducer::SetInstance( ITK_NULLPTR );
     if( std::uncaught_exception() && m_abortOnException )
       {
       abort( EXIT_FAILURE );
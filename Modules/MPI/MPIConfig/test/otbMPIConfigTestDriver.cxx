@@ -23,5 +23,6 @@
 void RegisterTests()
 {
    REGISTER_TEST(otbMPIConfigTest);
+   REGISTER_TEST(otbMPIDistributedStatisticsTest);
 }
 
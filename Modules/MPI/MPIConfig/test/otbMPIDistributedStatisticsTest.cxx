@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMPIConfig.h"
+#include "otbDistributedReducer.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbStreamingStatisticsVectorImageFilter.h"
+#include "otbStreamingShrinkImageFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+typedef otb::VectorImage<double, 2>                                 ImageType;
+typedef otb::ImageFileReader<ImageType>                             ReaderType;
+typedef otb::StreamingStatisticsVectorImageFilter<ImageType>        StatisticsType;
+typedef otb::StreamingShrinkImageFilter<ImageType, ImageType>       ShrinkType;
+
+const unsigned int nbDivisions = 7;
+
+StatisticsType::Pointer ComputeStatistics(const char * filename)
+{
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(filename);
+
+  StatisticsType::Pointer statistics = StatisticsType::New();
+  statistics->SetInput(reader->GetOutput());
+  statistics->GetStreamer()->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+  statistics->Update();
+  return statistics;
+}
+
+ImageType::Pointer Shrink(const char * filename)
+{
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(filename);
+
+  ShrinkType::Pointer shrink = ShrinkType::New();
+  shrink->SetInput(reader->GetOutput());
+  shrink->SetShrinkFactor(4);
+  shrink->Update();
+  return shrink->GetOutput();
+}
+
+bool IsClose(double a, double b)
+{
+  return std::abs(a - b) <= 1e-9 * std::max(1., std::abs(b));
+}
+}
+
+int otbMPIDistributedStatisticsTest(int argc, char* argv[])
+{
+  otb::MPIConfig::Pointer config = otb::MPIConfig::Instance();
+  config->Init(argc, argv, true);
+
+  if (otb::DistributedReducer::GetInstance().IsNull())
+    {
+    config->logError("No reducer registered: run the test with several processes");
+    return EXIT_FAILURE;
+    }
+
+  // Each process streams its share of the divisions
+  StatisticsType::Pointer distributed = ComputeStatistics(argv[1]);
+  ImageType::Pointer distributedShrunk = Shrink(argv[1]);
+
+  // Each process streams the whole image
+  otb::DistributedReducer::Pointer reducer = otb::DistributedReducer::GetInstance();
+  otb::DistributedReducer::SetInstance(ITK_NULLPTR);
+  StatisticsType::Pointer reference = ComputeStatistics(argv[1]);
+  ImageType::Pointer referenceShrunk = Shrink(argv[1]);
+  otb::DistributedReducer::SetInstance(reducer);
+
+  std::ostringstream errors;
+  for (unsigned int b = 0; b < reference->GetMean().GetSize(); ++b)
+    {
+    if (distributed->GetMinimum()[b] != reference->GetMinimum()[b]
+        || distributed->GetMaximum()[b] != reference->GetMaximum()[b]
+        || !IsClose(distributed->GetMean()[b], reference->GetMean()[b])
+        || !IsClose(distributed->GetCovariance()(b, b), reference->GetCovariance()(b, b)))
+      {
+      errors << "Band " << b << " differs: mean " << distributed->GetMean()[b]
+             << " instead of " << reference->GetMean()[b] << std::endl;
+      }
+    }
+  if (distributed->GetNbRelevantPixels() != reference->GetNbRelevantPixels())
+    {
+    errors << "Wrong number of relevant pixels" << std::endl;
+    }
+
+  const size_t shrunkSize = referenceShrunk->GetLargestPossibleRegion().GetNumberOfPixels()
+    * referenceShrunk->GetNumberOfComponentsPerPixel();
+  if (distributedShrunk->GetLargestPossibleRegion() != referenceShrunk->GetLargestPossibleRegion())
+    {
+    errors << "Wrong shrunk image region" << std::endl;
+    }
+  else
+    {
+    for (size_t i = 0; i < shrunkSize; ++i)
+      {
+      if (distributedShrunk->GetBufferPointer()[i] != referenceShrunk->GetBufferPointer()[i])
+        {
+        errors << "Shrunk images differ at component " << i << std::endl;
+        break;
+        }
+      }
+    }
+
+  if (!errors.str().empty())
+    {
+    std::cerr << "Process " << config->GetMyRank() << ": " << errors.str();
+    return EXIT_FAILURE;
+    }
+
+  config->logInfo("Distributed statistics match the single process ones");
+  return EXIT_SUCCESS;
+}
@@ -36,6 +36,7 @@
 #include "otbWrapperComplexOutputImageParameter.h"
 #include "otbWrapperDocExampleStructure.h"
 #include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "otbPipelineProfiler.h"
 #include "OTBApplicationEngineExport.h"
 
 namespace otb
@@ -154,6 +155,13 @@ public:
    */
   int ExecuteAndWriteOutput();
 
+  /** Write the outputs of an executed application which have an
+   * associated filename, except the excluded ones, then let the
+   * application clean up (see AfterExecuteAndWriteOutputs()).
+   * ExecuteAndWriteOutput() calls this method after Execute().
+   */
+  void WriteOutputs(const std::vector<std::string>& excludedKeys = std::vector<std::string>());
+
   /* Get the internal application parameters
    *
    * WARNING: this method may disappear from the API */
@@ -195,6 +203,11 @@ public:
    */
   bool HasAutomaticValue(std::string paramKey) const;
 
+  /* Return true if the specified input image is read in several
+   * passes by the application
+   */
+  bool IsMultiPassInput(std::string paramKey) const;
+
   /* Returns true if the parameter has an associated value provided externally
    *  (not automatically computed by the application) */
   bool HasUserValue(std::string paramKey) const;
@@ -715,6 +728,26 @@ public:
 
   itk::ProcessObject* GetProgressSource() const;
 
+  /** Set the profiler recording the filters of the application. Each
+   * process registered with AddProcess() (writers and persistent
+   * filters) is attached to it, along with its upstream pipeline.
+   * No profiling is done by default. */
+  void SetProfiler(PipelineProfiler * profiler);
+
+  PipelineProfiler* GetProfiler() const;
+
+  /** Set/Get the number of pipelines computing the divisions of each
+   * output image at the same time. The other pipelines are made by
+   * executing copies of the application with the same parameters, and
+   * given to the writer as concurrent inputs (see
+   * ImageFileWriter::AddConcurrentInput()). This only suits the
+   * applications reading their inputs from files, whose pipelines hold
+   * no persistent filter. 1 (the default) computes one division at a
+   * time. */
+  void SetNumberOfConcurrentPipelines(unsigned int nbPipelines);
+
+  unsigned int GetNumberOfConcurrentPipelines() const;
+
   std::string GetProgressDescription() const;
 
   /** Doc element accessors. */
@@ -930,6 +963,14 @@ protected:
   /** Declare a parameter as NOT having an automatic value */
   void AutomaticValueOff(std::string paramKey);
 
+  /** Declare an input image as read in several passes, for instance
+   * by a persistent filter updated in DoExecute() before the outputs
+   * are streamed */
+  void MultiPassInputOn(std::string paramKey);
+
+  /** Declare an input image as streamed once (default state) */
+  void MultiPassInputOff(std::string paramKey);
+
   /* Set an output image value
    *
    * Can be called for types :
@@ -979,6 +1020,23 @@ private:
    * implementation does nothing */
   virtual void AfterExecuteAndWriteOutputs();
 
+  /* Write the enabled output images sharing the same largest possible
+   * region with a single MultiImageFileWriter, so that their pipeline
+   * is streamed once for all of them. Return the keys of the
+   * parameters written this way. */
+  std::vector<std::string> WriteOutputImagesTogether(const std::vector<std::string>& paramList,
+                                                     bool useRAM, unsigned int ram);
+
+  /* Execute NumberOfConcurrentPipelines - 1 copies of the application,
+   * with the parameter values of the application. No copy is kept if
+   * one of them fails. */
+  void ExecuteConcurrentApplications();
+
+  /* Hash the XML serialization of the parameter values, except the
+   * available RAM which only changes the streaming layout. The result is
+   * given to the output image writers as their pipeline signature. */
+  std::string ComputeParametersSignature();
+
   Application(const Application &); //purposely not implemented
   void operator =(const Application&); //purposely not implemented
 
@@ -990,6 +1048,12 @@ private:
   itk::ProcessObject::Pointer       m_ProgressSource;
   std::string                       m_ProgressSourceDescription;
 
+  PipelineProfiler::Pointer         m_Profiler;
+
+  unsigned int                      m_NumberOfConcurrentPipelines;
+  /** Copies of the application computing the output images along with it */
+  std::vector<Pointer>              m_ConcurrentApplications;
+
   /** Long name of the application (that can be displayed...) */
   std::string m_DocName;
   /** Long and precise application description . */
@@ -77,6 +77,22 @@ public:
   /** Clean registry by releasing unused modules */
   static void CleanRegistry();
 
+  /** Name of the index file listing the applications of a directory */
+  static std::string GetApplicationIndexFileName();
+
+  /** Write the index of the applications found in a directory: the
+   *  name, module and parameter keys of each application. This index
+   *  lets GetAvailableApplications() list the applications without
+   *  loading their modules. The entries of a previous index whose
+   *  module is unchanged are kept, so only the new or rebuilt modules
+   *  are loaded. Return false if the index can not be written. */
+  static bool WriteApplicationIndex(const std::string& directory);
+
+  /** Return the parameter keys of an application, as recorded in the
+   *  index of its directory. The list is empty if the application is
+   *  not indexed, or if its module changed since it was indexed. */
+  static std::vector<std::string> GetIndexedParametersKeys(const std::string& applicationName);
+
 protected:
   ApplicationRegistry();
   ~ApplicationRegistry() ITK_OVERRIDE;
@@ -42,6 +42,23 @@ namespace Wrapper
  * (if such application exists, if not it will refer to a parameter of this
  * composite application).
  *
+ * Internal applications can also be chained lazily : ConnectImage()
+ * records that an output image feeds the input image of another
+ * application, and ExecuteChain() executes an application after the
+ * ones it depends on, making the connections on the way. An input the
+ * application streams once is connected in memory, so that the chain
+ * is computed as a single streamed pipeline. An input declared as read
+ * in several passes (see Application::MultiPassInputOn()) gets a
+ * persistent pass instead : the upstream output is written once to a
+ * temporary file, which is read back by each pass rather than
+ * computing the upstream pipeline again.
+ *
+ * The "ram" budget of the composite application is shared by the
+ * chain : the applications connected in memory run in the same
+ * pipeline, and split the budget between their own "ram" parameters.
+ * The persistent passes, which run one at a time, use the whole
+ * budget.
+ *
  * \ingroup OTBApplicationEngine
  */
 class OTBApplicationEngine_EXPORT CompositeApplication: public Application
@@ -67,6 +84,12 @@ public:
 
   typedef std::map<std::string, InternalApplication> InternalAppContainer;
 
+  /** Set/Get the directory of the temporary files written by the
+   * persistent passes (default: the temporary directory of the system,
+   * given by TMPDIR, TMP or TEMP) */
+  itkSetStringMacro(TemporaryDirectory);
+  itkGetStringMacro(TemporaryDirectory);
+
 protected:
   /** Constructor */
   CompositeApplication();
@@ -88,9 +111,9 @@ protected:
   bool AddApplication(std::string appType, std::string key, std::string desc);
 
   /**
-   * Method to remove all internal applications. Application deriving from
-   * CompositeApplication should call this method at the beginning of their
-   * DoInit().
+   * Method to remove all internal applications and their image
+   * connections. Application deriving from CompositeApplication should
+   * call this method at the beginning of their DoInit().
    */
   void ClearApplications();
 
@@ -143,12 +166,73 @@ protected:
    */
   void UpdateInternalParameters(std::string key);
 
+  /**
+   * Connect the output image outputKey of an internal application to the
+   * input image inputKey of another one (for instance "app2.in" and
+   * "app1.out"). The connection is made by ExecuteChain().
+   */
+  bool ConnectImage(std::string inputKey, std::string outputKey);
+
+  /**
+   * Execute an internal application, after the applications it is
+   * connected to with ConnectImage(). See ExecuteChain(const std::vector<std::string> &).
+   */
+  void ExecuteChain(std::string key);
+
+  /**
+   * Execute internal applications, after the applications they are
+   * connected to with ConnectImage(). Each application of the chain is
+   * executed once, even when several applications depend on it. The
+   * temporary files of the previous chain are removed first.
+   */
+  void ExecuteChain(const std::vector<std::string> & keys);
+
+  /**
+   * Remove the temporary files written by the persistent passes
+   */
+  void ClearTemporaryFiles();
+
+  /**
+   * Remove the temporary files once the outputs are written. Derived
+   * applications overriding this method should call it.
+   */
+  void AfterExecuteAndWriteOutputs() ITK_OVERRIDE;
+
 private:
   CompositeApplication(const CompositeApplication &); //purposely not implemented
   void operator =(const CompositeApplication&); //purposely not implemented
 
+  /** Output image of an internal application feeding the input image
+   * of another one */
+  struct ImageConnection
+    {
+    std::string InputApp;
+    std::string InputKey;
+    std::string OutputApp;
+    std::string OutputKey;
+    };
+
+  typedef std::vector<ImageConnection> ImageConnectionContainer;
+
+  /** Append the applications key depends on, then key, to chain */
+  void SortChain(const std::string & key,
+                 std::map<std::string, int> & states,
+                 std::vector<std::string> & chain);
+
+  /** Write an output image of an internal application to a temporary
+   * file, and return the file name */
+  std::string WritePersistentPass(const std::string & appKey,
+                                  const std::string & outputKey,
+                                  unsigned int ram);
+
   InternalAppContainer m_AppContainer;
 
+  ImageConnectionContainer m_ImageConnections;
+
+  std::vector<std::string> m_TemporaryFiles;
+
+  std::string m_TemporaryDirectory;
+
   AddProcessCommandType::Pointer    m_AddProcessCommand;
 };
 
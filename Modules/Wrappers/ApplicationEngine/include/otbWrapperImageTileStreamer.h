@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbWrapperImageTileStreamer_h
+#define otbWrapperImageTileStreamer_h
+
+#include "itkObject.h"
+#include "itkImageBase.h"
+#include "otbWrapperTypes.h"
+#include "otbStreamingManager.h"
+#include "OTBApplicationEngineExport.h"
+
+namespace otb
+{
+namespace Wrapper
+{
+
+/** \class ImageTileStreamer
+ *  \brief Generate an image tile by tile, to process it in memory
+ *  without computing it at once.
+ *
+ * The image, typically the output of an application, is split by a
+ * streaming manager as ImageFileWriter does: by default the tiles are
+ * sized from the available RAM and from the memory print of the
+ * pipeline, or they are squares of a given dimension.
+ *
+ * After GenerateTile(), the buffer of the image holds the tile. Its
+ * buffered region may be larger than the tile, and it is reused by the
+ * next tile, so the buffer must be copied to be kept.
+ *
+ * This class is used by the Python bindings to iterate over the tiles
+ * of an output image as numpy arrays.
+ *
+ * \ingroup OTBApplicationEngine
+ */
+class OTBApplicationEngine_EXPORT ImageTileStreamer : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageTileStreamer             Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Defining ::New() static method */
+  itkNewMacro(Self);
+
+  /** RTTI support */
+  itkTypeMacro(ImageTileStreamer, itk::Object);
+
+  typedef itk::ImageBase<2>                ImageBaseType;
+  typedef ImageBaseType::RegionType        RegionType;
+  typedef StreamingManager<UInt8ImageType> StreamingManagerType;
+
+  /** Set the image to split */
+  void SetImage(ImageBaseType* image);
+  ImageBaseType* GetImage();
+
+  /** Set the RAM available to compute a tile, in MB (0 to use the
+   *  default of the configuration) */
+  itkSetMacro(AvailableRAM, unsigned int);
+  itkGetConstMacro(AvailableRAM, unsigned int);
+
+  /** Set the dimension of square tiles. When 0 (the default), the
+   *  tiles are sized from the available RAM. */
+  itkSetMacro(TileDimension, unsigned int);
+  itkGetConstMacro(TileDimension, unsigned int);
+
+  /** Update the information of the image and split its largest
+   *  region. Return the number of tiles. */
+  unsigned int PrepareTiles();
+
+  /** Get the number of tiles computed by PrepareTiles() */
+  unsigned int GetNumberOfTiles() const;
+
+  /** Get the region of a tile */
+  RegionType GetTileRegion(unsigned int tile) const;
+
+  /** Update the pipeline of the image on a tile */
+  void GenerateTile(unsigned int tile);
+
+  /** Get the type of the components of the image pixels. Throw an
+   *  exception if the image is not an Image or a VectorImage of one of
+   *  these types. */
+  ImagePixelType GetPixelType() const;
+
+  /** Get the buffer of the image: the components of the pixels of its
+   *  buffered region, pixel interleaved */
+  void* GetBufferPointer();
+
+protected:
+  ImageTileStreamer();
+  ~ImageTileStreamer() ITK_OVERRIDE;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  ImageTileStreamer(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+
+  ImageBaseType::Pointer        m_Image;
+  StreamingManagerType::Pointer m_StreamingManager;
+  unsigned int                  m_AvailableRAM;
+  unsigned int                  m_TileDimension;
+};
+
+} // end namespace Wrapper
+} //end namespace otb
+
+#endif
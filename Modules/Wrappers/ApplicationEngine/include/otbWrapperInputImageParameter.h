@@ -85,6 +85,13 @@ public:
   template <class TImageType>
     TImageType* GetImage();
 
+  /** Get the image as it was set, or as read by the last GetImage()
+   * call (null if the file has not been read yet). */
+  ImageBaseType* GetImageBase() const
+  {
+    return m_Image.GetPointer();
+  }
+
   /** Set a FloatVectorImageType image.*/
   void SetImage(FloatVectorImageType* image);
 
@@ -112,6 +119,14 @@ public:
 
   void ClearValue() ITK_OVERRIDE;
 
+  /** Set/Get the MultiPass flag : the application reads this input
+   * several times (statistics, estimation passes...) before streaming
+   * its outputs, so that an expensive upstream pipeline is better
+   * computed once and written to a file (see CompositeApplication). */
+  itkSetMacro(MultiPass, bool);
+  itkGetConstMacro(MultiPass, bool);
+  itkBooleanMacro(MultiPass);
+
 
 protected:
   /** Constructor */
@@ -158,6 +173,9 @@ private:
   /** flag : are we using a filename or an image pointer as an input */
   bool m_UseFilename;
 
+  /** flag : is the input read in several passes */
+  bool m_MultiPass;
+
 }; // End class InputImage Parameter
 
 
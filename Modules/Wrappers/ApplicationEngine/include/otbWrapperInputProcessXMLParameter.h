@@ -76,6 +76,10 @@ public:
 
   int Read(Application::Pointer application);
 
+  /** Set the parameters of application from an application node, as
+   * written by OutputProcessXMLParameter::ParseApplication() */
+  int ReadApplication(Application::Pointer application, TiXmlElement* n_AppNode);
+
   void otbAppLogInfo(Application::Pointer app, std::string info);
 
 /* copied from Utilities/tinyXMLlib/tinyxml.cpp. Must have a FIX inside tinyxml.cpp */
@@ -25,6 +25,7 @@
 #include "itkImageBase.h"
 #include "otbWrapperParameter.h"
 #include "otbImageFileWriter.h"
+#include "otbMultiImageFileWriter.h"
 
 namespace otb
 {
@@ -77,6 +78,11 @@ public:
   itkSetMacro(RAMValue, unsigned int);
   itkGetMacro(RAMValue, unsigned int);
 
+  /** Set/Get the signature of the pipeline producing the image, added to
+   *  the journal of resumable writes */
+  itkSetStringMacro(PipelineSignature);
+  itkGetStringMacro(PipelineSignature);
+
   /** Implement the reset method (replace pixel type by default type) */
   void Reset() ITK_OVERRIDE
   {
@@ -103,6 +109,20 @@ public:
 
   void Write();
 
+  /** Add the image, cast to the pixel type, to the images written by
+   * writer instead of writing it. The writer must be updated while
+   * this parameter is alive. */
+  void AddToMultiWriter(MultiImageFileWriter* writer);
+
+  /** Add an image computed by an independent copy of the pipeline of
+   * the image, given to the writer as a concurrent input (see
+   * ImageFileWriter::AddConcurrentInput()). The copies are released
+   * once written. */
+  void AddConcurrentImage(ImageBaseType* image);
+
+  /** Remove the concurrent images */
+  void ClearConcurrentImages();
+
   itk::ProcessObject* GetWriter();
 
   void InitializeWriters();
@@ -129,6 +149,7 @@ protected:
 
   //FloatVectorImageType::Pointer m_Image;
   ImageBaseType::Pointer m_Image;
+  std::vector<ImageBaseType::Pointer> m_ConcurrentImages;
   std::string            m_FileName;
   ImagePixelType         m_PixelType;
   ImagePixelType         m_DefaultPixelType;
@@ -177,6 +198,14 @@ private:
 
   unsigned int                  m_RAMValue;
 
+  std::string                   m_PipelineSignature;
+
+  /** Writer receiving the image during AddToMultiWriter() */
+  MultiImageFileWriter*         m_MultiWriter;
+
+  /** Filter casting the image added to a MultiImageFileWriter */
+  itk::ProcessObject::Pointer   m_Caster;
+
 }; // End class OutputImage Parameter
 
 } // End namespace Wrapper
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbWrapperParameterSweep_h
+#define otbWrapperParameterSweep_h
+
+#include "otbWrapperApplication.h"
+#include "itkCommand.h"
+
+namespace otb
+{
+namespace Wrapper
+{
+
+/** \class ParameterSweep
+ *  \brief Execute an application with several parameter sets, sharing
+ *  the decoding of their inputs.
+ *
+ * Each parameter set given to AddParameterSet() defines a variant: a
+ * new instance of the application, with the common parameters set
+ * first, then the ones of the set. Values are given as strings, as on
+ * the command line: several values for list parameters, and an
+ * optional pixel type after the file name of an output image.
+ *
+ * The input images given by the same file names to all the variants
+ * are read once: the readers of the first variant feed the other
+ * ones, so that the variants are sibling pipelines. The images set
+ * with SetCommonInputImage(), for instance the output of another
+ * application, are shared the same way.
+ *
+ * ExecuteAndWriteOutput() writes the output images of all the variants
+ * lying on the same grid with a single MultiImageFileWriter: the
+ * shared part of the pipelines is then computed once per streaming
+ * division. The other outputs are written by each variant.
+ *
+ * \ingroup OTBApplicationEngine
+ */
+class OTBApplicationEngine_EXPORT ParameterSweep : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef ParameterSweep                Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** RTTI support */
+  itkTypeMacro(ParameterSweep, itk::Object);
+
+  /** Values of parameters, by key */
+  typedef std::map<std::string, std::vector<std::string> > ParameterSetType;
+
+  typedef InputImageParameter::ImageBaseType ImageBaseType;
+
+  /** Set/Get the name of the application to execute */
+  itkSetStringMacro(ApplicationName);
+  itkGetStringMacro(ApplicationName);
+
+  /** Set a parameter common to all the variants */
+  void SetCommonParameter(const std::string & key, const std::string & value);
+
+  /** Set a list parameter common to all the variants */
+  void SetCommonParameter(const std::string & key, const std::vector<std::string> & values);
+
+  /** Set an input image common to all the variants */
+  void SetCommonInputImage(const std::string & key, ImageBaseType * image);
+
+  /** Add a variant of the application */
+  void AddParameterSet(const ParameterSetType & parameters);
+
+  /** Remove the variants and the common parameters */
+  void ClearParameterSets();
+
+  /** Get the number of variants */
+  unsigned int GetNumberOfParameterSets() const
+  {
+    return static_cast<unsigned int>(m_ParameterSets.size());
+  }
+
+  /** Get the application of a variant, once executed */
+  Application* GetVariant(unsigned int i);
+
+  /** Create and execute the variants. Their output images can then be
+   * used in memory. */
+  void Execute();
+
+  /** Execute the variants, then write their outputs */
+  void ExecuteAndWriteOutput();
+
+protected:
+  ParameterSweep();
+  ~ParameterSweep() ITK_OVERRIDE;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  ParameterSweep(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  typedef itk::MemberCommand<Self> AddProcessCommandType;
+
+  /** Forward the processes to watch of the variants */
+  void LinkWatchers(itk::Object * caller, const itk::EventObject & event);
+
+  /** Keys of the input images given by the same file names to all the
+   * variants */
+  std::vector<std::string> GetSharedInputKeys();
+
+  /** Feed the shared inputs of a variant from the first one */
+  void ShareInputImages(Application * variant, const std::vector<std::string> & keys);
+
+  std::string                        m_ApplicationName;
+  ParameterSetType                   m_CommonParameters;
+  std::map<std::string, ImageBaseType::Pointer> m_CommonInputImages;
+  std::vector<ParameterSetType>      m_ParameterSets;
+  std::vector<Application::Pointer>  m_Variants;
+  AddProcessCommandType::Pointer     m_AddProcessCommand;
+};
+
+} // end namespace Wrapper
+} // end namespace otb
+
+#endif
@@ -34,6 +34,7 @@ ENABLE_SHARED
     OTBImageBase
     OTBCommon
     OTBObjectList
+    OTBStreaming
     OTBBoostAdapters
     OTBOSSIMAdapters
     OTBITK
@@ -37,12 +37,19 @@
 #include "otbWrapperRAMParameter.h"
 #include "otbWrapperProxyParameter.h"
 #include "otbWrapperParameterKey.h"
+#include "otbWrapperApplicationRegistry.h"
 
 
 #include "otbWrapperAddProcessToWatchEvent.h"
 
+#ifdef OTB_USE_MPI
+#include "otbMPIConfig.h"
+#endif
+
 #include "otbMacro.h"
 #include "otbWrapperTypes.h"
+#include "otbMultiImageFileWriter.h"
+#include <algorithm>
 #include <exception>
 #include "itkMacro.h"
 
@@ -56,6 +63,7 @@ Application::Application()
     m_Description(""),
     m_Logger(otb::Logger::New()),
     m_ProgressSourceDescription(""),
+    m_NumberOfConcurrentPipelines(1),
     m_DocName(""),
     m_DocLongDescription(""),
     m_DocAuthors(""),
@@ -404,111 +412,310 @@ int Application::ExecuteAndWriteOutput()
 
   if (status == 0)
     {
-      std::vector<std::string> paramList = GetParametersKeys(true);
-      // First Get the value of the available memory to use with the
-      // writer if a RAMParameter is set
-      bool useRAM = false;
-      unsigned int ram = 0;
-      for (std::vector<std::string>::const_iterator it = paramList.begin();
-           it != paramList.end();
-           ++it)
-        {
-        std::string key = *it;
+    this->WriteOutputs();
+    }
+  else
+    {
+    this->AfterExecuteAndWriteOutputs();
+    }
 
-        if (GetParameterType(key) == ParameterType_RAM
-            && IsParameterEnabled(key))
-          {
-          Parameter* param = GetParameterByKey(key);
-          RAMParameter* ramParam = dynamic_cast<RAMParameter*>(param);
-          if(ramParam!=ITK_NULLPTR)
-            {
-            ram = ramParam->GetValue();
-            useRAM = true;
-            }
-          }
+  m_Chrono.Stop();
+  return status;
+}
+
+void Application::WriteOutputs(const std::vector<std::string>& excludedKeys)
+{
+  std::vector<std::string> paramList = GetParametersKeys(true);
+  // First Get the value of the available memory to use with the
+  // writer if a RAMParameter is set
+  bool useRAM = false;
+  unsigned int ram = 0;
+  for (std::vector<std::string>::const_iterator it = paramList.begin();
+       it != paramList.end();
+       ++it)
+    {
+    std::string key = *it;
+
+    if (GetParameterType(key) == ParameterType_RAM
+        && IsParameterEnabled(key))
+      {
+      Parameter* param = GetParameterByKey(key);
+      RAMParameter* ramParam = dynamic_cast<RAMParameter*>(param);
+      if(ramParam!=ITK_NULLPTR)
+        {
+        ram = ramParam->GetValue();
+        useRAM = true;
         }
+      }
+    }
+
+  // The excluded outputs are written by the caller
+  for (std::vector<std::string>::const_iterator it = excludedKeys.begin();
+       it != excludedKeys.end();
+       ++it)
+    {
+    paramList.erase(std::remove(paramList.begin(), paramList.end(), *it), paramList.end());
+    }
+
+  const std::vector<std::string> writtenKeys = this->WriteOutputImagesTogether(paramList, useRAM, ram);
+  const std::string parametersSignature = this->ComputeParametersSignature();
 
-      for (std::vector<std::string>::const_iterator it = paramList.begin();
-           it != paramList.end();
-           ++it)
+  // Copies of the pipelines of the output images written one at a time
+  if (m_NumberOfConcurrentPipelines > 1)
+    {
+    this->ExecuteConcurrentApplications();
+    }
+
+  for (std::vector<std::string>::const_iterator it = paramList.begin();
+       it != paramList.end();
+       ++it)
+    {
+    std::string key = *it;
+    if (std::find(writtenKeys.begin(), writtenKeys.end(), key) != writtenKeys.end())
+      {
+      continue;
+      }
+    if (GetParameterType(key) == ParameterType_OutputImage
+        && IsParameterEnabled(key) && HasValue(key) )
+      {
+      Parameter* param = GetParameterByKey(key);
+      OutputImageParameter* outputParam = dynamic_cast<OutputImageParameter*>(param);
+
+      if(outputParam!=ITK_NULLPTR)
         {
-        std::string key = *it;
-        if (GetParameterType(key) == ParameterType_OutputImage
-            && IsParameterEnabled(key) && HasValue(key) )
+        outputParam->InitializeWriters();
+        std::string checkReturn = outputParam->CheckFileName(true);
+        if (!checkReturn.empty())
           {
-          Parameter* param = GetParameterByKey(key);
-          OutputImageParameter* outputParam = dynamic_cast<OutputImageParameter*>(param);
-
-          if(outputParam!=ITK_NULLPTR)
-            {
-            outputParam->InitializeWriters();
-            std::string checkReturn = outputParam->CheckFileName(true);
-            if (!checkReturn.empty())
-              {
-              otbAppLogWARNING("Check filename: "<<checkReturn);
-              }
-            if (useRAM)
-              {
-              outputParam->SetRAMValue(ram);
-              }
-            std::ostringstream progressId;
-            progressId << "Writing " << outputParam->GetFileName() << "...";
-            AddProcess(outputParam->GetWriter(), progressId.str());
-            outputParam->Write();
-            }
+          otbAppLogWARNING("Check filename: "<<checkReturn);
           }
-        else if (GetParameterType(key) == ParameterType_OutputVectorData
-                 && IsParameterEnabled(key) && HasValue(key) )
+        if (useRAM)
           {
-          Parameter* param = GetParameterByKey(key);
-          OutputVectorDataParameter* outputParam = dynamic_cast<OutputVectorDataParameter*>(param);
-          if(outputParam!=ITK_NULLPTR)
-            {
-            outputParam->InitializeWriters();
-            std::ostringstream progressId;
-            progressId << "Writing " << outputParam->GetFileName() << "...";
-            AddProcess(outputParam->GetWriter(), progressId.str());
-            outputParam->Write();
-            }
+          outputParam->SetRAMValue(ram);
           }
-        else if (GetParameterType(key) == ParameterType_ComplexOutputImage
-                 && IsParameterEnabled(key) && HasValue(key) )
+        outputParam->SetPipelineSignature(parametersSignature);
+        outputParam->ClearConcurrentImages();
+        for (unsigned int i = 0; i < m_ConcurrentApplications.size(); ++i)
           {
-          Parameter* param = GetParameterByKey(key);
-          ComplexOutputImageParameter* outputParam = dynamic_cast<ComplexOutputImageParameter*>(param);
-          
-          if(outputParam!=ITK_NULLPTR)
+          OutputImageParameter* concurrentParam =
+            dynamic_cast<OutputImageParameter*>(m_ConcurrentApplications[i]->GetParameterByKey(key));
+          if (concurrentParam != ITK_NULLPTR && concurrentParam->GetValue() != ITK_NULLPTR)
             {
-            outputParam->InitializeWriters();
-            if (useRAM)
-              {
-              outputParam->SetRAMValue(ram);
-              }
-            std::ostringstream progressId;
-            progressId << "Writing " << outputParam->GetFileName() << "...";
-            AddProcess(outputParam->GetWriter(), progressId.str());
-            outputParam->Write();
+            outputParam->AddConcurrentImage(concurrentParam->GetValue());
             }
           }
-
-        //xml writer parameter
-        else if (m_HaveOutXML && GetParameterType(key) == ParameterType_OutputProcessXML
-                 && IsParameterEnabled(key) && HasValue(key) )
+        std::ostringstream progressId;
+        progressId << "Writing " << outputParam->GetFileName() << "...";
+        AddProcess(outputParam->GetWriter(), progressId.str());
+        outputParam->Write();
+        outputParam->ClearConcurrentImages();
+        }
+      }
+    else if (GetParameterType(key) == ParameterType_OutputVectorData
+             && IsParameterEnabled(key) && HasValue(key) )
+      {
+      Parameter* param = GetParameterByKey(key);
+      OutputVectorDataParameter* outputParam = dynamic_cast<OutputVectorDataParameter*>(param);
+      if(outputParam!=ITK_NULLPTR)
+        {
+        outputParam->InitializeWriters();
+        std::ostringstream progressId;
+        progressId << "Writing " << outputParam->GetFileName() << "...";
+        AddProcess(outputParam->GetWriter(), progressId.str());
+        outputParam->Write();
+        }
+      }
+    else if (GetParameterType(key) == ParameterType_ComplexOutputImage
+             && IsParameterEnabled(key) && HasValue(key) )
+      {
+      Parameter* param = GetParameterByKey(key);
+      ComplexOutputImageParameter* outputParam = dynamic_cast<ComplexOutputImageParameter*>(param);
+      
+      if(outputParam!=ITK_NULLPTR)
+        {
+        outputParam->InitializeWriters();
+        if (useRAM)
           {
-          Parameter* param = GetParameterByKey(key);
-          OutputProcessXMLParameter* outXMLParam = dynamic_cast<OutputProcessXMLParameter*>(param);
-          if(outXMLParam!=ITK_NULLPTR)
-            {
-            outXMLParam->Write(this);
-            }
+          outputParam->SetRAMValue(ram);
           }
+        std::ostringstream progressId;
+        progressId << "Writing " << outputParam->GetFileName() << "...";
+        AddProcess(outputParam->GetWriter(), progressId.str());
+        outputParam->Write();
         }
+      }
+
+    //xml writer parameter
+    else if (m_HaveOutXML && GetParameterType(key) == ParameterType_OutputProcessXML
+             && IsParameterEnabled(key) && HasValue(key) )
+      {
+      Parameter* param = GetParameterByKey(key);
+      OutputProcessXMLParameter* outXMLParam = dynamic_cast<OutputProcessXMLParameter*>(param);
+      if(outXMLParam!=ITK_NULLPTR)
+        {
+        outXMLParam->Write(this);
+        }
+      }
     }
 
+  m_ConcurrentApplications.clear();
+
   this->AfterExecuteAndWriteOutputs();
+}
 
-  m_Chrono.Stop();
-  return status;
+void
+Application::ExecuteConcurrentApplications()
+{
+  m_ConcurrentApplications.clear();
+
+  OutputProcessXMLParameter::Pointer outXMLParam = OutputProcessXMLParameter::New();
+  InputProcessXMLParameter::Pointer inXMLParam = InputProcessXMLParameter::New();
+  TiXmlElement* n_App = outXMLParam->ParseApplication(this);
+  try
+    {
+    for (unsigned int i = 1; i < m_NumberOfConcurrentPipelines; ++i)
+      {
+      Application::Pointer copy = ApplicationRegistry::CreateApplication(this->GetName());
+      if (copy.IsNull())
+        {
+        itkExceptionMacro(<< "Can not create a copy of the application " << this->GetName());
+        }
+      // The copies only log their warnings and errors
+      copy->GetLogger()->SetPriorityLevel(itk::LoggerBase::WARNING);
+      inXMLParam->ReadApplication(copy, n_App);
+      copy->Execute();
+      m_ConcurrentApplications.push_back(copy);
+      }
+    }
+  catch (std::exception& err)
+    {
+    otbAppLogWARNING(<< "The divisions are computed by a single pipeline: " << err.what());
+    m_ConcurrentApplications.clear();
+    }
+  delete n_App;
+
+  if (!m_ConcurrentApplications.empty())
+    {
+    otbAppLogINFO(<< m_ConcurrentApplications.size() + 1 << " pipelines compute the divisions at the same time");
+    }
+}
+
+std::string
+Application::ComputeParametersSignature()
+{
+  OutputProcessXMLParameter::Pointer xmlParam = OutputProcessXMLParameter::New();
+  TiXmlElement* n_App = xmlParam->ParseApplication(this);
+
+  TiXmlElement* n_Parameter = n_App->FirstChildElement("parameter");
+  while (n_Parameter != ITK_NULLPTR)
+    {
+    TiXmlElement* n_Next = n_Parameter->NextSiblingElement("parameter");
+    TiXmlElement* n_Type = n_Parameter->FirstChildElement("type");
+    if (n_Type != ITK_NULLPTR && n_Type->GetText() != ITK_NULLPTR
+        && std::string(n_Type->GetText()) == "RAM")
+      {
+      n_App->RemoveChild(n_Parameter);
+      }
+    n_Parameter = n_Next;
+    }
+
+  TiXmlPrinter printer;
+  printer.SetStreamPrinting();
+  n_App->Accept(&printer);
+  delete n_App;
+
+  // FNV-1a hash of the serialized parameters
+  const std::string serialized = printer.CStr();
+  unsigned long long hash = 14695981039346656037ULL;
+  for (std::string::const_iterator it = serialized.begin(); it != serialized.end(); ++it)
+    {
+    hash ^= static_cast<unsigned char>(*it);
+    hash *= 1099511628211ULL;
+    }
+
+  std::ostringstream oss;
+  oss << GetName() << ":" << std::hex << hash;
+  return oss.str();
+}
+
+std::vector<std::string>
+Application::WriteOutputImagesTogether(const std::vector<std::string>& paramList,
+                                       bool useRAM, unsigned int ram)
+{
+  std::vector<std::string> keys;
+
+#ifdef OTB_USE_MPI
+  // Each output is written in parallel by all the processes
+  if (otb::MPIConfig::Instance()->GetNbProcs() > 1)
+    {
+    return keys;
+    }
+#endif
+
+  // Gather the output images on the grid of the first one
+  std::vector<OutputImageParameter*> outputParams;
+  OutputImageParameter::ImageBaseType::RegionType largestRegion;
+  for (std::vector<std::string>::const_iterator it = paramList.begin();
+       it != paramList.end();
+       ++it)
+    {
+    const std::string& key = *it;
+    if (GetParameterType(key) != ParameterType_OutputImage
+        || !IsParameterEnabled(key) || !HasValue(key))
+      {
+      continue;
+      }
+    OutputImageParameter* outputParam = dynamic_cast<OutputImageParameter*>(GetParameterByKey(key));
+    if (outputParam == ITK_NULLPTR || outputParam->GetValue() == ITK_NULLPTR
+        || !MultiImageFileWriter::IsSupportedFileName(outputParam->GetFileName()))
+      {
+      continue;
+      }
+    outputParam->GetValue()->UpdateOutputInformation();
+    if (outputParams.empty())
+      {
+      largestRegion = outputParam->GetValue()->GetLargestPossibleRegion();
+      }
+    else if (outputParam->GetValue()->GetLargestPossibleRegion() != largestRegion)
+      {
+      continue;
+      }
+    outputParams.push_back(outputParam);
+    keys.push_back(key);
+    }
+
+  // A single image is written by its own writer
+  if (outputParams.size() < 2)
+    {
+    keys.clear();
+    return keys;
+    }
+
+  MultiImageFileWriter::Pointer multiWriter = MultiImageFileWriter::New();
+  std::ostringstream progressId;
+  progressId << "Writing";
+  for (unsigned int i = 0; i < outputParams.size(); ++i)
+    {
+    OutputImageParameter* outputParam = outputParams[i];
+    outputParam->InitializeWriters();
+    std::string checkReturn = outputParam->CheckFileName(true);
+    if (!checkReturn.empty())
+      {
+      otbAppLogWARNING("Check filename: "<<checkReturn);
+      }
+    outputParam->AddToMultiWriter(multiWriter);
+    progressId << " " << outputParam->GetFileName();
+    }
+  progressId << "...";
+
+  if (useRAM)
+    {
+    multiWriter->SetAutomaticAdaptativeStreaming(ram);
+    }
+  AddProcess(multiWriter, progressId.str());
+  multiWriter->Update();
+
+  return keys;
 }
 
 /* Enable the use of an optional parameter. Returns the previous state */
@@ -564,6 +771,35 @@ void Application::AutomaticValueOff(std::string paramKey)
   GetParameterByKey(paramKey)->SetAutomaticValue(false);
 }
 
+/* Return true if the specified input image is read in several passes
+ * by the application
+ */
+bool Application::IsMultiPassInput(std::string paramKey) const
+{
+  const InputImageParameter* param = dynamic_cast<const InputImageParameter*>(GetParameterByKey(paramKey));
+  return param != ITK_NULLPTR && param->GetMultiPass();
+}
+
+void Application::MultiPassInputOn(std::string paramKey)
+{
+  InputImageParameter* param = dynamic_cast<InputImageParameter*>(GetParameterByKey(paramKey));
+  if (param == ITK_NULLPTR)
+    {
+    itkExceptionMacro(<<paramKey << " parameter can't be casted to InputImageParameter");
+    }
+  param->SetMultiPass(true);
+}
+
+void Application::MultiPassInputOff(std::string paramKey)
+{
+  InputImageParameter* param = dynamic_cast<InputImageParameter*>(GetParameterByKey(paramKey));
+  if (param == ITK_NULLPTR)
+    {
+    itkExceptionMacro(<<paramKey << " parameter can't be casted to InputImageParameter");
+    }
+  param->SetMultiPass(false);
+}
+
 /* Returns true if the parameter has an associated value provided externally
  *  (not automatically computed by the application) */
 bool Application::HasUserValue(std::string paramKey) const
@@ -1665,6 +1901,11 @@ Application::AddProcess(itk::ProcessObject* object, std::string description)
   m_ProgressSource = object;
   m_ProgressSourceDescription = description;
 
+  if (m_Profiler.IsNotNull())
+    {
+    m_Profiler->Attach(object);
+    }
+
   AddProcessToWatchEvent event;
   event.SetProcess(object);
   event.SetProcessDescription(description);
@@ -1676,6 +1917,26 @@ itk::ProcessObject* Application::GetProgressSource() const
   return m_ProgressSource;
 }
 
+void Application::SetProfiler(PipelineProfiler * profiler)
+{
+  m_Profiler = profiler;
+}
+
+PipelineProfiler* Application::GetProfiler() const
+{
+  return m_Profiler;
+}
+
+void Application::SetNumberOfConcurrentPipelines(unsigned int nbPipelines)
+{
+  m_NumberOfConcurrentPipelines = std::max(nbPipelines, 1U);
+}
+
+unsigned int Application::GetNumberOfConcurrentPipelines() const
+{
+  return m_NumberOfConcurrentPipelines;
+}
+
 std::string Application::GetProgressDescription() const
 {
   return m_ProgressSourceDescription;
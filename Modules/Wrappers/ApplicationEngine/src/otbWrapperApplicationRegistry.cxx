@@ -28,6 +28,10 @@
 #include "itkMutexLockHolder.h"
 
 #include <iterator>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <cstdio>
 
 namespace otb
 {
@@ -37,6 +41,78 @@ namespace Wrapper
 // Constant : environment variable for application path
 static const char OTB_APPLICATION_VAR[] = "OTB_APPLICATION_PATH";
 
+// Constant : name of the application index in an application directory
+static const char OTB_APPLICATION_INDEX[] = "otbapp_index.txt";
+
+/** Application recorded in an index : module file name and parameter keys */
+struct ApplicationIndexEntry
+{
+  std::string Library;
+  std::vector<std::string> Keys;
+};
+
+// Index entries sorted by application name
+typedef std::map<std::string, ApplicationIndexEntry> ApplicationIndexType;
+
+static std::string JoinApplicationPath(const std::string& directory, const std::string& filename)
+{
+#ifdef _WIN32
+  const char sep = '\\';
+#else
+  const char sep = '/';
+#endif
+  std::string fullpath = directory;
+  if (!fullpath.empty() && fullpath[fullpath.size() - 1] != sep)
+    {
+    fullpath.push_back(sep);
+    }
+  fullpath.append(filename);
+  return fullpath;
+}
+
+/** Read the index of an application directory. The entries whose
+ *  module was removed, or modified after the index was written, are
+ *  ignored : these modules have to be loaded again. */
+static void ReadApplicationIndex(const std::string& directory, ApplicationIndexType& index)
+{
+  index.clear();
+  const std::string indexPath = JoinApplicationPath(directory, OTB_APPLICATION_INDEX);
+  std::ifstream ifs(indexPath.c_str());
+  if (!ifs)
+    {
+    return;
+    }
+  const long int indexTime = itksys::SystemTools::ModifiedTime(indexPath);
+
+  std::string line;
+  while (std::getline(ifs, line))
+    {
+    if (line.empty() || line[0] == '#')
+      {
+      continue;
+      }
+    std::istringstream iss(line);
+    std::string name;
+    ApplicationIndexEntry entry;
+    if (!(iss >> name >> entry.Library))
+      {
+      continue;
+      }
+    const std::string libPath = JoinApplicationPath(directory, entry.Library);
+    if (!itksys::SystemTools::FileExists(libPath.c_str(), true) ||
+        itksys::SystemTools::ModifiedTime(libPath) > indexTime)
+      {
+      continue;
+      }
+    std::string key;
+    while (iss >> key)
+      {
+      entry.Keys.push_back(key);
+      }
+    index[name] = entry;
+    }
+}
+
 class ApplicationPrivateRegistry
 {
 public:
@@ -309,6 +385,14 @@ ApplicationRegistry::GetAvailableApplications(bool useFactory)
       {
       continue;
       }
+    // The modules recorded in an up to date index are not loaded
+    ApplicationIndexType index;
+    ReadApplicationIndex(pathList[k], index);
+    std::set<std::string> indexedLibraries;
+    for (ApplicationIndexType::const_iterator it = index.begin(); it != index.end(); ++it)
+      {
+      indexedLibraries.insert(it->second.Library);
+      }
     for (unsigned int i = 0; i < dir->GetNumberOfFiles(); i++)
       {
       const char *filename = dir->GetFile(i);
@@ -321,6 +405,11 @@ ApplicationRegistry::GetAvailableApplications(bool useFactory)
           prefixPos == 0)
         {
         std::string name = sfilename.substr(appPrefix.size(),extPos-appPrefix.size());
+        if (indexedLibraries.count(sfilename))
+          {
+          appSet.insert(name);
+          continue;
+          }
         std::string fullpath = pathList[k];
         if (!fullpath.empty() && fullpath[fullpath.size() - 1] != sep)
           {
@@ -368,6 +457,138 @@ ApplicationRegistry::CleanRegistry()
   m_ApplicationPrivateRegistryGlobal.ReleaseUnusedHandle();
 }
 
+std::string
+ApplicationRegistry::GetApplicationIndexFileName()
+{
+  return std::string(OTB_APPLICATION_INDEX);
+}
+
+bool
+ApplicationRegistry::WriteApplicationIndex(const std::string& directory)
+{
+  std::string appPrefix("otbapp_");
+  std::string appExtension = itksys::DynamicLoader::LibExtension();
+#ifdef __APPLE__
+  appExtension = ".dylib";
+#endif
+
+  itk::Directory::Pointer dir = itk::Directory::New();
+  if (!dir->Load(directory.c_str()))
+    {
+    return false;
+    }
+
+  ApplicationIndexType previousIndex;
+  ReadApplicationIndex(directory, previousIndex);
+
+  ApplicationIndexType index;
+  for (unsigned int i = 0; i < dir->GetNumberOfFiles(); i++)
+    {
+    std::string sfilename(dir->GetFile(i));
+    std::string::size_type extPos = sfilename.rfind(appExtension);
+    std::string::size_type prefixPos = sfilename.find(appPrefix);
+    if (extPos + appExtension.size() != sfilename.size() || prefixPos != 0)
+      {
+      continue;
+      }
+    std::string name = sfilename.substr(appPrefix.size(),extPos-appPrefix.size());
+
+    ApplicationIndexType::const_iterator previous = previousIndex.find(name);
+    if (previous != previousIndex.end() && previous->second.Library == sfilename)
+      {
+      index[name] = previous->second;
+      continue;
+      }
+
+    ApplicationPointer appli = LoadApplicationFromPath(JoinApplicationPath(directory, sfilename), name);
+    if (appli.IsNull())
+      {
+      otbMsgDevMacro( << "Module " << sfilename << " does not provide application " << name << ", not indexed" << std::endl );
+      continue;
+      }
+    ApplicationIndexEntry& entry = index[name];
+    entry.Library = sfilename;
+    entry.Keys = appli->GetParametersKeys();
+    }
+  CleanRegistry();
+
+  // Write a temporary file first, so that a reader never sees a partial index
+  const std::string indexPath = JoinApplicationPath(directory, OTB_APPLICATION_INDEX);
+  const std::string tmpPath = indexPath + ".tmp";
+  std::ofstream ofs(tmpPath.c_str());
+  if (!ofs)
+    {
+    return false;
+    }
+  ofs << "# OTB application index : name module parameter_keys..." << std::endl;
+  for (ApplicationIndexType::const_iterator it = index.begin(); it != index.end(); ++it)
+    {
+    ofs << it->first << " " << it->second.Library;
+    for (std::vector<std::string>::const_iterator key = it->second.Keys.begin();
+         key != it->second.Keys.end(); ++key)
+      {
+      ofs << " " << *key;
+      }
+    ofs << std::endl;
+    }
+  ofs.close();
+  if (!ofs)
+    {
+    itksys::SystemTools::RemoveFile(tmpPath.c_str());
+    return false;
+    }
+#ifdef _WIN32
+  // rename() does not replace an existing file on Windows
+  itksys::SystemTools::RemoveFile(indexPath.c_str());
+#endif
+  if (std::rename(tmpPath.c_str(), indexPath.c_str()) != 0)
+    {
+    itksys::SystemTools::RemoveFile(tmpPath.c_str());
+    return false;
+    }
+  return true;
+}
+
+std::vector<std::string>
+ApplicationRegistry::GetIndexedParametersKeys(const std::string& name)
+{
+#if defined(WIN32)
+  const char pathSeparator = ';';
+#else
+  const char pathSeparator = ':';
+#endif
+
+  std::string appExtension = itksys::DynamicLoader::LibExtension();
+#ifdef __APPLE__
+  appExtension = ".dylib";
+#endif
+  std::string appLibName = "otbapp_" + name + appExtension;
+
+  std::string otbAppPath = GetApplicationPath();
+  std::vector<itksys::String> pathList;
+  if (!otbAppPath.empty())
+    {
+    pathList = itksys::SystemTools::SplitString(otbAppPath.c_str(),pathSeparator,false);
+    }
+  // Same search order as CreateApplicationFaster()
+  for (unsigned int k=0 ; k<pathList.size() ; ++k)
+    {
+    ApplicationIndexType index;
+    ReadApplicationIndex(pathList[k], index);
+    ApplicationIndexType::const_iterator it = index.find(name);
+    if (it != index.end())
+      {
+      return it->second.Keys;
+      }
+    // The module found here is the one that would be loaded
+    if (itksys::SystemTools::FileExists(JoinApplicationPath(pathList[k], appLibName).c_str(), true))
+      {
+      break;
+      }
+    }
+  return std::vector<std::string>();
+}
+
 Application::Pointer
 ApplicationRegistry::LoadApplicationFromPath(std::string path,std::string name)
 {
@@ -24,12 +24,74 @@
 #include "otbWrapperApplicationRegistry.h"
 #include "otbWrapperAddProcessToWatchEvent.h"
 #include "otbWrapperParameterKey.h"
+#include "otbWrapperRAMParameter.h"
+#include "otbConfigurationManager.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <atomic>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
 
 namespace otb
 {
 namespace Wrapper
 {
 
+namespace
+{
+
+/** Get the "ram" parameter of an application, if any */
+RAMParameter* GetRAMParameter(Application* app, bool follow)
+{
+  const std::vector<std::string> keys = app->GetParametersKeys(false);
+  if (std::find(keys.begin(), keys.end(), "ram") == keys.end())
+    {
+    return ITK_NULLPTR;
+    }
+  return dynamic_cast<RAMParameter*>(app->GetParameterByKey("ram", follow));
+}
+
+/** Find the first application of the streamed segment holding key */
+std::string FindSegment(std::map<std::string, std::string> & segments, const std::string & key)
+{
+  std::string root(key);
+  while (segments[root] != root)
+    {
+    root = segments[root];
+    }
+  return root;
+}
+
+/** Get the directory of the temporary files of the system */
+std::string GetSystemTemporaryDirectory()
+{
+  const char * variables[] = {"TMPDIR", "TMP", "TEMP"};
+  for (unsigned int i = 0; i < 3; ++i)
+    {
+    const char * directory = itksys::SystemTools::GetEnv(variables[i]);
+    if (directory != ITK_NULLPTR && *directory != '\0')
+      {
+      return directory;
+      }
+    }
+#ifdef _WIN32
+  return itksys::SystemTools::GetCurrentWorkingDirectory();
+#else
+  return "/tmp";
+#endif
+}
+
+/** Number of the temporary files written by the process so far */
+std::atomic<unsigned int> TemporaryFileCounter(0);
+
+}
+
 CompositeApplication::CompositeApplication()
 {
   m_AddProcessCommand = AddProcessCommandType::New();
@@ -38,6 +100,7 @@ CompositeApplication::CompositeApplication()
 
 CompositeApplication::~CompositeApplication()
 {
+  this->ClearTemporaryFiles();
 }
 
 void
@@ -46,6 +109,13 @@ CompositeApplication
 {
   if (typeid(AddProcessToWatchEvent) == typeid( event ))
     {
+    // Internal applications have no profiler: attach their processes
+    // to the one of the composite application
+    if (this->GetProfiler())
+      {
+      const AddProcessToWatchEvent* eventToWatch = dynamic_cast<const AddProcessToWatchEvent*> (&event);
+      this->GetProfiler()->Attach(eventToWatch->GetProcess());
+      }
     this->InvokeEvent(event);
     }
 }
@@ -74,6 +144,7 @@ CompositeApplication
 ::ClearApplications()
 {
   m_AppContainer.clear();
+  m_ImageConnections.clear();
 }
 
 bool
@@ -186,5 +257,246 @@ CompositeApplication
   GetInternalApplication(key)->UpdateParameters();
 }
 
+bool
+CompositeApplication
+::ConnectImage(std::string inputKey, std::string outputKey)
+{
+  std::string key1(inputKey);
+  std::string key2(outputKey);
+  Application *app1 = DecodeKey(key1);
+  Application *app2 = DecodeKey(key2);
+  if (app1 == this || app2 == this)
+    {
+    otbAppLogWARNING("Only images of internal applications can be connected ("
+      <<inputKey<<" to "<<outputKey<<")");
+    return false;
+    }
+  if (!dynamic_cast<InputImageParameter*>(app1->GetParameterByKey(key1)) ||
+      !dynamic_cast<OutputImageParameter*>(app2->GetParameterByKey(key2)))
+    {
+    otbAppLogWARNING("Can not connect "<<outputKey<<" to "<<inputKey
+      <<" : an output image and an input image are expected");
+    return false;
+    }
+
+  ImageConnection connection;
+  connection.InputApp = inputKey.substr(0, inputKey.find('.'));
+  connection.InputKey = key1;
+  connection.OutputApp = outputKey.substr(0, outputKey.find('.'));
+  connection.OutputKey = key2;
+
+  for (ImageConnectionContainer::iterator it = m_ImageConnections.begin();
+       it != m_ImageConnections.end(); ++it)
+    {
+    if (it->InputApp == connection.InputApp && it->InputKey == connection.InputKey)
+      {
+      otbAppLogWARNING("Image is already connected ! Override current connection");
+      *it = connection;
+      return true;
+      }
+    }
+  m_ImageConnections.push_back(connection);
+  return true;
+}
+
+void
+CompositeApplication
+::ExecuteChain(std::string key)
+{
+  this->ExecuteChain(std::vector<std::string>(1, key));
+}
+
+void
+CompositeApplication
+::ExecuteChain(const std::vector<std::string> & keys)
+{
+  this->ClearTemporaryFiles();
+
+  // Order the applications so that each one comes after the ones it
+  // depends on
+  std::map<std::string, int> states;
+  std::vector<std::string> chain;
+  for (std::vector<std::string>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+    {
+    this->SortChain(*it, states, chain);
+    }
+
+  // The multi-pass inputs may depend on the other parameters
+  for (std::vector<std::string>::const_iterator it = chain.begin(); it != chain.end(); ++it)
+    {
+    UpdateInternalParameters(*it);
+    }
+
+  // Gather the applications connected in memory in streamed segments
+  std::map<std::string, std::string> segments;
+  for (std::vector<std::string>::const_iterator it = chain.begin(); it != chain.end(); ++it)
+    {
+    segments[*it] = *it;
+    }
+  for (ImageConnectionContainer::const_iterator it = m_ImageConnections.begin();
+       it != m_ImageConnections.end(); ++it)
+    {
+    if (segments.count(it->InputApp) &&
+        !GetInternalApplication(it->InputApp)->IsMultiPassInput(it->InputKey))
+      {
+      segments[FindSegment(segments, it->InputApp)] = FindSegment(segments, it->OutputApp);
+      }
+    }
+
+  // Split the RAM budget between the applications of each segment
+  RAMParameter* ramParam = GetRAMParameter(this, true);
+  unsigned int ram = ConfigurationManager::GetMaxRAMHint();
+  if (ramParam != ITK_NULLPTR && ramParam->HasValue())
+    {
+    ram = ramParam->GetValue();
+    }
+  std::map<std::string, unsigned int> segmentSizes;
+  for (std::vector<std::string>::const_iterator it = chain.begin(); it != chain.end(); ++it)
+    {
+    if (GetRAMParameter(GetInternalApplication(*it), false) != ITK_NULLPTR)
+      {
+      ++segmentSizes[FindSegment(segments, *it)];
+      }
+    }
+
+  std::map<std::string, std::string> persistentFiles;
+  for (std::vector<std::string>::const_iterator it = chain.begin(); it != chain.end(); ++it)
+    {
+    Application* app = GetInternalApplication(*it);
+    for (ImageConnectionContainer::const_iterator cit = m_ImageConnections.begin();
+         cit != m_ImageConnections.end(); ++cit)
+      {
+      if (cit->InputApp != *it)
+        {
+        continue;
+        }
+      if (app->IsMultiPassInput(cit->InputKey))
+        {
+        // Each output is written once, whatever the number of
+        // applications reading it
+        std::string & fileName = persistentFiles[cit->OutputApp + "." + cit->OutputKey];
+        if (fileName.empty())
+          {
+          fileName = this->WritePersistentPass(cit->OutputApp, cit->OutputKey, ram);
+          }
+        app->SetParameterString(cit->InputKey, fileName);
+        }
+      else
+        {
+        app->SetParameterInputImage(cit->InputKey,
+          GetInternalApplication(cit->OutputApp)->GetParameterOutputImage(cit->OutputKey));
+        }
+      }
+
+    // The RAM parameter shared with the composite application keeps
+    // the whole budget
+    RAMParameter* appRAMParam = GetRAMParameter(app, false);
+    if (appRAMParam != ITK_NULLPTR && appRAMParam != ramParam)
+      {
+      const unsigned int share = std::max(ram / segmentSizes[FindSegment(segments, *it)], 1u);
+      otbAppLogDEBUG(<< GetInternalAppDescription(*it) << " uses " << share << " MB of RAM");
+      appRAMParam->SetValue(share);
+      }
+
+    ExecuteInternal(*it);
+    }
+}
+
+void
+CompositeApplication
+::ClearTemporaryFiles()
+{
+  for (std::vector<std::string>::const_iterator it = m_TemporaryFiles.begin();
+       it != m_TemporaryFiles.end(); ++it)
+    {
+    if (itksys::SystemTools::FileExists(it->c_str()))
+      {
+      itksys::SystemTools::RemoveFile(it->c_str());
+      }
+    }
+  m_TemporaryFiles.clear();
+}
+
+void
+CompositeApplication
+::AfterExecuteAndWriteOutputs()
+{
+  this->ClearTemporaryFiles();
+}
+
+void
+CompositeApplication
+::SortChain(const std::string & key,
+            std::map<std::string, int> & states,
+            std::vector<std::string> & chain)
+{
+  // 0 : not visited, 1 : visiting its dependencies, 2 : in the chain
+  int & state = states[key];
+  if (state == 2)
+    {
+    return;
+    }
+  if (state == 1)
+    {
+    otbAppLogFATAL("Cyclic image connections through internal application : "<<key);
+    }
+  // Fails on unknown applications
+  GetInternalApplication(key);
+  state = 1;
+  for (ImageConnectionContainer::const_iterator it = m_ImageConnections.begin();
+       it != m_ImageConnections.end(); ++it)
+    {
+    if (it->InputApp == key)
+      {
+      this->SortChain(it->OutputApp, states, chain);
+      }
+    }
+  state = 2;
+  chain.push_back(key);
+}
+
+std::string
+CompositeApplication
+::WritePersistentPass(const std::string & appKey,
+                      const std::string & outputKey,
+                      unsigned int ram)
+{
+  OutputImageParameter* outputParam = dynamic_cast<OutputImageParameter*>(
+    GetInternalApplication(appKey)->GetParameterByKey(outputKey));
+  if (outputParam == ITK_NULLPTR || outputParam->GetValue() == ITK_NULLPTR)
+    {
+    otbAppLogFATAL("No output image "<<outputKey<<" in internal application "<<appKey);
+    }
+
+  std::string directory(m_TemporaryDirectory);
+  if (directory.empty())
+    {
+    directory = GetSystemTemporaryDirectory();
+    }
+  // Unique in the process and between processes, as several
+  // composites may run at once in the same directory
+  std::ostringstream uniqueName;
+  uniqueName << this->GetName() << "_" << appKey << "_" << outputKey
+             << "_" << getpid() << "_" << TemporaryFileCounter++;
+  std::string baseName(uniqueName.str());
+  std::replace(baseName.begin(), baseName.end(), '.', '_');
+  const std::string fileName(directory + "/" + baseName + ".tif");
+  m_TemporaryFiles.push_back(fileName);
+  m_TemporaryFiles.push_back(directory + "/" + baseName + ".geom");
+
+  OutputImageParameter::Pointer persistentParam = OutputImageParameter::New();
+  persistentParam->SetValue(outputParam->GetValue());
+  persistentParam->SetPixelType(outputParam->GetPixelType());
+  persistentParam->SetFileName(fileName);
+  persistentParam->SetRAMValue(ram);
+  persistentParam->InitializeWriters();
+
+  std::ostringstream progressId;
+  progressId << GetInternalAppDescription(appKey) << " (persistent pass)...";
+  AddProcess(persistentParam->GetWriter(), progressId.str());
+  persistentParam->Write();
+  return fileName;
+}
+
 } // end namespace Wrapper
 } // end namespace otb
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperImageTileStreamer.h"
+#include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbTileDimensionTiledStreamingManager.h"
+#include "otbMacro.h"
+
+namespace otb
+{
+namespace Wrapper
+{
+
+namespace
+{
+/** Get the buffer of an Image or a VectorImage of TPixel */
+template <class TPixel>
+bool GetBufferIfPixelType(itk::ImageBase<2>* image, void*& buffer)
+{
+  if (otb::VectorImage<TPixel>* vectorImage = dynamic_cast<otb::VectorImage<TPixel>*>(image))
+    {
+    buffer = vectorImage->GetBufferPointer();
+    return true;
+    }
+  if (otb::Image<TPixel>* scalarImage = dynamic_cast<otb::Image<TPixel>*>(image))
+    {
+    buffer = scalarImage->GetBufferPointer();
+    return true;
+    }
+  return false;
+}
+}
+
+ImageTileStreamer::ImageTileStreamer()
+  : m_AvailableRAM(0),
+    m_TileDimension(0)
+{
+}
+
+ImageTileStreamer::~ImageTileStreamer()
+{
+}
+
+void
+ImageTileStreamer::SetImage(ImageBaseType* image)
+{
+  if (m_Image != image)
+    {
+    m_Image = image;
+    m_StreamingManager = ITK_NULLPTR;
+    this->Modified();
+    }
+}
+
+ImageTileStreamer::ImageBaseType*
+ImageTileStreamer::GetImage()
+{
+  return m_Image;
+}
+
+unsigned int
+ImageTileStreamer::PrepareTiles()
+{
+  if (m_Image.IsNull())
+    {
+    itkExceptionMacro(<< "No image to split");
+    }
+  m_Image->UpdateOutputInformation();
+
+  if (m_TileDimension > 0)
+    {
+    typedef TileDimensionTiledStreamingManager<UInt8ImageType> TileDimensionTiledStreamingManagerType;
+    TileDimensionTiledStreamingManagerType::Pointer streamingManager = TileDimensionTiledStreamingManagerType::New();
+    streamingManager->SetTileDimension(m_TileDimension);
+    m_StreamingManager = streamingManager;
+    }
+  else
+    {
+    typedef RAMDrivenAdaptativeStreamingManager<UInt8ImageType> RAMDrivenAdaptativeStreamingManagerType;
+    RAMDrivenAdaptativeStreamingManagerType::Pointer streamingManager = RAMDrivenAdaptativeStreamingManagerType::New();
+    streamingManager->SetAvailableRAMInMB(m_AvailableRAM);
+    streamingManager->SetBias(1.0);
+    m_StreamingManager = streamingManager;
+    }
+  m_StreamingManager->PrepareStreaming(m_Image, m_Image->GetLargestPossibleRegion());
+
+  otbMsgDevMacro(<< "Image split in " << m_StreamingManager->GetNumberOfSplits() << " tiles");
+  return m_StreamingManager->GetNumberOfSplits();
+}
+
+unsigned int
+ImageTileStreamer::GetNumberOfTiles() const
+{
+  if (m_StreamingManager.IsNull())
+    {
+    return 0;
+    }
+  return m_StreamingManager->GetNumberOfSplits();
+}
+
+ImageTileStreamer::RegionType
+ImageTileStreamer::GetTileRegion(unsigned int tile) const
+{
+  if (tile >= this->GetNumberOfTiles())
+    {
+    itkExceptionMacro(<< "Tile " << tile << " out of range, the image has " << this->GetNumberOfTiles() << " tiles");
+    }
+  return m_StreamingManager->GetSplit(tile);
+}
+
+void
+ImageTileStreamer::GenerateTile(unsigned int tile)
+{
+  RegionType region = this->GetTileRegion(tile);
+  m_Image->SetRequestedRegion(region);
+  m_Image->PropagateRequestedRegion();
+  m_Image->UpdateOutputData();
+}
+
+ImagePixelType
+ImageTileStreamer::GetPixelType() const
+{
+  ImageBaseType* image = m_Image.GetPointer();
+  void* buffer = ITK_NULLPTR;
+  if (GetBufferIfPixelType<unsigned char>(image, buffer))
+    {
+    return ImagePixelType_uint8;
+    }
+  if (GetBufferIfPixelType<short>(image, buffer))
+    {
+    return ImagePixelType_int16;
+    }
+  if (GetBufferIfPixelType<unsigned short>(image, buffer))
+    {
+    return ImagePixelType_uint16;
+    }
+  if (GetBufferIfPixelType<int>(image, buffer))
+    {
+    return ImagePixelType_int32;
+    }
+  if (GetBufferIfPixelType<unsigned int>(image, buffer))
+    {
+    return ImagePixelType_uint32;
+    }
+  if (GetBufferIfPixelType<float>(image, buffer))
+    {
+    return ImagePixelType_float;
+    }
+  if (GetBufferIfPixelType<double>(image, buffer))
+    {
+    return ImagePixelType_double;
+    }
+  itkExceptionMacro(<< "Unsupported image type : " << (image ? image->GetNameOfClass() : "no image"));
+}
+
+void*
+ImageTileStreamer::GetBufferPointer()
+{
+  void* buffer = ITK_NULLPTR;
+  if (GetBufferIfPixelType<unsigned char>(m_Image, buffer)
+      || GetBufferIfPixelType<short>(m_Image, buffer)
+      || GetBufferIfPixelType<unsigned short>(m_Image, buffer)
+      || GetBufferIfPixelType<int>(m_Image, buffer)
+      || GetBufferIfPixelType<unsigned int>(m_Image, buffer)
+      || GetBufferIfPixelType<float>(m_Image, buffer)
+      || GetBufferIfPixelType<double>(m_Image, buffer))
+    {
+    return buffer;
+    }
+  itkExceptionMacro(<< "Unsupported image type : " << (m_Image.IsNotNull() ? m_Image->GetNameOfClass() : "no image"));
+}
+
+void
+ImageTileStreamer::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "AvailableRAM: " << m_AvailableRAM << std::endl;
+  os << indent << "TileDimension: " << m_TileDimension << std::endl;
+  os << indent << "NumberOfTiles: " << this->GetNumberOfTiles() << std::endl;
+}
+
+} // end namespace Wrapper
+} //end namespace otb
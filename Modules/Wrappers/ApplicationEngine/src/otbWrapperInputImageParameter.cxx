@@ -36,6 +36,7 @@ InputImageParameter::InputImageParameter()
   m_FileName="";
   m_PreviousFileName="";
   m_UseFilename = true;
+  m_MultiPass = false;
   this->ClearValue();
 }
 
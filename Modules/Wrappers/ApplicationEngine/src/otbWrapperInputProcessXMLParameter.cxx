@@ -220,10 +220,20 @@ InputProcessXMLParameter::Read(Application::Pointer this_)
   otb_Platform = this_->GetChildNodeTextOf(n_OTB, "platform");
   */
 
-  int ret = 0;
-
   TiXmlElement *n_AppNode   = n_OTB->FirstChildElement("application");
 
+  const int ret = this->ReadApplication(this_, n_AppNode);
+
+  fclose(fp);
+
+  return ret;
+}
+
+int
+InputProcessXMLParameter::ReadApplication(Application::Pointer this_, TiXmlElement* n_AppNode)
+{
+  int ret = 0;
+
   std::string app_Name;
   app_Name = GetChildNodeTextOf(n_AppNode, "name");
   /*
@@ -263,7 +273,6 @@ InputProcessXMLParameter::Read(Application::Pointer this_)
     itkWarningMacro( << "Input XML was generated for a different application( " <<
                        app_Name << ") while application loaded is:" <<this_->GetName());
 
-              fclose(fp);
     return -1;
     }
 
@@ -455,8 +464,6 @@ InputProcessXMLParameter::Read(Application::Pointer this_)
 
   ret = 0; //resetting return to zero, we don't use it anyway for now.
 
-  fclose(fp);
-
   return ret;
 }
 
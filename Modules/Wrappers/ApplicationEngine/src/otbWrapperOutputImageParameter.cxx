@@ -43,7 +43,9 @@ namespace Wrapper
 OutputImageParameter::OutputImageParameter()
   : m_PixelType(ImagePixelType_float),
     m_DefaultPixelType(ImagePixelType_float),
-    m_RAMValue(0)
+    m_RAMValue(0),
+    m_PipelineSignature(),
+    m_MultiWriter(ITK_NULLPTR)
 {
   this->SetName("Output Image");
   this->SetKey("out");
@@ -121,11 +123,21 @@ void OutputImageParameter::InitializeWriters()
 }
 
 
-template <typename TInput, typename TOutput> void ClampAndWriteImage(itk::ImageBase<2> * in, otb::ImageFileWriter<TOutput> * writer, const std::string & filename, const unsigned int & ramValue)
+template <typename TInput, typename TOutput> void ClampAndWriteImage(itk::ImageBase<2> * in, otb::ImageFileWriter<TOutput> * writer, const std::string & filename, const unsigned int & ramValue,
+  const std::string & pipelineSignature, const std::vector<itk::ImageBase<2>::Pointer> & concurrentImages,
+  MultiImageFileWriter * multiWriter, itk::ProcessObject::Pointer & caster)
 {
   typedef otb::ClampImageFilter<TInput, TOutput> ClampFilterType; 
   typename ClampFilterType::Pointer clampFilter = ClampFilterType::New();         
   clampFilter->SetInput( dynamic_cast<TInput*>(in));
+
+  if (multiWriter != ITK_NULLPTR)
+    {
+    // The clamp filter is kept until the writer is updated
+    multiWriter->AddInputImage(clampFilter->GetOutput(), filename);
+    caster = clampFilter.GetPointer();
+    return;
+    }
   
   bool useStandardWriter = true;
 
@@ -174,15 +186,39 @@ template <typename TInput, typename TOutput> void ClampAndWriteImage(itk::ImageB
     writer->SetFileName( filename );                                     
     writer->SetInput(clampFilter->GetOutput());                                     
     writer->SetAutomaticAdaptativeStreaming(ramValue);
+    writer->SetPipelineSignature(pipelineSignature);
+
+    // Each copy of the pipeline is cast by its own filter
+    std::vector<typename ClampFilterType::Pointer> concurrentClampFilters;
+    writer->ClearConcurrentInputs();
+    for (unsigned int i = 0; i < concurrentImages.size(); ++i)
+      {
+      typename ClampFilterType::Pointer concurrentClampFilter = ClampFilterType::New();
+      concurrentClampFilter->SetInput(dynamic_cast<TInput*>(concurrentImages[i].GetPointer()));
+      writer->AddConcurrentInput(concurrentClampFilter->GetOutput());
+      concurrentClampFilters.push_back(concurrentClampFilter);
+      }
+
     writer->Update();
+    writer->ClearConcurrentInputs();
     }
 }
 
-template <typename TInput, typename TOutput > void ClampAndWriteVectorImage(itk::ImageBase<2> * in, otb::ImageFileWriter<TOutput > * writer, const std::string & filename, const unsigned int & ramValue)
+template <typename TInput, typename TOutput > void ClampAndWriteVectorImage(itk::ImageBase<2> * in, otb::ImageFileWriter<TOutput > * writer, const std::string & filename, const unsigned int & ramValue,
+  const std::string & pipelineSignature, const std::vector<itk::ImageBase<2>::Pointer> & concurrentImages,
+  MultiImageFileWriter * multiWriter, itk::ProcessObject::Pointer & caster)
 {
   typedef otb::ClampVectorImageFilter<TInput, TOutput> ClampFilterType; 
   typename ClampFilterType::Pointer clampFilter = ClampFilterType::New();         
   clampFilter->SetInput( dynamic_cast<TInput*>(in));
+
+  if (multiWriter != ITK_NULLPTR)
+    {
+    // The clamp filter is kept until the writer is updated
+    multiWriter->AddInputImage(clampFilter->GetOutput(), filename);
+    caster = clampFilter.GetPointer();
+    return;
+    }
   
   bool useStandardWriter = true;
   
@@ -229,7 +265,21 @@ template <typename TInput, typename TOutput > void ClampAndWriteVectorImage(itk:
     writer->SetFileName( filename );                                     
     writer->SetInput(clampFilter->GetOutput());                                     
     writer->SetAutomaticAdaptativeStreaming(ramValue);
+    writer->SetPipelineSignature(pipelineSignature);
+
+    // Each copy of the pipeline is cast by its own filter
+    std::vector<typename ClampFilterType::Pointer> concurrentClampFilters;
+    writer->ClearConcurrentInputs();
+    for (unsigned int i = 0; i < concurrentImages.size(); ++i)
+      {
+      typename ClampFilterType::Pointer concurrentClampFilter = ClampFilterType::New();
+      concurrentClampFilter->SetInput(dynamic_cast<TInput*>(concurrentImages[i].GetPointer()));
+      writer->AddConcurrentInput(concurrentClampFilter->GetOutput());
+      concurrentClampFilters.push_back(concurrentClampFilter);
+      }
+
     writer->Update();
+    writer->ClearConcurrentInputs();
     }
 }
 
@@ -242,37 +292,37 @@ OutputImageParameter::SwitchImageWrite()
     {
     case ImagePixelType_uint8:
     {
-    ClampAndWriteImage<TInputImageType,UInt8ImageType>(m_Image,m_UInt8Writer,m_FileName,m_RAMValue);
+    ClampAndWriteImage<TInputImageType,UInt8ImageType>(m_Image,m_UInt8Writer,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_int16:
     {
-    ClampAndWriteImage<TInputImageType,Int16ImageType>(m_Image,m_Int16Writer,m_FileName,m_RAMValue);
+    ClampAndWriteImage<TInputImageType,Int16ImageType>(m_Image,m_Int16Writer,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_uint16:
     {
-    ClampAndWriteImage<TInputImageType,UInt16ImageType>(m_Image,m_UInt16Writer,m_FileName,m_RAMValue);
+    ClampAndWriteImage<TInputImageType,UInt16ImageType>(m_Image,m_UInt16Writer,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_int32:
     {
-    ClampAndWriteImage<TInputImageType,Int32ImageType>(m_Image,m_Int32Writer,m_FileName,m_RAMValue);
+    ClampAndWriteImage<TInputImageType,Int32ImageType>(m_Image,m_Int32Writer,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_uint32:
     {
-    ClampAndWriteImage<TInputImageType,UInt32ImageType>(m_Image,m_UInt32Writer,m_FileName,m_RAMValue);
+    ClampAndWriteImage<TInputImageType,UInt32ImageType>(m_Image,m_UInt32Writer,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_float:
     {
-    ClampAndWriteImage<TInputImageType,FloatImageType>(m_Image,m_FloatWriter,m_FileName,m_RAMValue);
+    ClampAndWriteImage<TInputImageType,FloatImageType>(m_Image,m_FloatWriter,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_double:
     {
-    ClampAndWriteImage<TInputImageType,DoubleImageType>(m_Image,m_DoubleWriter,m_FileName,m_RAMValue);
+    ClampAndWriteImage<TInputImageType,DoubleImageType>(m_Image,m_DoubleWriter,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     }
@@ -287,37 +337,37 @@ OutputImageParameter::SwitchVectorImageWrite()
     {
     case ImagePixelType_uint8:
     {
-    ClampAndWriteVectorImage<TInputVectorImageType,UInt8VectorImageType>(m_Image,m_VectorUInt8Writer,m_FileName,m_RAMValue);
+    ClampAndWriteVectorImage<TInputVectorImageType,UInt8VectorImageType>(m_Image,m_VectorUInt8Writer,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_int16:
     {
-    ClampAndWriteVectorImage<TInputVectorImageType,Int16VectorImageType>(m_Image,m_VectorInt16Writer,m_FileName,m_RAMValue);
+    ClampAndWriteVectorImage<TInputVectorImageType,Int16VectorImageType>(m_Image,m_VectorInt16Writer,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_uint16:
     {
-    ClampAndWriteVectorImage<TInputVectorImageType,UInt16VectorImageType>(m_Image,m_VectorUInt16Writer,m_FileName,m_RAMValue);
+    ClampAndWriteVectorImage<TInputVectorImageType,UInt16VectorImageType>(m_Image,m_VectorUInt16Writer,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_int32:
     {
-    ClampAndWriteVectorImage<TInputVectorImageType,Int32VectorImageType>(m_Image,m_VectorInt32Writer,m_FileName,m_RAMValue);
+    ClampAndWriteVectorImage<TInputVectorImageType,Int32VectorImageType>(m_Image,m_VectorInt32Writer,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_uint32:
     {
-    ClampAndWriteVectorImage<TInputVectorImageType,UInt32VectorImageType>(m_Image,m_VectorUInt32Writer,m_FileName,m_RAMValue);
+    ClampAndWriteVectorImage<TInputVectorImageType,UInt32VectorImageType>(m_Image,m_VectorUInt32Writer,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_float:
     {
-    ClampAndWriteVectorImage<TInputVectorImageType,FloatVectorImageType>(m_Image,m_VectorFloatWriter,m_FileName,m_RAMValue);
+    ClampAndWriteVectorImage<TInputVectorImageType,FloatVectorImageType>(m_Image,m_VectorFloatWriter,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     case ImagePixelType_double:
     {
-    ClampAndWriteVectorImage<TInputVectorImageType,DoubleVectorImageType>(m_Image,m_VectorDoubleWriter,m_FileName,m_RAMValue);
+    ClampAndWriteVectorImage<TInputVectorImageType,DoubleVectorImageType>(m_Image,m_VectorDoubleWriter,m_FileName,m_RAMValue,m_PipelineSignature,m_ConcurrentImages,m_MultiWriter,m_Caster);
     break;
     }
     }
@@ -328,12 +378,23 @@ template <class TInputRGBAImageType>
 void
 OutputImageParameter::SwitchRGBAImageWrite()
   {
-  if( m_PixelType == ImagePixelType_uint8 )
+  if( m_PixelType == ImagePixelType_uint8 && m_MultiWriter != ITK_NULLPTR )
+    {
+    m_MultiWriter->AddInputImage(dynamic_cast<UInt8RGBAImageType*>(m_Image.GetPointer()), this->GetFileName());
+    }
+  else if( m_PixelType == ImagePixelType_uint8 )
     {
     m_RGBAUInt8Writer->SetFileName( this->GetFileName() );
     m_RGBAUInt8Writer->SetInput(dynamic_cast<UInt8RGBAImageType*>(m_Image.GetPointer()) );
     m_RGBAUInt8Writer->SetAutomaticAdaptativeStreaming(m_RAMValue);
+    m_RGBAUInt8Writer->SetPipelineSignature(m_PipelineSignature);
+    m_RGBAUInt8Writer->ClearConcurrentInputs();
+    for (unsigned int i = 0; i < m_ConcurrentImages.size(); ++i)
+      {
+      m_RGBAUInt8Writer->AddConcurrentInput(dynamic_cast<UInt8RGBAImageType*>(m_ConcurrentImages[i].GetPointer()));
+      }
     m_RGBAUInt8Writer->Update();
+    m_RGBAUInt8Writer->ClearConcurrentInputs();
     }
    else
      itkExceptionMacro("Unknown PixelType for RGBA Image. Only uint8 is supported.");
@@ -343,12 +404,23 @@ template <class TInputRGBImageType>
 void
 OutputImageParameter::SwitchRGBImageWrite()
   {
-   if( m_PixelType == ImagePixelType_uint8 )
+   if( m_PixelType == ImagePixelType_uint8 && m_MultiWriter != ITK_NULLPTR )
+    {
+    m_MultiWriter->AddInputImage(dynamic_cast<UInt8RGBImageType*>(m_Image.GetPointer()), this->GetFileName());
+    }
+   else if( m_PixelType == ImagePixelType_uint8 )
     {
     m_RGBUInt8Writer->SetFileName( this->GetFileName() );
     m_RGBUInt8Writer->SetInput(dynamic_cast<UInt8RGBImageType*>(m_Image.GetPointer()) );
     m_RGBUInt8Writer->SetAutomaticAdaptativeStreaming(m_RAMValue);
+    m_RGBUInt8Writer->SetPipelineSignature(m_PipelineSignature);
+    m_RGBUInt8Writer->ClearConcurrentInputs();
+    for (unsigned int i = 0; i < m_ConcurrentImages.size(); ++i)
+      {
+      m_RGBUInt8Writer->AddConcurrentInput(dynamic_cast<UInt8RGBImageType*>(m_ConcurrentImages[i].GetPointer()));
+      }
     m_RGBUInt8Writer->Update();
+    m_RGBUInt8Writer->ClearConcurrentInputs();
     }
    else
      itkExceptionMacro("Unknown PixelType for RGB Image. Only uint8 is supported.");
@@ -430,6 +502,22 @@ OutputImageParameter::Write()
   }
 
 
+void
+OutputImageParameter::AddToMultiWriter(MultiImageFileWriter* writer)
+{
+  m_MultiWriter = writer;
+  try
+    {
+    this->Write();
+    }
+  catch (...)
+    {
+    m_MultiWriter = ITK_NULLPTR;
+    throw;
+    }
+  m_MultiWriter = ITK_NULLPTR;
+}
+
 itk::ProcessObject*
 OutputImageParameter::GetWriter()
 {
@@ -555,6 +643,18 @@ OutputImageParameter::SetValue(ImageBaseType* image)
   SetActive(true);
 }
 
+void
+OutputImageParameter::AddConcurrentImage(ImageBaseType* image)
+{
+  m_ConcurrentImages.push_back(image);
+}
+
+void
+OutputImageParameter::ClearConcurrentImages()
+{
+  m_ConcurrentImages.clear();
+}
+
 bool
 OutputImageParameter::HasValue() const
 {
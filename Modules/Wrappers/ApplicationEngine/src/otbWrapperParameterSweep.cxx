@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperParameterSweep.h"
+#include "otbWrapperApplicationRegistry.h"
+#include "otbWrapperAddProcessToWatchEvent.h"
+#include "otbWrapperInputImageListParameter.h"
+#include "otbMultiImageFileWriter.h"
+#include "otbMacro.h"
+
+#ifdef OTB_USE_MPI
+#include "otbMPIConfig.h"
+#endif
+
+#include <algorithm>
+
+namespace otb
+{
+namespace Wrapper
+{
+
+namespace
+{
+
+/** Set parameters from their values given as strings */
+void SetParameterValues(Application* app, const ParameterSweep::ParameterSetType & parameters)
+{
+  for (ParameterSweep::ParameterSetType::const_iterator it = parameters.begin();
+       it != parameters.end(); ++it)
+    {
+    const std::string & key = it->first;
+    const std::vector<std::string> & values = it->second;
+    const ParameterType type = app->GetParameterType(key);
+
+    if (type == ParameterType_InputImageList || type == ParameterType_InputVectorDataList ||
+        type == ParameterType_InputFilenameList || type == ParameterType_StringList ||
+        type == ParameterType_ListView)
+      {
+      app->SetParameterStringList(key, values);
+      }
+    else if (type == ParameterType_Empty && values.size() == 1)
+      {
+      app->SetParameterEmpty(key, values[0] != "false" && values[0] != "0");
+      }
+    else if (type == ParameterType_OutputImage && values.size() == 2)
+      {
+      // File name followed by the pixel type
+      app->SetParameterString(key, values[0]);
+      int pixelType = ImagePixelType_uint8;
+      while (pixelType <= ImagePixelType_double &&
+             OutputImageParameter::ConvertPixelTypeToString(static_cast<ImagePixelType>(pixelType)) != values[1])
+        {
+        ++pixelType;
+        }
+      if (pixelType > ImagePixelType_double)
+        {
+        itkGenericExceptionMacro(<< "Unknown pixel type " << values[1] << " for parameter " << key);
+        }
+      app->SetParameterOutputImagePixelType(key, static_cast<ImagePixelType>(pixelType));
+      }
+    else if (values.size() == 1)
+      {
+      app->SetParameterString(key, values[0]);
+      }
+    else
+      {
+      itkGenericExceptionMacro(<< "Wrong number of values (" << values.size() << ") for parameter " << key);
+      }
+    }
+}
+
+}
+
+ParameterSweep::ParameterSweep()
+{
+  m_AddProcessCommand = AddProcessCommandType::New();
+  m_AddProcessCommand->SetCallbackFunction(this, &ParameterSweep::LinkWatchers);
+}
+
+ParameterSweep::~ParameterSweep()
+{
+}
+
+void
+ParameterSweep
+::SetCommonParameter(const std::string & key, const std::string & value)
+{
+  m_CommonParameters[key] = std::vector<std::string>(1, value);
+  this->Modified();
+}
+
+void
+ParameterSweep
+::SetCommonParameter(const std::string & key, const std::vector<std::string> & values)
+{
+  m_CommonParameters[key] = values;
+  this->Modified();
+}
+
+void
+ParameterSweep
+::SetCommonInputImage(const std::string & key, ImageBaseType * image)
+{
+  m_CommonInputImages[key] = image;
+  this->Modified();
+}
+
+void
+ParameterSweep
+::AddParameterSet(const ParameterSetType & parameters)
+{
+  m_ParameterSets.push_back(parameters);
+  this->Modified();
+}
+
+void
+ParameterSweep
+::ClearParameterSets()
+{
+  m_CommonParameters.clear();
+  m_CommonInputImages.clear();
+  m_ParameterSets.clear();
+  m_Variants.clear();
+  this->Modified();
+}
+
+Application*
+ParameterSweep
+::GetVariant(unsigned int i)
+{
+  if (i >= m_Variants.size())
+    {
+    itkExceptionMacro(<< "No variant " << i << ", " << m_Variants.size() << " variants executed");
+    }
+  return m_Variants[i];
+}
+
+void
+ParameterSweep
+::Execute()
+{
+  if (m_ParameterSets.empty())
+    {
+    itkExceptionMacro(<< "No parameter set given");
+    }
+
+  m_Variants.clear();
+  for (unsigned int i = 0; i < m_ParameterSets.size(); ++i)
+    {
+    Application::Pointer variant = ApplicationRegistry::CreateApplication(m_ApplicationName);
+    if (variant.IsNull())
+      {
+      itkExceptionMacro(<< "Could not create application " << m_ApplicationName);
+      }
+    variant->AddObserver(AddProcessToWatchEvent(), m_AddProcessCommand.GetPointer());
+    SetParameterValues(variant, m_CommonParameters);
+    for (std::map<std::string, ImageBaseType::Pointer>::const_iterator it = m_CommonInputImages.begin();
+         it != m_CommonInputImages.end(); ++it)
+      {
+      variant->SetParameterInputImage(it->first, it->second);
+      }
+    SetParameterValues(variant, m_ParameterSets[i]);
+    m_Variants.push_back(variant);
+    }
+
+  // The first variant creates the readers, the other ones are plugged
+  // on them
+  const std::vector<std::string> sharedKeys = this->GetSharedInputKeys();
+  otbMsgDevMacro(<< sharedKeys.size() << " input images shared by the " << m_Variants.size() << " variants");
+  m_Variants[0]->Execute();
+  for (unsigned int i = 1; i < m_Variants.size(); ++i)
+    {
+    this->ShareInputImages(m_Variants[i], sharedKeys);
+    m_Variants[i]->Execute();
+    }
+}
+
+void
+ParameterSweep
+::ExecuteAndWriteOutput()
+{
+  this->Execute();
+
+  // Gather the output images of all the variants on the grid of the
+  // first one
+  std::vector<std::vector<std::string> > writtenKeys(m_Variants.size());
+  std::vector<OutputImageParameter*> outputParams;
+  ImageBaseType::RegionType largestRegion;
+  bool writeTogether = true;
+#ifdef OTB_USE_MPI
+  // Each output is written in parallel by all the processes
+  writeTogether = otb::MPIConfig::Instance()->GetNbProcs() <= 1;
+#endif
+  for (unsigned int i = 0; writeTogether && i < m_Variants.size(); ++i)
+    {
+    Application* variant = m_Variants[i];
+    const std::vector<std::string> keys = variant->GetParametersKeys(true);
+    for (std::vector<std::string>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+      {
+      if (variant->GetParameterType(*it) != ParameterType_OutputImage
+          || !variant->IsParameterEnabled(*it) || !variant->HasValue(*it))
+        {
+        continue;
+        }
+      OutputImageParameter* outputParam = dynamic_cast<OutputImageParameter*>(variant->GetParameterByKey(*it));
+      if (outputParam == ITK_NULLPTR || outputParam->GetValue() == ITK_NULLPTR
+          || !MultiImageFileWriter::IsSupportedFileName(outputParam->GetFileName()))
+        {
+        continue;
+        }
+      outputParam->GetValue()->UpdateOutputInformation();
+      if (outputParams.empty())
+        {
+        largestRegion = outputParam->GetValue()->GetLargestPossibleRegion();
+        }
+      else if (outputParam->GetValue()->GetLargestPossibleRegion() != largestRegion)
+        {
+        continue;
+        }
+      outputParams.push_back(outputParam);
+      writtenKeys[i].push_back(*it);
+      }
+    }
+
+  if (outputParams.size() > 1)
+    {
+    MultiImageFileWriter::Pointer multiWriter = MultiImageFileWriter::New();
+    for (unsigned int i = 0; i < outputParams.size(); ++i)
+      {
+      outputParams[i]->InitializeWriters();
+      const std::string checkReturn = outputParams[i]->CheckFileName(true);
+      if (!checkReturn.empty())
+        {
+        otbWarningMacro(<< "Check filename: " << checkReturn);
+        }
+      outputParams[i]->AddToMultiWriter(multiWriter);
+      }
+
+    // The variants share the RAM parameter of the common parameters
+    const std::vector<std::string> keys = m_Variants[0]->GetParametersKeys(false);
+    if (std::find(keys.begin(), keys.end(), "ram") != keys.end()
+        && m_Variants[0]->GetParameterType("ram") == ParameterType_RAM
+        && m_Variants[0]->IsParameterEnabled("ram"))
+      {
+      multiWriter->SetAutomaticAdaptativeStreaming(m_Variants[0]->GetParameterInt("ram"));
+      }
+
+    std::ostringstream progressId;
+    progressId << "Writing " << outputParams.size() << " images of " << m_Variants.size()
+               << " " << m_ApplicationName << " variants...";
+    AddProcessToWatchEvent event;
+    event.SetProcess(multiWriter);
+    event.SetProcessDescription(progressId.str());
+    this->InvokeEvent(event);
+    multiWriter->Update();
+    }
+  else
+    {
+    writtenKeys.assign(m_Variants.size(), std::vector<std::string>());
+    }
+
+  for (unsigned int i = 0; i < m_Variants.size(); ++i)
+    {
+    m_Variants[i]->WriteOutputs(writtenKeys[i]);
+    }
+}
+
+void
+ParameterSweep
+::LinkWatchers(itk::Object * itkNotUsed(caller), const itk::EventObject & event)
+{
+  if (typeid(AddProcessToWatchEvent) == typeid( event ))
+    {
+    this->InvokeEvent(event);
+    }
+}
+
+std::vector<std::string>
+ParameterSweep
+::GetSharedInputKeys()
+{
+  std::vector<std::string> sharedKeys;
+  Application* first = m_Variants[0];
+  const std::vector<std::string> keys = first->GetParametersKeys(true);
+  for (std::vector<std::string>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+    {
+    const ParameterType type = first->GetParameterType(*it);
+    if ((type != ParameterType_InputImage && type != ParameterType_InputImageList)
+        || m_CommonInputImages.count(*it)
+        || !first->IsParameterEnabled(*it) || !first->HasValue(*it))
+      {
+      continue;
+      }
+    const std::vector<std::string> fileNames = (type == ParameterType_InputImage) ?
+      std::vector<std::string>(1, first->GetParameterString(*it)) :
+      first->GetParameterStringList(*it);
+    if (std::find(fileNames.begin(), fileNames.end(), std::string()) != fileNames.end())
+      {
+      continue;
+      }
+
+    bool shared = true;
+    for (unsigned int i = 1; shared && i < m_Variants.size(); ++i)
+      {
+      Application* variant = m_Variants[i];
+      shared = variant->IsParameterEnabled(*it) && variant->HasValue(*it) &&
+        fileNames == ((type == ParameterType_InputImage) ?
+          std::vector<std::string>(1, variant->GetParameterString(*it)) :
+          variant->GetParameterStringList(*it));
+      }
+    if (shared)
+      {
+      sharedKeys.push_back(*it);
+      }
+    }
+  return sharedKeys;
+}
+
+void
+ParameterSweep
+::ShareInputImages(Application * variant, const std::vector<std::string> & keys)
+{
+  Application* first = m_Variants[0];
+  for (std::vector<std::string>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+    {
+    InputImageParameter* inputParam = dynamic_cast<InputImageParameter*>(first->GetParameterByKey(*it));
+    InputImageListParameter* inputListParam = dynamic_cast<InputImageListParameter*>(first->GetParameterByKey(*it));
+    if (inputParam != ITK_NULLPTR)
+      {
+      // Images not read by the first variant are left to each variant
+      if (inputParam->GetImageBase() != ITK_NULLPTR)
+        {
+        variant->SetParameterInputImage(*it, inputParam->GetImageBase());
+        }
+      }
+    else if (inputListParam != ITK_NULLPTR)
+      {
+      InputImageListParameter* variantListParam = dynamic_cast<InputImageListParameter*>(variant->GetParameterByKey(*it));
+      for (unsigned int i = 0; i < inputListParam->Size(); ++i)
+        {
+        variantListParam->SetNthImage(i, inputListParam->GetNthImage(i));
+        }
+      }
+    }
+}
+
+void
+ParameterSweep
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ApplicationName: " << m_ApplicationName << std::endl;
+  os << indent << "NumberOfParameterSets: " << m_ParameterSets.size() << std::endl;
+  os << indent << "NumberOfCommonParameters: " << m_CommonParameters.size() << std::endl;
+}
+
+} // end namespace Wrapper
+} // end namespace otb
@@ -34,6 +34,8 @@ void RegisterTests()
   REGISTER_TEST(otbWrapperChoiceParameterNew);
   REGISTER_TEST(otbWrapperChoiceParameterTest1);
   REGISTER_TEST(otbWrapperApplicationRegistry);
+  REGISTER_TEST(otbWrapperApplicationIndex);
+  REGISTER_TEST(otbWrapperImageTileStreamerTest);
   REGISTER_TEST(otbWrapperStringListParameterNew);
   REGISTER_TEST(otbWrapperStringListParameterTest1);
   REGISTER_TEST(otbWrapperRAMParameterNew);
@@ -54,4 +56,6 @@ void RegisterTests()
   REGISTER_TEST(otbWrapperOutputImageParameterNew);
   REGISTER_TEST(otbWrapperOutputImageParameterTest1);
   REGISTER_TEST(otbApplicationMemoryConnectTest);
+  REGISTER_TEST(otbWrapperCompositeApplicationChainTest);
+  REGISTER_TEST(otbWrapperParameterSweepTest);
 }
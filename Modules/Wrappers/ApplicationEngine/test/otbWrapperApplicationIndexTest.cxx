@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER)
+#pragma warning ( disable : 4786 )
+#endif
+
+#include "otbWrapperApplicationRegistry.h"
+#include "itksys/SystemTools.hxx"
+#include "itksys/DynamicLoader.hxx"
+
+#include <algorithm>
+#include <fstream>
+
+int otbWrapperApplicationIndex(int argc, char* argv[])
+{
+  if (argc < 2)
+    {
+    std::cerr << "Usage : " << argv[0] << " directory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  using otb::Wrapper::ApplicationRegistry;
+
+  const std::string directory(argv[1]);
+  itksys::SystemTools::RemoveADirectory(directory.c_str());
+  itksys::SystemTools::MakeDirectory(directory.c_str());
+  ApplicationRegistry::SetApplicationPath(directory);
+
+  // An empty directory gives an empty index
+  if (!ApplicationRegistry::WriteApplicationIndex(directory))
+    {
+    std::cout << "Can not write the index of " << directory << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string indexPath = directory + "/" + ApplicationRegistry::GetApplicationIndexFileName();
+  if (!itksys::SystemTools::FileExists(indexPath.c_str(), true))
+    {
+    std::cout << "No index written in " << directory << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (!ApplicationRegistry::GetAvailableApplications(false).empty())
+    {
+    std::cout << "Applications found in an empty directory" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // A module which is not a shared library : it can only be listed
+  // through the index, since loading it fails.
+  std::string appExtension = itksys::DynamicLoader::LibExtension();
+#ifdef __APPLE__
+  appExtension = ".dylib";
+#endif
+  const std::string library = "otbapp_Indexed" + appExtension;
+  std::ofstream(std::string(directory + "/" + library).c_str()) << "not a module";
+  {
+  std::ofstream ofs(indexPath.c_str());
+  ofs << "# test index" << std::endl;
+  ofs << "Indexed " << library << " in out ram" << std::endl;
+  ofs << "Removed otbapp_Removed" << appExtension << " in" << std::endl;
+  }
+
+  std::vector<std::string> apps = ApplicationRegistry::GetAvailableApplications(false);
+  if (apps.size() != 1 || apps[0] != "Indexed")
+    {
+    std::cout << "Expected the indexed application only, found " << apps.size() << " applications" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::vector<std::string> keys = ApplicationRegistry::GetIndexedParametersKeys("Indexed");
+  if (keys.size() != 3 || keys[0] != "in" || keys[1] != "out" || keys[2] != "ram")
+    {
+    std::cout << "Wrong parameter keys read from the index" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (!ApplicationRegistry::GetIndexedParametersKeys("Removed").empty())
+    {
+    std::cout << "Entry of a removed module used" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Rewriting the index keeps the entry of the unchanged module, and
+  // drops the removed one
+  if (!ApplicationRegistry::WriteApplicationIndex(directory))
+    {
+    std::cout << "Can not update the index of " << directory << std::endl;
+    return EXIT_FAILURE;
+    }
+  keys = ApplicationRegistry::GetIndexedParametersKeys("Indexed");
+  if (keys.size() != 3)
+    {
+    std::cout << "Entry of an unchanged module lost on update" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
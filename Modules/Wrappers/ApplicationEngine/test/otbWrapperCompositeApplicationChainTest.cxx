@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER)
+#pragma warning ( disable : 4786 )
+#endif
+
+#include "otbWrapperCompositeApplication.h"
+#include "otbWrapperApplicationRegistry.h"
+#include "itksys/SystemTools.hxx"
+
+namespace otb
+{
+namespace Wrapper
+{
+
+/** Smoothing feeding a linear Convert (multi-pass input) and a second
+ * Smoothing (streamed once) */
+class CompositeChainTestApplication : public CompositeApplication
+{
+public:
+  typedef CompositeChainTestApplication Self;
+  typedef CompositeApplication          Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  itkNewMacro(Self);
+
+  itkTypeMacro(CompositeChainTestApplication, CompositeApplication);
+
+  Application* GetChainApplication(std::string key)
+  {
+    return GetInternalApplication(key);
+  }
+
+private:
+  void DoInit() ITK_OVERRIDE
+  {
+    SetName("CompositeChainTest");
+    SetDescription("Test of the chaining of internal applications");
+
+    ClearApplications();
+    AddApplication("Smoothing", "smoothing", "Smoothing step");
+    AddApplication("Convert", "convert", "Conversion step");
+    AddApplication("Smoothing", "resmoothing", "Second smoothing step");
+
+    ShareParameter("in", "smoothing.in");
+    ShareParameter("out", "convert.out");
+    AddRAMParameter();
+
+    GetInternalApplication("smoothing")->SetParameterString("type", "mean");
+    GetInternalApplication("resmoothing")->SetParameterString("type", "mean");
+    GetInternalApplication("convert")->SetParameterString("type", "linear");
+
+    ConnectImage("convert.in", "smoothing.out");
+    ConnectImage("resmoothing.in", "smoothing.out");
+  }
+
+  void DoUpdateParameters() ITK_OVERRIDE
+  {}
+
+  void DoExecute() ITK_OVERRIDE
+  {
+    std::vector<std::string> keys;
+    keys.push_back("convert");
+    keys.push_back("resmoothing");
+    ExecuteChain(keys);
+  }
+};
+
+}
+}
+
+int otbWrapperCompositeApplicationChainTest(int argc, char * argv[])
+{
+  if(argc<5)
+    {
+    std::cerr<<"Usage: "<<argv[0]<<" application_path infname outfname tmpdir"<<std::endl;
+    return EXIT_FAILURE;
+    }
+
+  typedef otb::Wrapper::CompositeChainTestApplication ApplicationType;
+
+  otb::Wrapper::ApplicationRegistry::SetApplicationPath(argv[1]);
+
+  ApplicationType::Pointer app = ApplicationType::New();
+  app->Init();
+  app->SetTemporaryDirectory(argv[4]);
+  app->SetParameterString("in", argv[2]);
+  app->SetParameterString("out", argv[3]);
+  app->SetParameterString("ram", "128");
+  app->Execute();
+
+  // The multi-pass input of Convert is read from a persistent pass
+  const std::string persistentFile = app->GetChainApplication("convert")->GetParameterString("in");
+  if (persistentFile.empty() || !itksys::SystemTools::FileExists(persistentFile.c_str()))
+    {
+    std::cout << "No persistent pass for convert.in" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (!app->GetChainApplication("resmoothing")->GetParameterString("in").empty())
+    {
+    std::cout << "resmoothing.in is not connected in memory" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The two smoothings share a pipeline, the conversion has its own
+  if (app->GetChainApplication("smoothing")->GetParameterInt("ram") != 64 ||
+      app->GetChainApplication("resmoothing")->GetParameterInt("ram") != 64 ||
+      app->GetChainApplication("convert")->GetParameterInt("ram") != 128)
+    {
+    std::cout << "Wrong RAM split" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Execute the chain again, and remove the temporary files once the
+  // output is written
+  app->ExecuteAndWriteOutput();
+  if (itksys::SystemTools::FileExists(persistentFile.c_str()))
+    {
+    std::cout << "Temporary file " << persistentFile << " not removed" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (!itksys::SystemTools::FileExists(argv[3]))
+    {
+    std::cout << "Output " << argv[3] << " not written" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The temporary files of a chain executed without writing are removed
+  // with the application
+  app->Execute();
+  const std::string lastPersistentFile = app->GetChainApplication("convert")->GetParameterString("in");
+  if (!itksys::SystemTools::FileExists(lastPersistentFile.c_str()))
+    {
+    std::cout << "No persistent pass for convert.in" << std::endl;
+    return EXIT_FAILURE;
+    }
+  app = ITK_NULLPTR;
+  if (itksys::SystemTools::FileExists(lastPersistentFile.c_str()))
+    {
+    std::cout << "Temporary file " << lastPersistentFile << " not removed by the destructor" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER)
+#pragma warning ( disable : 4786 )
+#endif
+
+#include "otbWrapperImageTileStreamer.h"
+#include "otbImageFileReader.h"
+#include "itkImageRegionConstIterator.h"
+
+int otbWrapperImageTileStreamerTest(int itkNotUsed(argc), char* argv[])
+{
+  typedef otb::Wrapper::FloatVectorImageType ImageType;
+  typedef otb::ImageFileReader<ImageType>    ReaderType;
+  typedef otb::Wrapper::ImageTileStreamer    StreamerType;
+  typedef StreamerType::RegionType           RegionType;
+
+  const unsigned int tileDimension = atoi(argv[2]);
+
+  // Reference : the whole image
+  ReaderType::Pointer referenceReader = ReaderType::New();
+  referenceReader->SetFileName(argv[1]);
+  referenceReader->Update();
+  ImageType::Pointer reference = referenceReader->GetOutput();
+  const unsigned int nbBands = reference->GetNumberOfComponentsPerPixel();
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  StreamerType::Pointer streamer = StreamerType::New();
+  streamer->SetImage(reader->GetOutput());
+  streamer->SetTileDimension(tileDimension);
+  const unsigned int nbTiles = streamer->PrepareTiles();
+  if (nbTiles < 2 || nbTiles != streamer->GetNumberOfTiles())
+    {
+    std::cout << "Image split in " << nbTiles << " tiles" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (streamer->GetPixelType() != otb::Wrapper::ImagePixelType_float)
+    {
+    std::cout << "Wrong pixel type" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  unsigned long nbPixels = 0;
+  for (unsigned int tile = 0; tile < nbTiles; ++tile)
+    {
+    streamer->GenerateTile(tile);
+    const RegionType region = streamer->GetTileRegion(tile);
+    const RegionType bufferedRegion = reader->GetOutput()->GetBufferedRegion();
+    if (!bufferedRegion.IsInside(region))
+      {
+      std::cout << "Tile " << region << " not in the buffered region " << bufferedRegion << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    // Read the tile from the raw buffer, as the Python bindings do
+    const float* buffer = static_cast<const float*>(streamer->GetBufferPointer());
+    itk::ImageRegionConstIterator<ImageType> it(reference, region);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+      {
+      const ImageType::IndexType index = it.GetIndex();
+      const float* pixel = buffer + nbBands *
+        ((index[1] - bufferedRegion.GetIndex()[1]) * bufferedRegion.GetSize()[0] + (index[0] - bufferedRegion.GetIndex()[0]));
+      for (unsigned int band = 0; band < nbBands; ++band)
+        {
+        if (pixel[band] != it.Get()[band])
+          {
+          std::cout << "Wrong value at " << index << " band " << band << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    nbPixels += region.GetNumberOfPixels();
+    }
+
+  // The tiles do not overlap, so they cover the whole image
+  if (nbPixels != reference->GetLargestPossibleRegion().GetNumberOfPixels())
+    {
+    std::cout << "The tiles cover " << nbPixels << " pixels" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
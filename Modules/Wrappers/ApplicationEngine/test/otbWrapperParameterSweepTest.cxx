@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER)
+#pragma warning ( disable : 4786 )
+#endif
+
+#include "otbWrapperParameterSweep.h"
+#include "otbWrapperApplicationRegistry.h"
+#include "itksys/SystemTools.hxx"
+
+int otbWrapperParameterSweepTest(int argc, char * argv[])
+{
+  if(argc<6)
+    {
+    std::cerr<<"Usage: "<<argv[0]<<" application_path infname outfname1 outfname2 reffname"<<std::endl;
+    return EXIT_FAILURE;
+    }
+
+  typedef otb::Wrapper::ParameterSweep SweepType;
+
+  otb::Wrapper::ApplicationRegistry::SetApplicationPath(argv[1]);
+
+  // Two mean smoothings of the same image
+  SweepType::Pointer sweep = SweepType::New();
+  sweep->SetApplicationName("Smoothing");
+  sweep->SetCommonParameter("in", argv[2]);
+  sweep->SetCommonParameter("type", "mean");
+
+  SweepType::ParameterSetType parameters;
+  parameters["type.mean.radius"].push_back("2");
+  parameters["out"].push_back(argv[3]);
+  sweep->AddParameterSet(parameters);
+
+  parameters.clear();
+  parameters["type.mean.radius"].push_back("4");
+  parameters["out"].push_back(argv[4]);
+  parameters["out"].push_back("float");
+  sweep->AddParameterSet(parameters);
+
+  sweep->ExecuteAndWriteOutput();
+
+  // The second variant reads the input from the reader of the first
+  otb::Wrapper::InputImageParameter* in1 =
+    dynamic_cast<otb::Wrapper::InputImageParameter*>(sweep->GetVariant(0)->GetParameterByKey("in"));
+  otb::Wrapper::InputImageParameter* in2 =
+    dynamic_cast<otb::Wrapper::InputImageParameter*>(sweep->GetVariant(1)->GetParameterByKey("in"));
+  if (in1->GetImageBase() == ITK_NULLPTR || in1->GetImageBase() != in2->GetImageBase())
+    {
+    std::cout << "The input image is not shared by the variants" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (!itksys::SystemTools::FileExists(argv[3]) || !itksys::SystemTools::FileExists(argv[4]))
+    {
+    std::cout << "Outputs not written" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Reference for the second variant, compared by the test driver
+  otb::Wrapper::Application::Pointer reference = otb::Wrapper::ApplicationRegistry::CreateApplication("Smoothing");
+  reference->SetParameterString("in", argv[2]);
+  reference->SetParameterString("type", "mean");
+  reference->SetParameterString("type.mean.radius", "4");
+  reference->SetParameterString("out", argv[5]);
+  reference->ExecuteAndWriteOutput();
+
+  return EXIT_SUCCESS;
+}
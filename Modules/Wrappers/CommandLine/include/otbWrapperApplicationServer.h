@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbWrapperApplicationServer_h
+#define otbWrapperApplicationServer_h
+
+#include "otbWrapperApplication.h"
+
+#include <atomic>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace otb
+{
+namespace Wrapper
+{
+
+/** \class ApplicationServer
+ *  \brief Run command line jobs received on a local Unix socket.
+ *
+ * Launching an application from the command line loads its module,
+ * registers the GDAL and OSSIM drivers and sets up the elevation
+ * before any processing. For many small jobs, this startup dominates.
+ * The server is a long-running process running the jobs sent by
+ * SubmitJob() with a CommandLineLauncher each: the modules of the
+ * applications already run stay loaded, and the drivers and the
+ * elevation handler are set up once.
+ *
+ * A job is the expression given to the command line launcher
+ * (module_name [MODULEPATH] [arguments]), or -inxml followed by an
+ * application XML file and optionally the MODULEPATH. The name of the
+ * application is then read from the XML file.
+ *
+ * Serve() first warms up: it registers the GDAL drivers, sets up the
+ * elevation handler from the configuration of OTB and loads the
+ * PreloadedApplications. It then forks NumberOfConcurrentJobs worker
+ * processes, which inherit this state. Each worker accepts a connection
+ * when it is free and runs its job, so that up to NumberOfConcurrentJobs
+ * jobs run at once without sharing the projection and elevation
+ * handlers, which are not thread-safe. Each worker gets its share of
+ * AvailableRAM, given to the applications as the default value of their
+ * ram parameter, and of NumberOfThreads.
+ *
+ * The log of the application is sent back to the client, followed by
+ * the status of the job. The error messages of the launcher itself
+ * (unknown parameter, missing value...) are written on the standard
+ * error of the server. The progress is not reported, unless the job
+ * asks for it with -progress.
+ *
+ * The protocol is a line per argument of the job, ended by an empty
+ * line; the answer is the log, ended by a line "OTB_JOB_STATUS <code>".
+ *
+ * \sa CommandLineLauncher
+ *
+ * \ingroup OTBCommandLine
+ */
+class ITK_ABI_EXPORT ApplicationServer : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef ApplicationServer             Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Defining ::New() static method */
+  itkNewMacro(Self);
+
+  /** RTTI support */
+  itkTypeMacro(ApplicationServer, itk::Object);
+
+  /** Set/Get the path of the socket */
+  itkSetStringMacro(SocketPath);
+  itkGetStringMacro(SocketPath);
+
+  /** Set/Get the number of worker processes, i.e. the maximum number
+   * of jobs run at once */
+  itkSetMacro(NumberOfConcurrentJobs, unsigned int);
+  itkGetConstMacro(NumberOfConcurrentJobs, unsigned int);
+
+  /** Set/Get the RAM shared by the workers, in MB. 0 means the
+   * maximum RAM hint of the configuration. */
+  itkSetMacro(AvailableRAM, unsigned int);
+  itkGetConstMacro(AvailableRAM, unsigned int);
+
+  /** Set/Get the number of threads shared by the workers. 0 means the
+   * default number of threads of ITK. */
+  itkSetMacro(NumberOfThreads, unsigned int);
+  itkGetConstMacro(NumberOfThreads, unsigned int);
+
+  /** Set/Get the applications loaded before forking the workers */
+  void SetPreloadedApplications(const std::vector<std::string>& names)
+  {
+    m_PreloadedApplications = names;
+    this->Modified();
+  }
+  const std::vector<std::string>& GetPreloadedApplications() const
+  {
+    return m_PreloadedApplications;
+  }
+
+  /** Get the number of jobs run so far by the workers, successful or not */
+  unsigned int GetNumberOfCompletedJobs() const
+  {
+    return m_NumberOfCompletedJobs;
+  }
+
+  /** Listen on the socket and run the jobs received until Stop() is
+   * called. Return false if the socket can not be created. */
+  bool Serve();
+
+  /** Make Serve() return once the running jobs are completed. It only
+   * performs async-signal-safe calls, so that it may be called from a
+   * signal handler. */
+  void Stop();
+
+  /** Send a job to the server listening on socketPath, and wait for
+   * its completion. The log of the job is written to log. Return the
+   * exit status of the job (EXIT_FAILURE if the server can not be
+   * reached). */
+  static int SubmitJob(const std::string& socketPath, const std::vector<std::string>& job, std::ostream& log);
+
+protected:
+  /** Constructor */
+  ApplicationServer();
+
+  /** Destructor */
+  ~ApplicationServer() ITK_OVERRIDE;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+  /** Run a job, writing the log of the application to log. The job is
+   * given the RAM and the number of threads of the worker. */
+  bool RunJob(std::vector<std::string> job, std::ostream& log);
+
+private:
+  ApplicationServer(const ApplicationServer &); //purposely not implemented
+  void operator =(const ApplicationServer&); //purposely not implemented
+
+  /** Register the drivers, set up the elevation handler and load the
+   * preloaded applications, before forking the workers */
+  void WarmUp();
+
+  /** Fork a worker process, return its pid (-1 on error). The worker
+   * writes a byte to completedJobsPipe per completed job. */
+  pid_t StartWorker(int& completedJobsPipe);
+
+  /** Accept and handle connections until the server stops. Run in the
+   * worker processes. */
+  void RunWorker(int completedJobsPipe);
+
+  /** Read a job, run it and send its log and status back */
+  void HandleConnection(int connection);
+
+  std::string                  m_SocketPath;
+  unsigned int                 m_NumberOfConcurrentJobs;
+  unsigned int                 m_AvailableRAM;
+  unsigned int                 m_NumberOfThreads;
+  std::vector<std::string>     m_PreloadedApplications;
+
+  int                          m_ListenSocket;
+  /** Written by Stop() to wake Serve() up */
+  int                          m_StopPipe[2];
+  /** Closed by the parent to make the idle workers exit */
+  int                          m_WorkersStopPipe[2];
+  std::atomic<bool>            m_Stopping;
+  std::atomic<unsigned int>    m_NumberOfCompletedJobs;
+
+  /** RAM and threads of the jobs run by a worker */
+  unsigned int                 m_WorkerRAM;
+  unsigned int                 m_WorkerNumberOfThreads;
+
+  /** Applications kept alive so that their modules stay loaded */
+  std::map<std::string, Application::Pointer> m_LoadedApplications;
+};
+
+} // end namespace Wrapper
+} // end namespace otb
+
+#endif // otbWrapperApplicationServer_h
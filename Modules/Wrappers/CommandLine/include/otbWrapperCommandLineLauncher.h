@@ -117,6 +117,10 @@ public:
   /** Performs specific action for testing environment */
   void LoadTestEnv();
 
+  /** Set the stream receiving the log of the application (std::cout
+   * by default) */
+  void SetLogStream(std::ostream& stream);
+
 protected:
   /** Constructor */
   CommandLineLauncher();
@@ -167,6 +171,9 @@ protected:
   /** Returns the width of the longest key (in number of chars) */
   unsigned int GetMaxKeySize() const;
 
+  /** Write the profile of the filters if asked with -profile */
+  void WriteProfile();
+
 private:
 
   CommandLineLauncher(const CommandLineLauncher &); //purposely not implemented
@@ -185,6 +192,7 @@ private:
 
   AddProcessCommandType::Pointer    m_AddProcessCommand;
   bool                              m_ReportProgress;
+  std::string                       m_ProfileFileName;
 
 }; //end class
 
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperApplicationServer.h"
+#include "otbWrapperCommandLineLauncher.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+otb::Wrapper::ApplicationServer * ServerInstance = ITK_NULLPTR;
+
+extern "C" void StopServer(int)
+{
+  if (ServerInstance != ITK_NULLPTR)
+    {
+    ServerInstance->Stop();
+    }
+}
+
+std::string CleanWord(const std::string & word)
+{
+  std::string res("");
+  // Suppress whitespace characters at the beginning and ending of the string
+  std::string::size_type cleanStart = word.find_first_not_of(" \t");
+  std::string::size_type cleanEnd = word.find_last_not_of(" \t\f\v\n\r");
+  // cleanStart == npos implies cleanEnd == npos
+  if (cleanEnd != std::string::npos)
+    {
+    res = word.substr(cleanStart, cleanEnd - cleanStart + 1);
+    }
+  return res;
+}
+
+void ShowUsage(char* argv[])
+{
+  std::cerr << "Usage: " << argv[0] << " -socket path [-jobs nb] [-ram MB] [-threads nb] [-preload module_name]..." << std::endl;
+  std::cerr << "       " << argv[0] << " -socket path -submit module_name [MODULEPATH] [arguments]" << std::endl;
+  std::cerr << "       " << argv[0] << " -socket path -submit -inxml file.xml [MODULEPATH]" << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  std::string socketPath;
+  unsigned int nbJobs = 1;
+  unsigned int ram = 0;
+  unsigned int nbThreads = 0;
+  std::vector<std::string> preloaded;
+  std::vector<std::string> job;
+  bool submit = false;
+
+  for (int i = 1; i < argc; ++i)
+    {
+    if (submit)
+      {
+      const std::string arg = CleanWord(argv[i]);
+      if (!arg.empty())
+        {
+        job.push_back(arg);
+        }
+      }
+    else if (strcmp(argv[i], "-submit") == 0)
+      {
+      submit = true;
+      }
+    else if (i + 1 < argc && strcmp(argv[i], "-socket") == 0)
+      {
+      socketPath = argv[++i];
+      }
+    else if (i + 1 < argc && strcmp(argv[i], "-jobs") == 0)
+      {
+      nbJobs = atoi(argv[++i]);
+      }
+    else if (i + 1 < argc && strcmp(argv[i], "-ram") == 0)
+      {
+      ram = atoi(argv[++i]);
+      }
+    else if (i + 1 < argc && strcmp(argv[i], "-threads") == 0)
+      {
+      nbThreads = atoi(argv[++i]);
+      }
+    else if (i + 1 < argc && strcmp(argv[i], "-preload") == 0)
+      {
+      preloaded.push_back(CleanWord(argv[++i]));
+      }
+    else
+      {
+      ShowUsage(argv);
+      return EXIT_FAILURE;
+      }
+    }
+
+  if (socketPath.empty() || (submit && job.empty()))
+    {
+    ShowUsage(argv);
+    return EXIT_FAILURE;
+    }
+
+  if (submit)
+    {
+    return otb::Wrapper::ApplicationServer::SubmitJob(socketPath, job, std::cout);
+    }
+
+  otb::Wrapper::ApplicationServer::Pointer server = otb::Wrapper::ApplicationServer::New();
+  server->SetSocketPath(socketPath);
+  server->SetNumberOfConcurrentJobs(nbJobs);
+  server->SetAvailableRAM(ram);
+  server->SetNumberOfThreads(nbThreads);
+  server->SetPreloadedApplications(preloaded);
+
+  ServerInstance = server.GetPointer();
+  std::signal(SIGINT, StopServer);
+  std::signal(SIGTERM, StopServer);
+
+  std::cout << "Waiting for jobs on " << socketPath << std::endl;
+  const bool success = server->Serve();
+  ServerInstance = ITK_NULLPTR;
+
+  std::cout << server->GetNumberOfCompletedJobs() << " jobs run" << std::endl;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,663 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperApplicationServer.h"
+#include "otbWrapperCommandLineLauncher.h"
+#include "otbWrapperApplicationRegistry.h"
+#include "otb_tinyxml.h"
+#include "otbConfigurationManager.h"
+#include "otbDEMHandler.h"
+#include "otbGDALDriverManagerWrapper.h"
+
+#include "itkMultiThreader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace otb
+{
+namespace Wrapper
+{
+
+namespace
+{
+const char * JobStatusTag = "OTB_JOB_STATUS ";
+
+/** Write the whole buffer, return false on error */
+bool SendAll(int socket, const std::string& buffer)
+{
+  size_t sent = 0;
+  while (sent < buffer.size())
+    {
+    const ssize_t n = ::send(socket, buffer.data() + sent, buffer.size() - sent, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR)
+      {
+      continue;
+      }
+    if (n <= 0)
+      {
+      return false;
+      }
+    sent += static_cast<size_t>(n);
+    }
+  return true;
+}
+
+/** Fill the address of a Unix socket, return false if the path is too long */
+bool MakeAddress(const std::string& path, sockaddr_un& address)
+{
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(address.sun_path))
+    {
+    return false;
+    }
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  return true;
+}
+
+/** Get the name of the application described by an XML file */
+std::string GetApplicationNameFromXML(const std::string& filename)
+{
+  TiXmlDocument doc(filename.c_str());
+  if (!doc.LoadFile(TIXML_ENCODING_UTF8))
+    {
+    return std::string();
+    }
+  TiXmlElement * nameElement = TiXmlHandle(&doc).FirstChild("OTB").FirstChild("application").FirstChild("name").Element();
+  if (nameElement == ITK_NULLPTR || nameElement->GetText() == ITK_NULLPTR)
+    {
+    return std::string();
+    }
+  return nameElement->GetText();
+}
+}
+
+ApplicationServer::ApplicationServer()
+  : m_SocketPath(),
+    m_NumberOfConcurrentJobs(1),
+    m_AvailableRAM(0),
+    m_NumberOfThreads(0),
+    m_PreloadedApplications(),
+    m_ListenSocket(-1),
+    m_Stopping(false),
+    m_NumberOfCompletedJobs(0),
+    m_WorkerRAM(0),
+    m_WorkerNumberOfThreads(0)
+{
+  // Stop() wakes Serve() up through this pipe
+  m_StopPipe[0] = m_StopPipe[1] = -1;
+  if (::pipe(m_StopPipe) == 0)
+    {
+    for (unsigned int i = 0; i < 2; ++i)
+      {
+      ::fcntl(m_StopPipe[i], F_SETFL, ::fcntl(m_StopPipe[i], F_GETFL) | O_NONBLOCK);
+      ::fcntl(m_StopPipe[i], F_SETFD, FD_CLOEXEC);
+      }
+    }
+  m_WorkersStopPipe[0] = m_WorkersStopPipe[1] = -1;
+}
+
+ApplicationServer::~ApplicationServer()
+{
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+    if (m_StopPipe[i] >= 0)
+      {
+      ::close(m_StopPipe[i]);
+      }
+    }
+  m_LoadedApplications.clear();
+  ApplicationRegistry::CleanRegistry();
+}
+
+bool ApplicationServer::Serve()
+{
+  sockaddr_un address;
+  if (!MakeAddress(m_SocketPath, address))
+    {
+    itkWarningMacro(<< "Invalid socket path: " << m_SocketPath);
+    return false;
+    }
+
+  // Replace the socket left by a previous server, but nothing else
+  struct stat fileStat;
+  if (::lstat(m_SocketPath.c_str(), &fileStat) == 0)
+    {
+    if (!S_ISSOCK(fileStat.st_mode))
+      {
+      itkWarningMacro(<< m_SocketPath << " exists and is not a socket");
+      return false;
+      }
+    ::unlink(m_SocketPath.c_str());
+    }
+
+  if (m_StopPipe[0] < 0)
+    {
+    itkWarningMacro(<< "Can not create the pipe waking the server up");
+    return false;
+    }
+
+  m_ListenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (m_ListenSocket < 0)
+    {
+    itkWarningMacro(<< "Can not create a socket: " << std::strerror(errno));
+    return false;
+    }
+  // The jobs run with the rights of the server: the socket is created
+  // accessible to its owner only
+  const mode_t previousMask = ::umask(S_IXUSR | S_IRWXG | S_IRWXO);
+  const bool bound = (::bind(m_ListenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+  ::umask(previousMask);
+  if (!bound || ::listen(m_ListenSocket, SOMAXCONN) != 0)
+    {
+    itkWarningMacro(<< "Can not listen on " << m_SocketPath << ": " << std::strerror(errno));
+    ::close(m_ListenSocket);
+    m_ListenSocket = -1;
+    return false;
+    }
+
+  // The workers wait on the socket together: the ones losing the race
+  // for a connection get EAGAIN instead of blocking
+  ::fcntl(m_ListenSocket, F_SETFL, ::fcntl(m_ListenSocket, F_GETFL) | O_NONBLOCK);
+  ::fcntl(m_ListenSocket, F_SETFD, FD_CLOEXEC);
+
+  if (::pipe(m_WorkersStopPipe) != 0)
+    {
+    itkWarningMacro(<< "Can not create the pipe stopping the workers: " << std::strerror(errno));
+    ::close(m_ListenSocket);
+    m_ListenSocket = -1;
+    ::unlink(m_SocketPath.c_str());
+    return false;
+    }
+  ::fcntl(m_WorkersStopPipe[0], F_SETFD, FD_CLOEXEC);
+  ::fcntl(m_WorkersStopPipe[1], F_SETFD, FD_CLOEXEC);
+
+  // Forget the calls to Stop() made before serving
+  char wakeUp;
+  while (::read(m_StopPipe[0], &wakeUp, 1) > 0)
+    {
+    }
+
+  // Share the RAM and the threads between the workers
+  const unsigned int nbWorkers = std::max(m_NumberOfConcurrentJobs, 1U);
+  const unsigned int ram = m_AvailableRAM > 0 ? m_AvailableRAM
+    : static_cast<unsigned int>(ConfigurationManager::GetMaxRAMHint());
+  const unsigned int nbThreads = m_NumberOfThreads > 0 ? m_NumberOfThreads
+    : static_cast<unsigned int>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
+  m_WorkerRAM = std::max(ram / nbWorkers, 1U);
+  m_WorkerNumberOfThreads = std::max(nbThreads / nbWorkers, 1U);
+
+  this->WarmUp();
+
+  m_Stopping = false;
+  bool success = true;
+  std::vector<pid_t> workers(nbWorkers, -1);
+  std::vector<pollfd> events(nbWorkers + 1);
+  for (unsigned int i = 0; i < events.size(); ++i)
+    {
+    events[i].fd = -1;
+    events[i].events = POLLIN;
+    }
+  events[0].fd = m_StopPipe[0];
+  for (unsigned int i = 0; i < nbWorkers; ++i)
+    {
+    workers[i] = this->StartWorker(events[i + 1].fd);
+    if (workers[i] < 0)
+      {
+      success = false;
+      m_Stopping = true;
+      break;
+      }
+    }
+
+  // Count the jobs completed by the workers, and replace the workers
+  // which exited
+  while (!m_Stopping)
+    {
+    for (unsigned int i = 0; i < events.size(); ++i)
+      {
+      events[i].revents = 0;
+      }
+    if (::poll(&events[0], events.size(), -1) < 0)
+      {
+      if (errno == EINTR)
+        {
+        continue;
+        }
+      break;
+      }
+    if (events[0].revents != 0)
+      {
+      // Woken up by Stop()
+      break;
+      }
+    for (unsigned int i = 0; i < nbWorkers; ++i)
+      {
+      if (events[i + 1].revents == 0)
+        {
+        continue;
+        }
+      char completed[64];
+      const ssize_t n = ::read(events[i + 1].fd, completed, sizeof(completed));
+      if (n > 0)
+        {
+        m_NumberOfCompletedJobs += static_cast<unsigned int>(n);
+        }
+      else if (n == 0 || errno != EINTR)
+        {
+        ::close(events[i + 1].fd);
+        ::waitpid(workers[i], ITK_NULLPTR, 0);
+        itkWarningMacro(<< "Worker " << workers[i] << " exited, starting a new one");
+        workers[i] = this->StartWorker(events[i + 1].fd);
+        }
+      }
+    }
+
+  // The idle workers exit when this pipe is closed, the other ones once
+  // their job is completed
+  ::close(m_WorkersStopPipe[1]);
+  for (unsigned int i = 0; i < nbWorkers; ++i)
+    {
+    if (workers[i] < 0)
+      {
+      continue;
+      }
+    char completed[64];
+    ssize_t n = 0;
+    while ((n = ::read(events[i + 1].fd, completed, sizeof(completed))) != 0)
+      {
+      if (n > 0)
+        {
+        m_NumberOfCompletedJobs += static_cast<unsigned int>(n);
+        }
+      else if (errno != EINTR)
+        {
+        break;
+        }
+      }
+    ::close(events[i + 1].fd);
+    ::waitpid(workers[i], ITK_NULLPTR, 0);
+    }
+  ::close(m_WorkersStopPipe[0]);
+  m_WorkersStopPipe[0] = m_WorkersStopPipe[1] = -1;
+
+  ::close(m_ListenSocket);
+  m_ListenSocket = -1;
+  ::unlink(m_SocketPath.c_str());
+  return success;
+}
+
+void ApplicationServer::Stop()
+{
+  m_Stopping = true;
+  if (m_StopPipe[1] >= 0)
+    {
+    const char wakeUp = 0;
+    const ssize_t written = ::write(m_StopPipe[1], &wakeUp, 1);
+    (void) written;
+    }
+}
+
+void ApplicationServer::WarmUp()
+{
+  // Register the GDAL drivers
+  GDALDriverManagerWrapper::GetInstance();
+
+  // Set up the elevation handler with the configuration of OTB
+  DEMHandler::Pointer demHandler = DEMHandler::Instance();
+  const std::string geoidFile = ConfigurationManager::GetGeoidFile();
+  if (!geoidFile.empty())
+    {
+    demHandler->OpenGeoidFile(geoidFile);
+    }
+  const std::string demDirectory = ConfigurationManager::GetDEMDirectory();
+  if (!demDirectory.empty() && demHandler->IsValidDEMDirectory(demDirectory.c_str()))
+    {
+    demHandler->OpenDEMDirectory(demDirectory);
+    }
+
+  for (std::vector<std::string>::const_iterator it = m_PreloadedApplications.begin();
+       it != m_PreloadedApplications.end();
+       ++it)
+    {
+    const Application::Pointer application = ApplicationRegistry::CreateApplication(*it);
+    if (application.IsNull())
+      {
+      itkWarningMacro(<< "Can not load the application " << *it);
+      continue;
+      }
+    m_LoadedApplications[*it] = application;
+    }
+}
+
+pid_t ApplicationServer::StartWorker(int& completedJobsPipe)
+{
+  completedJobsPipe = -1;
+  int completedPipe[2];
+  if (::pipe(completedPipe) != 0)
+    {
+    itkWarningMacro(<< "Can not create the pipe of a worker: " << std::strerror(errno));
+    return -1;
+    }
+
+  const pid_t pid = ::fork();
+  if (pid < 0)
+    {
+    itkWarningMacro(<< "Can not start a worker: " << std::strerror(errno));
+    ::close(completedPipe[0]);
+    ::close(completedPipe[1]);
+    return -1;
+    }
+  if (pid == 0)
+    {
+    // The worker must not hold the pipe closed to stop it
+    ::close(completedPipe[0]);
+    ::close(m_WorkersStopPipe[1]);
+    this->RunWorker(completedPipe[1]);
+    std::cout.flush();
+    std::cerr.flush();
+    ::_exit(EXIT_SUCCESS);
+    }
+
+  ::close(completedPipe[1]);
+  ::fcntl(completedPipe[0], F_SETFD, FD_CLOEXEC);
+  completedJobsPipe = completedPipe[0];
+  return pid;
+}
+
+void ApplicationServer::RunWorker(int completedJobsPipe)
+{
+  itk::MultiThreader::SetGlobalDefaultNumberOfThreads(m_WorkerNumberOfThreads);
+
+  while (!m_Stopping)
+    {
+    pollfd events[2];
+    events[0].fd = m_ListenSocket;
+    events[0].events = POLLIN;
+    events[0].revents = 0;
+    events[1].fd = m_WorkersStopPipe[0];
+    events[1].events = POLLIN;
+    events[1].revents = 0;
+    if (::poll(events, 2, -1) < 0)
+      {
+      if (errno == EINTR)
+        {
+        continue;
+        }
+      break;
+      }
+    if (events[1].revents != 0)
+      {
+      // The server stops
+      break;
+      }
+    if ((events[0].revents & POLLIN) == 0)
+      {
+      // The socket is unusable
+      break;
+      }
+
+    const int connection = ::accept(m_ListenSocket, ITK_NULLPTR, ITK_NULLPTR);
+    if (connection < 0)
+      {
+      if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+        // Another worker took the connection
+        continue;
+        }
+      break;
+      }
+    ::fcntl(connection, F_SETFL, ::fcntl(connection, F_GETFL) & ~O_NONBLOCK);
+    this->HandleConnection(connection);
+
+    const char completed = 1;
+    const ssize_t written = ::write(completedJobsPipe, &completed, 1);
+    (void) written;
+    }
+  ::close(completedJobsPipe);
+}
+
+void ApplicationServer::HandleConnection(int connection)
+{
+  // Read the arguments, one per line, up to an empty line
+  std::vector<std::string> job;
+  std::string line;
+  bool complete = false;
+  char buffer[4096];
+  while (!complete)
+    {
+    const ssize_t n = ::recv(connection, buffer, sizeof(buffer), 0);
+    if (n < 0 && errno == EINTR)
+      {
+      continue;
+      }
+    if (n <= 0)
+      {
+      break;
+      }
+    for (ssize_t i = 0; i < n && !complete; ++i)
+      {
+      if (buffer[i] != '\n')
+        {
+        line.push_back(buffer[i]);
+        }
+      else if (line.empty())
+        {
+        complete = true;
+        }
+      else
+        {
+        job.push_back(line);
+        line.clear();
+        }
+      }
+    }
+
+  std::ostringstream log;
+  bool success = false;
+  if (!complete)
+    {
+    log << "ERROR: Incomplete job received." << std::endl;
+    }
+  else
+    {
+    try
+      {
+      success = this->RunJob(job, log);
+      }
+    catch (std::exception& err)
+      {
+      log << "ERROR: " << err.what() << std::endl;
+      }
+    catch (...)
+      {
+      log << "ERROR: Caught unknown exception during job execution." << std::endl;
+      }
+    }
+  log << JobStatusTag << (success ? EXIT_SUCCESS : EXIT_FAILURE) << "\n";
+  SendAll(connection, log.str());
+  ::close(connection);
+}
+
+bool ApplicationServer::RunJob(std::vector<std::string> job, std::ostream& log)
+{
+  if (job.empty())
+    {
+    log << "ERROR: Empty job." << std::endl;
+    return false;
+    }
+
+  // An XML file alone gives the name of the application
+  if (job[0] == "-inxml")
+    {
+    const std::string name = job.size() > 1 ? GetApplicationNameFromXML(job[1]) : std::string();
+    if (name.empty())
+      {
+      log << "ERROR: Can not read the application name from the XML file." << std::endl;
+      return false;
+      }
+    // The module paths follow the XML file
+    std::vector<std::string> expression(1, name);
+    expression.insert(expression.end(), job.begin() + 2, job.end());
+    expression.push_back(job[0]);
+    expression.push_back(job[1]);
+    job = expression;
+    }
+
+  // The progress would be written on the output of the server
+  if (std::find(job.begin(), job.end(), "-progress") == job.end())
+    {
+    job.push_back("-progress");
+    job.push_back("false");
+    }
+
+  CommandLineLauncher::Pointer launcher = CommandLineLauncher::New();
+  launcher->SetLogStream(log);
+
+  if (!launcher->Load(job))
+    {
+    log << "ERROR: Can not load the application, see the log of the server." << std::endl;
+    return false;
+    }
+
+  // Keep an instance of the application, so that its module is not
+  // unloaded once the job is completed
+  const std::string name = job[0];
+  if (m_LoadedApplications.find(name) == m_LoadedApplications.end())
+    {
+    m_LoadedApplications[name] = ApplicationRegistry::CreateApplication(name);
+    }
+
+  // The RAM of the worker is the default value of the ram parameter
+  const Application::Pointer application = m_LoadedApplications[name];
+  if (m_WorkerRAM > 0 && application.IsNotNull()
+      && std::find(job.begin(), job.end(), "-ram") == job.end())
+    {
+    const std::vector<std::string> keys = application->GetParametersKeys();
+    if (std::find(keys.begin(), keys.end(), "ram") != keys.end())
+      {
+      std::ostringstream ram;
+      ram << m_WorkerRAM;
+      job.push_back("-ram");
+      job.push_back(ram.str());
+      if (!launcher->Load(job))
+        {
+        log << "ERROR: Can not load the application, see the log of the server." << std::endl;
+        return false;
+        }
+      }
+    }
+
+  return launcher->ExecuteAndWriteOutput();
+}
+
+int ApplicationServer::SubmitJob(const std::string& socketPath, const std::vector<std::string>& job, std::ostream& log)
+{
+  std::string request;
+  for (std::vector<std::string>::const_iterator it = job.begin(); it != job.end(); ++it)
+    {
+    if (it->empty() || it->find('\n') != std::string::npos)
+      {
+      log << "ERROR: Job arguments can not be empty or hold a new line." << std::endl;
+      return EXIT_FAILURE;
+      }
+    request += *it + "\n";
+    }
+  request += "\n";
+
+  sockaddr_un address;
+  if (!MakeAddress(socketPath, address))
+    {
+    log << "ERROR: Invalid socket path: " << socketPath << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const int connection = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (connection < 0
+      || ::connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+      || !SendAll(connection, request))
+    {
+    log << "ERROR: Can not send the job to " << socketPath << ": " << std::strerror(errno) << std::endl;
+    if (connection >= 0)
+      {
+      ::close(connection);
+      }
+    return EXIT_FAILURE;
+    }
+
+  std::string answer;
+  char buffer[4096];
+  while (true)
+    {
+    const ssize_t n = ::recv(connection, buffer, sizeof(buffer), 0);
+    if (n < 0 && errno == EINTR)
+      {
+      continue;
+      }
+    if (n <= 0)
+      {
+      break;
+      }
+    answer.append(buffer, static_cast<size_t>(n));
+    }
+  ::close(connection);
+
+  // The status is on the last line
+  const std::string::size_type statusPos = answer.rfind(JobStatusTag);
+  if (statusPos == std::string::npos)
+    {
+    log << answer;
+    log << "ERROR: The server did not send the status of the job." << std::endl;
+    return EXIT_FAILURE;
+    }
+  log << answer.substr(0, statusPos);
+  return std::atoi(answer.c_str() + statusPos + std::strlen(JobStatusTag));
+}
+
+void ApplicationServer::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Socket path: " << m_SocketPath << std::endl;
+  os << indent << "Number of concurrent jobs: " << m_NumberOfConcurrentJobs << std::endl;
+  os << indent << "Available RAM: " << m_AvailableRAM << std::endl;
+  os << indent << "Number of threads: " << m_NumberOfThreads << std::endl;
+  os << indent << "Number of preloaded applications: " << m_PreloadedApplications.size() << std::endl;
+  os << indent << "Number of completed jobs: " << m_NumberOfCompletedJobs << std::endl;
+}
+
+} // end namespace Wrapper
+} // end namespace otb
@@ -45,9 +45,11 @@
 
 #include "otbWrapperApplicationRegistry.h"
 #include "otbWrapperTypes.h"
+#include "otbImageBufferPool.h"
 #include <itksys/RegularExpression.hxx>
 #include <string>
 #include <iostream>
+#include <cstdlib>
 
 using std::string;
 
@@ -57,7 +59,7 @@ namespace Wrapper
 {
 
 CommandLineLauncher::CommandLineLauncher() :
-  /*m_Expression(""),*/m_VExpression(), m_WatcherList(), m_ReportProgress(true)
+  /*m_Expression(""),*/m_VExpression(), m_WatcherList(), m_ReportProgress(true), m_ProfileFileName()
 {
   m_Application = ITK_NULLPTR;
   m_Parser = CommandLineParser::New();
@@ -87,6 +89,11 @@ void CommandLineLauncher::DeleteWatcherList()
 }
 
 
+void CommandLineLauncher::SetLogStream(std::ostream& stream)
+{
+  m_LogOutput->SetStream(stream);
+}
+
 bool CommandLineLauncher::Load(const std::vector<std::string> &vexp)
 {
   m_VExpression = vexp;
@@ -131,6 +138,7 @@ bool CommandLineLauncher::Execute()
   if( m_Application->Execute() == 0 )
     {
     this->DisplayOutputParameters();
+    this->WriteProfile();
     return true;
     }
   else
@@ -149,6 +157,7 @@ bool CommandLineLauncher::ExecuteAndWriteOutput()
     if( m_Application->ExecuteAndWriteOutput() == 0 )
     {
       this->DisplayOutputParameters();
+      this->WriteProfile();
     }
     else
     {
@@ -382,6 +391,38 @@ CommandLineLauncher::ParamResultType CommandLineLauncher::LoadParameters()
     }
   }
 
+  // Check for the profile parameter
+  if (m_Parser->IsAttributExists("-profile", m_VExpression) == true)
+  {
+    std::vector<std::string> val = m_Parser->GetAttribut("-profile", m_VExpression);
+    if (val.size() == 1 && !val[0].empty())
+    {
+      m_ProfileFileName = val[0];
+      m_Application->SetProfiler(PipelineProfiler::New());
+    }
+    else
+    {
+      std::cerr << "ERROR: Invalid value for parameter -profile. It must be a file name." << std::endl;
+      return WRONGPARAMETERVALUE;
+    }
+  }
+
+  // Check for the number of concurrent pipelines
+  if (m_Parser->IsAttributExists("-pipelines", m_VExpression) == true)
+  {
+    std::vector<std::string> val = m_Parser->GetAttribut("-pipelines", m_VExpression);
+    const int nbPipelines = (val.size() == 1 ? atoi(val[0].c_str()) : 0);
+    if (nbPipelines > 0)
+    {
+      m_Application->SetNumberOfConcurrentPipelines(nbPipelines);
+    }
+    else
+    {
+      std::cerr << "ERROR: Invalid value for parameter -pipelines. It must be a positive integer." << std::endl;
+      return WRONGPARAMETERVALUE;
+    }
+  }
+
   const std::vector<std::string> appKeyList = m_Application->GetParametersKeys(true);
   // Loop over each parameter key declared in the application
   // FIRST PASS : set parameter values
@@ -669,6 +710,14 @@ void CommandLineLauncher::DisplayHelp(bool longHelp)
     bigKey.append(" ");
 
   std::cerr << "        -"<<bigKey<<" <boolean>        Report progress " << std::endl;
+  bigKey = "profile";
+  for(unsigned int i=0; i<maxKeySize-std::string("profile").size(); i++)
+    bigKey.append(" ");
+  std::cerr << "        -"<<bigKey<<" <string>         Write the profile of the filters (JSON, or CSV with a .csv extension)" << std::endl;
+  bigKey = "pipelines";
+  for(unsigned int i=0; i<maxKeySize-std::string("pipelines").size(); i++)
+    bigKey.append(" ");
+  std::cerr << "        -"<<bigKey<<" <int32>          Number of pipelines computing the output images at the same time" << std::endl;
   bigKey = "help";
   for(unsigned int i=0; i<maxKeySize-std::string("help").size(); i++)
     bigKey.append(" ");
@@ -925,6 +974,8 @@ bool CommandLineLauncher::CheckKeyValidity(std::string& refKey)
   std::vector<std::string> appKeyList = m_Application->GetParametersKeys(true);
   appKeyList.push_back("help");
   appKeyList.push_back("progress");
+  appKeyList.push_back("profile");
+  appKeyList.push_back("pipelines");
   appKeyList.push_back("testenv");
   appKeyList.push_back("version");
 
@@ -988,12 +1039,29 @@ void CommandLineLauncher::DisplayOutputParameters()
   std::cout << oss.str() << std::endl;
 }
 
+void CommandLineLauncher::WriteProfile()
+{
+  if (m_ProfileFileName.empty() || m_Application->GetProfiler() == ITK_NULLPTR)
+    {
+    return;
+    }
+
+  m_Application->GetProfiler()->Detach();
+  m_Application->GetProfiler()->WriteReport(m_ProfileFileName);
+  std::cout << "Profile of the filters written in " << m_ProfileFileName << std::endl;
+
+  if (ImageBufferPool::GetInstance().IsEnabled())
+    {
+    ImageBufferPool::GetInstance().PrintStatistics(std::cout);
+    }
+}
+
 unsigned int CommandLineLauncher::GetMaxKeySize() const
 {
   const std::vector<std::string> appKeyList = m_Application->GetParametersKeys(true);
   const unsigned int nbOfParam = appKeyList.size();
 
-  unsigned int maxKeySize = std::string("progress").size();
+  unsigned int maxKeySize = std::string("pipelines").size();
   
   for (unsigned int i = 0; i < nbOfParam; i++)
     {
@@ -24,9 +24,13 @@ void RegisterTests()
 {
   REGISTER_TEST(otbWrapperCommandLineLauncherNew);
   REGISTER_TEST(otbWrapperCommandLineLauncherTest);
+  REGISTER_TEST(otbWrapperCommandLineLauncherCheckProfile);
   REGISTER_TEST(otbWrapperCommandLineParserNew);
   REGISTER_TEST(otbWrapperCommandLineParserTest1);
   REGISTER_TEST(otbWrapperCommandLineParserTest2);
   REGISTER_TEST(otbWrapperCommandLineParserTest3);
   REGISTER_TEST(otbWrapperCommandLineParserTest4);
+#ifndef _WIN32
+  REGISTER_TEST(otbWrapperApplicationServerTest);
+#endif
 }
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperApplicationServer.h"
+#include "otbWrapperApplicationRegistry.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+
+namespace
+{
+/** Copy of the job writing its output image to another file */
+std::vector<std::string> RenameOutput(const std::vector<std::string>& job, const std::string& suffix)
+{
+  std::vector<std::string> renamed(job);
+  std::vector<std::string>::iterator out = std::find(renamed.begin(), renamed.end(), "-out");
+  if (out != renamed.end() && out + 1 != renamed.end())
+    {
+    const std::string fileName = *(out + 1);
+    const std::string extension = itksys::SystemTools::GetFilenameLastExtension(fileName);
+    *(out + 1) = fileName.substr(0, fileName.size() - extension.size()) + suffix + extension;
+    }
+  return renamed;
+}
+}
+
+int otbWrapperApplicationServerTest(int argc, char* argv[])
+{
+  typedef otb::Wrapper::ApplicationServer ServerType;
+
+  const std::string socketPath(argv[1]);
+  std::vector<std::string> job;
+  for (int i = 2; i < argc; i++)
+    {
+    job.push_back(std::string(argv[i]));
+    }
+
+  ServerType::Pointer server = ServerType::New();
+  server->SetSocketPath(socketPath);
+  server->SetNumberOfConcurrentJobs(2);
+
+  // The module is loaded once, before the workers are started
+  if (job.size() > 1 && job[1][0] != '-')
+    {
+    otb::Wrapper::ApplicationRegistry::AddApplicationPath(job[1]);
+    }
+  server->SetPreloadedApplications(std::vector<std::string>(1, job[0]));
+
+  bool served = false;
+  std::thread serverThread([&server, &served] { served = server->Serve(); });
+
+  // Wait for the socket
+  for (unsigned int i = 0; i < 100 && !itksys::SystemTools::FileExists(socketPath.c_str()); ++i)
+    {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+  // Two jobs run at once by the two workers
+  int status[2] = {EXIT_FAILURE, EXIT_FAILURE};
+  std::ostringstream logs[2];
+  std::vector<std::thread> clients;
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+    std::ostringstream suffix;
+    suffix << "_" << i;
+    const std::vector<std::string> renamed = RenameOutput(job, suffix.str());
+    clients.push_back(std::thread([&socketPath, &status, &logs, renamed, i]
+      { status[i] = ServerType::SubmitJob(socketPath, renamed, logs[i]); }));
+    }
+  for (unsigned int i = 0; i < clients.size(); ++i)
+    {
+    clients[i].join();
+    std::cout << logs[i].str();
+    }
+  unsigned int nbJobs = 2;
+  int result = (status[0] == EXIT_SUCCESS) ? status[1] : status[0];
+
+  // The same job saved to an XML file, then run from it. The module
+  // path follows the XML file.
+  if (result == EXIT_SUCCESS)
+    {
+    const std::string xmlFile = socketPath + ".xml";
+    std::vector<std::string> xmlJob(job);
+    xmlJob.push_back("-outxml");
+    xmlJob.push_back(xmlFile);
+    result = ServerType::SubmitJob(socketPath, xmlJob, std::cout);
+    ++nbJobs;
+
+    if (result == EXIT_SUCCESS)
+      {
+      std::vector<std::string> inXMLJob;
+      inXMLJob.push_back("-inxml");
+      inXMLJob.push_back(xmlFile);
+      if (job.size() > 1 && job[1][0] != '-')
+        {
+        inXMLJob.push_back(job[1]);
+        }
+      result = ServerType::SubmitJob(socketPath, inXMLJob, std::cout);
+      ++nbJobs;
+      }
+    }
+
+  server->Stop();
+  serverThread.join();
+
+  if (!served)
+    {
+    std::cerr << "The server could not listen on " << socketPath << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (server->GetNumberOfCompletedJobs() != nbJobs)
+    {
+    std::cerr << server->GetNumberOfCompletedJobs() << " jobs run instead of " << nbJobs << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return result;
+}
@@ -24,6 +24,10 @@
 
 #include "otbWrapperCommandLineLauncher.h"
 
+#include <fstream>
+#include <map>
+#include <sstream>
+
 
 int otbWrapperCommandLineLauncherNew(int itkNotUsed(argc), char* itkNotUsed(argv)[])
 {
@@ -64,3 +68,162 @@ int otbWrapperCommandLineLauncherTest(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+namespace
+{
+typedef std::map<std::string, std::string> ProfileEntryType;
+
+/** Read the entries of a profile written as JSON by PipelineProfiler,
+ * one "key": value per line */
+bool ReadJSONProfile(const std::string& filename, std::vector<ProfileEntryType>& entries)
+{
+  std::ifstream ifs(filename.c_str());
+  if (!ifs.is_open())
+    {
+    std::cerr << "Unable to open " << filename << std::endl;
+    return false;
+    }
+
+  std::ostringstream content;
+  content << ifs.rdbuf();
+  std::istringstream lines(content.str());
+
+  int depth = 0;
+  bool inProcessObjects = false;
+  std::string line;
+  while (std::getline(lines, line))
+    {
+    const std::string::size_type first = line.find_first_not_of(" \t");
+    if (first == std::string::npos)
+      {
+      continue;
+      }
+    line = line.substr(first);
+    if (line[0] == '{')
+      {
+      ++depth;
+      if (inProcessObjects)
+        {
+        entries.push_back(ProfileEntryType());
+        }
+      continue;
+      }
+    if (line[0] == '}')
+      {
+      --depth;
+      continue;
+      }
+    if (line[0] == ']')
+      {
+      inProcessObjects = false;
+      continue;
+      }
+    if (line.compare(0, 18, "\"processObjects\": ") == 0)
+      {
+      inProcessObjects = true;
+      continue;
+      }
+
+    // "key": value,
+    const std::string::size_type colon = line.find("\": ");
+    if (line[0] != '"' || colon == std::string::npos || !inProcessObjects || entries.empty())
+      {
+      std::cerr << "Unexpected line in the profile: " << line << std::endl;
+      return false;
+      }
+    std::string value = line.substr(colon + 3);
+    if (!value.empty() && value[value.size() - 1] == ',')
+      {
+      value.erase(value.size() - 1);
+      }
+    if (value.size() >= 2 && value[0] == '"')
+      {
+      value = value.substr(1, value.size() - 2);
+      }
+    entries.back()[line.substr(1, colon - 1)] = value;
+    }
+
+  if (depth != 0 || inProcessObjects)
+    {
+    std::cerr << "The profile is not a complete JSON document" << std::endl;
+    return false;
+    }
+  return true;
+}
+
+double GetProfileValue(const ProfileEntryType& entry, const std::string& key)
+{
+  ProfileEntryType::const_iterator it = entry.find(key);
+  if (it == entry.end())
+    {
+    return -1.;
+    }
+  std::istringstream iss(it->second);
+  double value = -1.;
+  iss >> value;
+  return iss.fail() ? -1. : value;
+}
+}
+
+/** Check the profile written by -profile: each class given after the
+ * filename must have run, and its measures must be consistent */
+int otbWrapperCommandLineLauncherCheckProfile(int argc, char* argv[])
+{
+  if (argc < 3)
+    {
+    std::cerr << "Usage: " << argv[0] << " profile.json class1 [class2 ...]" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::vector<ProfileEntryType> entries;
+  if (!ReadJSONProfile(argv[1], entries))
+    {
+    return EXIT_FAILURE;
+    }
+
+  bool ok = true;
+  for (int i = 2; i < argc; ++i)
+    {
+    const std::string className = argv[i];
+    bool found = false;
+    for (std::vector<ProfileEntryType>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+      {
+      ProfileEntryType::const_iterator classIt = it->find("class");
+      if (classIt == it->end() || classIt->second != className)
+        {
+        continue;
+        }
+      found = true;
+
+      const double calls = GetProfileValue(*it, "calls");
+      const double wallTime = GetProfileValue(*it, "wallTime");
+      const double selfWallTime = GetProfileValue(*it, "selfWallTime");
+      const double processCpuTime = GetProfileValue(*it, "processCpuTime");
+      const double selfProcessCpuTime = GetProfileValue(*it, "selfProcessCpuTime");
+      const double threads = GetProfileValue(*it, "threads");
+      const double bytes = GetProfileValue(*it, "inputBytes") + GetProfileValue(*it, "outputBytes");
+
+      std::cout << className << ": " << calls << " calls, " << wallTime << " s, "
+                << processCpuTime << " s process CPU, " << bytes << " bytes" << std::endl;
+
+      if (calls < 1 || threads < 1 || bytes <= 0.)
+        {
+        std::cerr << className << " did not run or did not process any data" << std::endl;
+        ok = false;
+        }
+      if (wallTime < 0. || selfWallTime < 0. || selfWallTime > wallTime
+          || processCpuTime < 0. || selfProcessCpuTime < 0. || selfProcessCpuTime > processCpuTime)
+        {
+        std::cerr << className << " has inconsistent times" << std::endl;
+        ok = false;
+        }
+      }
+    if (!found)
+      {
+      std::cerr << "No entry for " << className << " in the profile" << std::endl;
+      ok = false;
+      }
+    }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
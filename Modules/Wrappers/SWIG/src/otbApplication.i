@@ -40,6 +40,10 @@
 #if OTB_SWIGNUMPY
 %include "numpy.i"
 
+ %{
+#include "otbPyImageSource.h"
+%}
+
 %init
 %{
 import_array();
@@ -68,6 +72,9 @@ import_array();
 %apply (unsigned long** ARGOUTVIEW_ARRAY3, int *DIM1, int *DIM2, int *DIM3) {(unsigned long** buffer, int *dim1, int *dim2, int *dim3)};
 %apply (double** ARGOUTVIEW_ARRAY3, int *DIM1, int *DIM2, int *DIM3) {(double** buffer, int *dim1, int *dim2, int *dim3)};
 
+%apply int *OUTPUT { int *startx, int *starty, int *sizex, int *sizey };
+%apply double *OUTPUT { double *originx, double *originy, double *spacingx, double *spacingy };
+
 #endif /* OTB_SWIGNUMPY */
 
 namespace otb
@@ -398,6 +405,43 @@ public:
        GetVectorImageAsNumpyArrayMacro(Double, double)
 #undef GetVectorImageAsNumpyArrayMacro
 
+#define SetVectorImageFromTileProviderMacro(prefix, PixelDataType)      \
+      itkProcessObject_Pointer SetVectorImageFrom##prefix##TileProvider_(std::string pkey, PyObject* provider, \
+                                    int sizex, int sizey, int nbBands, double originx, double originy, double spacingx, double spacingy) \
+      {                                                                 \
+        otb::Wrapper::Parameter *parameter = $self->GetParameterList()->GetParameterByKey(pkey); \
+        InputImageParameter* inputImageParam = dynamic_cast<InputImageParameter*>(parameter); \
+        if (!inputImageParam)                                           \
+          {                                                             \
+          itkGenericExceptionMacro(<< "Parameter " << pkey << " is not an input image"); \
+          }                                                             \
+        typedef otb::VectorImage<##PixelDataType##>   ImageType;       \
+        typedef otb::PyImageSource<ImageType>         SourceType;      \
+        SourceType::Pointer source = SourceType::New();                 \
+        source->SetTileCallable(provider);                              \
+        SourceType::SizeType size;                                      \
+        size[0] = sizex; size[1] = sizey;                               \
+        source->SetSize(size);                                          \
+        source->SetNumberOfComponents(nbBands);                         \
+        SourceType::PointType origin;                                   \
+        origin[0] = originx; origin[1] = originy;                       \
+        source->SetOrigin(origin);                                      \
+        SourceType::SpacingType spacing;                                \
+        spacing[0] = spacingx; spacing[1] = spacingy;                   \
+        source->SetSpacing(spacing);                                    \
+        inputImageParam->SetImage<ImageType>(source->GetOutput());      \
+        return source.GetPointer();                                     \
+      }
+
+       SetVectorImageFromTileProviderMacro(Float, float)
+       SetVectorImageFromTileProviderMacro(Int16, signed short)
+       SetVectorImageFromTileProviderMacro(Int32, signed int)
+       SetVectorImageFromTileProviderMacro(UInt8, unsigned char)
+       SetVectorImageFromTileProviderMacro(UInt16, unsigned short)
+       SetVectorImageFromTileProviderMacro(UInt32, unsigned int)
+       SetVectorImageFromTileProviderMacro(Double, double)
+#undef SetVectorImageFromTileProviderMacro
+
 } /* end of %extend */
 #endif /* OTB_SWIGNUMPY */
 
@@ -414,6 +458,95 @@ private:
 
 DECLARE_REF_COUNT_CLASS( Application )
 
+class ImageTileStreamer : public itkObject
+{
+public:
+  static ImageTileStreamer_Pointer New();
+
+  void SetAvailableRAM(unsigned int ram);
+  unsigned int GetAvailableRAM() const;
+  void SetTileDimension(unsigned int dimension);
+  unsigned int GetTileDimension() const;
+
+  unsigned int PrepareTiles();
+  unsigned int GetNumberOfTiles() const;
+  void GenerateTile(unsigned int tile);
+  otb::Wrapper::ImagePixelType GetPixelType() const;
+
+  %extend {
+
+      void SetImageFromParameter(Application* app, std::string pkey)
+      {
+        otb::Wrapper::Parameter *parameter = app->GetParameterList()->GetParameterByKey(pkey);
+        OutputImageParameter* outputImageParam = dynamic_cast<OutputImageParameter*>(parameter);
+        if (!outputImageParam)
+          {
+          itkGenericExceptionMacro(<< "Parameter " << pkey << " is not an output image");
+          }
+        $self->SetImage(outputImageParam->GetValue());
+      }
+
+      void GetTileRegion_(unsigned int tile, int *startx, int *starty, int *sizex, int *sizey)
+      {
+        ImageTileStreamer::RegionType region = $self->GetTileRegion(tile);
+        *startx = region.GetIndex()[0];
+        *starty = region.GetIndex()[1];
+        *sizex = region.GetSize()[0];
+        *sizey = region.GetSize()[1];
+      }
+
+      void GetBufferedRegion_(int *startx, int *starty, int *sizex, int *sizey)
+      {
+        ImageTileStreamer::RegionType region = $self->GetImage()->GetBufferedRegion();
+        *startx = region.GetIndex()[0];
+        *starty = region.GetIndex()[1];
+        *sizex = region.GetSize()[0];
+        *sizey = region.GetSize()[1];
+      }
+
+      void GetOriginAndSpacing_(double *originx, double *originy, double *spacingx, double *spacingy)
+      {
+        *originx = $self->GetImage()->GetOrigin()[0];
+        *originy = $self->GetImage()->GetOrigin()[1];
+        *spacingx = $self->GetImage()->GetSpacing()[0];
+        *spacingy = $self->GetImage()->GetSpacing()[1];
+      }
+
+#if OTB_SWIGNUMPY
+#define GetBufferAsNumpyArrayMacro(prefix, PixelType)                   \
+      void GetBufferAs##prefix##NumpyArray_(##PixelType##** buffer, int *dim1, int *dim2, int *dim3) \
+        {                                                               \
+        ImageTileStreamer::RegionType region = $self->GetImage()->GetBufferedRegion(); \
+        *dim1 = region.GetSize()[1];                                    \
+        *dim2 = region.GetSize()[0];                                    \
+        *dim3 = $self->GetImage()->GetNumberOfComponentsPerPixel();     \
+        *buffer = reinterpret_cast<##PixelType##*>($self->GetBufferPointer()); \
+        }
+
+       GetBufferAsNumpyArrayMacro(Float, float)
+       GetBufferAsNumpyArrayMacro(Int16, signed short)
+       GetBufferAsNumpyArrayMacro(Int32, signed int)
+       GetBufferAsNumpyArrayMacro(UInt8, unsigned char)
+       GetBufferAsNumpyArrayMacro(UInt16, unsigned short)
+       GetBufferAsNumpyArrayMacro(UInt32, unsigned int)
+       GetBufferAsNumpyArrayMacro(Double, double)
+#undef GetBufferAsNumpyArrayMacro
+#endif /* OTB_SWIGNUMPY */
+
+  } /* end of %extend */
+
+protected:
+  ImageTileStreamer();
+#if SWIGJAVA
+  virtual ~ImageTileStreamer();
+#endif
+private:
+  ImageTileStreamer(const ImageTileStreamer &);
+  void operator =(const ImageTileStreamer&);
+};
+
+DECLARE_REF_COUNT_CLASS( ImageTileStreamer )
+
 
     /* Int8 Int16 Int32 Int64 */
     /* UInt8 UInt16 UInt32 UInt64 */
@@ -463,6 +596,18 @@ class ApplicationProxy(object):
     else:
       return dict.__setattr__(self, attr, value)
 
+class ImageTile(object):
+  """
+  Tile of an image, as given by Application.GetImageTiles():
+  array : numpy array of shape (sizey, sizex, bands)
+  region : (startx, starty, sizex, sizey), in pixels
+  geotransform : GDAL geotransform of the tile
+  """
+  def __init__(self, array, region, geotransform):
+    self.array = array
+    self.region = region
+    self.geotransform = geotransform
+
 }
 #endif
 
@@ -741,6 +886,104 @@ class ApplicationProxy(object):
       numpy_vector_image = numpy_vector_image[:,:,1]
       return numpy_vector_image
 
+    def GetImageTiles(self, paramKey, ram=None, tileDimension=0):
+      """
+      Generate the output image paramKey tile by tile, instead of
+      computing it at once like GetVectorImageAsNumpyArray.
+      Execute() must have been called. The tiles are sized from ram (in
+      MB, by default the 'ram' parameter of the application if any, or
+      the default of the configuration), or are squares of
+      tileDimension pixels.
+
+      This method is a generator of ImageTile. The array of a tile is a
+      view on the buffer of the image, without copy: it is only valid
+      until the next tile is generated, and must be copied to be kept.
+      """
+      if ram is None:
+        ram = 0
+        if 'ram' in self.GetParametersKeys(True):
+          ram = self.GetParameterInt('ram')
+      streamer = ImageTileStreamer.New()
+      streamer.SetImageFromParameter(self, paramKey)
+      streamer.SetAvailableRAM(ram)
+      streamer.SetTileDimension(tileDimension)
+      for tile in range(streamer.PrepareTiles()):
+        streamer.GenerateTile(tile)
+        yield streamer.GetTile(tile)
+
+    def SetImageFromTileProvider(self, paramKey, provider, sizex, sizey, nbBands, dt='float', geotransform=None):
+      """
+      Set the input image paramKey from a tile provider, so that the
+      application streams an image computed, or read, by Python code.
+      provider is a callable receiving (startx, starty, sizex, sizey) and
+      returning the pixels of this region as a numpy array of shape
+      (sizey, sizex, nbBands). It is called each time the pipeline of
+      the application requests a region.
+      Valid datatypes are:
+      int16, int32, uint8, uint16, uint32, float, double.
+      geotransform is the GDAL geotransform of the image (default: unit
+      spacing, first pixel centered on (0,0)).
+      """
+      import numpy
+      setters = {
+        'int16' : (numpy.int16, self.SetVectorImageFromInt16TileProvider_),
+        'int32' : (numpy.int32, self.SetVectorImageFromInt32TileProvider_),
+        'uint8' : (numpy.uint8, self.SetVectorImageFromUInt8TileProvider_),
+        'uint16' : (numpy.uint16, self.SetVectorImageFromUInt16TileProvider_),
+        'uint32' : (numpy.uint32, self.SetVectorImageFromUInt32TileProvider_),
+        'float' : (numpy.float32, self.SetVectorImageFromFloatTileProvider_),
+        'double' : (numpy.float64, self.SetVectorImageFromDoubleTileProvider_),
+        }
+      if dt not in setters:
+        raise ValueError("Unknown datatype '" + dt + "'. Available types are:\n"
+                         "int16, int32, uint8, uint16, uint32, float, double")
+      npType, setter = setters[dt]
+
+      originx, originy, spacingx, spacingy = 0.0, 0.0, 1.0, 1.0
+      if geotransform is not None:
+        spacingx = geotransform[1]
+        spacingy = geotransform[5]
+        originx = geotransform[0] + 0.5 * spacingx
+        originy = geotransform[3] + 0.5 * spacingy
+
+      def tile(startx, starty, tileSizex, tileSizey):
+        return numpy.ascontiguousarray(provider(startx, starty, tileSizex, tileSizey), dtype=npType)
+
+      source = setter(paramKey, tile, sizex, sizey, nbBands, originx, originy, spacingx, spacingy)
+      # the input image only references its source weakly
+      self.__dict__.setdefault('_tileSources', {})[paramKey] = source
+      return
+
+
+    }
+}
+
+%extend ImageTileStreamer
+{
+  %pythoncode
+    {
+    def GetTile(self, tile):
+      """
+      Return the ImageTile of a tile generated by GenerateTile(). Its
+      array is a view on the buffer of the image.
+      """
+      startx, starty, sizex, sizey = self.GetTileRegion_(tile)
+      bufferx, buffery, buffersizex, buffersizey = self.GetBufferedRegion_()
+      getBuffer = {
+        ImagePixelType_uint8 : self.GetBufferAsUInt8NumpyArray_,
+        ImagePixelType_int16 : self.GetBufferAsInt16NumpyArray_,
+        ImagePixelType_uint16 : self.GetBufferAsUInt16NumpyArray_,
+        ImagePixelType_int32 : self.GetBufferAsInt32NumpyArray_,
+        ImagePixelType_uint32 : self.GetBufferAsUInt32NumpyArray_,
+        ImagePixelType_float : self.GetBufferAsFloatNumpyArray_,
+        ImagePixelType_double : self.GetBufferAsDoubleNumpyArray_,
+        }[self.GetPixelType()]
+      array = getBuffer()[starty - buffery : starty - buffery + sizey,
+                          startx - bufferx : startx - bufferx + sizex, :]
+      originx, originy, spacingx, spacingy = self.GetOriginAndSpacing_()
+      geotransform = (originx + (startx - 0.5) * spacingx, spacingx, 0.0,
+                      originy + (starty - 0.5) * spacingy, 0.0, spacingy)
+      return ImageTile(array, (startx, starty, sizex, sizey), geotransform)
 
     }
 }
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPyImageSource_h
+#define otbPyImageSource_h
+
+#include "itkImageSource.h"
+#include <cstring>
+
+// The python header defines _POSIX_C_SOURCE without a preceding #undef
+#undef _POSIX_C_SOURCE
+// The python header defines _XOPEN_SOURCE without a preceding #undef
+#undef _XOPEN_SOURCE
+
+#include <Python.h>
+
+namespace otb
+{
+
+/** \class PyImageSource
+ *  \brief Image source whose pixels are given by a Python callable,
+ *  one requested region at a time.
+ *
+ * The callable is called with the index and size of the requested
+ * region (startx, starty, sizex, sizey). It must return an object
+ * exposing a C contiguous buffer (typically a numpy array of shape
+ * (sizey, sizex, bands)) holding the pixels of the region, pixel
+ * interleaved, in the component type of the output image. The buffer
+ * is copied in the output, so that the pipeline can stream an image
+ * that Python code computes, or reads, tile by tile.
+ *
+ * The callable is called from the thread updating the pipeline, with
+ * the Python global interpreter lock held.
+ *
+ * \ingroup OTBSWIG
+ */
+template <class TOutputImage>
+class PyImageSource : public itk::ImageSource<TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef PyImageSource                     Self;
+  typedef itk::ImageSource<TOutputImage>    Superclass;
+  typedef itk::SmartPointer<Self>           Pointer;
+  typedef itk::SmartPointer<const Self>     ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PyImageSource, ImageSource);
+
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::RegionType        RegionType;
+  typedef typename OutputImageType::SizeType          SizeType;
+  typedef typename OutputImageType::PointType         PointType;
+  typedef typename OutputImageType::SpacingType       SpacingType;
+  typedef typename OutputImageType::InternalPixelType InternalPixelType;
+
+  /** Set the Python callable providing the tiles. A reference to it is
+   *  kept by the source. */
+  void SetTileCallable(PyObject *obj)
+  {
+    if (obj != m_TileCallable)
+      {
+      Py_XDECREF(m_TileCallable);
+      m_TileCallable = obj;
+      Py_XINCREF(m_TileCallable);
+      this->Modified();
+      }
+  }
+
+  /** Size of the image */
+  itkSetMacro(Size, SizeType);
+  itkGetConstMacro(Size, SizeType);
+
+  /** Number of bands of the image */
+  itkSetMacro(NumberOfComponents, unsigned int);
+  itkGetConstMacro(NumberOfComponents, unsigned int);
+
+  /** Origin (center of the first pixel) and spacing of the image */
+  itkSetMacro(Origin, PointType);
+  itkGetConstMacro(Origin, PointType);
+  itkSetMacro(Spacing, SpacingType);
+  itkGetConstMacro(Spacing, SpacingType);
+
+protected:
+  PyImageSource()
+    : m_TileCallable(ITK_NULLPTR),
+      m_NumberOfComponents(1)
+  {
+    m_Size.Fill(0);
+    m_Origin.Fill(0.);
+    m_Spacing.Fill(1.);
+  }
+
+  ~PyImageSource() ITK_OVERRIDE
+  {
+    Py_XDECREF(m_TileCallable);
+  }
+
+  void GenerateOutputInformation() ITK_OVERRIDE
+  {
+    OutputImageType * output = this->GetOutput();
+    RegionType largestRegion;
+    largestRegion.SetSize(m_Size);
+    output->SetLargestPossibleRegion(largestRegion);
+    output->SetNumberOfComponentsPerPixel(m_NumberOfComponents);
+    output->SetOrigin(m_Origin);
+    output->SetSpacing(m_Spacing);
+  }
+
+  void GenerateData() ITK_OVERRIDE
+  {
+    OutputImageType * output = this->GetOutput();
+    const RegionType region = output->GetRequestedRegion();
+    output->SetBufferedRegion(region);
+    output->Allocate();
+
+    const size_t expectedLength = region.GetNumberOfPixels() * m_NumberOfComponents * sizeof(InternalPixelType);
+
+    PyGILState_STATE gilState = PyGILState_Ensure();
+    if (!PyCallable_Check(m_TileCallable))
+      {
+      PyGILState_Release(gilState);
+      itkExceptionMacro(<< "TileCallable is not a callable Python object, or it has not been set.");
+      }
+
+    PyObject *result = PyObject_CallFunction(m_TileCallable, const_cast<char*>("llll"),
+                                             static_cast<long>(region.GetIndex()[0]),
+                                             static_cast<long>(region.GetIndex()[1]),
+                                             static_cast<long>(region.GetSize()[0]),
+                                             static_cast<long>(region.GetSize()[1]));
+    if (!result)
+      {
+      PyErr_Print();
+      PyGILState_Release(gilState);
+      itkExceptionMacro(<< "There was an error executing the TileCallable on region " << region);
+      }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(result, &view, PyBUF_C_CONTIGUOUS) != 0)
+      {
+      PyErr_Print();
+      Py_DECREF(result);
+      PyGILState_Release(gilState);
+      itkExceptionMacro(<< "The TileCallable did not return a contiguous buffer");
+      }
+
+    const size_t length = static_cast<size_t>(view.len);
+    if (length == expectedLength)
+      {
+      std::memcpy(output->GetBufferPointer(), view.buf, length);
+      }
+    PyBuffer_Release(&view);
+    Py_DECREF(result);
+    PyGILState_Release(gilState);
+
+    if (length != expectedLength)
+      {
+      itkExceptionMacro(<< "The TileCallable returned " << length << " bytes for region " << region
+                        << ", " << expectedLength << " bytes were expected");
+      }
+  }
+
+private:
+  PyImageSource(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+
+  PyObject *   m_TileCallable;
+  SizeType     m_Size;
+  unsigned int m_NumberOfComponents;
+  PointType    m_Origin;
+  SpacingType  m_Spacing;
+};
+
+} // end namespace otb
+
+#endif
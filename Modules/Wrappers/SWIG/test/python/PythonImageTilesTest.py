@@ -0,0 +1,69 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) 2005-2017 CS Systemes d'Information (CS SI)
+#
+# This file is part of Orfeo Toolbox
+#
+#     https://www.orfeo-toolbox.org/
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+
+#  Example on streaming an image tile by tile to and from numpy
+#
+
+import numpy as np
+
+def test(otbApplication, argv):
+	inFile  = argv[1]
+	outFile = argv[2]
+
+	def smoothing():
+		app = otbApplication.Registry.CreateApplication("Smoothing")
+		app.SetParameterString("in", inFile)
+		app.SetParameterString("type", 'mean')
+		app.Execute()
+		return app
+
+	# Reference : the whole output at once, from another instance so
+	# that the tiles are not sliced from its buffer
+	reference = smoothing().GetVectorImageAsNumpyArray("out", 'float')
+	result = np.zeros(reference.shape, dtype=np.float32)
+
+	nbPixels = 0
+	nbTiles = 0
+	for tile in smoothing().GetImageTiles("out", tileDimension=64):
+		startx, starty, sizex, sizey = tile.region
+		# The array is only valid until the next tile
+		result[starty:starty+sizey, startx:startx+sizex, :] = tile.array
+		nbPixels += sizex * sizey
+		nbTiles += 1
+
+	if nbPixels != reference.shape[0] * reference.shape[1]:
+		raise Exception("The tiles cover %d pixels" % nbPixels)
+	if nbTiles < 2:
+		raise Exception("The image was not streamed")
+	if not np.array_equal(result, reference):
+		raise Exception("Tiles differ from the whole image")
+
+	# Feed the image back tile by tile
+	requested = []
+	def provider(startx, starty, sizex, sizey):
+		requested.append((startx, starty, sizex, sizey))
+		return result[starty:starty+sizey, startx:startx+sizex, :]
+
+	Rescale = otbApplication.Registry.CreateApplication("Rescale")
+	Rescale.SetImageFromTileProvider("in", provider, result.shape[1], result.shape[0], result.shape[2])
+	Rescale.SetParameterString("out", outFile)
+	Rescale.SetParameterInt("ram", 1)
+	Rescale.ExecuteAndWriteOutput()
+
+	if not requested:
+		raise Exception("The tile provider was never called")
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbWrapperApplicationRegistry.h"
+#include "itksys/SystemTools.hxx"
+
+/**
+ * Small executable to write the index of the applications found in
+ * each given directory (see ApplicationRegistry::WriteApplicationIndex).
+ *
+ * It runs at the end of the build and of the installation of OTB, and
+ * can be used on any other application directory.
+ */
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+    {
+    std::cerr << "Usage : " << argv[0] << " module_path [module_path ...]" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  for (int i = 1 ; i < argc ; ++i)
+    {
+    std::string module_path(argv[i]);
+    if (!itksys::SystemTools::FileIsDirectory(module_path.c_str()))
+      {
+      std::cout << "No application to index in " << module_path << std::endl;
+      continue;
+      }
+    if (!otb::Wrapper::ApplicationRegistry::WriteApplicationIndex(module_path))
+      {
+      std::cerr << "Error writing the application index of " << module_path << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}